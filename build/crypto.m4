@@ -315,3 +315,31 @@ AC_DEFUN([TS_CHECK_EARLY_DATA], [
 
   AC_SUBST(has_tls_early_data)
 ])
+
+dnl
+dnl Since OpenSSL 3.0
+dnl
+AC_DEFUN([TS_CHECK_KTLS], [
+  _ktls_saved_LIBS=$LIBS
+
+  TS_ADDTO(LIBS, [$OPENSSL_LIBS])
+  AC_CHECK_HEADERS(openssl/ssl.h)
+  AC_CHECK_FUNCS(
+    SSL_sendfile,
+    [
+      has_ktls=1
+      ktls_check=yes
+    ],
+    [
+      has_ktls=0
+      ktls_check=no
+    ]
+  )
+
+  LIBS=$_ktls_saved_LIBS
+
+  AC_MSG_CHECKING([for OpenSSL kernel TLS support])
+  AC_MSG_RESULT([$ktls_check])
+
+  AC_SUBST(has_ktls)
+])
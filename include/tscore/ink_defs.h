@@ -130,3 +130,6 @@ int ink_login_name_max();
 // Get the hardware topology
 hwloc_topology_t ink_get_topology();
 #endif
+
+// Spread the pages of a page aligned area over all NUMA nodes, a no-op without hwloc or on one node.
+void ink_numa_interleave(void *addr, size_t len);
@@ -170,6 +170,7 @@ struct _InkFreeList {
   uint32_t type_size, chunk_size, used, allocated, alignment;
   uint32_t allocated_base, used_base;
   int advice;
+  uint32_t magazine_index; ///< Slot of this list in each thread's magazines.
 };
 
 typedef struct ink_freelist_ops InkFreeListOps;
@@ -178,6 +179,7 @@ typedef struct _InkFreeList InkFreeList;
 const InkFreeListOps *ink_freelist_malloc_ops();
 const InkFreeListOps *ink_freelist_freelist_ops();
 void ink_freelist_init_ops(int nofl_class, int nofl_proxy);
+void ink_freelist_init_magazines(uint32_t magazine_size);
 
 /*
  * alignment must be a power of 2
@@ -65,6 +65,7 @@ int cache_config_ram_cache_compress_percent    = 90;
 int cache_config_ram_cache_use_seen_filter     = 1;
 int cache_config_http_max_alts                 = 3;
 int cache_config_dir_sync_frequency            = 60;
+int cache_config_dir_numa_interleave           = 0;
 int cache_config_permit_pinning                = 0;
 int cache_config_select_alternate              = 1;
 int cache_config_max_doc_size                  = 0;
@@ -76,12 +77,21 @@ int cache_config_hit_evacuate_size_limit       = 0;
 int cache_config_force_sector_size             = 0;
 int cache_config_target_fragment_size          = DEFAULT_TARGET_FRAGMENT_SIZE;
 int cache_config_agg_write_backlog             = AGG_SIZE * 2;
+int cache_config_agg_write_buffer_size         = AGG_SIZE;
+int cache_config_agg_write_buffers             = 1;
+int cache_config_admission_policy              = CACHE_ADMISSION_NONE;
+int cache_config_admission_threshold           = 2;
+int64_t cache_config_admission_sketch_width    = 0;
 int cache_config_enable_checksum               = 0;
 int cache_config_alt_rewrite_max_size          = 4096;
 int cache_config_read_while_writer             = 0;
 int cache_config_mutex_retry_delay             = 2;
 int cache_read_while_writer_retry_delay        = 50;
 int cache_config_read_while_writer_max_retries = 10;
+int cache_config_read_ahead_fragments          = 0;
+int64_t cache_config_read_ahead_max_bytes      = 16 * 1024 * 1024;
+int64_t cache_config_zero_copy_min_size        = 0;
+int cache_config_zero_copy_max_wait            = 100;
 
 // Globals
 
@@ -107,7 +117,9 @@ std::atomic<int> gnvol = 0;
 ClassAllocator<CacheVC> cacheVConnectionAllocator("cacheVConnection");
 ClassAllocator<EvacuationBlock> evacuationBlockAllocator("evacuationBlock");
 ClassAllocator<CacheRemoveCont> cacheRemoveContAllocator("cacheRemoveCont");
+ClassAllocator<CacheReadAhead> cacheReadAheadAllocator("cacheReadAhead");
 ClassAllocator<EvacuationKey> evacuationKeyAllocator("evacuationKey");
+ClassAllocator<CacheZeroCopyRange> cacheZeroCopyRangeAllocator("cacheZeroCopyRange");
 int CacheVC::size_to_init = -1;
 CacheKey zero_key;
 
@@ -212,7 +224,7 @@ cache_bytes_used(int volume)
       if (!gvol[i]->header->cycle) {
         used += gvol[i]->header->write_pos - gvol[i]->start;
       } else {
-        used += gvol[i]->len - gvol[i]->dirlen() - EVACUATION_SIZE;
+        used += gvol[i]->len - gvol[i]->dirlen() - gvol[i]->evacuation_size();
       }
     }
   }
@@ -659,6 +671,12 @@ CacheProcessor::start_internal(int flags)
         gdisks[gndisks] = new CacheDisk();
         if (check) {
           gdisks[gndisks]->read_only_p = true;
+        } else if (cache_config_zero_copy_min_size > 0) {
+          // sendfile needs the page cache, which the O_DIRECT descriptor bypasses
+          gdisks[gndisks]->sendfile_fd = open(path, O_RDONLY | O_CLOEXEC);
+          if (gdisks[gndisks]->sendfile_fd < 0) {
+            Warning("cache unable to open '%s' for zero copy reads: %s", path, strerror(errno));
+          }
         }
         gdisks[gndisks]->forced_volume_num = sd->forced_volume_num;
         if (sd->hash_base_string) {
@@ -912,6 +930,7 @@ CacheProcessor::cacheInitialized()
         for (i = 0; i < gnvol; i++) {
           vol = gvol[i];
           gvol[i]->ram_cache->init(vol->dirlen() * DEFAULT_RAM_CACHE_MULTIPLIER, vol);
+          gvol[i]->admission_init(vol->dirlen() * DEFAULT_RAM_CACHE_MULTIPLIER);
           ram_cache_bytes += gvol[i]->dirlen();
           Debug("cache_init", "CacheProcessor::cacheInitialized - ram_cache_bytes = %" PRId64 " = %" PRId64 "Mb", ram_cache_bytes,
                 ram_cache_bytes / (1024 * 1024));
@@ -960,6 +979,7 @@ CacheProcessor::cacheInitialized()
             factor = static_cast<double>(static_cast<int64_t>(gvol[i]->len >> STORE_BLOCK_SHIFT)) / theCache->cache_size;
             Debug("cache_init", "CacheProcessor::cacheInitialized - factor = %f", factor);
             gvol[i]->ram_cache->init(static_cast<int64_t>(http_ram_cache_size * factor), vol);
+            gvol[i]->admission_init(static_cast<int64_t>(http_ram_cache_size * factor));
             ram_cache_bytes += static_cast<int64_t>(http_ram_cache_size * factor);
             CACHE_VOL_SUM_DYN_STAT(cache_ram_cache_bytes_total_stat, (int64_t)(http_ram_cache_size * factor));
           } else {
@@ -1219,6 +1239,24 @@ Vol::clear_dir()
   return 0;
 }
 
+void
+Vol::agg_init()
+{
+  int size = (cache_vol && cache_vol->agg_buffer_size) ? cache_vol->agg_buffer_size : cache_config_agg_write_buffer_size;
+
+  // fragments are sized against AGG_SIZE, so never go below it
+  agg_buf_size  = ROUND_TO_STORE_BLOCK(std::min(std::max(size, AGG_SIZE), MAX_AGG_SIZE));
+  agg_buf_count = std::min(std::max(cache_config_agg_write_buffers, 1), MAX_AGG_BUFFERS);
+  for (int i = 0; i < agg_buf_count; i++) {
+    if (!agg_buffers[i]) {
+      agg_buffers[i] = static_cast<char *>(ats_memalign(ats_pagesize(), agg_buf_size));
+      memset(agg_buffers[i], 0, agg_buf_size);
+    }
+  }
+  agg_buffer = agg_buffers[0];
+  Debug("cache_init", "Vol %s: %d aggregation buffers of %d bytes", hash_text.get(), agg_buf_count, agg_buf_size);
+}
+
 int
 Vol::init(char *s, off_t blocks, off_t dir_skip, bool clear)
 {
@@ -1232,6 +1270,8 @@ Vol::init(char *s, off_t blocks, off_t dir_skip, bool clear)
            static_cast<uint64_t>(dir_skip), static_cast<uint64_t>(blocks));
   CryptoContext().hash_immediate(hash_id, hash_text, strlen(hash_text));
 
+  agg_init();
+
   dir_skip = ROUND_TO_STORE_BLOCK((dir_skip < START_POS ? START_POS : dir_skip));
   path     = ats_strdup(s);
   len      = blocks * STORE_BLOCK_SIZE;
@@ -1260,6 +1300,10 @@ Vol::init(char *s, off_t blocks, off_t dir_skip, bool clear)
   if (raw_dir == nullptr) {
     raw_dir = static_cast<char *>(ats_memalign(ats_pagesize(), this->dirlen()));
   }
+  // Every thread probes every directory, so do not leave it all on the node that read it in.
+  if (cache_config_dir_numa_interleave) {
+    ink_numa_interleave(raw_dir, this->dirlen());
+  }
 
   dir    = reinterpret_cast<Dir *>(raw_dir + this->headerlen());
   header = reinterpret_cast<VolHeaderFooter *>(raw_dir);
@@ -1301,6 +1345,27 @@ Vol::init(char *s, off_t blocks, off_t dir_skip, bool clear)
   return 0;
 }
 
+void
+Vol::admission_init(int64_t ram_cache_bytes)
+{
+  int policy = (cache_vol && cache_vol->admission >= 0) ? cache_vol->admission : cache_config_admission_policy;
+  if (policy != CACHE_ADMISSION_TINYLFU || admission) {
+    return;
+  }
+  // by default one counter per document this stripe's share of the RAM
+  // cache can hold, the popular set the filter has to tell apart, capped
+  // by the directory
+  int64_t width = cache_config_admission_sketch_width;
+  if (!width) {
+    width = ram_cache_bytes / cache_config_min_average_object_size;
+    if (width <= 0 || width > direntries()) {
+      width = direntries();
+    }
+  }
+  admission = new CacheAdmissionFilter(width);
+  Debug("cache_init", "Vol %s: TinyLFU admission with %" PRId64 " counters", hash_text.get(), admission->width());
+}
+
 int
 Vol::handle_dir_clear(int event, void *data)
 {
@@ -1481,7 +1546,7 @@ Vol::handle_recover_from_data(int event, void * /* data ATS_UNUSED */)
     if (recover_wrapped && start == io.aiocb.aio_offset) {
       doc = reinterpret_cast<Doc *>(s);
       if (doc->magic != DOC_MAGIC || doc->write_serial < last_write_serial) {
-        recover_pos = skip + len - EVACUATION_SIZE;
+        recover_pos = skip + len - evacuation_size();
         goto Ldone;
       }
     }
@@ -1534,7 +1599,7 @@ Vol::handle_recover_from_data(int event, void * /* data ATS_UNUSED */)
           // (doc->sync_serial < last_sync_serial) ||
           // (doc->sync_serial > header->sync_serial + 1).
           // if we are too close to the end, wrap around
-          else if (recover_pos - (e - s) > (skip + len) - AGG_SIZE) {
+          else if (recover_pos - (e - s) > (skip + len) - agg_reserve()) {
             recover_wrapped     = true;
             recover_pos         = start;
             io.aiocb.aio_nbytes = RECOVERY_SIZE;
@@ -1549,7 +1614,7 @@ Vol::handle_recover_from_data(int event, void * /* data ATS_UNUSED */)
           // If we are in the danger zone - recover_pos is within AGG_SIZE
           // from the end, then wrap around
           recover_pos -= e - s;
-          if (recover_pos > (skip + len) - AGG_SIZE) {
+          if (recover_pos > (skip + len) - agg_reserve()) {
             recover_wrapped     = true;
             recover_pos         = start;
             io.aiocb.aio_nbytes = RECOVERY_SIZE;
@@ -1602,8 +1667,8 @@ Ldone : {
     return handle_recover_write_dir(EVENT_IMMEDIATE, nullptr);
   }
 
-  recover_pos += EVACUATION_SIZE; // safely cover the max write size
-  if (recover_pos < header->write_pos && (recover_pos + EVACUATION_SIZE >= header->write_pos)) {
+  recover_pos += evacuation_size(); // safely cover the max write size
+  if (recover_pos < header->write_pos && (recover_pos + evacuation_size() >= header->write_pos)) {
     Debug("cache_init", "Head Pos: %" PRIu64 ", Rec Pos: %" PRIu64 ", Wrapped:%d", header->write_pos, recover_pos, recover_wrapped);
     Warning("no valid directory found while recovering '%s', clearing", hash_text.get());
     goto Lclear;
@@ -2121,7 +2186,7 @@ CacheVC::is_pread_capable()
 
 #define STORE_COLLISION 1
 
-static void
+void
 unmarshal_helper(Doc *doc, Ptr<IOBufferData> &buf, int &okay)
 {
   using UnmarshalFunc           = int(char *buf, int len, RefCountObj *block_ref);
@@ -2130,8 +2195,11 @@ unmarshal_helper(Doc *doc, Ptr<IOBufferData> &buf, int &okay)
 
   // introduced by https://github.com/apache/trafficserver/pull/4874, this is used to distinguish the doc version
   // before and after #4847
-  if (version < CACHE_DB_VERSION) {
+  if (version < ts::VersionNumber(24, 2)) {
     unmarshal_func = &HTTPInfo::unmarshal_v24_1;
+  } else if (version < CACHE_DB_VERSION) {
+    // before the alternates had a Vary fingerprint
+    unmarshal_func = &HTTPInfo::unmarshal_v24_2;
   }
 
   char *tmp = doc->hdr();
@@ -2212,7 +2280,7 @@ CacheVC::handleReadDone(int event, Event *e)
       if (!f.doc_from_ram_cache) {
         f.not_from_ram_cache = 1;
       }
-      if (cache_config_enable_checksum && doc->checksum != DOC_NO_CHECKSUM) {
+      if (cache_config_enable_checksum && doc->checksum != DOC_NO_CHECKSUM && !f.doc_header_only) {
         // verify that the checksum matches
         uint32_t checksum = 0;
         for (char *b = doc->hdr(); b < reinterpret_cast<char *>(doc) + doc->len; b++) {
@@ -2237,7 +2305,7 @@ CacheVC::handleReadDone(int event, Event *e)
         unmarshal_helper(doc, buf, okay);
       }
       // Put the request in the ram cache only if its a open_read or lookup
-      if (vio.op == VIO::READ && okay) {
+      if (vio.op == VIO::READ && okay && !f.doc_header_only) {
         bool cutoff_check;
         // cutoff_check :
         // doc_len == 0 for the first fragment (it is set from the vector)
@@ -2279,6 +2347,12 @@ CacheVC::handleRead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   cancel_trigger();
 
   f.doc_from_ram_cache = false;
+  f.doc_header_only    = false;
+  // the file ranges of the previous fragment hold their own references
+  if (zero_copy_range) {
+    Vol::zero_copy_release(zero_copy_range);
+    zero_copy_range = nullptr;
+  }
 
   // check ram cache
   ink_assert(vol->mutex->thread_holding == this_ethread());
@@ -2298,20 +2372,38 @@ CacheVC::handleRead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   if (dir_agg_buf_valid(vol, &dir)) {
     int agg_offset = vol->vol_offset(&dir) - vol->header->write_pos;
     buf            = new_IOBufferData(iobuffer_size_to_index(io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
-    ink_assert((agg_offset + io.aiocb.aio_nbytes) <= (unsigned)vol->agg_buf_pos);
-    char *doc = buf->data();
-    char *agg = vol->agg_buffer + agg_offset;
+    char *doc      = buf->data();
+    char *agg      = vol->agg_buffer_at(agg_offset, io.aiocb.aio_nbytes);
     memcpy(doc, agg, io.aiocb.aio_nbytes);
     io.aio_result = io.aiocb.aio_nbytes;
     SET_HANDLER(&CacheVC::handleReadDone);
     return EVENT_RETURN;
   }
+  // see if it was already requested by read-ahead
+  if (read_ahead.head) {
+    int ret = read_ahead_take();
+    if (ret != EVENT_NONE) {
+      return ret;
+    }
+  }
 
   io.aiocb.aio_fildes = vol->fd;
   io.aiocb.aio_offset = vol->vol_offset(&dir);
   if (static_cast<off_t>(io.aiocb.aio_offset + io.aiocb.aio_nbytes) > static_cast<off_t>(vol->skip + vol->len)) {
     io.aiocb.aio_nbytes = vol->skip + vol->len - io.aiocb.aio_offset;
   }
+  // A zero copy reader sends the data of the fragments after the first from
+  // the span, so it reads only enough to check the fragment header, unless
+  // the fragment is about to be overwritten.
+  if (f.zero_copy && save_handler == reinterpret_cast<ContinuationHandler>(&CacheVC::openReadReadDone)) {
+    size_t header_size = std::max(CACHE_BLOCK_SIZE, vol->disk->hw_sector_size);
+    if (io.aiocb.aio_nbytes > header_size &&
+        (zero_copy_range = vol->zero_copy_pin(io.aiocb.aio_offset, io.aiocb.aio_nbytes)) != nullptr) {
+      io.aiocb.aio_nbytes = header_size;
+      f.doc_header_only   = true;
+      doc_offset          = io.aiocb.aio_offset;
+    }
+  }
   buf              = new_IOBufferData(iobuffer_size_to_index(io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
   io.aiocb.aio_buf = buf->data();
   io.action        = this;
@@ -2849,6 +2941,13 @@ cplist_reconfigure()
       }
       gnvol += cp->num_vols;
     }
+
+    for (config_vol = config_volumes.cp_queue.head; config_vol; config_vol = config_vol->link.next) {
+      if (config_vol->cachep) {
+        config_vol->cachep->agg_buffer_size = config_vol->agg_buffer_size;
+        config_vol->cachep->admission       = config_vol->admission;
+      }
+    }
   }
   return 0;
 }
@@ -3023,6 +3122,12 @@ register_cache_stats(RecRawStatBlock *rsb, const char *prefix)
   REG_INT("frags_per_doc.3+", cache_three_plus_plus_fragment_document_count_stat);
   REG_INT("read_busy.success", cache_read_busy_success_stat);
   REG_INT("read_busy.failure", cache_read_busy_failure_stat);
+  REG_INT("read_ahead.issued", cache_read_ahead_issued_stat);
+  REG_INT("read_ahead.hits", cache_read_ahead_hit_stat);
+  REG_INT("read_ahead.wasted", cache_read_ahead_wasted_stat);
+  REG_INT("admission.admitted", cache_admission_admitted_stat);
+  REG_INT("admission.rejected", cache_admission_rejected_stat);
+  REG_INT("zero_copy.revoked", cache_zero_copy_revoked_stat);
   REG_INT("write_bytes_stat", cache_write_bytes_stat);
   REG_INT("vector_marshals", cache_hdr_vector_marshal_stat);
   REG_INT("hdr_marshals", cache_hdr_marshal_stat);
@@ -3081,6 +3186,8 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_dir_sync_frequency, "proxy.config.cache.dir.sync_frequency");
   Debug("cache_init", "proxy.config.cache.dir.sync_frequency = %d", cache_config_dir_sync_frequency);
 
+  REC_ReadConfigInt32(cache_config_dir_numa_interleave, "proxy.config.cache.dir.numa_interleave");
+
   REC_EstablishStaticConfigInt32(cache_config_select_alternate, "proxy.config.cache.select_alternate");
   Debug("cache_init", "proxy.config.cache.select_alternate = %d", cache_config_select_alternate);
 
@@ -3097,6 +3204,18 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_read_while_writer_retry_delay, "proxy.config.cache.read_while_writer_retry.delay");
   Debug("cache_init", "proxy.config.cache.read_while_writer_retry.delay = %dms", cache_read_while_writer_retry_delay);
 
+  REC_EstablishStaticConfigInt32(cache_config_read_ahead_fragments, "proxy.config.cache.read_ahead.fragments");
+  Debug("cache_init", "proxy.config.cache.read_ahead.fragments = %d", cache_config_read_ahead_fragments);
+
+  REC_EstablishStaticConfigInteger(cache_config_read_ahead_max_bytes, "proxy.config.cache.read_ahead.max_bytes");
+  Debug("cache_init", "proxy.config.cache.read_ahead.max_bytes = %" PRId64, cache_config_read_ahead_max_bytes);
+
+  REC_ReadConfigInteger(cache_config_zero_copy_min_size, "proxy.config.cache.zero_copy.min_size");
+  Debug("cache_init", "proxy.config.cache.zero_copy.min_size = %" PRId64, cache_config_zero_copy_min_size);
+
+  REC_EstablishStaticConfigInt32(cache_config_zero_copy_max_wait, "proxy.config.cache.zero_copy.max_wait");
+  Debug("cache_init", "proxy.config.cache.zero_copy.max_wait = %dms", cache_config_zero_copy_max_wait);
+
   REC_EstablishStaticConfigInt32(cache_config_hit_evacuate_percent, "proxy.config.cache.hit_evacuate_percent");
   Debug("cache_init", "proxy.config.cache.hit_evacuate_percent = %d", cache_config_hit_evacuate_percent);
 
@@ -3119,6 +3238,21 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_agg_write_backlog, "proxy.config.cache.agg_write_backlog");
   Debug("cache_init", "proxy.config.cache.agg_write_backlog = %d", cache_config_agg_write_backlog);
 
+  REC_ReadConfigInt32(cache_config_agg_write_buffer_size, "proxy.config.cache.agg_write.buffer_size");
+  Debug("cache_init", "proxy.config.cache.agg_write.buffer_size = %d", cache_config_agg_write_buffer_size);
+
+  REC_ReadConfigInt32(cache_config_agg_write_buffers, "proxy.config.cache.agg_write.buffers");
+  Debug("cache_init", "proxy.config.cache.agg_write.buffers = %d", cache_config_agg_write_buffers);
+
+  REC_ReadConfigInt32(cache_config_admission_policy, "proxy.config.cache.admission.policy");
+  Debug("cache_init", "proxy.config.cache.admission.policy = %d", cache_config_admission_policy);
+
+  REC_EstablishStaticConfigInt32(cache_config_admission_threshold, "proxy.config.cache.admission.threshold");
+  Debug("cache_init", "proxy.config.cache.admission.threshold = %d", cache_config_admission_threshold);
+
+  REC_ReadConfigInteger(cache_config_admission_sketch_width, "proxy.config.cache.admission.sketch_width");
+  Debug("cache_init", "proxy.config.cache.admission.sketch_width = %" PRId64, cache_config_admission_sketch_width);
+
   REC_EstablishStaticConfigInt32(cache_config_enable_checksum, "proxy.config.cache.enable_checksum");
   Debug("cache_init", "proxy.config.cache.enable_checksum = %d", cache_config_enable_checksum);
 
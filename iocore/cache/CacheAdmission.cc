@@ -0,0 +1,144 @@
+/** @file
+
+  TinyLFU disk write admission filter.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_CacheAdmission.h"
+#include "tscore/ink_memory.h"
+
+#include <algorithm>
+
+CacheAdmissionFilter::CacheAdmissionFilter(int64_t width)
+{
+  int64_t w = MIN_WIDTH;
+  while (w < MAX_WIDTH && w * 2 <= width) {
+    w <<= 1;
+  }
+  _mask     = w - 1;
+  _window   = w * 10; // accesses between aging, as in the TinyLFU paper
+  _counters = static_cast<uint8_t *>(ats_malloc(DEPTH * w / 2));
+  memset(_counters, 0, DEPTH * w / 2);
+  // the doorkeeper sees every distinct key of a window, give it more room
+  _door_mask = w * 16 - 1;
+  _door      = static_cast<uint64_t *>(ats_malloc(w * 2));
+  memset(_door, 0, w * 2);
+}
+
+CacheAdmissionFilter::~CacheAdmissionFilter()
+{
+  ats_free(_counters);
+  ats_free(_door);
+}
+
+// The key is already a cryptographic hash, its 32 bit slices serve as
+// independent hash functions.
+uint32_t
+CacheAdmissionFilter::_index(const CryptoHash &key, int row) const
+{
+  return key.slice32(row) & _mask;
+}
+
+// Counter i of a row is the low nibble of its byte if i is even, else the high one.
+uint8_t
+CacheAdmissionFilter::_get(int row, uint32_t i) const
+{
+  return (_counters[(row * width() + i) >> 1] >> ((i & 1) << 2)) & 0xf;
+}
+
+void
+CacheAdmissionFilter::_inc(int row, uint32_t i)
+{
+  _counters[(row * width() + i) >> 1] += 1 << ((i & 1) << 2);
+}
+
+bool
+CacheAdmissionFilter::_door_test(const CryptoHash &key) const
+{
+  uint64_t a = (key.slice32(0) ^ key.slice32(3)) & _door_mask;
+  uint64_t b = (key.slice32(1) ^ key.slice32(2)) & _door_mask;
+  return (_door[a >> 6] & (1ULL << (a & 63))) && (_door[b >> 6] & (1ULL << (b & 63)));
+}
+
+void
+CacheAdmissionFilter::_door_set(const CryptoHash &key)
+{
+  uint64_t a = (key.slice32(0) ^ key.slice32(3)) & _door_mask;
+  uint64_t b = (key.slice32(1) ^ key.slice32(2)) & _door_mask;
+  _door[a >> 6] |= 1ULL << (a & 63);
+  _door[b >> 6] |= 1ULL << (b & 63);
+}
+
+int
+CacheAdmissionFilter::estimate(const CryptoHash &key) const
+{
+  int freq = MAX_FREQ;
+  for (int i = 0; i < DEPTH; i++) {
+    freq = std::min<int>(freq, _get(i, _index(key, i)));
+  }
+  return freq + (_door_test(key) ? 1 : 0);
+}
+
+void
+CacheAdmissionFilter::_increment(const CryptoHash &key)
+{
+  if (!_door_test(key)) {
+    _door_set(key);
+    return;
+  }
+  // conservative update, only raise the counters holding the minimum
+  uint32_t idx[DEPTH];
+  uint8_t freq[DEPTH];
+  uint8_t low = MAX_FREQ;
+  for (int i = 0; i < DEPTH; i++) {
+    idx[i]  = _index(key, i);
+    freq[i] = _get(i, idx[i]);
+    low     = std::min(low, freq[i]);
+  }
+  if (low == MAX_FREQ) {
+    return;
+  }
+  for (int i = 0; i < DEPTH; i++) {
+    if (freq[i] == low) {
+      _inc(i, idx[i]);
+    }
+  }
+}
+
+void
+CacheAdmissionFilter::_age()
+{
+  // halve both nibbles, dropping the bit shifted from the high one into the low
+  for (int64_t i = 0; i < DEPTH * width() / 2; i++) {
+    _counters[i] = (_counters[i] >> 1) & 0x77;
+  }
+  memset(_door, 0, width() * 2);
+  _samples /= 2;
+}
+
+bool
+CacheAdmissionFilter::admit(const CryptoHash &key, int threshold)
+{
+  _increment(key);
+  if (++_samples >= _window) {
+    _age();
+  }
+  return estimate(key) >= threshold;
+}
@@ -966,22 +966,33 @@ sync_cache_dir_on_shutdown()
     // check if we have data in the agg buffer
     // dont worry about the cachevc s in the agg queue
     // directories have not been inserted for these writes
-    if (d->agg_buf_pos) {
+    if (d->agg_buf_pos || d->agg_sealed) {
       Debug("cache_dir_sync", "Dir %s: flushing agg buffer first", d->hash_text.get());
 
       // set write limit
-      d->header->agg_pos = d->header->write_pos + d->agg_buf_pos;
+      d->header->agg_pos = d->header->write_pos + d->agg_sealed_len + d->agg_buf_pos;
 
-      int r = pwrite(d->fd, d->agg_buffer, d->agg_buf_pos, d->header->write_pos);
-      if (r != d->agg_buf_pos) {
+      bool flushed = true;
+      while (d->agg_buf_pos || d->agg_sealed) {
+        if (!d->agg_sealed) {
+          d->agg_seal();
+        }
+        int n = d->agg_buf_len[d->agg_buf_head];
+        int r = pwrite(d->fd, d->agg_buffers[d->agg_buf_head], n, d->header->write_pos);
+        if (r != n) {
+          flushed = false;
+          break;
+        }
+        d->header->last_write_pos = d->header->write_pos;
+        d->header->write_pos += n;
+        d->agg_release();
+        d->header->write_serial++;
+      }
+      if (!flushed) {
         ink_assert(!"flushing agg buffer failed");
         continue;
       }
-      d->header->last_write_pos = d->header->write_pos;
-      d->header->write_pos += d->agg_buf_pos;
       ink_assert(d->header->write_pos == d->header->agg_pos);
-      d->agg_buf_pos = 0;
-      d->header->write_serial++;
     }
 
     if (buflen < dirlen) {
@@ -1107,7 +1118,7 @@ Lrestart:
         Debug("cache_dir_sync", "Dir %s not dirty", vol->hash_text.get());
         goto Ldone;
       }
-      if (vol->is_io_in_progress() || vol->agg_buf_pos) {
+      if (vol->is_io_in_progress() || vol->agg_buf_pos || vol->agg_sealed) {
         Debug("cache_dir_sync", "Dir %s: waiting for agg buffer", vol->hash_text.get());
         vol->dir_sync_waiting = true;
         if (!vol->is_io_in_progress()) {
@@ -127,6 +127,9 @@ CacheDisk::~CacheDisk()
     }
     delete free_blocks;
   }
+  if (sendfile_fd >= 0) {
+    close(sendfile_fd);
+  }
 }
 
 int
@@ -656,6 +656,8 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
     CacheType scheme  = CACHE_NONE_TYPE;
     int size          = 0;
     int in_percent    = 0;
+    int agg_size      = 0;
+    int admission     = -1;
 
     while (true) {
       // skip all blank spaces at beginning of line
@@ -743,6 +745,31 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
         } else {
           in_percent = 0;
         }
+      } else if (strcasecmp(tmp, "agg_buffer_size") == 0) { // match agg_buffer_size
+        tmp += 16;
+        int64_t n = ink_atoi64(tmp);
+
+        if (n < AGG_SIZE || n > MAX_AGG_SIZE) {
+          err = "Bad aggregation buffer size";
+          break;
+        }
+        agg_size = static_cast<int>(n);
+        while (*tmp && !isspace(*tmp)) {
+          tmp++;
+        }
+      } else if (strcasecmp(tmp, "admission") == 0) { // match admission
+        tmp += 10;
+
+        if (!strcasecmp(tmp, "none")) {
+          tmp += 4;
+          admission = CACHE_ADMISSION_NONE;
+        } else if (!strcasecmp(tmp, "tinylfu")) {
+          tmp += 7;
+          admission = CACHE_ADMISSION_TINYLFU;
+        } else {
+          err = "Unknown admission policy";
+          break;
+        }
       }
 
       // ends here
@@ -765,9 +792,11 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
       } else {
         configp->in_percent = false;
       }
-      configp->scheme = scheme;
-      configp->size   = size;
-      configp->cachep = nullptr;
+      configp->scheme          = scheme;
+      configp->size            = size;
+      configp->agg_buffer_size = agg_size;
+      configp->admission       = admission;
+      configp->cachep          = nullptr;
       cp_queue.enqueue(configp);
       num_volumes++;
       if (scheme == CACHE_HTTP_TYPE) {
@@ -775,7 +804,8 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
       } else {
         ink_release_assert(!"Unexpected non-HTTP cache volume");
       }
-      Debug("cache_hosting", "added volume=%d, scheme=%d, size=%d percent=%d", volume_number, scheme, size, in_percent);
+      Debug("cache_hosting", "added volume=%d, scheme=%d, size=%d percent=%d agg_buffer_size=%d admission=%d", volume_number,
+            scheme, size, in_percent, agg_size, admission);
     }
 
     tmp = bufTok.iterNext(&i_state);
@@ -690,6 +690,10 @@ CacheVC::openReadMain(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
         // is the one we want, we don't need to do anything
         int cfi = fragment;
         --target;
+        // reads queued for the old position are of no use
+        if (read_ahead.head) {
+          read_ahead_clear();
+        }
         while (target > fragment) {
           next_CacheKey(&key, &key);
           ++fragment;
@@ -771,7 +775,16 @@ CacheVC::openReadMain(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   if (bytes > vio.ntodo()) {
     bytes = vio.ntodo();
   }
-  b           = new_IOBufferBlock(buf, bytes, doc_pos);
+  if (f.doc_header_only) {
+    ink_assert(doc_pos >= static_cast<int64_t>(doc->prefix_len()));
+    ink_atomic_increment(&zero_copy_range->refs, 1);
+    b = new_IOBufferBlock();
+    b->set(new_file_IOBufferData(vol->disk->sendfile_fd, doc_offset + doc_pos, bytes, &Vol::zero_copy_release, zero_copy_range,
+                                 &Vol::zero_copy_hold, &Vol::zero_copy_unhold),
+           bytes, 0);
+  } else {
+    b = new_IOBufferBlock(buf, bytes, doc_pos);
+  }
   b->_buf_end = b->_end;
   vio.buffer.writer()->append_block(b);
   vio.ndone += bytes;
@@ -809,6 +822,9 @@ Lread : {
   if (dir_probe(&key, vol, &dir, &last_collision)) {
     SET_HANDLER(&CacheVC::openReadReadDone);
     int ret = do_read_call(&key);
+    if (cache_config_read_ahead_fragments > 0 && !f.zero_copy) {
+      read_ahead_fill();
+    }
     if (ret == EVENT_RETURN) {
       goto Lcallreturn;
     }
@@ -846,6 +862,280 @@ Lcallreturn:
   return handleEvent(AIO_EVENT_DONE, nullptr);
 }
 
+// Pin [offset, offset + nbytes) for a zero copy reader, or return nullptr if
+// the aggregation writer is about to reach it and it has to be read now.
+CacheZeroCopyRange *
+Vol::zero_copy_pin(off_t offset, int64_t nbytes)
+{
+  ink_assert(mutex->thread_holding == this_ethread());
+  off_t ahead = offset - header->write_pos;
+  if (ahead < 0) { // behind the writer, it gets there on the next cycle
+    ahead += skip + len - start;
+  }
+  if (ahead < evacuation_size()) {
+    return nullptr;
+  }
+  CacheZeroCopyRange *r = cacheZeroCopyRangeAllocator.alloc();
+  r->vol                = this;
+  r->start              = offset;
+  r->end                = offset + nbytes;
+  r->refs               = 1;
+  r->sends              = 0;
+  ink_mutex_acquire(&zero_copy_mutex);
+  zero_copy_ranges.push(r);
+  ink_mutex_release(&zero_copy_mutex);
+  return r;
+}
+
+// Whether a pinned range overlaps [offset, offset + nbytes). With @a revoke
+// the ranges which are not being sent right now are taken back instead, so
+// their readers fail on their next send and the write can go ahead.
+bool
+Vol::zero_copy_blocked(off_t offset, int64_t nbytes, bool revoke)
+{
+  Vol *vol     = this;
+  bool blocked = false;
+  ink_mutex_acquire(&zero_copy_mutex);
+  CacheZeroCopyRange *next;
+  for (CacheZeroCopyRange *r = zero_copy_ranges.head; r; r = next) {
+    next = r->link.next;
+    if (!(r->start < offset + nbytes && offset < r->end)) {
+      continue;
+    }
+    if (revoke && ink_atomic_cas(&r->sends, 0, ZERO_COPY_REVOKED)) {
+      zero_copy_ranges.remove(r);
+      CACHE_INCREMENT_DYN_STAT(cache_zero_copy_revoked_stat);
+    } else {
+      blocked = true;
+    }
+  }
+  ink_mutex_release(&zero_copy_mutex);
+  return blocked;
+}
+
+// Drop a reference to a pinned range. Called from whichever thread frees
+// the last file range over it.
+void
+Vol::zero_copy_release(void *range)
+{
+  CacheZeroCopyRange *r = static_cast<CacheZeroCopyRange *>(range);
+  if (ink_atomic_increment(&r->refs, -1) == 1) {
+    Vol *vol = r->vol;
+    ink_mutex_acquire(&vol->zero_copy_mutex);
+    if (!(r->sends & ZERO_COPY_REVOKED)) {
+      vol->zero_copy_ranges.remove(r);
+    }
+    ink_mutex_release(&vol->zero_copy_mutex);
+    cacheZeroCopyRangeAllocator.free(r);
+  }
+}
+
+// Called by the net threads around each sendfile from a pinned range. The
+// writer only takes a range back while no send from it is in progress.
+bool
+Vol::zero_copy_hold(void *range)
+{
+  CacheZeroCopyRange *r = static_cast<CacheZeroCopyRange *>(range);
+  if (ink_atomic_increment(&r->sends, 1) & ZERO_COPY_REVOKED) {
+    ink_atomic_increment(&r->sends, -1);
+    return false;
+  }
+  return true;
+}
+
+void
+Vol::zero_copy_unhold(void *range)
+{
+  ink_atomic_increment(&static_cast<CacheZeroCopyRange *>(range)->sends, -1);
+}
+
+/*
+  Zero copy delivery of large objects.
+
+  Once set, every fragment after the first that has to come from disk is
+  read only as far as its header. openReadMain then hands the user a file
+  range over the buffered descriptor of the span instead of the data, and
+  the client connection sends it with sendfile. The range is read when the
+  socket takes it, so it is pinned in the volume until the last file range
+  over it is freed and the aggregation writer waits rather than write over
+  it. A fragment which the writer will reach within the evacuation window
+  is read into memory instead, as are RAM cache and aggregation buffer
+  hits. A client too slow to take a pinned range within
+  proxy.config.cache.zero_copy.max_wait loses it: the writer takes the
+  range back and the client connection fails on its next send.
+*/
+bool
+CacheVC::set_zero_copy()
+{
+  ink_assert(vio.op == VIO::READ);
+#if defined(linux)
+  if (cache_config_zero_copy_min_size > 0 && static_cast<int64_t>(doc_len) >= cache_config_zero_copy_min_size &&
+      vol->disk->sendfile_fd >= 0 && !cache_config_enable_checksum) {
+    f.zero_copy = true;
+  }
+#endif
+  return f.zero_copy;
+}
+
+/*
+  Read-ahead for multi-fragment objects.
+
+  openReadMain reads fragment N + 1 only once fragment N has been handed
+  to the user, so a single large object is bounded by the latency of one
+  disk read per fragment. read_ahead_fill() queues reads for the fragments
+  following the one just requested, and handleRead() claims a queued read
+  through read_ahead_take() instead of issuing a new one. The queue always
+  starts right after the requested fragment. When a seek moves the reader,
+  or a fragment is served from memory so its queued read is never claimed,
+  the queue is dropped and refilled from the new position.
+*/
+
+// Called with the volume lock held, after the read for @a key was started.
+void
+CacheVC::read_ahead_fill()
+{
+  if (write_vc || frag_type != CACHE_FRAG_TYPE_HTTP || !alternate.valid() || !alternate.get_frag_table()) {
+    return;
+  }
+  // frag_offset_count is one less than the number of fragments and
+  // @a key is fragment + 1, so the queued reads start at fragment + 2.
+  int nfrags = static_cast<int>(alternate.get_frag_offset_count()) + 1;
+  if (read_ahead.head) {
+    CacheKey expected;
+    next_CacheKey(&expected, &key);
+    if (read_ahead.head->key != expected) {
+      read_ahead_clear();
+    }
+  }
+  int target = fragment + 2 + read_ahead_count;
+  CacheKey next_key(read_ahead.tail ? read_ahead.tail->key : key);
+
+  while (read_ahead_count < cache_config_read_ahead_fragments && target < nfrags) {
+    Dir next_dir, *collision = nullptr;
+    next_CacheKey(&next_key, &next_key);
+    // fragments still in the aggregation buffer are served by handleRead()
+    if (!dir_probe(&next_key, vol, &next_dir, &collision) || dir_agg_buf_valid(vol, &next_dir)) {
+      break;
+    }
+    int64_t size = dir_approx_size(&next_dir);
+    if (read_ahead_bytes + size > cache_config_read_ahead_max_bytes) {
+      break;
+    }
+
+    CacheReadAhead *ra = cacheReadAheadAllocator.alloc();
+    ra->mutex          = mutex;
+    ra->key            = next_key;
+    ra->dir            = next_dir;
+    ra->vc             = this;
+    ra->done           = false;
+    ra->waiting        = false;
+    SET_CONTINUATION_HANDLER(ra, &CacheReadAhead::handleReadDone);
+
+    ra->io.aiocb.aio_fildes = vol->fd;
+    ra->io.aiocb.aio_offset = vol->vol_offset(&next_dir);
+    ra->io.aiocb.aio_nbytes = size;
+    if (static_cast<off_t>(ra->io.aiocb.aio_offset + ra->io.aiocb.aio_nbytes) > static_cast<off_t>(vol->skip + vol->len)) {
+      ra->io.aiocb.aio_nbytes = vol->skip + vol->len - ra->io.aiocb.aio_offset;
+    }
+    ra->buf              = new_IOBufferData(iobuffer_size_to_index(ra->io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+    ra->io.aiocb.aio_buf = ra->buf->data();
+    ra->io.aio_result    = 0;
+    ra->io.action        = ra;
+    ra->io.thread        = mutex->thread_holding->tt == DEDICATED ? AIO_CALLBACK_THREAD_ANY : mutex->thread_holding;
+
+    read_ahead.enqueue(ra);
+    ++read_ahead_count;
+    read_ahead_bytes += ra->io.aiocb.aio_nbytes;
+    ++target;
+    ink_assert(ink_aio_read(&ra->io) >= 0);
+    CACHE_INCREMENT_DYN_STAT(cache_read_ahead_issued_stat);
+  }
+}
+
+/* Claim the queued read for read_key/dir, if any. Reads queued before it
+   are no longer wanted (e.g. after a seek) and are abandoned.
+
+   @return EVENT_RETURN if the data is in @a buf, EVENT_CONT if the read
+   is still on disk and handleReadDone() will be called when it completes,
+   or EVENT_NONE if there was no read-ahead for this fragment.
+*/
+int
+CacheVC::read_ahead_take()
+{
+  CacheReadAhead *ra;
+  while ((ra = read_ahead.dequeue()) != nullptr) {
+    --read_ahead_count;
+    read_ahead_bytes -= ra->io.aiocb.aio_nbytes;
+    if (ra->key == *read_key && dir_offset(&ra->dir) == dir_offset(&dir)) {
+      CACHE_INCREMENT_DYN_STAT(cache_read_ahead_hit_stat);
+      SET_HANDLER(&CacheVC::handleReadDone);
+      if (!ra->done) {
+        // pretend the AIO is ours so die() waits for it
+        ra->waiting         = true;
+        io.aiocb.aio_fildes = vol->fd;
+        return EVENT_CONT;
+      }
+      buf           = ra->buf;
+      io.aiocb      = ra->io.aiocb;
+      io.aio_result = ra->io.aio_result;
+      ra->vc        = nullptr;
+      ra->abandon();
+      return EVENT_RETURN;
+    }
+    CACHE_INCREMENT_DYN_STAT(cache_read_ahead_wasted_stat);
+    ra->abandon();
+  }
+  return EVENT_NONE;
+}
+
+void
+CacheVC::read_ahead_clear()
+{
+  CacheReadAhead *ra;
+  while ((ra = read_ahead.dequeue()) != nullptr) {
+    CACHE_INCREMENT_DYN_STAT(cache_read_ahead_wasted_stat);
+    ra->abandon();
+  }
+  read_ahead_count = 0;
+  read_ahead_bytes = 0;
+}
+
+int
+CacheReadAhead::handleReadDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  done = true;
+  if (!vc) {
+    abandon();
+    return EVENT_DONE;
+  }
+  if (waiting) {
+    CacheVC *reader       = vc;
+    reader->buf           = buf;
+    reader->io.aiocb      = io.aiocb;
+    reader->io.aio_result = io.aio_result;
+    vc                    = nullptr;
+    abandon();
+    return reader->handleEvent(AIO_EVENT_DONE, nullptr);
+  }
+  return EVENT_CONT;
+}
+
+// Detach from the reader; the read is freed now if complete, otherwise when the AIO finishes.
+void
+CacheReadAhead::abandon()
+{
+  vc = nullptr;
+  if (!done) {
+    return;
+  }
+  buf.clear();
+  io.action.continuation = nullptr;
+  io.action.mutex        = nullptr;
+  io.mutex.clear();
+  mutex.clear();
+  cacheReadAheadAllocator.free(this);
+}
+
 /*
   This code follows CacheVC::openReadStartHead closely,
   if you change this you might have to change that.
@@ -247,16 +247,10 @@ CacheVC::scanObject(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
       goto Lskip;
     }
     {
-      char *tmp = doc->hdr();
-      int len   = doc->hlen;
-      while (len > 0) {
-        int r = HTTPInfo::unmarshal(tmp, len, buf.get());
-        if (r < 0) {
-          ink_assert(!"CacheVC::scanObject unmarshal failed");
-          goto Lskip;
-        }
-        len -= r;
-        tmp += r;
+      int okay = 1;
+      unmarshal_helper(doc, buf, okay);
+      if (!okay) {
+        goto Lskip;
       }
     }
     if (this->load_http_info(&vector, doc) != doc->hlen) {
@@ -192,7 +192,7 @@ CacheVC::handleWrite(int event, Event * /* e ATS_UNUSED */)
   agg_len = vol->round_to_approx_size(write_len + header_len + frag_len + sizeof(Doc));
   vol->agg_todo_size += agg_len;
   bool agg_error = (agg_len > AGG_SIZE || header_len + sizeof(Doc) > MAX_FRAG_SIZE ||
-                    (!f.readers && (vol->agg_todo_size > cache_config_agg_write_backlog + AGG_SIZE) && write_len));
+                    (!f.readers && (vol->agg_todo_size > cache_config_agg_write_backlog + vol->agg_buf_size) && write_len));
 #ifdef CACHE_AGG_FAIL_RATE
   agg_error = agg_error || ((uint32_t)mutex->thread_holding->generator.random() < (uint32_t)(UINT_MAX * CACHE_AGG_FAIL_RATE));
 #endif
@@ -215,7 +215,8 @@ CacheVC::handleWrite(int event, Event * /* e ATS_UNUSED */)
   } else {
     vol->agg.enqueue(this);
   }
-  if (!vol->is_io_in_progress()) {
+  // with spare buffers the next aggregation can fill during the write
+  if (!vol->is_io_in_progress() || vol->agg_buf_count > 1) {
     return vol->aggWrite(event, this);
   }
   return EVENT_CONT;
@@ -278,8 +279,8 @@ Vol::scan_for_pinned_documents()
 {
   if (cache_config_permit_pinning) {
     // we can't evacuate anything between header->write_pos and
-    // header->write_pos + AGG_SIZE.
-    int ps                = this->offset_to_vol_offset(header->write_pos + AGG_SIZE);
+    // header->write_pos + agg_reserve().
+    int ps                = this->offset_to_vol_offset(header->write_pos + agg_reserve());
     int pe                = this->offset_to_vol_offset(header->write_pos + 2 * EVACUATION_SIZE + (len / PIN_SCAN_EVERY));
     int vol_end_offset    = this->offset_to_vol_offset(len + skip);
     int before_end_of_vol = pe < vol_end_offset;
@@ -330,10 +331,9 @@ Vol::aggWriteDone(int event, Event *e)
     DDebug("cache_agg", "Dir %s, Write: %" PRIu64 ", last Write: %" PRIu64 "", hash_text.get(), header->write_pos,
            header->last_write_pos);
     ink_assert(header->write_pos == header->agg_pos);
-    if (header->write_pos + EVACUATION_SIZE > scan_pos) {
+    if (header->write_pos + evacuation_size() > scan_pos) {
       periodic_scan();
     }
-    agg_buf_pos = 0;
     header->write_serial++;
   } else {
     // delete all the directory entries that we inserted
@@ -345,19 +345,25 @@ Vol::aggWriteDone(int event, Event *e)
           (uint64_t)(io.aiocb.aio_offset + io.aiocb.aio_nbytes) / CACHE_BLOCK_SIZE);
     Dir del_dir;
     dir_clear(&del_dir);
-    for (int done = 0; done < agg_buf_pos;) {
-      Doc *doc = reinterpret_cast<Doc *>(agg_buffer + done);
+    for (int done = 0; done < static_cast<int>(io.aiocb.aio_nbytes);) {
+      Doc *doc = reinterpret_cast<Doc *>(static_cast<char *>(io.aiocb.aio_buf) + done);
       dir_set_offset(&del_dir, header->write_pos + done);
       dir_delete(&doc->key, this, &del_dir);
       done += round_to_approx_size(doc->len);
     }
-    agg_buf_pos = 0;
+    // the buffers behind this one were laid out after it, keep their offsets
+    if (agg_sealed > 1 || agg_buf_pos) {
+      header->last_write_pos = header->write_pos;
+      header->write_pos += io.aiocb.aio_nbytes;
+    }
   }
+  agg_release();
   set_io_not_in_progress();
-  // callback ready sync CacheVCs
+  // callback ready sync CacheVCs, their data may have been behind every
+  // other aggregation buffer
   CacheVC *c = nullptr;
   while ((c = sync.dequeue())) {
-    if (UINT_WRAP_LTE(c->write_serial + 2, header->write_serial)) {
+    if (UINT_WRAP_LTE(c->write_serial + 1 + agg_buf_count, header->write_serial)) {
       eventProcessor.schedule_imm(c, ET_CALL, AIO_EVENT_DONE);
     } else {
       sync.push(c); // put it back on the front
@@ -368,7 +374,7 @@ Vol::aggWriteDone(int event, Event *e)
     dir_sync_waiting = false;
     cacheDirSync->handleEvent(EVENT_IMMEDIATE, nullptr);
   }
-  if (agg.head || sync.head) {
+  if (agg.head || sync.head || agg_sealed) {
     return aggWrite(event, e);
   }
   return EVENT_CONT;
@@ -741,7 +747,7 @@ static int
 agg_copy(char *p, CacheVC *vc)
 {
   Vol *vol = vc->vol;
-  off_t o  = vol->header->write_pos + vol->agg_buf_pos;
+  off_t o  = vol->header->write_pos + vol->agg_sealed_len + vol->agg_buf_pos;
 
   if (!vc->f.evacuator) {
     Doc *doc                   = reinterpret_cast<Doc *>(p);
@@ -977,8 +983,6 @@ Vol::agg_wrap()
 int
 Vol::aggWrite(int event, void * /* e ATS_UNUSED */)
 {
-  ink_assert(!is_io_in_progress());
-
   Que(CacheVC, link) tocall;
   CacheVC *c;
 
@@ -990,10 +994,18 @@ Lagain:
     int writelen = c->agg_len;
     // [amc] this is checked multiple places, on here was it strictly less.
     ink_assert(writelen <= AGG_SIZE);
-    if (agg_buf_pos + writelen > AGG_SIZE || header->write_pos + agg_buf_pos + writelen > (skip + len)) {
+    if (agg_sealed == agg_buf_count || header->write_pos + agg_sealed_len + agg_buf_pos + writelen > (skip + len)) {
       break;
     }
-    DDebug("agg_read", "copying: %d, %" PRIu64 ", key: %d", agg_buf_pos, header->write_pos + agg_buf_pos, c->first_key.slice32(0));
+    if (agg_buf_pos + writelen > agg_buf_size) {
+      // keep one buffer free for filling
+      if (agg_sealed + 1 >= agg_buf_count) {
+        break;
+      }
+      agg_seal();
+    }
+    DDebug("agg_read", "copying: %d, %" PRIu64 ", key: %d", agg_buf_pos, header->write_pos + agg_sealed_len + agg_buf_pos,
+           c->first_key.slice32(0));
     int wrotelen = agg_copy(agg_buffer + agg_buf_pos, c);
     ink_assert(writelen == wrotelen);
     agg_todo_size -= writelen;
@@ -1014,8 +1026,13 @@ Lagain:
     c = n;
   }
 
+  // the previous buffer (or an evacuation read) is still on disk
+  if (is_io_in_progress()) {
+    goto Lwait;
+  }
+
   // if we got nothing...
-  if (!agg_buf_pos) {
+  if (!agg_buf_pos && !agg_sealed) {
     if (!agg.head && !sync.head) { // nothing to get
       return EVENT_CONT;
     }
@@ -1037,43 +1054,63 @@ Lagain:
     }
   }
 
-  // evacuate space
-  off_t end = header->write_pos + agg_buf_pos + EVACUATION_SIZE;
-  if (evac_range(header->write_pos, end, !header->phase) < 0) {
-    goto Lwait;
-  }
-  if (end > skip + len) {
-    if (evac_range(start, start + (end - (skip + len)), header->phase) < 0) {
+  {
+    // evacuate space
+    off_t end = header->write_pos + agg_sealed_len + agg_buf_pos + evacuation_size();
+    if (evac_range(header->write_pos, end, !header->phase) < 0) {
       goto Lwait;
     }
+    if (end > skip + len) {
+      if (evac_range(start, start + (end - (skip + len)), header->phase) < 0) {
+        goto Lwait;
+      }
+    }
   }
 
-  // if agg.head, then we are near the end of the disk, so
-  // write down the aggregation in whatever size it is.
-  if (agg_buf_pos < AGG_HIGH_WATER && !agg.head && !sync.head && !dir_sync_waiting) {
-    goto Lwait;
-  }
+  if (!agg_sealed) {
+    // if agg.head, then we are near the end of the disk, so
+    // write down the aggregation in whatever size it is.
+    if (agg_buf_pos < agg_buf_size / 2 && !agg.head && !sync.head && !dir_sync_waiting) {
+      goto Lwait;
+    }
 
-  // write sync marker
-  if (!agg_buf_pos) {
-    ink_assert(sync.head);
-    int l       = round_to_approx_size(sizeof(Doc));
-    agg_buf_pos = l;
-    Doc *d      = reinterpret_cast<Doc *>(agg_buffer);
-    memset(static_cast<void *>(d), 0, sizeof(Doc));
-    d->magic        = DOC_MAGIC;
-    d->len          = l;
-    d->sync_serial  = header->sync_serial;
-    d->write_serial = header->write_serial;
+    // write sync marker
+    if (!agg_buf_pos) {
+      ink_assert(sync.head);
+      int l       = round_to_approx_size(sizeof(Doc));
+      agg_buf_pos = l;
+      Doc *d      = reinterpret_cast<Doc *>(agg_buffer);
+      memset(static_cast<void *>(d), 0, sizeof(Doc));
+      d->magic        = DOC_MAGIC;
+      d->len          = l;
+      d->sync_serial  = header->sync_serial;
+      d->write_serial = header->write_serial;
+    }
+    agg_seal();
+  }
+
+  // a zero copy reader is still sending from the range under this write,
+  // after waiting zero_copy.max_wait for it the range is taken back
+  if (zero_copy_blocked(header->write_pos, agg_buf_len[agg_buf_head],
+                        zero_copy_wait_start &&
+                          Thread::get_hrtime() - zero_copy_wait_start >= HRTIME_MSECONDS(cache_config_zero_copy_max_wait))) {
+    Debug("cache_agg", "Dir %s, write at %" PRIu64 " waits for a zero copy read", hash_text.get(), header->write_pos);
+    if (!zero_copy_wait_start) {
+      zero_copy_wait_start = Thread::get_hrtime();
+    }
+    SET_HANDLER(&Vol::aggWrite);
+    trigger = eventProcessor.schedule_in(this, HRTIME_MSECONDS(cache_config_mutex_retry_delay), ET_CALL);
+    goto Lwait;
   }
+  zero_copy_wait_start = 0;
 
   // set write limit
-  header->agg_pos = header->write_pos + agg_buf_pos;
+  header->agg_pos = header->write_pos + agg_buf_len[agg_buf_head];
 
   io.aiocb.aio_fildes = fd;
   io.aiocb.aio_offset = header->write_pos;
-  io.aiocb.aio_buf    = agg_buffer;
-  io.aiocb.aio_nbytes = agg_buf_pos;
+  io.aiocb.aio_buf    = agg_buffers[agg_buf_head];
+  io.aiocb.aio_nbytes = agg_buf_len[agg_buf_head];
   io.action           = this;
   /*
     Callback on AIO thread so that we can issue a new write ASAP
@@ -1499,6 +1536,25 @@ Lcallreturn:
 
 // openWriteStartDone handles vector read (addition of alternates)
 // and lock misses
+// The admission filter decides whether a document that is not in the
+// cache yet gets written at all.
+static bool
+admit_new_doc(CacheVC *c)
+{
+  Vol *vol = c->vol;
+  if (!vol->admission) {
+    return true;
+  }
+  ProxyMutex *mutex = c->mutex.get();
+  if (vol->admission->admit(c->first_key, cache_config_admission_threshold)) {
+    CACHE_INCREMENT_DYN_STAT(cache_admission_admitted_stat);
+    return true;
+  }
+  DDebug("cache_admission", "rejected %X", c->first_key.slice32(0));
+  CACHE_INCREMENT_DYN_STAT(cache_admission_rejected_stat);
+  return false;
+}
+
 int
 CacheVC::openWriteStartDone(int event, Event *e)
 {
@@ -1585,6 +1641,10 @@ CacheVC::openWriteStartDone(int event, Event *e)
       // fail update because vector has been GC'd
       goto Lfailure;
     }
+    if (!admit_new_doc(this)) {
+      err = ECACHE_NOT_ADMITTED;
+      goto Lfailure;
+    }
   }
 Lsuccess:
   od->reading_vec = false;
@@ -1595,7 +1655,9 @@ Lsuccess:
   return callcont(CACHE_EVENT_OPEN_WRITE);
 
 Lfailure:
-  CACHE_INCREMENT_DYN_STAT(base_stat + CACHE_STAT_FAILURE);
+  if (err != ECACHE_NOT_ADMITTED) {
+    CACHE_INCREMENT_DYN_STAT(base_stat + CACHE_STAT_FAILURE);
+  }
   _action.continuation->handleEvent(CACHE_EVENT_OPEN_WRITE_FAILED, (void *)-err);
 Lcancel:
   if (od) {
@@ -1795,6 +1857,10 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info,
           err = ECACHE_NO_DOC;
           goto Lfailure;
         }
+        if (!admit_new_doc(c)) {
+          err = ECACHE_NOT_ADMITTED;
+          goto Lfailure;
+        }
         // document doesn't exist, begin write
         goto Lmiss;
       } else {
@@ -1823,7 +1889,9 @@ Lmiss:
   return ACTION_RESULT_DONE;
 
 Lfailure:
-  CACHE_INCREMENT_DYN_STAT(c->base_stat + CACHE_STAT_FAILURE);
+  if (err != ECACHE_NOT_ADMITTED) {
+    CACHE_INCREMENT_DYN_STAT(c->base_stat + CACHE_STAT_FAILURE);
+  }
   cont->handleEvent(CACHE_EVENT_OPEN_WRITE_FAILED, (void *)-err);
   if (c->od) {
     c->openWriteCloseDir(EVENT_IMMEDIATE, nullptr);
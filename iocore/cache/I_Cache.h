@@ -205,6 +205,17 @@ struct CacheVConnection : public VConnection {
     return -1;
   }
 
+  /** Deliver the fragments read from disk as file ranges.
+      The data blocks are then built with @c new_file_IOBufferData and may
+      only be written by a plain @c UnixNetVConnection.
+      @return @c true if the object will be delivered that way.
+  */
+  virtual bool
+  set_zero_copy()
+  {
+    return false;
+  }
+
   /** Test if the VC can support pread.
       @return @c true if @c do_io_pread will work, @c false if not.
   */
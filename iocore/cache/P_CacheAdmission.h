@@ -0,0 +1,83 @@
+/** @file
+
+  Disk write admission filter.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/CryptoHash.h"
+
+#define CACHE_ADMISSION_NONE 0
+#define CACHE_ADMISSION_TINYLFU 1
+
+/**
+  TinyLFU frequency filter deciding which new documents are written to disk.
+
+  Each write of a new document counts as an access of its key. The first
+  access in a window only sets the key's bits in the doorkeeper (a small bloom
+  filter), later ones increment a 4 row count-min sketch of 4 bit saturating
+  counters, packed two to a byte. A document is
+  admitted once its estimated frequency (sketch minimum plus doorkeeper bit)
+  reaches the threshold. After a window of sample accesses every counter is
+  halved and the doorkeeper is cleared, so stale popularity decays.
+
+  The filter is owned by a Vol and is only used with the Vol lock held.
+ */
+class CacheAdmissionFilter
+{
+public:
+  static constexpr int DEPTH         = 4;
+  static constexpr uint8_t MAX_FREQ  = 15;
+  static constexpr int64_t MIN_WIDTH = 64;
+  static constexpr int64_t MAX_WIDTH = 1 << 20; // 2MB of counters, 2MB of doorkeeper
+
+  /// @a width counters per row, rounded down to a power of 2 within
+  /// [MIN_WIDTH, MAX_WIDTH].
+  explicit CacheAdmissionFilter(int64_t width);
+  ~CacheAdmissionFilter();
+
+  /// Record an access of @a key, returns true if it should be written.
+  bool admit(const CryptoHash &key, int threshold);
+  /// Estimated access count of @a key in the current window.
+  int estimate(const CryptoHash &key) const;
+
+  int64_t
+  width() const
+  {
+    return _mask + 1;
+  }
+
+private:
+  void _increment(const CryptoHash &key);
+  void _age();
+  uint32_t _index(const CryptoHash &key, int row) const;
+  uint8_t _get(int row, uint32_t i) const;
+  void _inc(int row, uint32_t i);
+  bool _door_test(const CryptoHash &key) const;
+  void _door_set(const CryptoHash &key);
+
+  uint8_t *_counters = nullptr; // DEPTH rows of width() / 2 bytes
+  uint64_t *_door    = nullptr; // 16 * width() bits
+  int64_t _mask      = 0;
+  int64_t _door_mask = 0;
+  int64_t _samples   = 0;
+  int64_t _window    = 0;
+};
@@ -172,6 +172,8 @@ struct ConfigVol {
   off_t size;
   bool in_percent;
   int percent;
+  int agg_buffer_size;
+  int admission;
   CacheVol *cachep;
   LINK(ConfigVol, link);
 };
@@ -135,6 +135,12 @@ enum {
   cache_three_plus_plus_fragment_document_count_stat,
   cache_read_busy_success_stat,
   cache_read_busy_failure_stat,
+  cache_read_ahead_issued_stat,
+  cache_read_ahead_hit_stat,
+  cache_read_ahead_wasted_stat,
+  cache_admission_admitted_stat,
+  cache_admission_rejected_stat,
+  cache_zero_copy_revoked_stat,
   cache_gc_bytes_evacuated_stat,
   cache_gc_frags_evacuated_stat,
   cache_write_bytes_stat,
@@ -206,6 +212,7 @@ extern RecRawStatBlock *cache_rsb;
 
 // Configuration
 extern int cache_config_dir_sync_frequency;
+extern int cache_config_dir_numa_interleave;
 extern int cache_config_http_max_alts;
 extern int cache_config_permit_pinning;
 extern int cache_config_select_alternate;
@@ -226,6 +233,39 @@ extern int cache_config_target_fragment_size;
 extern int cache_config_mutex_retry_delay;
 extern int cache_read_while_writer_retry_delay;
 extern int cache_config_read_while_writer_max_retries;
+extern int cache_config_read_ahead_fragments;
+extern int64_t cache_config_read_ahead_max_bytes;
+extern int64_t cache_config_zero_copy_min_size;
+extern int cache_config_zero_copy_max_wait;
+extern int cache_config_agg_write_buffer_size;
+extern int cache_config_agg_write_buffers;
+extern int cache_config_admission_policy;
+extern int cache_config_admission_threshold;
+extern int64_t cache_config_admission_sketch_width;
+
+struct CacheVC;
+
+/** A fragment read issued ahead of the reader.
+
+    A CacheVC reading a multi-fragment object keeps up to
+    proxy.config.cache.read_ahead.fragments of these in flight for the
+    fragments after the one it is waiting on. Each read is its own
+    continuation sharing the reader's mutex, so that it can outlive the
+    CacheVC if the reader goes away while the AIO is still on disk.
+*/
+struct CacheReadAhead : public Continuation {
+  CacheKey key;
+  Dir dir;
+  Ptr<IOBufferData> buf;
+  AIOCallbackInternal io;
+  CacheVC *vc  = nullptr; // reader, cleared if the reader abandons the read
+  bool done    = false;   // AIO has completed
+  bool waiting = false;   // reader is blocked on this read
+  LINK(CacheReadAhead, link);
+
+  int handleReadDone(int event, Event *e);
+  void abandon();
+};
 
 // CacheVC
 struct CacheVC : public CacheVConnection {
@@ -300,6 +340,8 @@ struct CacheVC : public CacheVConnection {
     return f.compressed_in_ram;
   }
 
+  bool set_zero_copy() override;
+
   bool writer_done();
   int calluser(int event);
   int callcont(int event);
@@ -327,6 +369,9 @@ struct CacheVC : public CacheVConnection {
   int openReadFromWriterFailure(int event, Event *);
   int openReadChooseWriter(int event, Event *e);
   int openReadDirDelete(int event, Event *e);
+  void read_ahead_fill();
+  int read_ahead_take();
+  void read_ahead_clear();
 
   int openWriteCloseDir(int event, Event *e);
   int openWriteCloseHeadDone(int event, Event *e);
@@ -499,6 +544,8 @@ struct CacheVC : public CacheVConnection {
       unsigned int hit_evacuate : 1;
       unsigned int compressed_in_ram : 1; // compressed state in ram cache
       unsigned int allow_empty_doc : 1;   // used for cache empty http document
+      unsigned int zero_copy : 1;         // fragments read from disk are delivered as file ranges
+      unsigned int doc_header_only : 1;   // 'buf' holds only the header of a zero copy fragment
     } f;
   };
   // BTF optimization used to skip reading stuff in cache partition that doesn't contain any
@@ -507,6 +554,14 @@ struct CacheVC : public CacheVConnection {
   // BTF fix to handle objects that overlapped over two different reads,
   // this is how much we need to back up the buffer to get the start of the overlapping object.
   off_t scan_fix_buffer_offset;
+  // fragment reads in flight ahead of the reader, oldest first
+  Queue<CacheReadAhead> read_ahead;
+  int read_ahead_count;
+  int64_t read_ahead_bytes;
+  // span offset of 'buf' when it holds only a fragment header
+  off_t doc_offset;
+  // pin on the span range of the current zero copy fragment
+  CacheZeroCopyRange *zero_copy_range;
   // end region C
 };
 
@@ -535,6 +590,7 @@ extern CacheKey zero_key;
 extern CacheSync *cacheDirSync;
 // Function Prototypes
 int cache_write(CacheVC *, CacheHTTPInfoVector *);
+void unmarshal_helper(struct Doc *doc, Ptr<IOBufferData> &buf, int &okay);
 int get_alternate_index(CacheHTTPInfoVector *cache_vector, CacheKey key);
 CacheVC *new_DocEvacuator(int nbytes, Vol *d);
 
@@ -578,6 +634,12 @@ free_CacheVC(CacheVC *cont)
   }
   ink_assert(!cont->is_io_in_progress());
   ink_assert(!cont->od);
+  if (cont->read_ahead.head) {
+    cont->read_ahead_clear();
+  }
+  if (cont->zero_copy_range) {
+    Vol::zero_copy_release(cont->zero_copy_range);
+  }
   /* calling cont->io.action = nullptr causes compile problem on 2.6 solaris
      release build....weird??? For now, null out continuation and mutex
      of the action separately */
@@ -926,6 +988,7 @@ next_rand(unsigned int *p)
 }
 
 extern ClassAllocator<CacheRemoveCont> cacheRemoveContAllocator;
+extern ClassAllocator<CacheReadAhead> cacheReadAheadAllocator;
 
 TS_INLINE CacheRemoveCont *
 new_CacheRemoveCont()
@@ -36,9 +36,10 @@
 #define VOL_MAGIC 0xF1D0F00D
 #define START_BLOCKS 16 // 8k, STORE_BLOCK_SIZE
 #define START_POS ((off_t)START_BLOCKS * CACHE_BLOCK_SIZE)
-#define AGG_SIZE (4 * 1024 * 1024)     // 4MB
-#define AGG_HIGH_WATER (AGG_SIZE / 2)  // 2MB
-#define EVACUATION_SIZE (2 * AGG_SIZE) // 8MB
+#define AGG_SIZE (4 * 1024 * 1024)      // 4MB
+#define EVACUATION_SIZE (2 * AGG_SIZE)  // 8MB
+#define MAX_AGG_SIZE (32 * 1024 * 1024) // 32MB
+#define MAX_AGG_BUFFERS 3
 #define MAX_VOL_SIZE ((off_t)512 * 1024 * 1024 * 1024 * 1024)
 #define STORE_BLOCKS_PER_CACHE_BLOCK (STORE_BLOCK_SIZE / CACHE_BLOCK_SIZE)
 #define MAX_VOL_BLOCKS (MAX_VOL_SIZE / CACHE_BLOCK_SIZE)
@@ -119,6 +120,21 @@ struct EvacuationBlock {
   LINK(EvacuationBlock, link);
 };
 
+// A span range handed to a zero copy reader. The aggregation writer does
+// not write over it until every file range built on it has been sent, or
+// until it has waited proxy.config.cache.zero_copy.max_wait and takes the
+// range back.
+struct CacheZeroCopyRange {
+  Vol *vol;
+  off_t start;
+  off_t end;
+  int refs;
+  int sends; // sendfile calls in progress, ZERO_COPY_REVOKED once taken back
+  LINK(CacheZeroCopyRange, link);
+};
+
+#define ZERO_COPY_REVOKED (1 << 30)
+
 struct Vol : public Continuation {
   char *path = nullptr;
   ats_scoped_str hash_text;
@@ -144,16 +160,26 @@ struct Vol : public Continuation {
   Queue<CacheVC, Continuation::Link_link> agg;
   Queue<CacheVC, Continuation::Link_link> stat_cache_vcs;
   Queue<CacheVC, Continuation::Link_link> sync;
-  char *agg_buffer  = nullptr;
+  char *agg_buffer  = nullptr; // buffer currently being filled
   int agg_todo_size = 0;
   int agg_buf_pos   = 0;
+  // Ring of aggregation buffers. Sealed buffers are written to disk in
+  // order starting at agg_buf_head, agg_buffer is the one after them.
+  char *agg_buffers[MAX_AGG_BUFFERS] = {nullptr};
+  int agg_buf_len[MAX_AGG_BUFFERS]   = {0};
+  int agg_buf_size                   = AGG_SIZE;
+  int agg_buf_count                  = 1;
+  int agg_buf_head                   = 0;
+  int agg_sealed                     = 0; // buffers waiting for or under write
+  int agg_sealed_len                 = 0;
 
   Event *trigger = nullptr;
 
   OpenDir open_dir;
-  RamCache *ram_cache            = nullptr;
-  int evacuate_size              = 0;
-  DLL<EvacuationBlock> *evacuate = nullptr;
+  RamCache *ram_cache             = nullptr;
+  CacheAdmissionFilter *admission = nullptr;
+  int evacuate_size               = 0;
+  DLL<EvacuationBlock> *evacuate  = nullptr;
   DLL<EvacuationBlock> lookaside[LOOKASIDE_SIZE];
   CacheVC *doc_evacuator = nullptr;
 
@@ -174,6 +200,11 @@ struct Vol : public Continuation {
   int64_t first_fragment_offset = 0;
   Ptr<IOBufferData> first_fragment_data;
 
+  // Ranges pinned by zero copy readers, released from the net threads.
+  ink_mutex zero_copy_mutex;
+  DLL<CacheZeroCopyRange> zero_copy_ranges;
+  ink_hrtime zero_copy_wait_start = 0; // when the writer started to wait for them
+
   void cancel_trigger();
 
   int recover_data();
@@ -194,6 +225,8 @@ struct Vol : public Continuation {
   int clear_dir();
 
   int init(char *s, off_t blocks, off_t dir_skip, bool clear);
+  /// Set up the admission filter, sized for the @a ram_cache_bytes of the RAM cache this stripe has.
+  void admission_init(int64_t ram_cache_bytes);
 
   int handle_dir_clear(int event, void *data);
   int handle_dir_read(int event, void *data);
@@ -230,6 +263,12 @@ struct Vol : public Continuation {
   int aggWriteDone(int event, Event *e);
   int aggWrite(int event, void *e);
   void agg_wrap();
+  void agg_init();
+  void agg_seal();
+  void agg_release();
+  char *agg_buffer_at(off_t offset, int len);
+  off_t agg_reserve();
+  off_t evacuation_size();
 
   int evacuateWrite(CacheVC *evacuator, int event, Event *e);
   int evacuateDocReadDone(int event, Event *e);
@@ -242,6 +281,11 @@ struct Vol : public Continuation {
   void evacuate_cleanup();
   EvacuationBlock *force_evacuate_head(Dir *dir, int pinned);
   int within_hit_evacuate_window(Dir *dir);
+  CacheZeroCopyRange *zero_copy_pin(off_t offset, int64_t len);
+  bool zero_copy_blocked(off_t offset, int64_t len, bool revoke);
+  static void zero_copy_release(void *range);
+  static bool zero_copy_hold(void *range);
+  static void zero_copy_unhold(void *range);
   uint32_t round_to_approx_size(uint32_t l);
 
   // inline functions
@@ -264,12 +308,20 @@ struct Vol : public Continuation {
   Vol() : Continuation(new_ProxyMutex())
   {
     open_dir.mutex = mutex;
-    agg_buffer     = (char *)ats_memalign(ats_pagesize(), AGG_SIZE);
-    memset(agg_buffer, 0, AGG_SIZE);
+    ink_mutex_init(&zero_copy_mutex);
     SET_HANDLER(&Vol::aggWrite);
   }
 
-  ~Vol() override { ats_memalign_free(agg_buffer); }
+  ~Vol() override
+  {
+    ink_mutex_destroy(&zero_copy_mutex);
+    delete admission;
+    for (auto &b : agg_buffers) {
+      if (b) {
+        ats_memalign_free(b);
+      }
+    }
+  }
 };
 
 struct AIO_Callback_handler : public Continuation {
@@ -283,6 +335,8 @@ struct CacheVol {
   int scheme          = 0;
   off_t size          = 0;
   int num_vols        = 0;
+  int agg_buffer_size = 0;  // volume.config override, 0 for the global setting
+  int admission       = -1; // volume.config override, -1 for the global setting
   Vol **vols          = nullptr;
   DiskVol **disk_vols = nullptr;
   LINK(CacheVol, link);
@@ -334,6 +388,7 @@ extern std::atomic<int> gnvol;
 extern ClassAllocator<OpenDirEntry> openDirEntryAllocator;
 extern ClassAllocator<EvacuationBlock> evacuationBlockAllocator;
 extern ClassAllocator<EvacuationKey> evacuationKeyAllocator;
+extern ClassAllocator<CacheZeroCopyRange> cacheZeroCopyRangeAllocator;
 extern unsigned short *vol_hash_table;
 
 // inline Functions
@@ -372,7 +427,7 @@ Vol::vol_out_of_phase_valid(Dir *e)
 TS_INLINE int
 Vol::vol_out_of_phase_agg_valid(Dir *e)
 {
-  return (dir_offset(e) - 1 >= ((this->header->agg_pos - this->start + AGG_SIZE) / CACHE_BLOCK_SIZE));
+  return (dir_offset(e) - 1 >= ((this->header->agg_pos - this->start + this->agg_reserve()) / CACHE_BLOCK_SIZE));
 }
 
 TS_INLINE int
@@ -384,7 +439,8 @@ Vol::vol_out_of_phase_write_valid(Dir *e)
 TS_INLINE int
 Vol::vol_in_phase_valid(Dir *e)
 {
-  return (dir_offset(e) - 1 < ((this->header->write_pos + this->agg_buf_pos - this->start) / CACHE_BLOCK_SIZE));
+  return (dir_offset(e) - 1 <
+          ((this->header->write_pos + this->agg_sealed_len + this->agg_buf_pos - this->start) / CACHE_BLOCK_SIZE));
 }
 
 TS_INLINE off_t
@@ -408,7 +464,8 @@ Vol::vol_offset_to_offset(off_t pos)
 TS_INLINE int
 Vol::vol_in_phase_agg_buf_valid(Dir *e)
 {
-  return (this->vol_offset(e) >= this->header->write_pos && this->vol_offset(e) < (this->header->write_pos + this->agg_buf_pos));
+  return (this->vol_offset(e) >= this->header->write_pos &&
+          this->vol_offset(e) < (this->header->write_pos + this->agg_sealed_len + this->agg_buf_pos));
 }
 // length of the partition not including the offset of location 0.
 TS_INLINE off_t
@@ -504,7 +561,7 @@ TS_INLINE int
 Vol::within_hit_evacuate_window(Dir *xdir)
 {
   off_t oft       = dir_offset(xdir) - 1;
-  off_t write_off = (header->write_pos + AGG_SIZE - start) / CACHE_BLOCK_SIZE;
+  off_t write_off = (header->write_pos + agg_reserve() - start) / CACHE_BLOCK_SIZE;
   off_t delta     = oft - write_off;
   if (delta >= 0)
     return delta < hit_evacuate_window;
@@ -512,6 +569,59 @@ Vol::within_hit_evacuate_window(Dir *xdir)
     return -delta > (data_blocks - hit_evacuate_window) && -delta < data_blocks;
 }
 
+// Space past the last issued write which may already be claimed by the
+// aggregation buffers.
+TS_INLINE off_t
+Vol::agg_reserve()
+{
+  return static_cast<off_t>(agg_buf_count) * agg_buf_size;
+}
+
+TS_INLINE off_t
+Vol::evacuation_size()
+{
+  return 2 * agg_reserve();
+}
+
+TS_INLINE void
+Vol::agg_seal()
+{
+  ink_assert(agg_sealed < agg_buf_count);
+  agg_buf_len[(agg_buf_head + agg_sealed) % agg_buf_count] = agg_buf_pos;
+  agg_sealed_len += agg_buf_pos;
+  agg_sealed++;
+  agg_buffer  = agg_buffers[(agg_buf_head + agg_sealed) % agg_buf_count];
+  agg_buf_pos = 0;
+}
+
+// the head buffer is on disk (or failed), reuse it for filling
+TS_INLINE void
+Vol::agg_release()
+{
+  ink_assert(agg_sealed > 0);
+  agg_sealed_len -= agg_buf_len[agg_buf_head];
+  agg_buf_len[agg_buf_head] = 0;
+  agg_buf_head              = (agg_buf_head + 1) % agg_buf_count;
+  agg_sealed--;
+}
+
+// Memory for the fragment at header->write_pos + offset, which must
+// lie within the aggregation buffers.
+TS_INLINE char *
+Vol::agg_buffer_at(off_t offset, int len)
+{
+  for (int i = 0; i < agg_sealed; i++) {
+    int b = (agg_buf_head + i) % agg_buf_count;
+    if (offset < agg_buf_len[b]) {
+      ink_assert(offset + len <= agg_buf_len[b]);
+      return agg_buffers[b] + offset;
+    }
+    offset -= agg_buf_len[b];
+  }
+  ink_assert(offset + len <= agg_buf_pos);
+  return agg_buffer + offset;
+}
+
 TS_INLINE uint32_t
 Vol::round_to_approx_size(uint32_t l)
 {
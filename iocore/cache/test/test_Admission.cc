@@ -0,0 +1,180 @@
+/** @file
+
+  TinyLFU admission filter.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+
+#include "main.h"
+
+#define SMALL_FILE 10 * 1024
+
+static CryptoHash
+hash_of(int i)
+{
+  CryptoHash h;
+  CryptoContext().hash_immediate(h, &i, sizeof(i));
+  return h;
+}
+
+TEST_CASE("TinyLFU sketch", "cache")
+{
+  CacheAdmissionFilter filter(1024);
+  REQUIRE(filter.width() == 1024);
+  // the width is a bound, never rounded up
+  REQUIRE(CacheAdmissionFilter(1000).width() == 512);
+  REQUIRE(CacheAdmissionFilter(1).width() == CacheAdmissionFilter::MIN_WIDTH);
+  REQUIRE(CacheAdmissionFilter(INT64_MAX).width() == CacheAdmissionFilter::MAX_WIDTH);
+
+  CryptoHash a = hash_of(1);
+  REQUIRE(filter.estimate(a) == 0);
+  // the first access only reaches the doorkeeper
+  REQUIRE(!filter.admit(a, 2));
+  REQUIRE(filter.estimate(a) == 1);
+  REQUIRE(filter.admit(a, 2));
+  REQUIRE(!filter.admit(hash_of(2), 2));
+
+  // a scan of one-hit-wonders is rejected, popular keys stay admitted
+  int rejected = 0;
+  for (int i = 100; i < 2100; i++) {
+    rejected += !filter.admit(hash_of(i), 2);
+    if (i % 10 == 0) {
+      CHECK(filter.admit(a, 2));
+    }
+  }
+  CHECK(rejected > 1800);
+
+  // counters decay over the aging window
+  CacheAdmissionFilter aged(64);
+  CryptoHash b = hash_of(3);
+  CryptoHash c = hash_of(4);
+  for (int i = 0; i < 10; i++) {
+    aged.admit(b, 2);
+  }
+  REQUIRE(aged.estimate(b) == 10);
+  for (int i = 0; i < 64 * 10; i++) {
+    aged.admit(c, 2);
+  }
+  CHECK(aged.estimate(b) == 4);
+
+  // 4 bit counters saturate without spilling into their neighbours
+  CacheAdmissionFilter packed(64);
+  CryptoHash d = hash_of(5);
+  for (int i = 0; i < 40; i++) {
+    packed.admit(d, 2);
+  }
+  REQUIRE(packed.estimate(d) == CacheAdmissionFilter::MAX_FREQ + 1);
+  int others = 0;
+  for (int i = 1000; i < 1100; i++) {
+    others += packed.estimate(hash_of(i)) == 0;
+  }
+  CHECK(others > 80);
+}
+
+// The first write of a new document is rejected, the second one is cached.
+class AdmissionTestHandler : public CacheTestHandler
+{
+public:
+  AdmissionTestHandler(size_t size, const char *url)
+  {
+    this->_first = new CacheWriteTest(size, this, url);
+    this->_wt    = new CacheWriteTest(size, this, url);
+    this->_rt    = new CacheReadTest(size, this, url);
+
+    this->_first->mutex = this->mutex;
+    this->_wt->mutex    = this->mutex;
+    this->_rt->mutex    = this->mutex;
+    SET_HANDLER(&AdmissionTestHandler::start_test);
+  }
+
+  int
+  start_test(int event, void *e)
+  {
+    this_ethread()->schedule_imm(this->_first);
+    return 0;
+  }
+
+  void
+  handle_cache_event(int event, CacheTestBase *base) override
+  {
+    switch (event) {
+    case CACHE_EVENT_OPEN_WRITE_FAILED:
+      REQUIRE(base == this->_first);
+      base->close();
+      this_ethread()->schedule_imm(this->_wt);
+      break;
+    case CACHE_EVENT_OPEN_WRITE:
+      REQUIRE(base == this->_wt);
+      base->do_io_write();
+      break;
+    case CACHE_EVENT_OPEN_READ:
+      base->do_io_read();
+      break;
+    case VC_EVENT_READ_READY:
+    case VC_EVENT_WRITE_READY:
+      base->reenable();
+      break;
+    case VC_EVENT_WRITE_COMPLETE:
+      base->close();
+      this_ethread()->schedule_imm(this->_rt);
+      break;
+    case VC_EVENT_READ_COMPLETE:
+      base->close();
+      delete this;
+      break;
+    default:
+      REQUIRE(false);
+      base->close();
+      delete this;
+      break;
+    }
+  }
+
+private:
+  CacheTestBase *_first = nullptr;
+};
+
+class AdmissionCacheInit : public CacheInit
+{
+public:
+  AdmissionCacheInit() {}
+  int
+  cache_init_success_callback(int event, void *e) override
+  {
+    REQUIRE(gvol[0]->admission != nullptr);
+
+    AdmissionTestHandler *h = new AdmissionTestHandler(SMALL_FILE, "http://www.admission.com");
+    TerminalTest *tt        = new TerminalTest;
+    h->add(tt);
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("cache admission", "cache")
+{
+  RecSetRecordInt("proxy.config.cache.admission.policy", CACHE_ADMISSION_TINYLFU, REC_SOURCE_EXPLICIT);
+  init_cache(256 * 1024 * 1024);
+  AdmissionCacheInit *init = new AdmissionCacheInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
@@ -0,0 +1,65 @@
+/** @file
+
+  Cache write and read back with several aggregation buffers per stripe.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#define LARGE_FILE 10 * 1024 * 1024
+#define SMALL_FILE 10 * 1024
+
+class AggWriteInit : public CacheInit
+{
+public:
+  AggWriteInit() {}
+  int
+  cache_init_success_callback(int event, void *e) override
+  {
+    CacheTestHandler *h  = new CacheTestHandler(LARGE_FILE, "http://www.agg1.com");
+    CacheTestHandler *h2 = new CacheTestHandler(SMALL_FILE, "http://www.agg2.com");
+    CacheTestHandler *h3 = new CacheTestHandler(LARGE_FILE, "http://www.agg3.com");
+    CacheTestHandler *h4 = new CacheTestHandler(LARGE_FILE, "http://www.agg4.com");
+    TerminalTest *tt     = new TerminalTest;
+
+    REQUIRE(gnvol > 0);
+    REQUIRE(gvol[0]->agg_buf_count == 3);
+    REQUIRE(gvol[0]->agg_buf_size == 8 * 1024 * 1024);
+
+    h->add(h2);
+    h->add(h3);
+    h->add(h4);
+    h->add(tt);
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("cache write -> read with triple aggregation buffers", "cache")
+{
+  RecSetRecordInt("proxy.config.cache.agg_write.buffers", 3, REC_SOURCE_EXPLICIT);
+  RecSetRecordInt("proxy.config.cache.agg_write.buffer_size", 8 * 1024 * 1024, REC_SOURCE_EXPLICIT);
+  init_cache(256 * 1024 * 1024);
+  AggWriteInit *init = new AggWriteInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
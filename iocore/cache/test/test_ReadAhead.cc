@@ -0,0 +1,304 @@
+/** @file
+
+  Read of a multi-fragment object with and without fragment read-ahead.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#define LARGE_FILE (64 * 1024 * 1024)
+#define BENCH_FILE (1024 * 1024 * 1024)
+#define PATTERN_SIZE (10 * 1024 * 1024)
+#define CHUNK_SIZE (1024 * 1024)
+#define READ_AHEAD_FRAGMENTS 8
+
+// The regression run reads LARGE_FILE. Setting TS_READ_AHEAD_BENCH reads BENCH_FILE instead, for a
+// throughput comparison that is too slow to run on every check.
+static bool
+bench_run()
+{
+  return getenv("TS_READ_AHEAD_BENCH") != nullptr;
+}
+
+// The object is GLOBAL_DATA repeated, so it never has to be held in memory.
+static size_t
+pattern_avail(size_t pos)
+{
+  return PATTERN_SIZE - pos % PATTERN_SIZE;
+}
+
+class PatternWriteTest : public CacheTestBase
+{
+public:
+  PatternWriteTest(size_t size, CacheTestHandler *cont, const char *url) : CacheTestBase(cont), _size(size)
+  {
+    this->_write_buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+    this->info.create();
+    build_hdrs(this->info, url, "application/octet-stream");
+    SET_HANDLER(&PatternWriteTest::start_test);
+  }
+
+  int
+  start_test(int event, void *e) override
+  {
+    HttpCacheKey key = generate_key(this->info);
+    SET_HANDLER(&PatternWriteTest::write_event);
+    cacheProcessor.open_write(this, 0, &key, (CacheHTTPHdr *)this->info.request_get(), nullptr);
+    return 0;
+  }
+
+  int
+  write_event(int event, void *e)
+  {
+    switch (event) {
+    case CACHE_EVENT_OPEN_WRITE:
+      this->vc = static_cast<CacheVC *>(e);
+      this->process_event(event);
+      break;
+    case VC_EVENT_WRITE_READY:
+      this->fill_data();
+      this->process_event(event);
+      break;
+    case VC_EVENT_WRITE_COMPLETE:
+      this->process_event(event);
+      break;
+    default:
+      CHECK(false);
+      this->close();
+      TEST_DONE();
+      break;
+    }
+    return 0;
+  }
+
+  void
+  fill_data()
+  {
+    while (this->_pos < this->_size && this->_write_buffer->max_read_avail() < CHUNK_SIZE) {
+      size_t n = std::min(pattern_avail(this->_pos), std::min<size_t>(CHUNK_SIZE, this->_size - this->_pos));
+      this->_pos += this->_write_buffer->write(GLOBAL_DATA + this->_pos % PATTERN_SIZE, n);
+    }
+  }
+
+  void
+  do_io_write(size_t size = 0) override
+  {
+    this->vc->set_http_info(&this->info);
+    this->vio = this->vc->do_io_write(this, this->_size, this->_write_buffer->alloc_reader());
+    this->fill_data();
+  }
+
+  HTTPInfo info;
+
+private:
+  size_t _size             = 0;
+  size_t _pos              = 0;
+  MIOBuffer *_write_buffer = nullptr;
+};
+
+class PatternReadTest : public CacheTestBase
+{
+public:
+  PatternReadTest(size_t size, int read_ahead, CacheTestHandler *cont, const char *url)
+    : CacheTestBase(cont), _size(size), _read_ahead(read_ahead)
+  {
+    this->_read_buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+    this->_reader      = this->_read_buffer->alloc_reader();
+    this->info.create();
+    build_hdrs(this->info, url, "application/octet-stream");
+    SET_HANDLER(&PatternReadTest::start_test);
+  }
+
+  int
+  start_test(int event, void *e) override
+  {
+    HttpCacheKey key = generate_key(this->info);
+    cache_config_read_ahead_fragments = this->_read_ahead;
+    this->start                       = Thread::get_hrtime();
+    SET_HANDLER(&PatternReadTest::read_event);
+    cacheProcessor.open_read(this, &key, (CacheHTTPHdr *)this->info.request_get(), &this->params);
+    return 0;
+  }
+
+  int
+  read_event(int event, void *e)
+  {
+    switch (event) {
+    case CACHE_EVENT_OPEN_READ:
+      this->vc = static_cast<CacheVC *>(e);
+      this->process_event(event);
+      break;
+    case VC_EVENT_READ_READY:
+    case VC_EVENT_READ_COMPLETE:
+      while (this->_reader->block_read_avail()) {
+        auto str = this->_reader->block_read_view();
+        size_t n = std::min(str.size(), pattern_avail(this->_pos));
+        REQUIRE(memcmp(str.data(), GLOBAL_DATA + this->_pos % PATTERN_SIZE, n) == 0);
+        this->_reader->consume(n);
+        this->_pos += n;
+      }
+      if (event == VC_EVENT_READ_COMPLETE) {
+        this->elapsed = Thread::get_hrtime() - this->start;
+        REQUIRE(this->_pos == this->_size);
+      }
+      this->process_event(event);
+      break;
+    default:
+      CHECK(false);
+      this->close();
+      TEST_DONE();
+      break;
+    }
+    return 0;
+  }
+
+  void
+  do_io_read(size_t size = 0) override
+  {
+    this->vio = this->vc->do_io_read(this, this->_size, this->_read_buffer);
+  }
+
+  double
+  mbps() const
+  {
+    return (static_cast<double>(this->_size) / (1024 * 1024)) / (static_cast<double>(this->elapsed) / HRTIME_SECOND);
+  }
+
+  HTTPInfo info;
+  ink_hrtime start   = 0;
+  ink_hrtime elapsed = 0;
+
+private:
+  size_t _size            = 0;
+  size_t _pos             = 0;
+  int _read_ahead         = 0;
+  MIOBuffer *_read_buffer = nullptr;
+  IOBufferReader *_reader = nullptr;
+  OverridableHttpConfigParams params;
+};
+
+static int64_t
+read_ahead_hits()
+{
+  int64_t hits = 0;
+  RecGetRawStatSum(cache_rsb, cache_read_ahead_hit_stat, &hits);
+  return hits;
+}
+
+// Write one large object, then read it back once without and once with read-ahead.
+class ReadAheadTestHandler : public CacheTestHandler
+{
+public:
+  ReadAheadTestHandler(size_t size, const char *url = DEFAULT_URL) : _size(size)
+  {
+    this->_wt       = new PatternWriteTest(size, this, url);
+    this->_plain    = new PatternReadTest(size, 0, this, url);
+    this->_pipeline = new PatternReadTest(size, READ_AHEAD_FRAGMENTS, this, url);
+
+    this->_wt->mutex       = this->mutex;
+    this->_plain->mutex    = this->mutex;
+    this->_pipeline->mutex = this->mutex;
+    SET_HANDLER(&ReadAheadTestHandler::start_test);
+  }
+
+  int
+  start_test(int event, void *e)
+  {
+    this_ethread()->schedule_imm(this->_wt);
+    return 0;
+  }
+
+  void
+  handle_cache_event(int event, CacheTestBase *base) override
+  {
+    switch (event) {
+    case CACHE_EVENT_OPEN_WRITE:
+      base->do_io_write();
+      break;
+    case CACHE_EVENT_OPEN_READ:
+      base->do_io_read();
+      break;
+    case VC_EVENT_READ_READY:
+    case VC_EVENT_WRITE_READY:
+      base->reenable();
+      break;
+    case VC_EVENT_WRITE_COMPLETE:
+      base->close();
+      this->_hits = read_ahead_hits();
+      this_ethread()->schedule_imm(this->_plain);
+      break;
+    case VC_EVENT_READ_COMPLETE:
+      if (base == this->_plain) {
+        REQUIRE(read_ahead_hits() == this->_hits);
+        this->_plain_mbps = this->_plain->mbps();
+        base->close();
+        this_ethread()->schedule_imm(this->_pipeline);
+      } else {
+        // the fragments after the first few come from read-ahead
+        REQUIRE(read_ahead_hits() > this->_hits);
+        printf("read of %zu MB: %.1f MB/s without read-ahead, %.1f MB/s with %d fragments read-ahead\n",
+               this->_size / (1024 * 1024), this->_plain_mbps, this->_pipeline->mbps(), READ_AHEAD_FRAGMENTS);
+        base->close();
+        cache_config_read_ahead_fragments = 0;
+        delete this;
+      }
+      break;
+    default:
+      REQUIRE(false);
+      base->close();
+      delete this;
+      break;
+    }
+  }
+
+private:
+  size_t _size                = 0;
+  PatternReadTest *_plain    = nullptr;
+  PatternReadTest *_pipeline = nullptr;
+  double _plain_mbps          = 0;
+  int64_t _hits               = 0;
+};
+
+class ReadAheadCacheInit : public CacheInit
+{
+public:
+  ReadAheadCacheInit() {}
+  int
+  cache_init_success_callback(int event, void *e) override
+  {
+    ReadAheadTestHandler *h = new ReadAheadTestHandler(bench_run() ? BENCH_FILE : LARGE_FILE);
+    TerminalTest *tt        = new TerminalTest;
+    h->add(tt);
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("cache read-ahead", "cache")
+{
+  // both reads come from disk
+  RecSetRecordInt("proxy.config.cache.ram_cache.size", 0, REC_SOURCE_EXPLICIT);
+  init_cache(bench_run() ? 2048LL * 1024 * 1024 : 256 * 1024 * 1024);
+  ReadAheadCacheInit *init = new ReadAheadCacheInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
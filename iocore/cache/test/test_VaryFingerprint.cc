@@ -0,0 +1,407 @@
+/** @file
+
+  Vary fingerprints pick the same alternates as CalcVariability, and are kept
+  with the marshalled alternate.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "HttpTransactCache.h"
+#include "InkAPIInternal.h"
+
+#include <string>
+#include <vector>
+
+// @a fields is a list of "Name: value\r\n" lines.
+static void
+parse_hdr(HTTPHdr &hdr, HTTPType type, const char *fields)
+{
+  std::string text = type == HTTP_TYPE_REQUEST ? "GET http://www.example.com/ HTTP/1.1\r\n" : "HTTP/1.1 200 OK\r\n";
+  text += fields;
+  text += "\r\n";
+
+  HTTPParser parser;
+  const char *start = text.data();
+  const char *end   = start + text.size();
+
+  hdr.create(type);
+  http_parser_init(&parser);
+  ParseResult result =
+    type == HTTP_TYPE_REQUEST ? hdr.parse_req(&parser, &start, end, true) : hdr.parse_resp(&parser, &start, end, true);
+  http_parser_clear(&parser);
+  REQUIRE(result == PARSE_RESULT_DONE);
+}
+
+struct VaryCase {
+  const char *vary;   ///< Response fields.
+  const char *cached; ///< Request fields the alternate was cached for.
+  const char *client; ///< Request fields of the client.
+  bool match;         ///< Whether CalcVariability serves the alternate.
+};
+
+// The fingerprint of the client must equal that of the cached request exactly when CalcVariability
+// finds no variability.
+static void
+check_cases(const OverridableHttpConfigParams &params, const std::vector<VaryCase> &cases)
+{
+  for (const VaryCase &c : cases) {
+    HTTPHdr response, cached, client;
+    parse_hdr(response, HTTP_TYPE_RESPONSE, c.vary);
+    parse_hdr(cached, HTTP_TYPE_REQUEST, c.cached);
+    parse_hdr(client, HTTP_TYPE_REQUEST, c.client);
+
+    INFO("response: " << c.vary << "cached: " << c.cached << "client: " << c.client);
+
+    uint64_t cached_names, cached_values, client_names, client_values;
+    REQUIRE(HttpTransactCache::CalcVaryFingerprint(&params, &cached, &response, &cached_names, &cached_values));
+    REQUIRE(HttpTransactCache::CalcVaryFingerprint(&params, &client, &response, &client_names, &client_values));
+    Variability_t variability = HttpTransactCache::CalcVariability(&params, &client, &cached, &response);
+
+    CHECK(cached_names == client_names);
+    CHECK((variability == VARIABILITY_NONE) == c.match);
+    CHECK((cached_values == client_values) == c.match);
+
+    response.destroy();
+    cached.destroy();
+    client.destroy();
+  }
+}
+
+TEST_CASE("missing selecting headers", "[vary]")
+{
+  http_init();
+  OverridableHttpConfigParams params;
+
+  check_cases(params, {
+                        {"Vary: Accept-Language\r\n", "", "", true},
+                        {"Vary: Accept-Language\r\n", "Accept-Language: en\r\n", "", false},
+                        {"Vary: Accept-Language\r\n", "", "Accept-Language: en\r\n", false},
+                        // present but empty is not the same as missing
+                        {"Vary: Accept-Language\r\n", "Accept-Language:\r\n", "", false},
+                        {"Vary: Accept-Language\r\n", "Accept-Language:\r\n", "Accept-Language:\r\n", true},
+                        {"Vary: Accept-Language, Cookie\r\n", "Cookie: a=1\r\n", "Cookie: a=1\r\n", true},
+                        {"Vary: Accept-Language, Cookie\r\n", "Accept-Language: en\r\nCookie: a=1\r\n", "Cookie: a=1\r\n", false},
+                        // no Vary at all, or an empty one, never varies
+                        {"", "Accept-Language: en\r\n", "Accept-Language: fr\r\n", true},
+                        {"Vary: \r\n", "Accept-Language: en\r\n", "Accept-Language: fr\r\n", true},
+                      });
+}
+
+TEST_CASE("reordered and duplicated fields", "[vary]")
+{
+  http_init();
+  OverridableHttpConfigParams params;
+
+  check_cases(params, {
+                        // the order of the Vary fields does not matter for a match
+                        {"Vary: Accept-Language, Accept-Encoding\r\n", "Accept-Language: en\r\nAccept-Encoding: gzip\r\n",
+                         "Accept-Encoding: gzip\r\nAccept-Language: en\r\n", true},
+                        {"Vary: Accept-Encoding, Accept-Language\r\n", "Accept-Language: en\r\nAccept-Encoding: gzip\r\n",
+                         "Accept-Encoding: gzip\r\nAccept-Language: en\r\n", true},
+                        {"Vary: Accept-Encoding, Accept-Language\r\n", "Accept-Language: en\r\nAccept-Encoding: gzip\r\n",
+                         "Accept-Encoding: gzip\r\nAccept-Language: fr\r\n", false},
+                        // a field named twice
+                        {"Vary: Accept-Language, Accept-Language\r\n", "Accept-Language: en\r\n", "Accept-Language: en\r\n", true},
+                        {"Vary: Accept-Language, Accept-Language\r\n", "Accept-Language: en\r\n", "Accept-Language: de\r\n", false},
+                        {"Vary: Accept-Language\r\nVary: Accept-Language\r\n", "Accept-Language: en\r\n", "Accept-Language: en\r\n",
+                         true},
+                        {"Vary: Accept-Language\r\nVary: Cookie\r\n", "Accept-Language: en\r\nCookie: a=1\r\n",
+                         "Accept-Language: fr\r\nCookie: a=1\r\n", false},
+                        // the order of the values does matter
+                        {"Vary: Accept-Language\r\n", "Accept-Language: en, fr\r\n", "Accept-Language: fr, en\r\n", false},
+                        // duplicate request fields are combined
+                        {"Vary: Accept-Language\r\n", "Accept-Language: en, fr\r\n",
+                         "Accept-Language: en\r\nAccept-Language: fr\r\n", true},
+                        {"Vary: Accept-Language\r\n", "Accept-Language: en, fr\r\n",
+                         "Accept-Language: en\r\nAccept-Language: de\r\n", false},
+                        {"Vary: Accept-Language\r\n", "Accept-Language: en,fr\r\n", "Accept-Language:  en ,  fr\r\n", true},
+                        {"Vary: Accept-Language\r\n", "Accept-Language: en, fr\r\n", "Accept-Language: en, fr, en\r\n", false},
+                      });
+}
+
+TEST_CASE("case differences", "[vary]")
+{
+  http_init();
+  OverridableHttpConfigParams params;
+
+  check_cases(params, {
+                        {"Vary: accept-language\r\n", "Accept-Language: en\r\n", "ACCEPT-LANGUAGE: en\r\n", true},
+                        {"Vary: Accept-Language\r\n", "Accept-Language: en-US\r\n", "Accept-Language: EN-us\r\n", true},
+                        {"Vary: Accept-Language\r\n", "Accept-Language: en-US\r\n", "Accept-Language: en-GB\r\n", false},
+                        {"Vary: X-Device\r\n", "x-device: Mobile\r\n", "X-DEVICE: mobile\r\n", true},
+                        {"Vary: X-Device\r\n", "X-Device: mobile\r\n", "X-Device: tablet\r\n", false},
+                        {"Vary: x-device\r\n", "X-Device: mobile\r\n", "", false},
+                      });
+
+  // the names hash does not depend on how the response spells the fields
+  HTTPHdr lower, upper, request;
+  parse_hdr(lower, HTTP_TYPE_RESPONSE, "Vary: accept-language, x-device\r\n");
+  parse_hdr(upper, HTTP_TYPE_RESPONSE, "Vary: Accept-Language, X-DEVICE\r\n");
+  parse_hdr(request, HTTP_TYPE_REQUEST, "Accept-Language: en\r\nX-Device: mobile\r\n");
+
+  uint64_t lower_names, lower_values, upper_names, upper_values;
+  REQUIRE(HttpTransactCache::CalcVaryFingerprint(&params, &request, &lower, &lower_names, &lower_values));
+  REQUIRE(HttpTransactCache::CalcVaryFingerprint(&params, &request, &upper, &upper_names, &upper_values));
+  CHECK(lower_names == upper_names);
+  CHECK(lower_values == upper_values);
+
+  lower.destroy();
+  upper.destroy();
+  request.destroy();
+}
+
+TEST_CASE("exempt fields", "[vary]")
+{
+  http_init();
+  OverridableHttpConfigParams params;
+  std::vector<VaryCase> cases = {
+    {"Vary: User-Agent, Accept-Encoding\r\n", "User-Agent: a\r\nAccept-Encoding: gzip\r\n",
+     "User-Agent: b\r\nAccept-Encoding: br\r\n", false},
+  };
+
+  check_cases(params, cases);
+
+  params.global_user_agent_header = const_cast<char *>("User-Agent: ATS\r\n");
+  check_cases(params, {
+                        {"Vary: User-Agent\r\n", "User-Agent: a\r\n", "User-Agent: b\r\n", true},
+                        {"Vary: user-agent\r\n", "User-Agent: a\r\n", "", true},
+                        {"Vary: User-Agent, Accept-Encoding\r\n", "User-Agent: a\r\nAccept-Encoding: gzip\r\n",
+                         "User-Agent: b\r\nAccept-Encoding: br\r\n", false},
+                      });
+
+  params.ignore_accept_encoding_mismatch = 1;
+  cases[0].match                         = true;
+  check_cases(params, cases);
+
+  params.global_user_agent_header = nullptr;
+  cases[0].match                  = false;
+  check_cases(params, cases);
+}
+
+TEST_CASE("Vary: * has no fingerprint", "[vary]")
+{
+  http_init();
+  OverridableHttpConfigParams params;
+
+  struct {
+    const char *vary;
+    bool all;
+  } cases[] = {
+    {"Vary: *\r\n", true},
+    {"Vary: Accept-Language, *\r\n", true},
+    {"Vary: *, Accept-Language\r\n", true},
+    {"Vary: Accept-Language, Cookie\r\n", false},
+  };
+
+  for (auto &c : cases) {
+    HTTPHdr response, request;
+    parse_hdr(response, HTTP_TYPE_RESPONSE, c.vary);
+    parse_hdr(request, HTTP_TYPE_REQUEST, "Accept-Language: en\r\n");
+    INFO("response: " << c.vary);
+
+    uint64_t names, values;
+    Variability_t variability = HttpTransactCache::CalcVariability(&params, &request, &request, &response);
+    CHECK((variability == VARIABILITY_ALL) == c.all);
+    CHECK(HttpTransactCache::CalcVaryFingerprint(&params, &request, &response, &names, &values) == !c.all);
+
+    response.destroy();
+    request.destroy();
+  }
+}
+
+/*
+  Without the fingerprint SelectFromAlternates scores every alternate and the
+  transaction then drops the winner if CalcVariability finds it varies. With
+  the fingerprint the alternate served is the best scored one that
+  CalcVariability accepts, which is the one the full path would serve when it
+  wins the scoring.
+*/
+static int
+select_by_variability(CacheHTTPInfoVector &vector, HTTPHdr *client, const OverridableHttpConfigParams &params)
+{
+  int best_index = -1;
+  float best_Q   = 0.0;
+
+  for (int i = 0; i < vector.count(); i++) {
+    CacheHTTPInfo *alt = vector.get(i);
+    if (HttpTransactCache::CalcVariability(&params, client, alt->request_get(), alt->response_get()) != VARIABILITY_NONE) {
+      continue;
+    }
+    float Q = HttpTransactCache::calculate_quality_of_match(&params, client, alt->request_get(), alt->response_get());
+    if (Q > best_Q) {
+      best_Q     = Q;
+      best_index = i;
+    }
+  }
+  return best_index;
+}
+
+TEST_CASE("SelectFromAlternates", "[vary]")
+{
+  http_init();
+  OverridableHttpConfigParams params;
+  if (http_global_hooks == nullptr) {
+    http_global_hooks = new HttpAPIHooks;
+  }
+
+  struct {
+    const char *vary;
+    const char *cached;
+  } alternates[] = {
+    // each client below matches at most one of these, so scoring does not have to break ties
+    {"Vary: Accept-Language\r\n", "Accept-Language: en\r\n"},
+    {"Vary: Accept-Language\r\n", "Accept-Language: fr\r\n"},
+    {"Vary: accept-language\r\n", "Accept-Language: DE\r\n"},
+    {"Vary: Accept-Language, Cookie\r\n", "Accept-Language: es\r\nCookie: a=1\r\n"},
+    {"Vary: Cookie, Accept-Language\r\n", "Accept-Language: es\r\nCookie: b=2\r\n"},
+    {"Vary: Cookie, Cookie\r\n", "Cookie: c=3\r\n"},
+    {"Vary: *\r\n", "Accept-Language: it\r\n"},
+    {"Vary: Accept-Language\r\n", ""},
+  };
+
+  CacheHTTPInfoVector vector;
+  time_t now = time(nullptr);
+  for (auto &a : alternates) {
+    HTTPHdr request, response;
+    parse_hdr(request, HTTP_TYPE_REQUEST, a.cached);
+    parse_hdr(response, HTTP_TYPE_RESPONSE, a.vary);
+
+    CacheHTTPInfo info;
+    CryptoHash key;
+    info.create();
+    info.request_set(&request);
+    info.response_set(&response);
+    key.u64[0] = vector.count() + 1;
+    info.object_key_set(key);
+    info.request_sent_time_set(now);
+    info.response_received_time_set(now);
+    vector.insert(&info);
+
+    request.destroy();
+    response.destroy();
+  }
+
+  struct {
+    const char *client;
+    int expected;
+  } clients[] = {
+    {"Accept-Language: en\r\n", 0},
+    {"Accept-Language: FR\r\n", 1},
+    {"Accept-Language: de\r\n", 2},
+    {"Accept-Language: es\r\nCookie: a=1\r\n", 3},
+    {"Cookie: b=2\r\nAccept-Language: es\r\n", 4},
+    {"Accept-Language: pt\r\nCookie: c=3\r\n", 5},
+    {"Accept-Language: pt\r\n", -1},
+    {"Accept-Language: it\r\n", -1},
+    {"", 7},
+  };
+
+  // alternates written without a fingerprint, then with the one stored when they are written
+  for (bool stored : {false, true}) {
+    if (stored) {
+      for (int i = 0; i < vector.count(); i++) {
+        HttpTransactCache::SetVaryFingerprint(&params, vector.get(i));
+      }
+    }
+    for (auto &c : clients) {
+      HTTPHdr client;
+      parse_hdr(client, HTTP_TYPE_REQUEST, c.client);
+      INFO("client: " << c.client << "stored: " << stored);
+
+      int reference = select_by_variability(vector, &client, params);
+      CHECK(reference == c.expected);
+      CHECK(HttpTransactCache::SelectFromAlternates(&vector, &client, &params) == reference);
+
+      client.destroy();
+    }
+  }
+
+  // a change of configuration does not use the stored fingerprints
+  params.ignore_accept_encoding_mismatch = 1;
+  HTTPHdr client;
+  parse_hdr(client, HTTP_TYPE_REQUEST, "Accept-Language: fr\r\n");
+  CHECK(HttpTransactCache::SelectFromAlternates(&vector, &client, &params) == select_by_variability(vector, &client, params));
+  client.destroy();
+}
+
+TEST_CASE("marshalled fingerprint", "[vary]")
+{
+  http_init();
+  OverridableHttpConfigParams params;
+
+  HTTPHdr request, response;
+  parse_hdr(request, HTTP_TYPE_REQUEST, "Accept-Language: en\r\n");
+  parse_hdr(response, HTTP_TYPE_RESPONSE, "Vary: Accept-Language\r\n");
+
+  CacheHTTPInfo info;
+  info.create();
+  info.request_set(&request);
+  info.response_set(&response);
+  HttpTransactCache::SetVaryFingerprint(&params, &info);
+
+  uint64_t names = 0, values = 0;
+  uint32_t state = info.vary_fingerprint_get(&names, &values);
+  REQUIRE(state != 0);
+
+  int len = info.marshal_length();
+  std::vector<uint64_t> buf(len / sizeof(uint64_t) + 1);
+  len = info.marshal(reinterpret_cast<char *>(buf.data()), len);
+
+  uint64_t n = 0, v = 0;
+  CacheHTTPInfo loaded;
+
+  SECTION("current version")
+  {
+    REQUIRE(HTTPInfo::unmarshal(reinterpret_cast<char *>(buf.data()), len, nullptr) == len);
+    loaded.m_alt = reinterpret_cast<HTTPCacheAlt *>(buf.data());
+    CHECK(loaded.vary_fingerprint_get(&n, &v) == state);
+    CHECK(n == names);
+    CHECK(v == values);
+  }
+
+  SECTION("cache version 24.2")
+  {
+    // the same alternate as it was laid out before the hashes were added
+    int hashes   = sizeof(HTTPCacheAlt::m_vary_names) + sizeof(HTTPCacheAlt::m_vary_values);
+    int old_size = sizeof(HTTPCacheAlt) - hashes;
+    std::vector<uint64_t> old(buf.size());
+    char *src = reinterpret_cast<char *>(buf.data());
+    char *dst = reinterpret_cast<char *>(old.data());
+    memcpy(dst, src, old_size);
+    memcpy(dst + old_size, src + sizeof(HTTPCacheAlt), len - sizeof(HTTPCacheAlt));
+
+    HTTPCacheAlt *alt = reinterpret_cast<HTTPCacheAlt *>(dst);
+    alt->m_request_hdr.m_heap  = reinterpret_cast<HdrHeap *>(reinterpret_cast<intptr_t>(alt->m_request_hdr.m_heap) - hashes);
+    alt->m_response_hdr.m_heap = reinterpret_cast<HdrHeap *>(reinterpret_cast<intptr_t>(alt->m_response_hdr.m_heap) - hashes);
+    REQUIRE(alt->m_vary_state != 0);
+
+    REQUIRE(HTTPInfo::unmarshal_v24_2(dst, len - hashes, nullptr) == len - hashes);
+    loaded.m_alt = alt;
+    CHECK(loaded.vary_fingerprint_get(&n, &v) == 0);
+    int vary_len;
+    CHECK(loaded.response_get()->value_get(MIME_FIELD_VARY, MIME_LEN_VARY, &vary_len) != nullptr);
+  }
+
+  loaded.clear();
+  info.destroy();
+  request.destroy();
+  response.destroy();
+}
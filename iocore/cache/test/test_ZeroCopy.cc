@@ -0,0 +1,357 @@
+/** @file
+
+  A zero copy read keeps its span range from being overwritten when the
+  volume wraps before the range has been sent, until the aggregation writer
+  has waited proxy.config.cache.zero_copy.max_wait for it.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#define OBJECT_SIZE (8 * 1024 * 1024)
+#define FILLER_SIZE (10 * 1024 * 1024)
+#define MAX_FILLERS 40 // well past the 256M span
+#define CHUNK_SIZE (1024 * 1024)
+#define CHECK_INTERVAL HRTIME_MSECONDS(10)
+#define MAX_WAIT 500 // ms
+
+static char FILLER_DATA[CHUNK_SIZE];
+
+// Writes an object of a constant byte, different from GLOBAL_DATA.
+class FillerWriteTest : public CacheTestBase
+{
+public:
+  FillerWriteTest(CacheTestHandler *cont, const char *url) : CacheTestBase(cont)
+  {
+    this->_write_buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+    this->info.create();
+    build_hdrs(this->info, url, "application/octet-stream");
+    SET_HANDLER(&FillerWriteTest::start_test);
+  }
+
+  int
+  start_test(int event, void *e) override
+  {
+    HttpCacheKey key = generate_key(this->info);
+    SET_HANDLER(&FillerWriteTest::write_event);
+    cacheProcessor.open_write(this, 0, &key, (CacheHTTPHdr *)this->info.request_get(), nullptr);
+    return 0;
+  }
+
+  int
+  write_event(int event, void *e)
+  {
+    switch (event) {
+    case CACHE_EVENT_OPEN_WRITE:
+      this->vc = static_cast<CacheVC *>(e);
+      this->process_event(event);
+      break;
+    case VC_EVENT_WRITE_READY:
+      this->fill_data();
+      this->process_event(event);
+      break;
+    default:
+      // the write backlog overflows while the writer waits
+      this->process_event(event);
+      break;
+    }
+    return 0;
+  }
+
+  void
+  fill_data()
+  {
+    while (this->_pos < FILLER_SIZE && this->_write_buffer->max_read_avail() < CHUNK_SIZE) {
+      this->_pos += this->_write_buffer->write(FILLER_DATA, std::min<size_t>(CHUNK_SIZE, FILLER_SIZE - this->_pos));
+    }
+  }
+
+  void
+  do_io_write(size_t size = 0) override
+  {
+    this->vc->set_http_info(&this->info);
+    this->vio = this->vc->do_io_write(this, FILLER_SIZE, this->_write_buffer->alloc_reader());
+    this->fill_data();
+  }
+
+  HTTPInfo info;
+
+private:
+  size_t _pos              = 0;
+  MIOBuffer *_write_buffer = nullptr;
+};
+
+// Reads the object zero copy and keeps the first file range it is handed.
+class ZeroCopyReadTest : public CacheTestBase
+{
+public:
+  ZeroCopyReadTest(CacheTestHandler *cont, const char *url) : CacheTestBase(cont)
+  {
+    this->_read_buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+    this->_reader      = this->_read_buffer->alloc_reader();
+    this->info.create();
+    build_hdrs(this->info, url);
+    SET_HANDLER(&ZeroCopyReadTest::start_test);
+  }
+
+  int
+  start_test(int event, void *e) override
+  {
+    HttpCacheKey key = generate_key(this->info);
+    SET_HANDLER(&ZeroCopyReadTest::read_event);
+    cacheProcessor.open_read(this, &key, (CacheHTTPHdr *)this->info.request_get(), &this->params);
+    return 0;
+  }
+
+  int
+  read_event(int event, void *e)
+  {
+    switch (event) {
+    case CACHE_EVENT_OPEN_READ:
+      this->vc = static_cast<CacheVC *>(e);
+      REQUIRE(this->vc->set_zero_copy());
+      this->process_event(event);
+      break;
+    case VC_EVENT_READ_READY:
+    case VC_EVENT_READ_COMPLETE:
+      while (this->_reader->block_read_avail()) {
+        IOBufferBlock *b = this->_reader->get_current_block();
+        int64_t n        = this->_reader->block_read_avail();
+        if (b->is_file_range()) {
+          if (!this->range) {
+            REQUIRE(this->_reader->start_offset == 0);
+            this->range     = b->data;
+            this->range_pos = this->_pos;
+            this->range_len = n;
+          }
+        } else {
+          REQUIRE(memcmp(this->_reader->start(), GLOBAL_DATA + this->_pos, n) == 0);
+        }
+        this->_reader->consume(n);
+        this->_pos += n;
+      }
+      this->process_event(event);
+      break;
+    default:
+      CHECK(false);
+      this->close();
+      TEST_DONE();
+      break;
+    }
+    return 0;
+  }
+
+  void
+  do_io_read(size_t size = 0) override
+  {
+    this->vio = this->vc->do_io_read(this, OBJECT_SIZE, this->_read_buffer);
+  }
+
+  HTTPInfo info;
+  Ptr<IOBufferData> range;
+  int64_t range_pos = 0;
+  int64_t range_len = 0;
+
+private:
+  int64_t _pos            = 0;
+  MIOBuffer *_read_buffer = nullptr;
+  IOBufferReader *_reader = nullptr;
+  OverridableHttpConfigParams params;
+};
+
+/*
+  Write the object and read it zero copy, holding on to one file range as a
+  slow client would. Then write fillers until the aggregation writer wraps
+  around onto the range and check the span still holds the object there.
+  Keep holding the range until the writer gives up waiting and takes it
+  back, after which it can no longer be sent.
+*/
+class ZeroCopyWrapTestHandler : public CacheTestHandler
+{
+public:
+  ZeroCopyWrapTestHandler()
+  {
+    this->_wt = new CacheWriteTest(OBJECT_SIZE, this, "http://www.zerocopy.com/");
+    this->_rt = new ZeroCopyReadTest(this, "http://www.zerocopy.com/");
+
+    this->_wt->mutex = this->mutex;
+    this->_rt->mutex = this->mutex;
+    SET_HANDLER(&ZeroCopyWrapTestHandler::start_test);
+  }
+
+  int
+  start_test(int event, void *e)
+  {
+    SET_HANDLER(&ZeroCopyWrapTestHandler::check_event);
+    this_ethread()->schedule_imm(this->_wt);
+    return 0;
+  }
+
+  // Periodic check, between the cache events.
+  int
+  check_event(int event, void *e)
+  {
+    Vol *vol = gvol[0];
+    if (this->_read && !this->_checked) {
+      MUTEX_TRY_LOCK(lock, vol->mutex, this_ethread());
+      if (lock.is_locked() && !vol->is_io_in_progress() && vol->agg_sealed &&
+          vol->zero_copy_blocked(vol->header->write_pos, vol->agg_buf_len[vol->agg_buf_head], false)) {
+        this->check_range();
+      }
+    } else if (this->_checked && !this->_revoked) {
+      if (this->_range->hold_file_range()) {
+        this->_range->unhold_file_range();
+      } else {
+        // taken back once the writer has waited long enough
+        CHECK(ink_hrtime_to_msec(Thread::get_hrtime() - this->_checked_at) < MAX_WAIT + 1000);
+        this->_range   = nullptr;
+        this->_revoked = true;
+      }
+    }
+    if (this->_idle) {
+      if (this->_revoked) {
+        this->_check->cancel();
+        delete this;
+      } else if (this->_checked) {
+        // the sealed buffer is retried until the range is taken back
+      } else if (this->_fillers < MAX_FILLERS) {
+        this->start_filler();
+      } else {
+        CHECK(!"the writer never reached the zero copy range");
+        this->_check->cancel();
+        delete this;
+      }
+    }
+    return 0;
+  }
+
+  void
+  check_range()
+  {
+    std::unique_ptr<char[]> buf(new char[this->_range_len]);
+    REQUIRE(pread(this->_range->_fd, buf.get(), this->_range_len, this->_range->_fd_offset) == this->_range_len);
+    REQUIRE(memcmp(buf.get(), GLOBAL_DATA + this->_range_pos, this->_range_len) == 0);
+    this->_checked    = true;
+    this->_checked_at = Thread::get_hrtime();
+  }
+
+  void
+  start_filler()
+  {
+    char url[64];
+    snprintf(url, sizeof(url), "http://www.filler%d.com/", this->_fillers++);
+    this->_idle          = false;
+    this->_filler        = new FillerWriteTest(this, url);
+    this->_filler->mutex = this->mutex;
+    this_ethread()->schedule_imm(this->_filler);
+  }
+
+  void
+  handle_cache_event(int event, CacheTestBase *base) override
+  {
+    switch (event) {
+    case CACHE_EVENT_OPEN_WRITE:
+      base->do_io_write();
+      break;
+    case CACHE_EVENT_OPEN_READ:
+      base->do_io_read();
+      break;
+    case VC_EVENT_READ_READY:
+    case VC_EVENT_WRITE_READY:
+      base->reenable();
+      break;
+    case VC_EVENT_WRITE_COMPLETE:
+      base->close();
+      if (base == this->_wt) {
+        this_ethread()->schedule_imm(this->_rt);
+      } else {
+        this->_idle = true;
+      }
+      break;
+    case VC_EVENT_READ_COMPLETE: {
+      ZeroCopyReadTest *rt = static_cast<ZeroCopyReadTest *>(base);
+      REQUIRE(rt->range);
+      this->_range     = rt->range;
+      this->_range_pos = rt->range_pos;
+      this->_range_len = rt->range_len;
+      base->close();
+      this->_read  = true;
+      this->_idle  = true;
+      this->_check = this_ethread()->schedule_every(this, CHECK_INTERVAL);
+      break;
+    }
+    case VC_EVENT_ERROR:
+      REQUIRE(base == this->_filler);
+      base->close();
+      this->_idle = true;
+      break;
+    default:
+      REQUIRE(false);
+      base->close();
+      delete this;
+      break;
+    }
+  }
+
+private:
+  Ptr<IOBufferData> _range;
+  int64_t _range_pos      = 0;
+  int64_t _range_len      = 0;
+  CacheTestBase *_filler  = nullptr;
+  Event *_check           = nullptr;
+  ink_hrtime _checked_at  = 0;
+  int _fillers            = 0;
+  bool _read              = false;
+  bool _idle              = false;
+  bool _checked           = false;
+  bool _revoked           = false;
+};
+
+class ZeroCopyCacheInit : public CacheInit
+{
+public:
+  ZeroCopyCacheInit() {}
+  int
+  cache_init_success_callback(int event, void *e) override
+  {
+    ZeroCopyWrapTestHandler *h = new ZeroCopyWrapTestHandler;
+    TerminalTest *tt           = new TerminalTest;
+
+    REQUIRE(gnvol > 0);
+    REQUIRE(gvol[0]->disk->sendfile_fd >= 0);
+
+    h->add(tt);
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("zero copy range survives a volume wrap", "cache")
+{
+  memset(FILLER_DATA, 'z', sizeof(FILLER_DATA));
+  RecSetRecordInt("proxy.config.cache.zero_copy.min_size", 1, REC_SOURCE_EXPLICIT);
+  RecSetRecordInt("proxy.config.cache.zero_copy.max_wait", MAX_WAIT, REC_SOURCE_EXPLICIT);
+  init_cache(256 * 1024 * 1024);
+  ZeroCopyCacheInit *init = new ZeroCopyCacheInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
@@ -36,6 +36,7 @@ ink_event_system_init(ts::ModuleVersion v)
   ink_release_assert(v.check(EVENT_SYSTEM_MODULE_INTERNAL_VERSION));
   int config_max_iobuffer_size = DEFAULT_MAX_BUFFER_SIZE;
   int iobuffer_advice          = 0;
+  int magazine_size            = 0;
 
   // For backwards compatibility make sure to allow thread_freelist_size
   // This needs to change in 6.0
@@ -43,6 +44,9 @@ ink_event_system_init(ts::ModuleVersion v)
 
   REC_EstablishStaticConfigInt32(thread_freelist_low_watermark, "proxy.config.allocator.thread_freelist_low_watermark");
 
+  REC_ReadConfigInteger(magazine_size, "proxy.config.allocator.magazine_size");
+  ink_freelist_init_magazines(magazine_size);
+
   REC_ReadConfigInteger(config_max_iobuffer_size, "proxy.config.io.max_buffer_size");
 
   max_iobuffer_size = buffer_size_to_index(config_max_iobuffer_size, DEFAULT_BUFFER_SIZES - 1);
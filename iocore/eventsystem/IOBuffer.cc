@@ -32,30 +32,78 @@
 // General Buffer Allocator
 //
 inkcoreapi Allocator ioBufAllocator[DEFAULT_BUFFER_SIZES];
+inkcoreapi Allocator (*ioBufNodeAllocator)[DEFAULT_BUFFER_SIZES] = nullptr;
 inkcoreapi ClassAllocator<MIOBuffer> ioAllocator("ioAllocator", DEFAULT_BUFFER_NUMBER);
 inkcoreapi ClassAllocator<IOBufferData> ioDataAllocator("ioDataAllocator", DEFAULT_BUFFER_NUMBER);
 inkcoreapi ClassAllocator<IOBufferBlock> ioBlockAllocator("ioBlockAllocator", DEFAULT_BUFFER_NUMBER);
 int64_t default_large_iobuffer_size = DEFAULT_LARGE_BUFFER_SIZE;
 int64_t default_small_iobuffer_size = DEFAULT_SMALL_BUFFER_SIZE;
 int64_t max_iobuffer_size           = DEFAULT_BUFFER_SIZES - 1;
+static int iobuffer_allocator_advice  = 0;
 
 //
 // Initialization
 //
+static void
+init_buffer_allocator(Allocator &allocator, int i, const char *name, int iobuffer_advice)
+{
+  int64_t s = DEFAULT_BUFFER_BASE_SIZE * ((static_cast<int64_t>(1)) << i);
+  int64_t a = DEFAULT_BUFFER_ALIGNMENT;
+  int n     = i <= default_large_iobuffer_size ? DEFAULT_BUFFER_NUMBER : DEFAULT_HUGE_BUFFER_NUMBER;
+  if (s < a) {
+    a = s;
+  }
+  allocator.re_init(name, s, n, a, iobuffer_advice);
+}
+
 void
 init_buffer_allocators(int iobuffer_advice)
 {
+  iobuffer_allocator_advice = iobuffer_advice;
   for (int i = 0; i < DEFAULT_BUFFER_SIZES; i++) {
-    int64_t s = DEFAULT_BUFFER_BASE_SIZE * ((static_cast<int64_t>(1)) << i);
-    int64_t a = DEFAULT_BUFFER_ALIGNMENT;
-    int n     = i <= default_large_iobuffer_size ? DEFAULT_BUFFER_NUMBER : DEFAULT_HUGE_BUFFER_NUMBER;
-    if (s < a) {
-      a = s;
-    }
-
     auto name = new char[64];
     snprintf(name, 64, "ioBufAllocator[%d]", i);
-    ioBufAllocator[i].re_init(name, s, n, a, iobuffer_advice);
+    init_buffer_allocator(ioBufAllocator[i], i, name, iobuffer_advice);
+  }
+}
+
+// Each event thread bound to a node allocates from, and the memory is first touched on, that
+// node. Buffers go back to the allocator of the node they came from wherever they are freed.
+void
+init_numa_buffer_allocators(int n_nodes)
+{
+  ioBufNodeAllocator = new Allocator[n_nodes][DEFAULT_BUFFER_SIZES];
+  for (int node = 0; node < n_nodes; node++) {
+    for (int i = 0; i < DEFAULT_BUFFER_SIZES; i++) {
+      auto name = new char[64];
+      snprintf(name, 64, "ioBufAllocator[%d]/node%d", i, node);
+      init_buffer_allocator(ioBufNodeAllocator[node][i], i, name, iobuffer_allocator_advice);
+    }
+  }
+}
+
+// Read @a bytes of the file range under @a b, from @a offset past its start,
+// for a consumer that needs them in memory.
+static void
+read_file_range(char *p, const IOBufferBlock *b, int64_t offset, int64_t bytes)
+{
+  ink_assert(b->is_file_range());
+  int fd   = b->data->_fd;
+  off_t at = b->file_offset() + offset;
+  while (bytes > 0) {
+    ssize_t n = ::pread(fd, p, bytes, at);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      Warning("failed to read %" PRId64 " bytes of a file range at %" PRId64 ": %s", bytes, static_cast<int64_t>(at),
+              n < 0 ? strerror(errno) : "end of file");
+      memset(p, 0, bytes);
+      return;
+    }
+    p += n;
+    at += n;
+    bytes -= n;
   }
 }
 
@@ -121,9 +169,18 @@ MIOBuffer::write(IOBufferBlock const *b, int64_t alen, int64_t offset)
     } else {
       bytes = len;
     }
-    IOBufferBlock *bb = b->clone();
-    bb->_start += offset;
-    bb->_buf_end = bb->_end = bb->_start + bytes;
+    IOBufferBlock *bb;
+    if (b->is_file_range()) {
+      // whoever reads this buffer may not know about file ranges
+      bb = new_IOBufferBlock();
+      bb->alloc(iobuffer_size_to_index(bytes, MAX_BUFFER_SIZE_INDEX));
+      read_file_range(bb->end(), b, offset, bytes);
+      bb->fill(bytes);
+    } else {
+      bb = b->clone();
+      bb->_start += offset;
+      bb->_buf_end = bb->_end = bb->_start + bytes;
+    }
     append_block(bb);
     offset = 0;
     len -= bytes;
@@ -168,7 +225,11 @@ IOBufferReader::read(void *ab, int64_t len)
     if (n < l) {
       l = n;
     }
-    ::memcpy(b, start(), l);
+    if (block->is_file_range()) {
+      read_file_range(b, block.get(), start_offset, l);
+    } else {
+      ::memcpy(b, start(), l);
+    }
     consume(l);
     b += l;
     n -= l;
@@ -235,7 +296,11 @@ IOBufferReader::memcpy(void *ap, int64_t len, int64_t offset)
     } else {
       bytes = len;
     }
-    ::memcpy(p, b->start() + offset, bytes);
+    if (b->is_file_range()) {
+      read_file_range(p, b, offset, bytes);
+    } else {
+      ::memcpy(p, b->start() + offset, bytes);
+    }
     p += bytes;
     len -= bytes;
     b      = b->next.get();
@@ -313,6 +313,14 @@ public:
   ProtectedQueue EventQueueExternal;
   PriorityEventQueue EventQueue;
 
+  /** Immediate events of a work stealing thread group, see EventProcessor::enable_work_stealing. */
+  TaskDeque TaskQueue;
+  EventType steal_etype = -1; ///< Group to steal from, -1 if this thread does not steal.
+  uint64_t tasks_stolen = 0;  ///< Events taken from other threads of the group.
+
+  /// NUMA node this thread's CPUs are on, -1 if NUMA placement is off or they span nodes.
+  int numa_node = -1;
+
   static constexpr int NO_ETHREAD_ID = -1;
   int id                             = NO_ETHREAD_ID;
   unsigned int event_types           = 0;
@@ -325,6 +333,10 @@ public:
   void execute_regular();
   void process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_count);
   void process_event(Event *e, int calling_code);
+  int process_tasks();
+  void run_task(Event *e);
+  Event *steal_task();
+  bool task_available();
   void free_event(Event *e);
   LoopTailHandler *tail_cb = &DEFAULT_TAIL_HANDLER;
 
@@ -475,3 +487,4 @@ operator new(size_t, ink_dummy_for_new *p)
 extern EThread *this_ethread();
 
 extern int thread_max_heartbeat_mseconds;
+extern int thread_timer_wheel;
@@ -305,6 +305,7 @@ public:
     Que(Event, link) _spawnQueue;                    ///< Events to dispatch when thread is spawned.
     EThread *_thread[MAX_THREADS_IN_EACH_TYPE] = {}; ///< The actual threads in this group.
     std::function<void()> _afterStartCallback  = nullptr;
+    bool _work_stealing                        = false; ///< Idle threads take immediate events from busy ones.
   };
 
   /// Storage for per group data.
@@ -323,6 +324,25 @@ public:
 
   bool has_tg_started(int etype);
 
+  /** Let idle threads of the group @a etype run immediate events queued to its busy threads.
+
+      Must be called before the group is spawned. Continuations scheduled on such a group
+      without a mutex may then run on two threads at once.
+  */
+  void enable_work_stealing(EventType etype);
+
+  /// Wake a thread to run an event just pushed to the task queue of @a t.
+  void signal_task_thread(EThread *t);
+
+  /// Number of NUMA nodes memory is placed on, 0 unless proxy.config.exec_thread.numa is set.
+  int n_numa_nodes = 0;
+
+  /// Round robin over the threads of @a etype on NUMA node @a numa_node, or all of them if none is.
+  EThread *assign_thread(EventType etype, int numa_node);
+
+  /// NUMA node of the CPU the caller is running on, -1 if unknown or NUMA placement is off.
+  int current_numa_node() const;
+
   /*------------------------------------------------------*\
   | Unix & non NT Interface                                |
   \*------------------------------------------------------*/
@@ -114,8 +114,11 @@ enum AllocType {
 #define BUFFER_SIZE_INDEX_FOR_CONSTANT_SIZE(_size) (_size + DEFAULT_BUFFER_SIZES)
 
 inkcoreapi extern Allocator ioBufAllocator[DEFAULT_BUFFER_SIZES];
+/// Copies of ioBufAllocator per NUMA node, null unless NUMA placement is on.
+inkcoreapi extern Allocator (*ioBufNodeAllocator)[DEFAULT_BUFFER_SIZES];
 
 void init_buffer_allocators(int iobuffer_advice);
+void init_numa_buffer_allocators(int n_nodes);
 
 /**
   A reference counted wrapper around fast allocated or malloced memory.
@@ -200,6 +203,35 @@ public:
 
   */
   operator char *() { return _data; }
+
+  /// Whether this describes a range of a file rather than memory, see '_fd'.
+  bool
+  is_file_range() const
+  {
+    return _fd >= 0;
+  }
+
+  /**
+    Holds a file range for a send, see '_fd_hold'.
+
+    @return false if the range may no longer be sent.
+
+  */
+  bool
+  hold_file_range()
+  {
+    return _fd_hold == nullptr || _fd_hold(_fd_cookie);
+  }
+
+  /// Ends a send started with hold_file_range.
+  void
+  unhold_file_range()
+  {
+    if (_fd_unhold) {
+      _fd_unhold(_fd_cookie);
+    }
+  }
+
   /**
     Frees the IOBufferData object and its underlying memory. Deallocates
     the memory managed by this IOBufferData and then frees itself. You
@@ -219,6 +251,9 @@ public:
   */
   AllocType _mem_type = NO_ALLOC;
 
+  /// NUMA node of the fast allocator the memory came from, -1 for ioBufAllocator.
+  int _numa_node = -1;
+
   /**
     Points to the allocated memory. This member stores the address of
     the allocated memory. You should not modify its value directly,
@@ -227,6 +262,36 @@ public:
   */
   char *_data = nullptr;
 
+  /**
+    File descriptor holding the bytes when this IOBufferData describes a
+    range of a file rather than memory, -1 otherwise. A file range has no
+    '_data'; only a writer that sends it with sendfile may consume it, see
+    new_file_IOBufferData.
+
+  */
+  int _fd = -1;
+
+  /// Offset in '_fd' of the first byte of the range.
+  off_t _fd_offset = 0;
+
+  /**
+    Called with '_fd_cookie' when a file range is freed, so the owner of
+    the file knows the range has been sent and may be overwritten.
+
+  */
+  void (*_fd_release)(void *cookie) = nullptr;
+  void *_fd_cookie                  = nullptr;
+
+  /**
+    Called with '_fd_cookie' before and after each send of a file range.
+    A false return from '_fd_hold' means the owner of the file has taken
+    the range back, it must not be sent and the connection is failed.
+    Otherwise the owner leaves the range alone until '_fd_unhold'.
+
+  */
+  bool (*_fd_hold)(void *cookie)   = nullptr;
+  void (*_fd_unhold)(void *cookie) = nullptr;
+
   const char *_location = nullptr;
 
   /**
@@ -341,6 +406,26 @@ public:
     return (int64_t)(_buf_end - _end);
   }
 
+  /**
+    Whether the block is over a file range, see new_file_IOBufferData.
+    There is no memory behind the pointers of such a block, only the
+    distances between them mean anything. Its bytes are sent from, or
+    read from, the file at file_offset().
+
+  */
+  bool
+  is_file_range() const
+  {
+    return data && data->is_file_range();
+  }
+
+  /// Offset in the file of the start of the inuse area of a file range block.
+  off_t
+  file_offset() const
+  {
+    return data->_fd_offset + (_start - data->_data);
+  }
+
   /**
     Size of the memory allocated by the underlying IOBufferData.
     Computes the size of the entire block, which includes the used and
@@ -620,7 +705,8 @@ public:
   /**
     Start of unconsumed data. Returns a pointer to first unconsumed data
     on the buffer for this reader. A null pointer indicates no data is
-    available. It uses the current start_offset value.
+    available. It uses the current start_offset value. Not for a block
+    over a file range, see IOBufferBlock::is_file_range.
 
     @return pointer to the start of the unconsumed data.
 
@@ -631,7 +717,7 @@ public:
     End of inuse area of the first block with unconsumed data. Returns a
     pointer to the end of the first block with unconsumed data for this
     reader. A nullptr pointer indicates there are no blocks with unconsumed
-    data for this reader.
+    data for this reader. Not for a block over a file range.
 
     @return pointer to the end of the first block with unconsumed data.
 
@@ -667,7 +753,8 @@ public:
   /**
     Amount of data available in the first buffer with data for this
     reader.  Returns the number of unconsumed bytes of data available
-    on the first IOBufferBlock with data for this reader.
+    on the first IOBufferBlock with data for this reader. This is valid
+    for a file range too, whose bytes are then read with memcpy or read.
 
     @return number of unconsumed bytes of data available in the first
       buffer.
@@ -1357,6 +1444,10 @@ extern IOBufferData *new_IOBufferData_internal(const char *location, int64_t siz
 
 extern IOBufferData *new_xmalloc_IOBufferData_internal(const char *location, void *b, int64_t size);
 
+extern IOBufferData *new_file_IOBufferData_internal(const char *location, int fd, off_t offset, int64_t size,
+                                                    void (*release)(void *cookie) = nullptr, void *cookie = nullptr,
+                                                    bool (*hold)(void *cookie) = nullptr, void (*unhold)(void *cookie) = nullptr);
+
 class IOBufferData_tracker
 {
   const char *loc;
@@ -1373,6 +1464,8 @@ public:
 // TODO: remove new_xmalloc_IOBufferData. Because ats_xmalloc() doesn't exist anymore.
 #define new_IOBufferData IOBufferData_tracker(RES_PATH("memory/IOBuffer/"))
 #define new_xmalloc_IOBufferData(b, size) new_xmalloc_IOBufferData_internal(RES_PATH("memory/IOBuffer/"), (b), (size))
+#define new_file_IOBufferData(fd, offset, size, ...) \
+  new_file_IOBufferData_internal(RES_PATH("memory/IOBuffer/"), (fd), (offset), (size), ##__VA_ARGS__)
 
 extern int64_t iobuffer_size_to_index(int64_t size, int64_t max = max_iobuffer_size);
 extern int64_t index_to_buffer_size(int64_t idx);
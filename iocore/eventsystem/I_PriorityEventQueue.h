@@ -30,16 +30,58 @@
 #define N_PQ_LIST 10
 #define PQ_BUCKET_TIME(_i) (HRTIME_MSECONDS(5) << (_i))
 
+// 4 wheels of 256 slots of 1ms: 256ms, 65s, 4.6h, 49d
+#define TW_TICK HRTIME_MSECONDS(1)
+#define TW_BITS 8
+#define TW_SLOTS (1 << TW_BITS)
+#define TW_MASK (TW_SLOTS - 1)
+#define TW_LEVELS 4
+#define TW_READY (TW_LEVELS * TW_SLOTS) // slot index of the ready list
+
 class EThread;
 
+/**
+  Hierarchical timing wheel.
+
+  An event is filed in the lowest wheel whose span covers its timeout and
+  moves down one wheel each time the wheel above turns over onto its slot,
+  so insert and remove are O(1) and an event is handled at most TW_LEVELS
+  times before it is ready. Empty slots are skipped using a bitmap. Events
+  are never ready before their timeout, and at most one tick after it.
+*/
+struct TimerWheel {
+  Que(Event, link) slots[TW_READY + 1];
+  uint64_t occupied[TW_LEVELS][TW_SLOTS / 64];
+  uint64_t tick; ///< Next tick to expire, every earlier tick has been handled.
+
+  void enqueue(Event *e);
+  void remove(Event *e);
+  Event *dequeue_ready();
+  void advance(ink_hrtime now, EThread *t);
+  ink_hrtime earliest_timeout() const;
+
+  TimerWheel(ink_hrtime now);
+
+private:
+  void file(Event *e, int slot);
+  void cascade(int level, EThread *t);
+  int next_occupied(int level, int from) const;
+  uint64_t next_tick() const;
+};
+
 struct PriorityEventQueue {
   Que(Event, link) after[N_PQ_LIST];
   ink_hrtime last_check_time;
   uint32_t last_check_buckets;
+  TimerWheel *wheel = nullptr; ///< Used instead of @a after when proxy.config.thread.timer_wheel is set.
 
   void
   enqueue(Event *e, ink_hrtime now)
   {
+    if (wheel) {
+      wheel->enqueue(e);
+      return;
+    }
     ink_hrtime t = e->timeout_at - now;
     int i        = 0;
     // equivalent but faster
@@ -88,6 +130,10 @@ struct PriorityEventQueue {
   void
   remove(Event *e)
   {
+    if (wheel) {
+      wheel->remove(e);
+      return;
+    }
     ink_assert(e->in_the_priority_queue);
     e->in_the_priority_queue = 0;
     after[e->in_heap].remove(e);
@@ -97,6 +143,9 @@ struct PriorityEventQueue {
   dequeue_ready(ink_hrtime t)
   {
     (void)t;
+    if (wheel) {
+      return wheel->dequeue_ready();
+    }
     Event *e = after[0].dequeue();
     if (e) {
       ink_assert(e->in_the_priority_queue);
@@ -110,6 +159,9 @@ struct PriorityEventQueue {
   ink_hrtime
   earliest_timeout()
   {
+    if (wheel) {
+      return wheel->earliest_timeout();
+    }
     for (int i = 0; i < N_PQ_LIST; i++) {
       if (after[i].head) {
         return last_check_time + (PQ_BUCKET_TIME(i) / 2);
@@ -119,4 +171,5 @@ struct PriorityEventQueue {
   }
 
   PriorityEventQueue();
+  ~PriorityEventQueue();
 };
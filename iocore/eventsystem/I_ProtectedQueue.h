@@ -29,11 +29,16 @@
   (2). In case the queue is empty, dequeue() sleeps for a specified
        amount of time, or until a new element is inserted, whichever
        is earlier
+  (3). Enqueueing is a single atomic push. Only the first insert after
+       the owner announces a wait signals it, later ones and inserts
+       into a busy queue do not.
 
 
  ****************************************************************************/
 #pragma once
 
+#include <atomic>
+
 #include "tscore/ink_platform.h"
 #include "I_Event.h"
 struct ProtectedQueue {
@@ -45,11 +50,51 @@ struct ProtectedQueue {
   Event *dequeue_local();
   void dequeue_external();       // Dequeue any external events.
   void wait(ink_hrtime timeout); // Wait for @a timeout nanoseconds on a condition variable if there are no events.
+  bool wake_task();              // Wake a task thread that announced a wait, false if it is busy.
 
   InkAtomicList al;
   ink_mutex lock;
   ink_cond might_have_data;
   Que(Event, link) localQueue;
+  std::atomic<bool> sleeping{false}; ///< Set by the owner before it waits, cleared by the enqueue that wakes it.
+
+  /** Wait state of a work stealing thread, see @c wake_task.
+
+      The owner moves from @c TASK_ANNOUNCED to @c TASK_WAITING under @c lock right before the
+      condition wait, so a waker either stops the wait before it starts or needs the lock only
+      until the owner is inside it.
+  */
+  enum TaskWait : int {
+    TASK_BUSY,       ///< Running, finds new tasks on its own.
+    TASK_ANNOUNCED,  ///< About to wait.
+    TASK_WAITING,    ///< In the condition wait or about to enter it.
+    TASK_SIGNALLING, ///< A waker is taking the lock to signal.
+    TASK_WOKEN,      ///< Told about a task, does not wait.
+  };
+  std::atomic<int> task_wait{TASK_BUSY};
 
   ProtectedQueue();
 };
+
+/** Immediate events for one thread of a work stealing thread group.
+
+    Any thread may push. The owner and idle threads of the same group all
+    pop from the front, so the event that has waited longest runs next
+    wherever it runs. Cancelled events are freed on pop.
+*/
+struct TaskDeque {
+  void push(Event *e);
+  Event *pop();
+
+  int
+  size() const
+  {
+    return _size.load();
+  }
+
+  ink_mutex lock;
+  Que(Event, link) queue;
+  std::atomic<int> _size{0};
+
+  TaskDeque();
+};
@@ -27,11 +27,25 @@ PriorityEventQueue::PriorityEventQueue()
 {
   last_check_time    = Thread::get_hrtime_updated();
   last_check_buckets = last_check_time / PQ_BUCKET_TIME(0);
+  if (thread_timer_wheel) {
+    wheel = new TimerWheel(last_check_time);
+  }
+}
+
+PriorityEventQueue::~PriorityEventQueue()
+{
+  delete wheel;
 }
 
 void
 PriorityEventQueue::check_ready(ink_hrtime now, EThread *t)
 {
+  if (wheel) {
+    last_check_time = now;
+    wheel->advance(now, t);
+    return;
+  }
+
   int i, j, k = 0;
   uint32_t check_buckets = static_cast<uint32_t>(now / PQ_BUCKET_TIME(0));
   uint32_t todo_buckets  = check_buckets ^ last_check_buckets;
@@ -62,3 +76,176 @@ PriorityEventQueue::check_ready(ink_hrtime now, EThread *t)
     }
   }
 }
+
+/*-------------------------------------------------------------------------
+  -------------------------------------------------------------------------*/
+
+TimerWheel::TimerWheel(ink_hrtime now)
+{
+  memset(occupied, 0, sizeof(occupied));
+  tick = static_cast<uint64_t>(now / TW_TICK);
+}
+
+void
+TimerWheel::file(Event *e, int slot)
+{
+  e->in_the_priority_queue = 1;
+  e->in_heap               = slot;
+  slots[slot].enqueue(e);
+  if (slot < TW_READY) {
+    occupied[slot / TW_SLOTS][(slot % TW_SLOTS) / 64] |= uint64_t(1) << (slot % 64);
+  }
+}
+
+void
+TimerWheel::enqueue(Event *e)
+{
+  // round up so an event is never ready before its timeout
+  uint64_t when = static_cast<uint64_t>((e->timeout_at + TW_TICK - 1) / TW_TICK);
+
+  if (e->timeout_at <= 0 || when < tick) {
+    file(e, TW_READY);
+    return;
+  }
+
+  uint64_t delta = when - tick;
+  int level      = 0;
+  while (level < TW_LEVELS - 1 && delta >= (uint64_t(1) << (TW_BITS * (level + 1)))) {
+    ++level;
+  }
+  if (delta >= (uint64_t(1) << (TW_BITS * TW_LEVELS))) {
+    // beyond the top wheel, park in its furthest slot and re-file on cascade
+    when = tick + (uint64_t(1) << (TW_BITS * TW_LEVELS)) - 1;
+  }
+  file(e, level * TW_SLOTS + static_cast<int>((when >> (TW_BITS * level)) & TW_MASK));
+}
+
+void
+TimerWheel::remove(Event *e)
+{
+  ink_assert(e->in_the_priority_queue);
+  int slot                 = e->in_heap;
+  e->in_the_priority_queue = 0;
+  slots[slot].remove(e);
+  if (slot < TW_READY && slots[slot].empty()) {
+    occupied[slot / TW_SLOTS][(slot % TW_SLOTS) / 64] &= ~(uint64_t(1) << (slot % 64));
+  }
+}
+
+Event *
+TimerWheel::dequeue_ready()
+{
+  Event *e = slots[TW_READY].dequeue();
+  if (e) {
+    ink_assert(e->in_the_priority_queue);
+    e->in_the_priority_queue = 0;
+  }
+  return e;
+}
+
+/// @return the first occupied slot index >= @a from in wheel @a level, or TW_SLOTS.
+int
+TimerWheel::next_occupied(int level, int from) const
+{
+  for (int w = from / 64; w < TW_SLOTS / 64; ++w) {
+    uint64_t bits = occupied[level][w];
+    if (w == from / 64) {
+      bits &= ~uint64_t(0) << (from % 64);
+    }
+    if (bits) {
+      return w * 64 + __builtin_ctzll(bits);
+    }
+  }
+  return TW_SLOTS;
+}
+
+/// Re-file the events of the wheel @a level slot that @a tick has just turned over onto.
+void
+TimerWheel::cascade(int level, EThread *t)
+{
+  int idx = static_cast<int>((tick >> (TW_BITS * level)) & TW_MASK);
+
+  if (idx == 0 && level + 1 < TW_LEVELS) {
+    cascade(level + 1, t);
+  }
+
+  int slot           = level * TW_SLOTS + idx;
+  Que(Event, link) q = slots[slot];
+  slots[slot].clear();
+  occupied[level][idx / 64] &= ~(uint64_t(1) << (idx % 64));
+
+  Event *e;
+  while ((e = q.dequeue()) != nullptr) {
+    if (e->cancelled) {
+      e->in_the_priority_queue = 0;
+      e->cancelled             = 0;
+      EVENT_FREE(e, eventAllocator, t);
+    } else {
+      enqueue(e);
+    }
+  }
+}
+
+void
+TimerWheel::advance(ink_hrtime now, EThread *t)
+{
+  uint64_t target = static_cast<uint64_t>(now / TW_TICK);
+
+  while (tick <= target) {
+    int idx = static_cast<int>(tick & TW_MASK);
+    if (idx == 0) {
+      cascade(1, t);
+    }
+
+    if (occupied[0][idx / 64] & (uint64_t(1) << (idx % 64))) {
+      Event *e;
+      while ((e = slots[idx].dequeue()) != nullptr) {
+        file(e, TW_READY);
+      }
+      occupied[0][idx / 64] &= ~(uint64_t(1) << (idx % 64));
+    }
+
+    tick = std::min(next_tick(), target + 1);
+  }
+}
+
+/// @return the next tick after @a tick that has events to expire or a slot to cascade.
+uint64_t
+TimerWheel::next_tick() const
+{
+  for (int level = 0; level < TW_LEVELS; ++level) {
+    int shift     = TW_BITS * level;
+    uint64_t turn = (tick >> shift) & ~uint64_t(TW_MASK);
+    int idx       = static_cast<int>((tick >> shift) & TW_MASK);
+
+    int next = idx + 1 < TW_SLOTS ? next_occupied(level, idx + 1) : TW_SLOTS;
+    if (next < TW_SLOTS) {
+      return (turn + next) << shift;
+    }
+    // Slots before idx belong to the next turn of this wheel.
+    if (next_occupied(level, 0) < TW_SLOTS) {
+      return (turn + TW_SLOTS) << shift;
+    }
+    // This wheel is empty, only the ones above can bring anything in.
+  }
+  return UINT64_MAX;
+}
+
+ink_hrtime
+TimerWheel::earliest_timeout() const
+{
+  // tick itself has not been expired yet, and on a wheel boundary it has a cascade due
+  int idx = static_cast<int>(tick & TW_MASK);
+  if (!slots[TW_READY].empty() || (occupied[0][idx / 64] & (uint64_t(1) << (idx % 64)))) {
+    return static_cast<ink_hrtime>(tick) * TW_TICK;
+  }
+
+  uint64_t next = next_tick();
+  if (next == UINT64_MAX) {
+    return static_cast<ink_hrtime>(tick) * TW_TICK + HRTIME_FOREVER;
+  }
+  if (idx == 0) {
+    next = tick;
+  }
+  return static_cast<ink_hrtime>(next) * TW_TICK;
+}
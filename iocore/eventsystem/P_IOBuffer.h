@@ -202,6 +202,7 @@ new_IOBufferData_internal(const char *location, void *b, int64_t size, int64_t a
   (void)size;
   IOBufferData *d = THREAD_ALLOC(ioDataAllocator, this_thread());
   d->_size_index  = asize_index;
+  d->_numa_node   = -1;
   ink_assert(BUFFER_SIZE_INDEX_IS_CONSTANT(asize_index) || size <= d->block_size());
   d->_location = location;
   d->_data     = (char *)b;
@@ -214,6 +215,28 @@ new_xmalloc_IOBufferData_internal(const char *location, void *b, int64_t size)
   return new_IOBufferData_internal(location, b, size, BUFFER_SIZE_INDEX_FOR_XMALLOC_SIZE(size));
 }
 
+/*
+  A range of a file, sent from the file by the network write path instead
+  of from memory. The blocks built on it have no bytes behind their start
+  and end pointers, so the range may only be handed to a buffer whose sole
+  consumer is a plain UnixNetVConnection. @a release is called with
+  @a cookie once the range is freed, @a hold and @a unhold around each
+  send of it.
+*/
+TS_INLINE IOBufferData *
+new_file_IOBufferData_internal(const char *location, int fd, off_t offset, int64_t size, void (*release)(void *cookie),
+                               void *cookie, bool (*hold)(void *cookie), void (*unhold)(void *cookie))
+{
+  IOBufferData *d = new_IOBufferData_internal(location, nullptr, size, BUFFER_SIZE_INDEX_FOR_CONSTANT_SIZE(size));
+  d->_fd          = fd;
+  d->_fd_offset   = offset;
+  d->_fd_release  = release;
+  d->_fd_cookie   = cookie;
+  d->_fd_hold     = hold;
+  d->_fd_unhold   = unhold;
+  return d;
+}
+
 TS_INLINE IOBufferData *
 new_IOBufferData_internal(const char *location, void *b, int64_t size)
 {
@@ -229,6 +252,12 @@ new_IOBufferData_internal(const char *loc, int64_t size_index, AllocType type)
   return d;
 }
 
+TS_INLINE Allocator &
+iobuffer_allocator(int64_t size_index, int numa_node)
+{
+  return numa_node < 0 ? ioBufAllocator[size_index] : ioBufNodeAllocator[numa_node][size_index];
+}
+
 // IRIX has a compiler bug which prevents this function
 // from being compiled correctly at -O3
 // so it is DUPLICATED in IOBuffer.cc
@@ -241,11 +270,16 @@ IOBufferData::alloc(int64_t size_index, AllocType type)
   }
   _size_index = size_index;
   _mem_type   = type;
+  _numa_node  = -1;
+  if (ioBufNodeAllocator != nullptr) {
+    EThread *t = this_ethread();
+    _numa_node = t ? t->numa_node : -1;
+  }
   iobuffer_mem_inc(_location, size_index);
   switch (type) {
   case MEMALIGNED:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(size_index)) {
-      _data = (char *)ioBufAllocator[size_index].alloc_void();
+      _data = (char *)iobuffer_allocator(size_index, _numa_node).alloc_void();
       // coverity[dead_error_condition]
     } else if (BUFFER_SIZE_INDEX_IS_XMALLOCED(size_index)) {
       _data = (char *)ats_memalign(ats_pagesize(), index_to_buffer_size(size_index));
@@ -254,7 +288,7 @@ IOBufferData::alloc(int64_t size_index, AllocType type)
   default:
   case DEFAULT_ALLOC:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(size_index)) {
-      _data = (char *)ioBufAllocator[size_index].alloc_void();
+      _data = (char *)iobuffer_allocator(size_index, _numa_node).alloc_void();
     } else if (BUFFER_SIZE_INDEX_IS_XMALLOCED(size_index)) {
       _data = (char *)ats_malloc(BUFFER_SIZE_FOR_XMALLOC(size_index));
     }
@@ -271,7 +305,7 @@ IOBufferData::dealloc()
   switch (_mem_type) {
   case MEMALIGNED:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(_size_index)) {
-      ioBufAllocator[_size_index].free_void(_data);
+      iobuffer_allocator(_size_index, _numa_node).free_void(_data);
     } else if (BUFFER_SIZE_INDEX_IS_XMALLOCED(_size_index)) {
       ::free((void *)_data);
     }
@@ -279,7 +313,7 @@ IOBufferData::dealloc()
   default:
   case DEFAULT_ALLOC:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(_size_index)) {
-      ioBufAllocator[_size_index].free_void(_data);
+      iobuffer_allocator(_size_index, _numa_node).free_void(_data);
     } else if (BUFFER_SIZE_INDEX_IS_XMALLOCED(_size_index)) {
       ats_free(_data);
     }
@@ -288,6 +322,16 @@ IOBufferData::dealloc()
   _data       = nullptr;
   _size_index = BUFFER_SIZE_NOT_ALLOCATED;
   _mem_type   = NO_ALLOC;
+  _numa_node  = -1;
+  _fd         = -1;
+  _fd_offset  = 0;
+  _fd_hold    = nullptr;
+  _fd_unhold  = nullptr;
+  if (_fd_release) {
+    _fd_release(_fd_cookie);
+    _fd_release = nullptr;
+    _fd_cookie  = nullptr;
+  }
 }
 
 TS_INLINE void
@@ -473,6 +517,7 @@ IOBufferReader::start()
   }
 
   skip_empty_blocks();
+  ink_assert(!block->is_file_range());
   return block->start() + start_offset;
 }
 
@@ -484,6 +529,7 @@ IOBufferReader::end()
   }
 
   skip_empty_blocks();
+  ink_assert(!block->is_file_range());
   return block->end();
 }
 
@@ -116,7 +116,12 @@ EventProcessor::schedule(Event *e, EventType etype)
   if (e->continuation->mutex) {
     e->mutex = e->continuation->mutex;
   }
-  e->ethread->EventQueueExternal.enqueue(e);
+  if (e->timeout_at == 0 && e->ethread->steal_etype >= 0) {
+    e->ethread->TaskQueue.push(e);
+    signal_task_thread(e->ethread);
+  } else {
+    e->ethread->EventQueueExternal.enqueue(e);
+  }
   return e;
 }
 
@@ -35,6 +35,10 @@
 #include "tscore/ink_sock.h"
 #include "I_SocketManager.h"
 
+#if defined(linux)
+#include <sys/sendfile.h>
+#endif
+
 //
 // These limits are currently disabled
 //
@@ -233,6 +237,27 @@ SocketManager::writev(int fd, struct iovec *vector, size_t count)
   return r;
 }
 
+TS_INLINE int64_t
+SocketManager::sendfile(int fd, int in_fd, off_t offset, size_t count)
+{
+#if defined(linux)
+  int64_t r;
+  do {
+    if (likely((r = ::sendfile(fd, in_fd, &offset, count)) >= 0)) {
+      break;
+    }
+    r = -errno;
+  } while (transient_error());
+  return r;
+#else
+  (void)fd;
+  (void)in_fd;
+  (void)offset;
+  (void)count;
+  return -ENOTSUP;
+#endif
+}
+
 TS_INLINE int64_t
 SocketManager::write_vector(int fd, struct iovec *vector, size_t count, void *pOLP)
 {
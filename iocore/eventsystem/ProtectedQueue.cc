@@ -47,17 +47,13 @@ void
 ProtectedQueue::enqueue(Event *e)
 {
   ink_assert(!e->in_the_prot_queue && !e->in_the_priority_queue);
-  EThread *e_ethread   = e->ethread;
   e->in_the_prot_queue = 1;
-  bool was_empty       = (ink_atomiclist_push(&al, e) == nullptr);
-
-  if (was_empty) {
-    EThread *inserting_thread = this_ethread();
-    // queue e->ethread in the list of threads to be signalled
-    // inserting_thread == 0 means it is not a regular EThread
-    if (inserting_thread != e_ethread) {
-      e_ethread->tail_cb->signalActivity();
-    }
+  ink_atomiclist_push(&al, e);
+
+  // Only the first enqueue after the owner announced a wait has to wake it. A busy owner finds
+  // the event before it next waits, so in the common case this is the push and a load.
+  if (sleeping.load() && sleeping.exchange(false)) {
+    e->ethread->tail_cb->signalActivity();
   }
 }
 
@@ -76,8 +72,7 @@ ProtectedQueue::dequeue_external()
     if (!e->cancelled) {
       localQueue.enqueue(e);
     } else {
-      e->mutex = nullptr;
-      eventAllocator.free(e);
+      EVENT_FREE(e, eventAllocator, this_ethread());
     }
   }
 }
@@ -92,7 +87,80 @@ ProtectedQueue::wait(ink_hrtime timeout)
    *   - The `EThread::lock` will be locked again when the Event Thread wakes up.
    */
   if (INK_ATOMICLIST_EMPTY(al)) {
+    // A work stealing thread waits only if no task was handed to it since it announced the wait.
+    int state = TASK_ANNOUNCED;
+    if (!task_wait.compare_exchange_strong(state, TASK_WAITING) && state != TASK_BUSY) {
+      return;
+    }
     timespec ts = ink_hrtime_to_timespec(timeout);
     ink_cond_timedwait(&might_have_data, &lock, &ts);
+
+    // A waker that got in as the wait ended is after the lock, let it through.
+    state = TASK_WAITING;
+    if (!task_wait.compare_exchange_strong(state, TASK_BUSY) && state == TASK_SIGNALLING) {
+      while (task_wait.load() == TASK_SIGNALLING) {
+        ink_cond_wait(&might_have_data, &lock);
+      }
+    }
+  }
+}
+
+bool
+ProtectedQueue::wake_task()
+{
+  int state = TASK_ANNOUNCED;
+  if (task_wait.compare_exchange_strong(state, TASK_WOKEN)) {
+    // Seen by the owner before it waits.
+    return true;
+  }
+  if (state == TASK_WAITING && task_wait.compare_exchange_strong(state, TASK_SIGNALLING)) {
+    // The owner holds the lock only until it is inside a condition wait, so this does not block
+    // behind a busy thread.
+    ink_mutex_acquire(&lock);
+    task_wait = TASK_WOKEN;
+    ink_cond_signal(&might_have_data);
+    ink_mutex_release(&lock);
+    return true;
+  }
+  // Already being woken, or busy.
+  return state == TASK_SIGNALLING || state == TASK_WOKEN;
+}
+
+TaskDeque::TaskDeque()
+{
+  ink_mutex_init(&lock);
+}
+
+void
+TaskDeque::push(Event *e)
+{
+  ink_assert(!e->in_the_prot_queue && !e->in_the_priority_queue);
+  ink_mutex_acquire(&lock);
+  e->in_the_prot_queue = 1;
+  queue.enqueue(e);
+  ++_size;
+  ink_mutex_release(&lock);
+}
+
+Event *
+TaskDeque::pop()
+{
+  Event *e;
+
+  for (;;) {
+    if (_size.load() == 0) {
+      return nullptr;
+    }
+    ink_mutex_acquire(&lock);
+    if ((e = queue.dequeue()) != nullptr) {
+      --_size;
+      e->in_the_prot_queue = 0;
+    }
+    ink_mutex_release(&lock);
+    if (e == nullptr || !e->cancelled) {
+      return e;
+    }
+    // A stolen event goes back through the proxy allocator of the thread that popped it.
+    EVENT_FREE(e, eventAllocator, this_ethread());
   }
 }
@@ -27,6 +27,37 @@
 EventType ET_TASK = ET_CALL;
 TasksProcessor tasksProcessor;
 
+namespace
+{
+enum {
+  TASK_STAT_QUEUE_DEPTH,
+  TASK_STAT_STEALS,
+  N_TASK_STATS,
+};
+
+int
+TaskStatSync(const char *, RecDataT, RecData *, RecRawStatBlock *rsb, int)
+{
+  int64_t depth  = 0;
+  int64_t steals = 0;
+
+  for (EThread *t : eventProcessor.active_group_threads(ET_TASK)) {
+    depth += t->TaskQueue.size();
+    steals += t->tasks_stolen;
+  }
+
+  ink_mutex_acquire(&(rsb->mutex));
+  rsb->global[TASK_STAT_QUEUE_DEPTH]->sum   = depth;
+  rsb->global[TASK_STAT_QUEUE_DEPTH]->count = 1;
+  RecRawStatUpdateSum(rsb, TASK_STAT_QUEUE_DEPTH);
+  rsb->global[TASK_STAT_STEALS]->sum   = steals;
+  rsb->global[TASK_STAT_STEALS]->count = 1;
+  RecRawStatUpdateSum(rsb, TASK_STAT_STEALS);
+  ink_mutex_release(&(rsb->mutex));
+  return REC_ERR_OKAY;
+}
+} // namespace
+
 EventType
 TasksProcessor::register_event_type()
 {
@@ -39,6 +70,20 @@ TasksProcessor::register_event_type()
 int
 TasksProcessor::start(int task_threads, size_t stacksize)
 {
+  int work_stealing = 0;
+
+  REC_ReadConfigInteger(work_stealing, "proxy.config.task_threads.work_stealing");
+  if (work_stealing) {
+    eventProcessor.enable_work_stealing(ET_TASK);
+  }
+
+  RecRawStatBlock *rsb = RecAllocateRawStatBlock(N_TASK_STATS);
+  RecRegisterRawStat(rsb, RECT_PROCESS, "proxy.process.task_threads.queue_depth", RECD_INT, RECP_NON_PERSISTENT,
+                     TASK_STAT_QUEUE_DEPTH, nullptr);
+  RecRegisterRawStat(rsb, RECT_PROCESS, "proxy.process.task_threads.steals", RECD_INT, RECP_NON_PERSISTENT, TASK_STAT_STEALS,
+                     nullptr);
+  RecRegisterRawStatSyncCb("proxy.process.task_threads.steals", TaskStatSync, rsb, 0);
+
   eventProcessor.spawn_event_threads(ET_TASK, std::max(1, task_threads), stacksize);
   return 0;
 }
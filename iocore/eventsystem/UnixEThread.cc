@@ -50,6 +50,7 @@ char const *const EThread::STAT_NAME[] = {"proxy.process.eventloop.count",
 int const EThread::SAMPLE_COUNT[N_EVENT_TIMESCALES] = {10, 100, 1000};
 
 int thread_max_heartbeat_mseconds = THREAD_MAX_HEARTBEAT_MSECONDS;
+int thread_timer_wheel            = 0;
 
 EThread::EThread()
 {
@@ -179,6 +180,67 @@ EThread::process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_
   }
 }
 
+int
+EThread::process_tasks()
+{
+  Event *e;
+  int n = 0;
+
+  // Only what is queued now, so a thread that keeps scheduling to itself does not starve timers.
+  for (int todo = TaskQueue.size(); todo > 0 && (e = TaskQueue.pop()) != nullptr; --todo) {
+    run_task(e);
+    ++n;
+  }
+  if (n == 0 && (e = steal_task()) != nullptr) {
+    run_task(e);
+    ++n;
+  }
+  return n;
+}
+
+void
+EThread::run_task(Event *e)
+{
+  e->ethread = this;
+  if (!e->timeout_at) {
+    process_event(e, e->callback_event);
+  } else { // rescheduled while it was queued
+    EventQueueExternal.enqueue_local(e);
+  }
+}
+
+Event *
+EThread::steal_task()
+{
+  EThread *victim = nullptr;
+  int most        = 0;
+
+  for (EThread *t : eventProcessor.active_group_threads(steal_etype)) {
+    int n;
+    if (t != this && (n = t->TaskQueue.size()) > most) {
+      victim = t;
+      most   = n;
+    }
+  }
+
+  Event *e = victim ? victim->TaskQueue.pop() : nullptr;
+  if (e) {
+    ++tasks_stolen;
+  }
+  return e;
+}
+
+bool
+EThread::task_available()
+{
+  for (EThread *t : eventProcessor.active_group_threads(steal_etype)) {
+    if (t->TaskQueue.size() > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void
 EThread::execute_regular()
 {
@@ -220,6 +282,9 @@ EThread::execute_regular()
     ++(current_metric->_count);
 
     process_queue(&NegativeQueue, &ev_count, &nq_count);
+    if (steal_etype >= 0) {
+      ev_count += process_tasks();
+    }
 
     bool done_one;
     do {
@@ -263,7 +328,20 @@ EThread::execute_regular()
       sleep_time = 0;
     }
 
+    if (sleep_time > 0) {
+      // Announce the wait before the last look for work, so that an enqueue either sees this
+      // thread waiting and signals it, or is seen here.
+      EventQueueExternal.sleeping = true;
+      if (steal_etype >= 0) {
+        EventQueueExternal.task_wait = ProtectedQueue::TASK_ANNOUNCED;
+      }
+      if (!INK_ATOMICLIST_EMPTY(EventQueueExternal.al) || (steal_etype >= 0 && task_available())) {
+        sleep_time = 0;
+      }
+    }
     tail_cb->waitForActivity(sleep_time);
+    EventQueueExternal.sleeping  = false;
+    EventQueueExternal.task_wait = ProtectedQueue::TASK_BUSY;
 
     // loop cleanup
     loop_finish_time = Thread::get_hrtime_updated();
@@ -23,6 +23,7 @@
 
 #include "P_EventSystem.h"
 #include <sched.h>
+#include <vector>
 #if TS_USE_HWLOC
 #if HAVE_ALLOCA_H
 #include <alloca.h>
@@ -35,6 +36,9 @@
 /// Global singleton.
 class EventProcessor eventProcessor;
 
+/// NUMA node index of each CPU by OS index, filled in when NUMA placement is on.
+static std::vector<int> numa_node_of_cpu;
+
 class ThreadAffinityInitializer : public Continuation
 {
   using self = ThreadAffinityInitializer;
@@ -181,6 +185,24 @@ ThreadAffinityInitializer::init()
 
   obj_count = hwloc_get_nbobjs_by_type(ink_get_topology(), obj_type);
   Debug("iocore_thread", "Affinity: %d %ss: %d PU: %d", affinity, obj_name, obj_count, ink_number_of_processors());
+
+  int numa = 0;
+  REC_ReadConfigInteger(numa, "proxy.config.exec_thread.numa");
+  int n_nodes = hwloc_get_nbobjs_by_type(ink_get_topology(), HWLOC_OBJ_NODE);
+  if (numa && n_nodes > 1 && obj_count > 0) {
+    for (int i = 0; i < n_nodes; ++i) {
+      hwloc_obj_t node = hwloc_get_obj_by_type(ink_get_topology(), HWLOC_OBJ_NODE, i);
+      for (int cpu = hwloc_bitmap_first(node->cpuset); cpu >= 0; cpu = hwloc_bitmap_next(node->cpuset, cpu)) {
+        if (static_cast<size_t>(cpu) >= numa_node_of_cpu.size()) {
+          numa_node_of_cpu.resize(cpu + 1, -1);
+        }
+        numa_node_of_cpu[cpu] = i;
+      }
+    }
+    eventProcessor.n_numa_nodes = n_nodes;
+    init_numa_buffer_allocators(n_nodes);
+    Debug("iocore_thread", "NUMA placement across %d nodes", n_nodes);
+  }
 }
 
 int
@@ -200,6 +222,21 @@ ThreadAffinityInitializer::set_affinity(int, Event *)
     Debug("iocore_thread", "EThread: %d %s: %d", _name, obj->logical_index);
 #endif // HWLOC_API_VERSION
     hwloc_set_thread_cpubind(ink_get_topology(), t->tid, obj->cpuset, HWLOC_CPUBIND_STRICT);
+
+    // If the thread runs on a single node, prefer that node for everything it allocates.
+    for (int i = 0; i < eventProcessor.n_numa_nodes; ++i) {
+      hwloc_obj_t node = hwloc_get_obj_by_type(ink_get_topology(), HWLOC_OBJ_NODE, i);
+      if (hwloc_bitmap_isincluded(obj->cpuset, node->cpuset)) {
+        t->numa_node = i;
+#if HWLOC_API_VERSION >= 0x20000
+        hwloc_set_membind(ink_get_topology(), node->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET);
+#else
+        hwloc_set_membind_nodeset(ink_get_topology(), node->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD);
+#endif
+        Debug("iocore_thread", "EThread: %p NUMA node: %d", t, i);
+        break;
+      }
+    }
   } else {
     Warning("hwloc returned an unexpected number of objects -- CPU affinity disabled");
   }
@@ -376,6 +413,9 @@ EventProcessor::spawn_event_threads(EventType ev_type, int n_threads, size_t sta
     tg->_thread[i]               = t;
     t->id                        = i; // unfortunately needed to support affinity and NUMA logic.
     t->set_event_type(ev_type);
+    if (tg->_work_stealing) {
+      t->steal_etype = ev_type;
+    }
     t->schedule_spawn(&thread_initializer);
   }
   tg->_count = n_threads;
@@ -463,6 +503,57 @@ EventProcessor::shutdown()
 {
 }
 
+EThread *
+EventProcessor::assign_thread(EventType etype, int numa_node)
+{
+  ThreadGroupDescriptor *tg = &thread_group[etype];
+
+  if (numa_node >= 0) {
+    // Threads are spread over the nodes in order, so a match is a few steps away at most.
+    for (int i = 0; i < tg->_count; ++i) {
+      EThread *t = tg->_thread[++tg->_next_round_robin % tg->_count];
+      if (t->numa_node == numa_node) {
+        return t;
+      }
+    }
+  }
+  return assign_thread(etype);
+}
+
+int
+EventProcessor::current_numa_node() const
+{
+#if TS_USE_HWLOC && defined(linux)
+  if (n_numa_nodes > 0) {
+    int cpu = sched_getcpu();
+    return cpu >= 0 && static_cast<size_t>(cpu) < numa_node_of_cpu.size() ? numa_node_of_cpu[cpu] : -1;
+  }
+#endif
+  return -1;
+}
+
+void
+EventProcessor::enable_work_stealing(EventType etype)
+{
+  ink_release_assert(thread_group[etype]._count == 0);
+  thread_group[etype]._work_stealing = true;
+}
+
+void
+EventProcessor::signal_task_thread(EThread *t)
+{
+  // Wake the owner if it is waiting, otherwise an idle thread of the group to steal the event. A
+  // busy owner finds the event on its own before it next waits.
+  if (t->EventQueueExternal.wake_task()) {
+    return;
+  }
+  for (EThread *thief : active_group_threads(t->steal_etype)) {
+    if (thief->EventQueueExternal.wake_task()) {
+      break;
+    }
+  }
+}
+
 Event *
 EventProcessor::spawn_thread(Continuation *cont, const char *thr_name, size_t stacksize)
 {
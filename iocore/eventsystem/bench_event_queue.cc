@@ -0,0 +1,163 @@
+/** @file
+
+  Event thread timer queue benchmark.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+/****************************************************************************
+
+   bench_event_queue.cc
+
+   Description:
+
+   Drives a PriorityEventQueue the way an event thread full of idle
+   connections does, once with the exponential buckets and once with the
+   timing wheel, and reports the cost of each.
+
+   Usage: bench_event_queue [timers] [seconds] [resets per second]
+
+   Every timer is an inactivity timeout between 1 and 120 seconds. The
+   simulated clock advances 1ms per loop. Each loop expires and re-arms the
+   due timers and resets a share of the others, as I/O on a connection
+   does. Defaults are 1000000 timers, 30 seconds and 1000000 resets.
+
+ ****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "P_EventSystem.h"
+
+namespace
+{
+struct Rand {
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+  uint64_t
+  next()
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  ink_hrtime
+  timeout()
+  {
+    return HRTIME_SECONDS(1) + static_cast<ink_hrtime>(next() % static_cast<uint64_t>(HRTIME_SECONDS(119)));
+  }
+};
+
+struct Result {
+  double ns          = 0;
+  uint64_t expired   = 0;
+  uint64_t resets    = 0;
+  uint64_t max_early = 0;
+};
+
+Result
+run(bool wheel, int n_timers, int seconds, int resets_per_second)
+{
+  thread_timer_wheel = wheel;
+  PriorityEventQueue queue;
+  std::vector<Event> events(n_timers);
+  Rand rand;
+  Result result;
+  ink_hrtime now = queue.last_check_time;
+
+  for (auto &e : events) {
+    e.timeout_at = now + rand.timeout();
+    queue.enqueue(&e, now);
+  }
+
+  int loops         = seconds * 1000;
+  int resets_per_ms = resets_per_second / 1000;
+  ink_hrtime early  = 0;
+  auto start        = std::chrono::steady_clock::now();
+
+  for (int loop = 0; loop < loops; ++loop) {
+    now += HRTIME_MSECONDS(1);
+
+    queue.check_ready(now, nullptr);
+    Event *e;
+    while ((e = queue.dequeue_ready(now)) != nullptr) {
+      if (e->timeout_at - now > early) {
+        early = e->timeout_at - now;
+      }
+      ++result.expired;
+      e->timeout_at = now + rand.timeout();
+      queue.enqueue(e, now);
+    }
+
+    for (int i = 0; i < resets_per_ms; ++i) {
+      e = &events[rand.next() % n_timers];
+      if (e->in_the_priority_queue) {
+        queue.remove(e);
+        e->timeout_at = now + rand.timeout();
+        queue.enqueue(e, now);
+        ++result.resets;
+      }
+    }
+
+    (void)queue.earliest_timeout();
+  }
+
+  result.ns        = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  result.max_early = early;
+
+  for (auto &ev : events) {
+    if (ev.in_the_priority_queue) {
+      queue.remove(&ev);
+    }
+  }
+  return result;
+}
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  int n_timers          = argc > 1 ? atoi(argv[1]) : 1000000;
+  int seconds           = argc > 2 ? atoi(argv[2]) : 30;
+  int resets_per_second = argc > 3 ? atoi(argv[3]) : 1000000;
+
+  if (n_timers <= 0 || seconds <= 0 || resets_per_second < 0) {
+    fprintf(stderr, "Usage: %s [timers] [seconds] [resets per second]\n", argv[0]);
+    return 1;
+  }
+  printf("%d timers, %d simulated seconds, %d resets/second\n", n_timers, seconds, resets_per_second);
+
+  double buckets = 0;
+  for (bool wheel : {false, true}) {
+    Result r = run(wheel, n_timers, seconds, resets_per_second);
+    if (!wheel) {
+      buckets = r.ns;
+    }
+    uint64_t ops = r.expired + r.resets;
+    printf("%-8s %10.1f ms %8.1f ns/loop %7.1f ns/op %10" PRIu64 " expired %10" PRIu64 " reset  %5.2f ms max early %6.2fx\n",
+           wheel ? "wheel" : "buckets", r.ns / 1e6, r.ns / (seconds * 1000.0), ops ? r.ns / ops : 0.0, r.expired, r.resets,
+           static_cast<double>(r.max_early) / HRTIME_MSECOND, buckets / r.ns);
+  }
+
+  return 0;
+}
@@ -0,0 +1,198 @@
+/** @file
+
+  Cross thread event delivery benchmark.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+/****************************************************************************
+
+   bench_protected_queue.cc
+
+   Description:
+
+   Several producer threads enqueue events to the ProtectedQueue of one
+   event thread, which drains and waits on it the way EThread does. It is
+   run once with the condition variable wakeup of task threads and once
+   with the eventfd wakeup of net threads, and reports the events per
+   second delivered and how many wakeups that took.
+
+   Usage: bench_protected_queue [producers] [events per producer] [rounds]
+
+   Defaults are 4 producers, 65536 events per producer and 32 rounds.
+
+ ****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <thread>
+#include <vector>
+
+#include "P_EventSystem.h"
+
+namespace
+{
+/// Wakes the consumer through an eventfd, as NetHandler does.
+struct EventfdTailHandler : public EThread::LoopTailHandler {
+  int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  std::atomic<uint64_t> signals{0};
+
+  int
+  waitForActivity(ink_hrtime timeout) override
+  {
+    pollfd pfd = {fd, POLLIN, 0};
+    if (poll(&pfd, 1, ink_hrtime_to_msec(timeout)) > 0) {
+      uint64_t counter;
+      ATS_UNUSED_RETURN(read(fd, &counter, sizeof(counter)));
+    }
+    return 0;
+  }
+
+  void
+  signalActivity() override
+  {
+    uint64_t counter = 1;
+    ++signals;
+    ATS_UNUSED_RETURN(write(fd, &counter, sizeof(counter)));
+  }
+};
+
+/// Wakes the consumer through the queue condition variable, as the default handler does.
+struct CondTailHandler : public EThread::LoopTailHandler {
+  ProtectedQueue &q;
+  std::atomic<uint64_t> signals{0};
+
+  explicit CondTailHandler(ProtectedQueue &queue) : q(queue) {}
+
+  int
+  waitForActivity(ink_hrtime timeout) override
+  {
+    q.wait(Thread::get_hrtime() + timeout);
+    return 0;
+  }
+
+  void
+  signalActivity() override
+  {
+    ++signals;
+    (void)q.try_signal();
+  }
+};
+
+struct Result {
+  double ns      = 0;
+  uint64_t waits = 0;
+};
+
+Result
+run(EThread &target, int n_producers, int n_events, int rounds)
+{
+  ProtectedQueue &q = target.EventQueueExternal;
+  std::vector<std::vector<Event>> events(n_producers);
+  Result result;
+
+  for (auto &v : events) {
+    v = std::vector<Event>(n_events);
+    for (auto &e : v) {
+      e.ethread = &target;
+    }
+  }
+
+  ink_mutex_acquire(&q.lock);
+  auto start = std::chrono::steady_clock::now();
+
+  for (int round = 0; round < rounds; ++round) {
+    std::vector<std::thread> producers;
+    for (auto &v : events) {
+      producers.emplace_back([&v, &q]() {
+        for (auto &e : v) {
+          q.enqueue(&e);
+        }
+      });
+    }
+
+    int64_t expected = static_cast<int64_t>(n_producers) * n_events;
+    for (;;) {
+      q.dequeue_external();
+      while (q.dequeue_local() != nullptr) {
+        --expected;
+      }
+      if (expected == 0) {
+        break;
+      }
+      ink_hrtime timeout = HRTIME_MSECONDS(10);
+      q.sleeping         = true;
+      if (!INK_ATOMICLIST_EMPTY(q.al)) {
+        timeout = 0;
+      } else {
+        ++result.waits;
+      }
+      target.tail_cb->waitForActivity(timeout);
+      q.sleeping = false;
+    }
+
+    for (auto &t : producers) {
+      t.join();
+    }
+  }
+
+  result.ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  ink_mutex_release(&q.lock);
+  return result;
+}
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  int n_producers = argc > 1 ? atoi(argv[1]) : 4;
+  int n_events    = argc > 2 ? atoi(argv[2]) : 65536;
+  int rounds      = argc > 3 ? atoi(argv[3]) : 32;
+
+  if (n_producers <= 0 || n_events <= 0 || rounds <= 0) {
+    fprintf(stderr, "Usage: %s [producers] [events per producer] [rounds]\n", argv[0]);
+    return 1;
+  }
+  printf("%d producers, %d events each, %d rounds\n", n_producers, n_events, rounds);
+
+  double total = static_cast<double>(n_producers) * n_events * rounds;
+  for (bool use_eventfd : {false, true}) {
+    EThread target;
+    CondTailHandler cond(target.EventQueueExternal);
+    EventfdTailHandler evfd;
+    std::atomic<uint64_t> &signals = use_eventfd ? evfd.signals : cond.signals;
+
+    if (use_eventfd) {
+      target.tail_cb = &evfd;
+    } else {
+      target.tail_cb = &cond;
+    }
+    Result r = run(target, n_producers, n_events, rounds);
+    printf("%-8s %10.1f ms %12.0f events/s %10" PRIu64 " waits %10" PRIu64 " signals %8.3f signals/1000 events\n",
+           use_eventfd ? "eventfd" : "cond", r.ns / 1e6, total / (r.ns / 1e9), r.waits, signals.load(),
+           signals.load() * 1000.0 / total);
+    close(evfd.fd);
+  }
+
+  return 0;
+}
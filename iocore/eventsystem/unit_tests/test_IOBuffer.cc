@@ -24,6 +24,10 @@
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
 #include "tscore/I_Layout.h"
 
 #include "I_EventSystem.h"
@@ -337,6 +341,101 @@ TEST_CASE("MIOBuffer", "[iocore]")
   }
 }
 
+static int file_range_releases = 0;
+
+static void
+release_file_range(void *cookie)
+{
+  ++*static_cast<int *>(cookie);
+}
+
+TEST_CASE("IOBufferReader over a file range", "[iocore]")
+{
+  char path[] = "/tmp/test_IOBuffer.XXXXXX";
+  int fd      = mkstemp(path);
+  REQUIRE(fd >= 0);
+  unlink(path);
+
+  std::string file;
+  for (int i = 0; i < 10000; ++i) {
+    file += static_cast<char>('a' + i % 26);
+  }
+  REQUIRE(write(fd, file.data(), file.size()) == static_cast<ssize_t>(file.size()));
+
+  // "head", then bytes [1000, 9000) of the file, then "tail"
+  constexpr off_t RANGE_OFFSET = 1000;
+  constexpr int64_t RANGE_LEN  = 8000;
+  const std::string expected   = "head" + file.substr(RANGE_OFFSET, RANGE_LEN) + "tail";
+
+  MIOBuffer *miob        = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+  IOBufferReader *miob_r = miob->alloc_reader();
+  miob->write("head", 4);
+  IOBufferBlock *range = new_IOBufferBlock();
+  range->set(new_file_IOBufferData(fd, RANGE_OFFSET, RANGE_LEN, &release_file_range, &file_range_releases), RANGE_LEN, 0);
+  range->_buf_end = range->_end;
+  miob->append_block(range);
+  miob->write("tail", 4);
+
+  CHECK(miob_r->read_avail() == static_cast<int64_t>(expected.size()));
+  CHECK(!miob_r->block->is_file_range());
+  CHECK(range->is_file_range());
+  CHECK(range->file_offset() == RANGE_OFFSET);
+
+  SECTION("memcpy")
+  {
+    std::string buf(expected.size(), '\0');
+    CHECK(miob_r->memcpy(buf.data(), buf.size()) == buf.data() + buf.size());
+    CHECK(buf == expected);
+
+    // from inside the range, across its end
+    std::string part(52, '\0');
+    miob_r->memcpy(part.data(), part.size(), 4 + RANGE_LEN - 50);
+    CHECK(part == expected.substr(4 + RANGE_LEN - 50, 52));
+  }
+
+  SECTION("read")
+  {
+    std::string buf(10, '\0');
+    CHECK(miob_r->read(buf.data(), buf.size()) == 10);
+    CHECK(buf == expected.substr(0, 10));
+
+    // the block read avail of a range is the number of bytes left in it
+    CHECK(miob_r->block_read_avail() == RANGE_LEN - 6);
+    CHECK(miob_r->block->is_file_range());
+    CHECK(miob_r->block->file_offset() + miob_r->start_offset == RANGE_OFFSET + 6);
+
+    buf.assign(expected.size(), '\0');
+    CHECK(miob_r->read(buf.data(), buf.size()) == static_cast<int64_t>(expected.size() - 10));
+    buf.resize(expected.size() - 10);
+    CHECK(buf == expected.substr(10));
+    CHECK(miob_r->read_avail() == 0);
+  }
+
+  SECTION("write to another buffer")
+  {
+    MIOBuffer *copy        = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+    IOBufferReader *copy_r = copy->alloc_reader();
+    miob_r->consume(2);
+    CHECK(copy->write(miob_r, expected.size() - 4, 1) == static_cast<int64_t>(expected.size() - 4));
+
+    // the range is read into memory, the copy has no file range in it
+    std::string buf;
+    while (copy_r->block_read_avail() > 0) {
+      CHECK(!copy_r->block->is_file_range());
+      buf.append(copy_r->start(), copy_r->block_read_avail());
+      copy_r->consume(copy_r->block_read_avail());
+    }
+    CHECK(buf == expected.substr(3, expected.size() - 4));
+    free_MIOBuffer(copy);
+  }
+
+  // the owner of the file hears of the range once it is gone
+  free_MIOBuffer(miob);
+  CHECK(file_range_releases == 1);
+  file_range_releases = 0;
+  close(fd);
+}
+
 struct EventProcessorListener : Catch::TestEventListenerBase {
   using TestEventListenerBase::TestEventListenerBase;
 
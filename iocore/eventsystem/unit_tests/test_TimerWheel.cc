@@ -0,0 +1,274 @@
+/** @file
+
+  Catch based unit tests for the event thread timing wheel
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "P_EventSystem.h"
+
+// Delays in ticks that start, end or cross a wheel, and some past the top one.
+static const std::vector<uint64_t> DELAYS = {
+  0,
+  1,
+  2,
+  TW_SLOTS - 1,
+  TW_SLOTS,
+  TW_SLOTS + 1,
+  3 * TW_SLOTS + 7,
+  (uint64_t(1) << (2 * TW_BITS)) - 1,
+  uint64_t(1) << (2 * TW_BITS),
+  (uint64_t(1) << (2 * TW_BITS)) + 1,
+  (uint64_t(1) << (3 * TW_BITS)) - 1,
+  uint64_t(1) << (3 * TW_BITS),
+  (uint64_t(1) << (3 * TW_BITS)) + TW_SLOTS + 1,
+  (uint64_t(1) << (4 * TW_BITS)) - 1,
+  uint64_t(1) << (4 * TW_BITS),
+  (uint64_t(1) << (4 * TW_BITS)) + 12345,
+};
+
+// Start ticks just before the lower wheels turn over, so the first ticks cascade.
+static const std::vector<uint64_t> STARTS = {
+  1000000 * uint64_t(TW_SLOTS),
+  1000000 * uint64_t(TW_SLOTS) - 1,
+  (uint64_t(1) << (2 * TW_BITS)) * 1000 - 1,
+  (uint64_t(1) << (3 * TW_BITS)) * 100 - 1,
+  (uint64_t(1) << (3 * TW_BITS)) * 100 - 3,
+};
+
+class WheelDriver
+{
+public:
+  explicit WheelDriver(ink_hrtime start) : now(start), wheel(start) {}
+
+  void
+  add(Event *e, ink_hrtime timeout)
+  {
+    e->timeout_at = timeout;
+    wheel.enqueue(e);
+    // a timer that is already due is due right after now
+    pending[e] = std::max(timeout, now + 1);
+  }
+
+  void
+  remove(Event *e)
+  {
+    wheel.remove(e);
+    pending.erase(e);
+  }
+
+  // Sleep until the earliest timeout the wheel reports, the way an event thread does, and expire what is due.
+  void
+  step()
+  {
+    ink_hrtime last = now - now % TW_TICK;
+    ink_hrtime next = wheel.earliest_timeout();
+    now             = next > now ? next : now + TW_TICK;
+    wheel.advance(now, nullptr);
+
+    Event *e;
+    while ((e = wheel.dequeue_ready()) != nullptr) {
+      auto p = pending.find(e);
+      // exactly once
+      REQUIRE(p != pending.end());
+      REQUIRE(fired.insert(e).second);
+      ink_hrtime due = p->second;
+      pending.erase(p);
+
+      INFO("due " << due << " now " << now);
+      // never early, at most a tick late, and not due at the previous step
+      CHECK(due <= now);
+      CHECK(now - due <= TW_TICK);
+      CHECK(due > last);
+    }
+    // nothing still pending is overdue
+    for (auto &p : pending) {
+      CHECK(p.second > now - now % TW_TICK);
+    }
+  }
+
+  void
+  run()
+  {
+    for (int loops = 0; !pending.empty(); ++loops) {
+      REQUIRE(loops < 100000);
+      step();
+    }
+  }
+
+  ink_hrtime now;
+  TimerWheel wheel;
+  std::map<Event *, ink_hrtime> pending; ///< Event and when it is due.
+  std::set<Event *> fired;
+};
+
+TEST_CASE("TimerWheel fires every level in order", "[iocore][timer_wheel]")
+{
+  for (uint64_t start_tick : STARTS) {
+    INFO("start tick " << start_tick);
+    ink_hrtime start = static_cast<ink_hrtime>(start_tick) * TW_TICK;
+    WheelDriver driver(start);
+
+    // on a tick, just after one and just before the next
+    std::vector<Event> events(DELAYS.size() * 3);
+    for (size_t i = 0; i < DELAYS.size(); ++i) {
+      ink_hrtime at = start + static_cast<ink_hrtime>(DELAYS[i]) * TW_TICK;
+      driver.add(&events[3 * i], at);
+      driver.add(&events[3 * i + 1], at + 1);
+      driver.add(&events[3 * i + 2], at + TW_TICK - 1);
+    }
+    // every wheel is used
+    std::set<int> levels;
+    for (Event &e : events) {
+      levels.insert(e.in_heap / TW_SLOTS);
+    }
+    for (int level = 0; level < TW_LEVELS; ++level) {
+      CHECK(levels.count(level) == 1);
+    }
+
+    driver.run();
+    CHECK(driver.fired.size() == events.size());
+  }
+}
+
+TEST_CASE("TimerWheel fires dense timers at wheel boundaries in order", "[iocore][timer_wheel]")
+{
+  ink_hrtime start = static_cast<ink_hrtime>(STARTS[2]) * TW_TICK;
+  WheelDriver driver(start);
+
+  // a timer on each of the first three turns of the two lower wheels, added in reverse
+  std::vector<Event> events(4 * TW_SLOTS);
+  for (size_t i = 0; i < events.size(); ++i) {
+    size_t n = events.size() - 1 - i;
+    driver.add(&events[i], start + static_cast<ink_hrtime>(n * n * 3 + n) * TW_TICK + HRTIME_USECONDS(n % 1000));
+  }
+  driver.run();
+  CHECK(driver.fired.size() == events.size());
+}
+
+TEST_CASE("TimerWheel timers added while it runs", "[iocore][timer_wheel]")
+{
+  ink_hrtime start = static_cast<ink_hrtime>(STARTS[1]) * TW_TICK;
+  WheelDriver driver(start);
+
+  std::vector<Event> first(DELAYS.size());
+  std::vector<Event> later(DELAYS.size());
+  for (size_t i = 0; i < DELAYS.size(); ++i) {
+    driver.add(&first[i], start + static_cast<ink_hrtime>(DELAYS[i]) * TW_TICK);
+  }
+  // once the first wheel has turned over, add timers relative to the new time
+  while (driver.now < start + TW_SLOTS * TW_TICK) {
+    driver.step();
+  }
+  for (size_t i = 0; i < DELAYS.size(); ++i) {
+    driver.add(&later[i], driver.now + static_cast<ink_hrtime>(DELAYS[i]) * TW_TICK + 1);
+  }
+  // already due is ready on the next advance
+  Event overdue;
+  driver.add(&overdue, driver.now - HRTIME_SECONDS(1));
+  CHECK(overdue.in_heap == TW_READY);
+
+  driver.run();
+  CHECK(driver.fired.size() == 2 * DELAYS.size() + 1);
+}
+
+TEST_CASE("TimerWheel cancellation", "[iocore][timer_wheel]")
+{
+  ink_hrtime start = static_cast<ink_hrtime>(STARTS[3]) * TW_TICK;
+  WheelDriver driver(start);
+
+  std::vector<Event> kept(DELAYS.size());
+  std::vector<Event> removed(DELAYS.size());
+  std::vector<Event> moved(DELAYS.size());
+  for (size_t i = 0; i < DELAYS.size(); ++i) {
+    ink_hrtime at = start + static_cast<ink_hrtime>(DELAYS[i]) * TW_TICK;
+    driver.add(&kept[i], at);
+    driver.add(&removed[i], at);
+    driver.add(&moved[i], at);
+  }
+
+  SECTION("removed before it cascades")
+  {
+    for (Event &e : removed) {
+      driver.remove(&e);
+      CHECK(!e.in_the_priority_queue);
+    }
+  }
+
+  SECTION("removed after it cascaded to a lower wheel")
+  {
+    // run past the first cascade of every wheel but the top one
+    while (driver.now < start + (static_cast<ink_hrtime>(1) << (3 * TW_BITS)) * TW_TICK) {
+      driver.step();
+    }
+    for (Event &e : removed) {
+      if (e.in_the_priority_queue) {
+        driver.remove(&e);
+      }
+    }
+  }
+
+  SECTION("cancelled in place is dropped when its slot cascades")
+  {
+    // freed by the wheel, so these come from the allocator
+    for (uint64_t delay : DELAYS) {
+      if (delay < TW_SLOTS) {
+        continue;
+      }
+      Event *e = eventAllocator.alloc();
+      e->init(nullptr, start + static_cast<ink_hrtime>(delay) * TW_TICK);
+      driver.wheel.enqueue(e);
+      e->cancelled = 1;
+    }
+    for (Event &e : removed) {
+      driver.remove(&e);
+    }
+  }
+
+  // re-scheduling moves a timer, it fires once at the new time
+  for (size_t i = 0; i < DELAYS.size(); ++i) {
+    if (moved[i].in_the_priority_queue) {
+      driver.remove(&moved[i]);
+      driver.add(&moved[i], driver.now + static_cast<ink_hrtime>(DELAYS[DELAYS.size() - 1 - i]) * TW_TICK);
+    }
+  }
+
+  driver.run();
+  for (Event &e : kept) {
+    CHECK(driver.fired.count(&e) == 1);
+  }
+  for (Event &e : removed) {
+    CHECK(!e.in_the_priority_queue);
+  }
+  for (Event &e : moved) {
+    CHECK(!e.in_the_priority_queue);
+  }
+  // nothing else came out, the cancelled events included
+  CHECK(driver.fired.size() <= 3 * DELAYS.size());
+  for (Event *e : driver.fired) {
+    CHECK(e->cancelled == 0);
+  }
+}
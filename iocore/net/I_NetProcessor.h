@@ -103,6 +103,9 @@ public:
     */
     bool f_mptcp;
 
+    /// Use kernel TLS for connections on this port when possible.
+    bool f_ktls;
+
     /// Proxy Protocol enabled
     bool f_proxy_protocol;
 
@@ -151,6 +151,9 @@ struct NetVCOptions {
   // Use TCP Fast Open on this socket. The connect(2) call will be omitted.
   bool f_tcp_fastopen = false;
 
+  /// Hand the TLS record layer to the kernel after the handshake, if the cipher allows it.
+  bool f_ktls = false;
+
   /// Control use of SOCKS.
   /// Set to @c NO_SOCKS to disable use of SOCKS. Otherwise SOCKS is
   /// used if available.
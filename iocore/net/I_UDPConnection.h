@@ -98,6 +98,11 @@ public:
      other Continuations.
   */
   void bindToThread(Continuation *c);
+  /**
+     Same as above, but polls the socket on @a t, which must be an ET_UDP
+     thread, instead of the next one in turn.
+  */
+  void bindToThread(Continuation *c, EThread *t);
 
   virtual void UDPConnection_is_abstract() = 0;
 };
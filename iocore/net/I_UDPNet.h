@@ -68,10 +68,15 @@ public:
      to the NIC.
      @param recv_bufsize (optional) Socket buffer size for sending.
      Limits how much can be queued by OS before we read it.
+     @param thread (optional) ET_UDP thread that polls the socket. The
+     next one in turn if nullptr.
+     @param reuse_port (optional) Set SO_REUSEPORT so that several
+     sockets can be bound to @a addr, each read by its own thread.
      @return Action* Always returns ACTION_RESULT_DONE if socket was
      created successfully, or ACTION_IO_ERROR if not.
   */
-  inkcoreapi Action *UDPBind(Continuation *c, sockaddr const *addr, int send_bufsize = 0, int recv_bufsize = 0);
+  inkcoreapi Action *UDPBind(Continuation *c, sockaddr const *addr, int send_bufsize = 0, int recv_bufsize = 0,
+                             EThread *thread = nullptr, bool reuse_port = false);
 
   // Regarding sendto_re, sendmsg_re, recvfrom_re:
   // * You may be called back on 'c' with completion or error status.
@@ -46,6 +46,11 @@ public:
   virtual void free(); // fast deallocate
   void setContinuation(Continuation *c);
   void setConnection(UDPConnection *c);
+  /**
+     Send the data as datagrams of @a size bytes each (the last one may be shorter) with one
+     system call, using UDP GSO where the kernel has it. 0 sends the data as a single datagram.
+  */
+  void setSegmentSize(uint16_t size);
   UDPConnection *getConnection();
   IOBufferBlock *getIOBlockChain();
   int64_t getPktLength() const;
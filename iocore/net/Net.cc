@@ -56,6 +56,7 @@ configure_net()
   // These are not reloadable
   REC_ReadConfigInteger(net_event_period, "proxy.config.net.event_period");
   REC_ReadConfigInteger(net_accept_period, "proxy.config.net.accept_period");
+  REC_ReadConfigInteger(net_zero_copy_send_min_size, "proxy.config.net.zero_copy_send.min_size");
 
   // This is kinda fugly, but better than it was before (on every connection in and out)
   // Note that these would need to be ats_free()'d if we ever want to clean that up, but
@@ -93,6 +94,10 @@ register_net_stats()
     {"proxy.process.net.net_handler_run", net_handler_run_stat},
     {"proxy.process.net.read_bytes", net_read_bytes_stat},
     {"proxy.process.net.write_bytes", net_write_bytes_stat},
+    {"proxy.process.net.zero_copy_bytes", net_zero_copy_bytes_stat},
+    {"proxy.process.net.zero_copy_send.completions", net_zero_copy_send_completions_stat},
+    {"proxy.process.net.zero_copy_send.copied", net_zero_copy_send_copied_stat},
+    {"proxy.process.net.zero_copy_send.fallbacks", net_zero_copy_send_fallbacks_stat},
     {"proxy.process.net.fastopen_out.attempts", net_fastopen_attempts_stat},
     {"proxy.process.net.fastopen_out.successes", net_fastopen_successes_stat},
     {"proxy.process.socks.connections_successful", socks_connections_successful_stat},
@@ -29,6 +29,7 @@
 #include "P_SSLConfig.h"
 #include "P_SSLUtils.h"
 #include "SSLStats.h"
+#include "SSLLazyCert.h"
 
 // Maximum OCSP stapling response size.
 // This should be the response for a single certificate and will typically include the responder certificate chain,
@@ -490,6 +491,9 @@ ocsp_update()
     SSLCertContext *cc = certLookup->get(i);
     if (cc) {
       ctx = cc->getCtx();
+      if (!ctx && cc->lazy) {
+        ctx = cc->lazy->loaded();
+      }
       if (ctx) {
         certinfo *cinf    = nullptr;
         certinfo_map *map = stapling_get_cert_info(ctx.get());
@@ -57,6 +57,10 @@ enum Net_Stats {
   net_tcp_accept_stat,
   net_connections_throttled_in_stat,
   net_connections_throttled_out_stat,
+  net_zero_copy_bytes_stat,
+  net_zero_copy_send_completions_stat,
+  net_zero_copy_send_copied_stat,
+  net_zero_copy_send_fallbacks_stat,
   Net_Stat_Count
 };
 
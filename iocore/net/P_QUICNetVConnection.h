@@ -56,6 +56,9 @@
 #include "quic/QUICPinger.h"
 #include "quic/QUICPadder.h"
 #include "quic/QUICLossDetector.h"
+#include "quic/QUICCubicCongestionController.h"
+#include "quic/QUICBBRCongestionController.h"
+#include "quic/QUICPacer.h"
 #include "quic/QUICStreamManager.h"
 #include "quic/QUICAltConnectionManager.h"
 #include "quic/QUICPathValidator.h"
@@ -231,6 +234,7 @@ private:
   QUICAckFrameManager _ack_frame_manager;
   QUICPacketHeaderProtector _ph_protector;
   QUICRTTMeasure _rtt_measure;
+  QUICPacer _pacer;
   QUICApplicationMap *_application_map = nullptr;
 
   uint32_t _pmtu = 1280;
@@ -312,6 +316,7 @@ private:
   QUICConnectionErrorUPtr _state_common_send_packet();
   QUICConnectionErrorUPtr _state_handshake_send_retry_packet();
   QUICConnectionErrorUPtr _state_closing_send_packet();
+  void _send_batch(Ptr<IOBufferBlock> batch, uint32_t count, uint32_t segment_size);
 
   Ptr<ProxyMutex> _packet_transmitter_mutex;
 
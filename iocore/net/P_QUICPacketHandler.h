@@ -41,14 +41,24 @@ public:
   ~QUICPacketHandler();
 
   void send_packet(const QUICPacket &packet, QUICNetVConnection *vc, const QUICPacketHeaderProtector &pn_protector);
-  void send_packet(QUICNetVConnection *vc, Ptr<IOBufferBlock> udp_payload);
+  /**
+   * @a udp_payload may be a chain of datagrams of @a segment_size bytes each, except for the last one,
+   * which are sent with a single system call. 0 means @a udp_payload is one datagram.
+   */
+  void send_packet(QUICNetVConnection *vc, Ptr<IOBufferBlock> udp_payload, uint16_t segment_size = 0);
 
   void close_connection(QUICNetVConnection *conn);
 
+  /**
+   * Index of the socket this handler reads, which connection IDs issued for its connections carry.
+   * See QUICConnectionId::ROUTES.
+   */
+  uint8_t route() const;
+
 protected:
   void _send_packet(const QUICPacket &packet, UDPConnection *udp_con, IpEndpoint &addr, uint32_t pmtu,
                     const QUICPacketHeaderProtector *ph_protector, int dcil);
-  void _send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOBufferBlock> udp_payload);
+  void _send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOBufferBlock> udp_payload, uint16_t segment_size);
 
   // FIXME Remove this
   // QUICPacketHandler could be a continuation, but NetAccept is a contination too.
@@ -56,6 +66,7 @@ protected:
 
   Event *_collector_event                       = nullptr;
   QUICClosedConCollector *_closed_con_collector = nullptr;
+  uint8_t _route                                = 0;
 
   virtual void _recv_packet(int event, UDPPacket *udpPacket) = 0;
 };
@@ -76,6 +87,8 @@ public:
   virtual int acceptEvent(int event, void *e) override;
   void init_accept(EThread *t) override;
 
+  void set_route(uint8_t route);
+
 protected:
   // QUICPacketHandler
   Continuation *_get_continuation() override;
@@ -84,8 +97,11 @@ private:
   void _recv_packet(int event, UDPPacket *udp_packet) override;
   int _stateless_retry(const uint8_t *buf, uint64_t buf_len, UDPConnection *connection, IpEndpoint from, QUICConnectionId dcid,
                        QUICConnectionId scid, QUICConnectionId *original_cid);
+  EThread *_assign_thread();
+  void _attach_steering_program(UDPConnection *udp_con);
 
   QUICConnectionTable &_ctable;
+  uint32_t _next_thread = 0;
 };
 
 /*
@@ -29,6 +29,7 @@
 
 struct SSLConfigParams;
 struct SSLContextStorage;
+class SSLLazyCert;
 
 /** Special things to do instead of use a context.
     In general an option will be associated with a @c nullptr context because
@@ -66,8 +67,15 @@ struct ssl_ticket_key_t {
   unsigned char aes_key[16];
 };
 
+/** A set of session ticket keys, the most recent first.
+
+    The block is a single allocation. The keys are followed by an open addressed index of @c index_mask + 1
+    slots, each holding the position of a key plus one or 0 if the slot is empty, so the key of a ticket is
+    found by its name in constant time however many keys are kept.
+ */
 struct ssl_ticket_key_block {
   unsigned num_keys;
+  unsigned index_mask;
   ssl_ticket_key_t keys[];
 };
 
@@ -117,6 +125,7 @@ public:
   SSLCertContextOption opt                   = SSLCertContextOption::OPT_NONE; ///< Special handling option.
   shared_SSLMultiCertConfigParams userconfig = nullptr;                        ///< User provided settings
   shared_ssl_ticket_key_block keyblock       = nullptr;                        ///< session keys associated with this address
+  std::shared_ptr<SSLLazyCert> lazy          = nullptr;                        ///< Builds @a ctx on first use if set
 };
 
 struct SSLCertLookup : public ConfigInfo {
@@ -157,4 +166,7 @@ struct SSLCertLookup : public ConfigInfo {
 void ticket_block_free(void *ptr);
 ssl_ticket_key_block *ticket_block_alloc(unsigned count);
 ssl_ticket_key_block *ticket_block_create(char *ticket_key_data, int ticket_key_len);
+ssl_ticket_key_block *ticket_block_rotate(const ssl_ticket_key_block *keyblock, unsigned max_keys);
+void ticket_block_index(ssl_ticket_key_block *keyblock);
+int ticket_block_find(const ssl_ticket_key_block *keyblock, const unsigned char *key_name);
 ssl_ticket_key_block *ssl_create_ticket_keyblock(const char *ticket_key_path);
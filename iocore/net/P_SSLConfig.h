@@ -84,6 +84,8 @@ struct SSLConfigParams : public ConfigInfo {
   int ssl_session_cache_skip_on_contention;
   int ssl_session_cache_timeout;
   int ssl_session_cache_auto_clear;
+  int server_cert_lazy_load;       // build server SSL_CTXs on first use
+  int server_cert_lazy_cache_size; // lazily built SSL_CTXs to keep
 
   char *clientCertPath;
   char *clientCertPathOnly;
@@ -127,6 +129,7 @@ struct SSLConfigParams : public ConfigInfo {
   static load_ssl_file_func load_ssl_file_cb;
 
   static int async_handshake_enabled;
+  static int async_private_key_threads;
   static char *engine_conf_file;
 
   shared_SSL_CTX client_ctx;
@@ -186,6 +189,7 @@ struct SSLTicketParams : public ConfigInfo {
   char *ticket_key_filename;
   bool LoadTicket(bool &nochange);
   void LoadTicketData(char *ticket_data, int ticket_data_len);
+  bool RotateTicket();
   void cleanup();
 
   ~SSLTicketParams() override { cleanup(); }
@@ -195,6 +199,8 @@ struct SSLTicketKeyConfig {
   static void startup();
   static bool reconfigure();
   static bool reconfigure_data(char *ticket_data, int ticket_data_len);
+  static bool rotate();
+  static void schedule_rotate();
 
   static SSLTicketParams *
   acquire()
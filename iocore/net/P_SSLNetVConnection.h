@@ -74,6 +74,7 @@
 #define SSL_DEF_TLS_RECORD_MSEC_THRESHOLD 1000
 
 struct SSLCertLookup;
+class SSLLazyCert;
 
 typedef enum {
   SSL_HOOK_OP_DEFAULT,                     ///< Null / initialization value. Do normal processing.
@@ -182,6 +183,20 @@ public:
     transparentPassThrough = val;
   }
 
+  /// True if the kernel builds the TLS records written on this connection.
+  bool
+  is_ktls_send() const
+  {
+    return ktlsSend;
+  }
+
+  /// Note that the handshake waits for @a cert to load, or no longer does if @a cert is @c nullptr.
+  void
+  set_lazy_cert_wait(std::shared_ptr<SSLLazyCert> cert)
+  {
+    lazyCertWait = std::move(cert);
+  }
+
   // Copy up here so we overload but don't override
   using super::reenable;
 
@@ -469,6 +484,7 @@ private:
   enum SSLHandshakeStatus sslHandshakeStatus = SSL_HANDSHAKE_ONGOING;
   bool sslClientRenegotiationAbort           = false;
   bool sslSessionCacheHit                    = false;
+  bool ktlsSend                              = false;
   MIOBuffer *handShakeBuffer                 = nullptr;
   IOBufferReader *handShakeHolder            = nullptr;
   IOBufferReader *handShakeReader            = nullptr;
@@ -477,6 +493,9 @@ private:
 
   bool transparentPassThrough = false;
 
+  /// The certificate the handshake is paused for, if any.
+  std::shared_ptr<SSLLazyCert> lazyCertWait;
+
   /// The current hook.
   /// @note For @C SSL_HOOKS_INVOKE, this is the hook to invoke.
   class APIHook *curHook = nullptr;
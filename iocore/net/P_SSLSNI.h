@@ -37,6 +37,7 @@
 #include <vector>
 #include <strings.h>
 #include "YamlSNIConfig.h"
+#include "SNINameMatcher.h"
 
 // Properties for the next hop server
 struct NextHopProperty {
@@ -53,47 +54,12 @@ struct NextHopProperty {
 
 using actionVector = std::vector<std::unique_ptr<ActionItem>>;
 
-struct namedElement {
-public:
-  namedElement() {}
-
-  void
-  setGlobName(std::string name)
-  {
-    std::string::size_type pos = 0;
-    while ((pos = name.find('.', pos)) != std::string::npos) {
-      name.replace(pos, 1, "\\.");
-      pos += 2;
-    }
-    pos = 0;
-    while ((pos = name.find('*', pos)) != std::string::npos) {
-      name.replace(pos, 1, "(.{0,})");
-    }
-    Debug("ssl_sni", "Regexed fqdn=%s", name.c_str());
-    setRegexName(name);
-  }
-
-  void
-  setRegexName(const std::string &regexName)
-  {
-    const char *err_ptr;
-    int err_offset = 0;
-    if (!regexName.empty()) {
-      match = pcre_compile(regexName.c_str(), PCRE_ANCHORED, &err_ptr, &err_offset, nullptr);
-    } else {
-      match = nullptr;
-    }
-  }
-
-  pcre *match = nullptr;
-};
-
-struct actionElement : public namedElement {
+struct actionElement {
 public:
   actionVector actions;
 };
 
-struct NextHopItem : public namedElement {
+struct NextHopItem {
 public:
   NextHopProperty prop;
 };
@@ -105,6 +71,8 @@ struct SNIConfigParams : public ConfigInfo {
   char *sni_filename = nullptr;
   SNIList sni_action_list;
   NextHopPropertyList next_hop_list;
+  /// fqdn of each entry, numbered as in both @c sni_action_list and @c next_hop_list.
+  SNINameMatcher fqdn_matcher;
   YamlSNIConfig Y_sni;
   const NextHopProperty *getPropertyConfig(const std::string &servername) const;
   SNIConfigParams();
@@ -78,6 +78,9 @@ public:
   static bool set_session_id_context(SSL_CTX *ctx, const SSLConfigParams *params,
                                      const SSLMultiCertConfigParams *sslMultCertSettings);
 
+  shared_SSL_CTX init_lazy_ssl_ctx(CertLoadData const &data, const shared_SSLMultiCertConfigParams &sslMultCertSettings,
+                                   std::set<std::string> &names);
+
   static bool index_certificate(SSLCertLookup *lookup, SSLCertContext const &cc, const char *sni_name);
   static int check_server_cert_now(X509 *cert, const char *certname);
   static void clear_pw_references(SSL_CTX *ssl_ctx);
@@ -87,6 +90,8 @@ protected:
 
   bool _store_single_ssl_ctx(SSLCertLookup *lookup, shared_SSLMultiCertConfigParams sslMultCertSettings, shared_SSL_CTX ctx,
                              std::set<std::string> &names);
+  bool _store_lazy_ssl_ctx(SSLCertLookup *lookup, shared_SSLMultiCertConfigParams sslMultCertSettings, CertLoadData const &data,
+                           std::set<std::string> &names);
 
 private:
   virtual bool _store_ssl_ctx(SSLCertLookup *lookup, shared_SSLMultiCertConfigParams ssl_multi_cert_params);
@@ -111,6 +116,7 @@ void SSLPostConfigInitialize();
 
 // Wrapper functions to SSL I/O routines
 ssl_error_t SSLWriteBuffer(SSL *ssl, const void *buf, int64_t nbytes, int64_t &nwritten);
+ssl_error_t SSLSendFile(SSL *ssl, int fd, off_t offset, int64_t nbytes, int64_t &nwritten);
 ssl_error_t SSLReadBuffer(SSL *ssl, void *buf, int64_t nbytes, int64_t &nread);
 ssl_error_t SSLAccept(SSL *ssl);
 ssl_error_t SSLConnect(SSL *ssl);
@@ -53,6 +53,7 @@ public:
 
   int in_the_priority_queue = 0;
   int in_heap               = 0;
+  uint16_t segment_size     = 0; // 0 if the chain is a single datagram
 };
 
 inkcoreapi extern ClassAllocator<UDPPacketInternal> udpPacketAllocator;
@@ -126,6 +127,12 @@ UDPPacket::setContinuation(Continuation *c)
   static_cast<UDPPacketInternal *>(this)->cont = c;
 }
 
+TS_INLINE void
+UDPPacket::setSegmentSize(uint16_t size)
+{
+  static_cast<UDPPacketInternal *>(this)->segment_size = size;
+}
+
 TS_INLINE void
 UDPPacket::setConnection(UDPConnection *c)
 {
@@ -169,6 +176,7 @@ new_UDPPacket(struct sockaddr const *to, ink_hrtime when, Ptr<IOBufferBlock> &bu
   p->in_the_priority_queue = 0;
   p->in_heap               = 0;
   p->delivery_time         = when;
+  p->segment_size          = 0;
   if (to)
     ats_ip_copy(&p->to, to);
   p->chain = buf;
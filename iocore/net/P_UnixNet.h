@@ -117,6 +117,7 @@ struct EventIO {
 #include "P_UnixUDPConnection.h"
 #include "P_UnixPollDescriptor.h"
 #include <limits>
+#include <vector>
 
 class NetEvent;
 class NetHandler;
@@ -143,6 +144,9 @@ extern int http_accept_port_number;
 
 #define TRANSIENT_ACCEPT_ERROR_MESSAGE_EVERY HRTIME_HOURS(24)
 
+// seconds a closed socket waits for its zero copy sends to complete
+#define ZERO_COPY_LINGER_TIMEOUT 60
+
 // also the 'throttle connect headroom'
 #define EMERGENCY_THROTTLE 16
 #define THROTTLE_AT_ONCE 5
@@ -247,6 +251,7 @@ public:
   uint32_t keep_alive_queue_size = 0;
   Que(NetEvent, active_queue_link) active_queue;
   uint32_t active_queue_size = 0;
+  std::vector<ZeroCopyLinger> zero_copy_linger;
 
   /// configuration settings for managing the active and keep-alive queues
   struct Config {
@@ -293,6 +298,8 @@ public:
   void process_enabled_list();
   void process_ready_list();
   void manage_keep_alive_queue();
+  void linger_zero_copy(int fd, ZeroCopySend &sends);
+  void manage_zero_copy_linger(ink_hrtime now);
   bool manage_active_queue(bool ignore_queue_size);
   void add_to_keep_alive_queue(NetEvent *ne);
   void remove_from_keep_alive_queue(NetEvent *ne);
@@ -37,6 +37,7 @@
 #include "P_Connection.h"
 #include "P_NetAccept.h"
 #include "NetEvent.h"
+#include "P_ZeroCopySend.h"
 
 class UnixNetVConnection;
 class NetHandler;
@@ -52,6 +53,7 @@ NetVCOptions::reset()
   addr_binding       = ANY_ADDR;
   f_blocking         = false;
   f_blocking_connect = false;
+  f_ktls             = false;
   socks_support      = NORMAL_SOCKS;
   socks_version      = SOCKS_DEFAULT_VERSION;
   socket_recv_bufsize =
@@ -282,6 +284,7 @@ public:
   unsigned int id = 0;
 
   Connection con;
+  ZeroCopySend zero_copy;
   int recursion            = 0;
   OOB_callback *oob_ptr    = nullptr;
   bool from_accept_thread  = false;
@@ -0,0 +1,106 @@
+/** @file
+
+  MSG_ZEROCOPY transmit support for socket writes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "tscore/ink_platform.h"
+#include "tscore/ink_hrtime.h"
+#include "I_IOBuffer.h"
+
+class EThread;
+
+/// Bytes a single write must carry to be sent with MSG_ZEROCOPY, 0 disables it.
+extern int64_t net_zero_copy_send_min_size;
+
+/** Outstanding MSG_ZEROCOPY sends on one socket.
+
+    With MSG_ZEROCOPY the kernel transmits straight from the pages of the IOBufferData instead of
+    copying them, so the data must not be freed until the socket's error queue reports the send
+    complete. Every send that the kernel accepts gets the next 32 bit sequence number of the socket,
+    and the completions report ranges of those numbers.
+ */
+class ZeroCopySend
+{
+public:
+  /// Whether a write of @a len bytes on this socket should go out with MSG_ZEROCOPY.
+  bool
+  wants(int64_t len) const
+  {
+    return net_zero_copy_send_min_size > 0 && len >= net_zero_copy_send_min_size && !_disabled;
+  }
+
+  /** Send @a msg on @a fd with MSG_ZEROCOPY and pin @a data until it completes.
+
+      @a data holds the IOBufferData each iovec of @a msg points into. Returns the bytes written or
+      -errno like SocketManager. -ENOBUFS and -EOPNOTSUPP mean the caller should copy instead.
+   */
+  int64_t send(int fd, struct msghdr *msg, IOBufferData *const *data, unsigned ndata, EThread *t);
+
+  /// Drain the completions queued on @a fd and release the data they cover.
+  void reap(int fd, EThread *t);
+
+  /// Pin @a data until the send the kernel just accepted completes.
+  void pin(IOBufferData *const *data, unsigned ndata);
+
+  /** The sends numbered @a lo to @a hi completed, @a copied if the kernel copied their data anyway.
+
+      The range is inclusive and the numbers wrap. Only data that no earlier send still needs is
+      released. Returns the number of sends in the range.
+   */
+  uint32_t complete(uint32_t lo, uint32_t hi, bool copied);
+
+  bool
+  pending() const
+  {
+    return !_pending.empty();
+  }
+
+  /// Take over the sends of @a that, which must be for the same socket.
+  void take(ZeroCopySend &that);
+
+  /// Forget the socket, releasing anything still pinned.
+  void clear();
+
+private:
+  friend class ZeroCopySendTest;
+
+  struct Pinned {
+    uint32_t seq = 0;
+    bool done    = false;
+    Ptr<IOBufferData> data;
+  };
+
+  std::deque<Pinned> _pending;
+  uint32_t _next_seq = 0;
+  bool _enabled      = false; ///< SO_ZEROCOPY is set on the socket.
+  bool _disabled     = false; ///< The socket can not do zero copy, stop asking.
+};
+
+/// A closed socket that still has zero copy sends in flight.
+struct ZeroCopyLinger {
+  int fd              = -1;
+  ink_hrtime deadline = 0;
+  ZeroCopySend sends;
+};
@@ -19,6 +19,8 @@
   limitations under the License.
  */
 
+#include <algorithm>
+
 #include "tscore/ink_config.h"
 #include "tscore/I_Layout.h"
 
@@ -186,10 +188,9 @@ QUICNetProcessor::main_accept(Continuation *cont, SOCKET fd, AcceptOptions const
   ProxyMutex *mutex  = this_ethread()->mutex.get();
   int accept_threads = opt.accept_threads; // might be changed.
   IpEndpoint accept_ip;                    // local binding address.
+  int reuse_port = 0;
   // char thr_name[MAX_THREAD_NAME_LENGTH];
 
-  NetAccept *na = createNetAccept(opt);
-
   if (accept_threads < 0) {
     REC_ReadConfigInteger(accept_threads, "proxy.config.accept_threads");
   }
@@ -205,17 +206,43 @@ QUICNetProcessor::main_accept(Continuation *cont, SOCKET fd, AcceptOptions const
   ink_assert(0 < opt.local_port && opt.local_port < 65536);
   accept_ip.port() = htons(opt.local_port);
 
-  na->accept_fn = net_accept;
-  na->server.fd = fd;
-  ats_ip_copy(&na->server.accept_addr, &accept_ip);
-
-  na->action_         = new NetAcceptAction();
-  *na->action_        = cont;
-  na->action_->server = &na->server;
-  na->init_accept();
-
-  SCOPED_MUTEX_LOCK(lock, na->mutex, this_ethread());
-  udpNet.UDPBind((Continuation *)na, &na->server.accept_addr.sa, 1048576, 1048576);
+  // With SO_REUSEPORT every UDP thread reads the port with a socket of its own. Each socket has its own handler, and the
+  // connection IDs a handler issues carry the index of its socket so that packets keep going to it.
+  const EventProcessor::ThreadGroupDescriptor &udp_threads = eventProcessor.thread_group[ET_UDP];
+  int n_sockets                                            = 1;
+#ifdef SO_REUSEPORT
+  REC_ReadConfigInteger(reuse_port, "proxy.config.quic.server.reuse_port");
+  if (reuse_port) {
+    n_sockets = std::min(std::max(udp_threads._count, 1), static_cast<int>(UINT8_MAX));
+  }
+#endif
+  // All ports are read by the same threads, so the number of sockets is the same for every port
+  ink_release_assert(QUICConnectionId::ROUTES == 1 || QUICConnectionId::ROUTES == n_sockets);
+  QUICConnectionId::ROUTES = n_sockets;
+
+  NetAccept *na  = nullptr;
+  Action *action = nullptr;
+  for (int i = 0; i < n_sockets; ++i) {
+    na = createNetAccept(opt);
+    static_cast<QUICPacketHandlerIn *>(na)->set_route(i);
+
+    na->accept_fn = net_accept;
+    na->server.fd = fd;
+    ats_ip_copy(&na->server.accept_addr, &accept_ip);
+
+    na->action_         = new NetAcceptAction();
+    *na->action_        = cont;
+    na->action_->server = &na->server;
+    na->init_accept();
+
+    SCOPED_MUTEX_LOCK(lock, na->mutex, this_ethread());
+    // Bind in order of route, the kernel numbers the sockets of a port in the order they join it
+    udpNet.UDPBind((Continuation *)na, &na->server.accept_addr.sa, 1048576, 1048576,
+                   n_sockets > 1 ? udp_threads._thread[i] : nullptr, n_sockets > 1);
+    if (action == nullptr) {
+      action = na->action_.get();
+    }
+  }
 
-  return na->action_.get();
+  return action;
 }
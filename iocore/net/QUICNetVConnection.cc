@@ -62,6 +62,8 @@ static constexpr uint32_t UDP_HEADER_SIZE             = 8;
 static constexpr uint32_t MAX_PACKET_OVERHEAD         = 62; ///< Max long header len without length of token field of Initial packet
 static constexpr uint32_t MINIMUM_INITIAL_PACKET_SIZE = 1200;
 static constexpr ink_hrtime WRITE_READY_INTERVAL      = HRTIME_MSECONDS(2);
+static constexpr uint32_t SEND_BATCH_MAX_SEGMENTS     = 64;    // UDP_MAX_SEGMENTS of Linux
+static constexpr uint32_t SEND_BATCH_MAX_BYTES        = 65000; // fits in one IP datagram with the headers
 static constexpr uint32_t PACKET_PER_EVENT            = 256;
 static constexpr uint32_t MAX_CONSECUTIVE_STREAMS     = 8; ///< Interrupt sending STREAM frames to send ACK frame
 // static constexpr uint32_t MIN_PKT_PAYLOAD_LEN         = 3; ///< Minimum payload length for sampling for header protection
@@ -239,7 +241,7 @@ QUICNetVConnection::init(QUICConnectionId peer_cid, QUICConnectionId original_ci
   this->_peer_quic_connection_id     = peer_cid;
   this->_original_quic_connection_id = original_cid;
   this->_first_quic_connection_id    = first_cid;
-  this->_quic_connection_id.randomize();
+  this->_quic_connection_id.randomize(packet_handler->route());
 
   if (ctable) {
     this->_ctable = ctable;
@@ -392,7 +394,17 @@ QUICNetVConnection::start()
   this->_pinger = new QUICPinger();
   this->_padder = new QUICPadder(this->netvc_context);
   this->_rtt_measure.init(this->_context->ld_config());
-  this->_congestion_controller = new QUICNewRenoCongestionController(*_context);
+  switch (this->_quic_config->cc_algorithm()) {
+  case QUICCongestionControlAlgorithm::CUBIC:
+    this->_congestion_controller = new QUICCubicCongestionController(*_context);
+    break;
+  case QUICCongestionControlAlgorithm::BBR:
+    this->_congestion_controller = new QUICBBRCongestionController(*_context);
+    break;
+  default:
+    this->_congestion_controller = new QUICNewRenoCongestionController(*_context);
+    break;
+  }
   this->_loss_detector =
     new QUICLossDetector(*_context, this->_congestion_controller, &this->_rtt_measure, this->_pinger, this->_padder);
   this->_frame_dispatcher->add_handler(this->_loss_detector);
@@ -1335,6 +1347,28 @@ QUICNetVConnection::_state_common_send_packet()
 {
   uint32_t packet_count = 0;
   uint32_t error        = 0;
+
+  // Datagrams of the same size go out together in one GSO send, the last one may be shorter
+  Ptr<IOBufferBlock> batch;
+  IOBufferBlock *batch_tail = nullptr;
+  uint32_t batch_count      = 0;
+  uint32_t batch_bytes      = 0;
+  uint32_t segment_size     = 0;
+  bool batch_closed         = false;
+
+  // Headers are protected right before their batch goes out, so the masks of a batch are generated together
+  uint8_t *hp_packets[SEND_BATCH_MAX_SEGMENTS];
+  size_t hp_packet_lens[SEND_BATCH_MAX_SEGMENTS];
+  int hp_count = 0;
+  int dcil     = (this->_peer_quic_connection_id == QUICConnectionId::ZERO()) ? 0 : this->_peer_quic_connection_id.length();
+
+  auto protect_headers = [&]() {
+    if (hp_count && !this->_ph_protector.protect(hp_packets, hp_packet_lens, hp_count, dcil)) {
+      ink_assert(!"failed to protect buffer");
+    }
+    hp_count = 0;
+  };
+
   while (error == 0 && packet_count < PACKET_PER_EVENT) {
     uint32_t window = this->_congestion_controller->credit();
 
@@ -1342,6 +1376,13 @@ QUICNetVConnection::_state_common_send_packet()
       break;
     }
 
+    // The write ready timer brings us back here for whatever the pacer holds back
+    ink_hrtime now = Thread::get_hrtime();
+    if (!this->_pacer.can_send(now)) {
+      QUIC_INCREMENT_DYN_STAT_EX(QUICStats::pacing_delay_stat, (this->_pacer.next_send_time() - now) / HRTIME_USECOND);
+      break;
+    }
+
     Ptr<IOBufferBlock> udp_payload(new_IOBufferBlock());
     uint32_t udp_payload_len = std::min(window, this->_pmtu);
     udp_payload->alloc(iobuffer_size_to_index(udp_payload_len));
@@ -1387,16 +1428,19 @@ QUICNetVConnection::_state_common_send_packet()
         udp_payload->fill(len);
         written += len;
 
-        int dcil = (this->_peer_quic_connection_id == QUICConnectionId::ZERO()) ? 0 : this->_peer_quic_connection_id.length();
-        if (!this->_ph_protector.protect(buf, len, dcil)) {
-          ink_assert(!"failed to protect buffer");
+        if (hp_count == static_cast<int>(SEND_BATCH_MAX_SEGMENTS)) {
+          protect_headers();
         }
+        hp_packets[hp_count]     = buf;
+        hp_packet_lens[hp_count] = len;
+        ++hp_count;
 
         QUICConDebug("[TX] %s packet #%" PRIu64 " size=%zu", QUICDebugNames::packet_type(packet->type()), packet->packet_number(),
                      len);
 
         if (this->_pp_key_info.is_encryption_key_available(QUICKeyPhase::INITIAL) && packet->type() == QUICPacketType::HANDSHAKE &&
             this->netvc_context == NET_VCONNECTION_OUT) {
+          protect_headers();
           this->_pp_key_info.drop_keys(QUICKeyPhase::INITIAL);
           this->_minimum_encryption_level = QUICEncryptionLevel::HANDSHAKE;
         }
@@ -1407,13 +1451,38 @@ QUICNetVConnection::_state_common_send_packet()
     }
 
     if (written) {
-      this->_packet_handler->send_packet(this, udp_payload);
+      if (batch && (batch_closed || written > segment_size || batch_count == SEND_BATCH_MAX_SEGMENTS ||
+                    batch_bytes + written > SEND_BATCH_MAX_BYTES)) {
+        protect_headers();
+        this->_send_batch(batch, batch_count, segment_size);
+        batch = nullptr;
+      }
+      if (batch) {
+        batch_tail->next = udp_payload;
+        batch_tail       = udp_payload.get();
+        batch_closed     = written < segment_size;
+        ++batch_count;
+        batch_bytes += written;
+      } else {
+        batch        = udp_payload;
+        batch_tail   = udp_payload.get();
+        batch_closed = false;
+        batch_count  = 1;
+        batch_bytes  = written;
+        segment_size = written;
+      }
+      this->_pacer.on_packet_sent(Thread::get_hrtime(), written, this->_congestion_controller->pacing_rate());
     } else {
       udp_payload->dealloc();
       break;
     }
   }
 
+  if (batch) {
+    protect_headers();
+    this->_send_batch(batch, batch_count, segment_size);
+  }
+
   if (packet_count) {
     QUIC_INCREMENT_DYN_STAT_EX(QUICStats::total_packets_sent_stat, packet_count);
     net_activity(this, this_ethread());
@@ -1422,6 +1491,13 @@ QUICNetVConnection::_state_common_send_packet()
   return nullptr;
 }
 
+void
+QUICNetVConnection::_send_batch(Ptr<IOBufferBlock> batch, uint32_t count, uint32_t segment_size)
+{
+  this->_packet_handler->send_packet(this, batch, count > 1 ? segment_size : 0);
+  QUIC_INCREMENT_DYN_STAT_EX(QUICStats::send_burst_size_stat, count);
+}
+
 QUICConnectionErrorUPtr
 QUICNetVConnection::_state_closing_send_packet()
 {
@@ -1811,7 +1887,13 @@ QUICNetVConnection::_schedule_packet_write_ready(bool delay)
   if (!this->_packet_write_ready) {
     QUICConVVVDebug("Schedule %s event", QUICDebugNames::quic_event(QUIC_EVENT_PACKET_WRITE_READY));
     if (delay) {
-      this->_packet_write_ready = this->thread->schedule_in(this, WRITE_READY_INTERVAL, QUIC_EVENT_PACKET_WRITE_READY, nullptr);
+      // Come back as soon as the pacer lets the next packet go, but no later than the usual interval
+      ink_hrtime interval = WRITE_READY_INTERVAL;
+      ink_hrtime wait     = this->_pacer.next_send_time() - Thread::get_hrtime();
+      if (wait > 0 && wait < interval) {
+        interval = wait;
+      }
+      this->_packet_write_ready = this->thread->schedule_in(this, interval, QUIC_EVENT_PACKET_WRITE_READY, nullptr);
     } else {
       this->_packet_write_ready = this->thread->schedule_imm(this, QUIC_EVENT_PACKET_WRITE_READY, nullptr);
     }
@@ -70,6 +70,12 @@ QUICPacketHandler::close_connection(QUICNetVConnection *conn)
   }
 }
 
+uint8_t
+QUICPacketHandler::route() const
+{
+  return this->_route;
+}
+
 void
 QUICPacketHandler::_send_packet(const QUICPacket &packet, UDPConnection *udp_con, IpEndpoint &addr, uint32_t pmtu,
                                 const QUICPacketHeaderProtector *ph_protector, int dcil)
@@ -84,13 +90,14 @@ QUICPacketHandler::_send_packet(const QUICPacket &packet, UDPConnection *udp_con
     ph_protector->protect(reinterpret_cast<uint8_t *>(udp_payload->start()), udp_len, dcil);
   }
 
-  this->_send_packet(udp_con, addr, udp_payload);
+  this->_send_packet(udp_con, addr, udp_payload, 0);
 }
 
 void
-QUICPacketHandler::_send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOBufferBlock> udp_payload)
+QUICPacketHandler::_send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOBufferBlock> udp_payload, uint16_t segment_size)
 {
   UDPPacket *udp_packet = new_UDPPacket(addr, 0, udp_payload);
+  udp_packet->setSegmentSize(segment_size);
 
   if (is_debug_tag_set(debug_tag)) {
     ip_port_text_buffer ipb;
@@ -110,8 +117,9 @@ QUICPacketHandler::_send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IO
       }
     }
 
-    QUICDebugDS(dcid, scid, "send %s packet to %s from port %u size=%" PRId64, (QUICInvariants::is_long_header(buf) ? "LH" : "SH"),
-                ats_ip_nptop(&addr, ipb, sizeof(ipb)), udp_con->getPortNum(), buf_len);
+    QUICDebugDS(dcid, scid, "send %s packet to %s from port %u size=%" PRId64 " segment_size=%" PRIu16,
+                (QUICInvariants::is_long_header(buf) ? "LH" : "SH"), ats_ip_nptop(&addr, ipb, sizeof(ipb)), udp_con->getPortNum(),
+                buf_len, segment_size);
   }
 
   udp_con->send(this->_get_continuation(), udp_packet);
@@ -156,7 +164,10 @@ QUICPacketHandlerIn::acceptEvent(int event, void *data)
   ink_release_assert((event == NET_EVENT_DATAGRAM_READ_READY) ? (data != nullptr) : (1));
 
   if (event == NET_EVENT_DATAGRAM_OPEN) {
-    // Nothing to do.
+    // The first socket of a port attaches the program for all of them
+    if (this->_route == 0 && QUICConnectionId::ROUTES > 1) {
+      this->_attach_steering_program(static_cast<UDPConnection *>(data));
+    }
     return EVENT_CONT;
   } else if (event == NET_EVENT_DATAGRAM_READ_READY) {
     if (this->_collector_event == nullptr) {
@@ -188,6 +199,48 @@ QUICPacketHandlerIn::init_accept(EThread *t = nullptr)
   SET_HANDLER(&QUICPacketHandlerIn::acceptEvent);
 }
 
+void
+QUICPacketHandlerIn::set_route(uint8_t route)
+{
+  ink_assert(route < QUICConnectionId::ROUTES);
+  this->_route = route;
+}
+
+EThread *
+QUICPacketHandlerIn::_assign_thread()
+{
+  if (QUICConnectionId::ROUTES == 1) {
+    return eventProcessor.assign_thread(ET_NET);
+  }
+
+  // Each socket owns the net threads whose index is its route modulo ROUTES, so connections of different sockets never
+  // share a QUICPollCont queue as long as there are at least as many net threads as sockets.
+  const EventProcessor::ThreadGroupDescriptor &group = eventProcessor.thread_group[ET_NET];
+  int n_owned = 1;
+  if (group._count > this->_route) {
+    n_owned = (group._count - this->_route + QUICConnectionId::ROUTES - 1) / QUICConnectionId::ROUTES;
+  }
+  int i = this->_route + QUICConnectionId::ROUTES * (this->_next_thread++ % n_owned);
+  return group._thread[i % group._count];
+}
+
+void
+QUICPacketHandlerIn::_attach_steering_program(UDPConnection *udp_con)
+{
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+  // Pick the socket by QUICConnectionId::route() of the DCID.
+  std::vector<sock_filter> code = QUICConnectionId::route_program();
+  struct sock_fprog prog        = {static_cast<unsigned short>(code.size()), code.data()};
+  char *optval                  = reinterpret_cast<char *>(&prog);
+
+  if (safe_setsockopt(udp_con->getFd(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, optval, sizeof(prog)) < 0) {
+    Warning("Failed to attach the QUIC steering program, packets will be routed by 4-tuple: %s", strerror(errno));
+  }
+#else
+  QUICDebug("Packets are routed by 4-tuple, SO_ATTACH_REUSEPORT_CBPF is not supported");
+#endif
+}
+
 Continuation *
 QUICPacketHandlerIn::_get_continuation()
 {
@@ -318,7 +371,7 @@ QUICPacketHandlerIn::_recv_packet(int event, UDPPacket *udp_packet)
     Connection con;
     con.setRemote(&udp_packet->from.sa);
 
-    eth                           = eventProcessor.assign_thread(ET_NET);
+    eth                           = this->_assign_thread();
     QUICConnectionId original_cid = dcid;
     QUICConnectionId peer_cid     = scid;
 
@@ -363,9 +416,9 @@ QUICPacketHandler::send_packet(const QUICPacket &packet, QUICNetVConnection *vc,
 }
 
 void
-QUICPacketHandler::send_packet(QUICNetVConnection *vc, Ptr<IOBufferBlock> udp_payload)
+QUICPacketHandler::send_packet(QUICNetVConnection *vc, Ptr<IOBufferBlock> udp_payload, uint16_t segment_size)
 {
-  this->_send_packet(vc->get_udp_con(), vc->con.addr, udp_payload);
+  this->_send_packet(vc->get_udp_con(), vc->con.addr, udp_payload, segment_size);
 }
 
 int
@@ -390,7 +443,7 @@ QUICPacketHandlerIn::_stateless_retry(const uint8_t *buf, uint64_t buf_len, UDPC
   if (token_length == 0) {
     QUICRetryToken token(from, dcid);
     QUICConnectionId local_cid;
-    local_cid.randomize();
+    local_cid.randomize(this->_route);
     QUICPacketUPtr retry_packet = QUICPacketFactory::create_retry_packet(scid, local_cid, dcid, token);
 
     QUICDebug("[TX] %s packet ODCID=%" PRIx64, QUICDebugNames::packet_type(retry_packet->type()),
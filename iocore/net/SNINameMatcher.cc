@@ -0,0 +1,210 @@
+/** @file
+
+  Server name matching for sni.yaml entries.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "SNINameMatcher.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+constexpr int OVECSIZE{30};
+
+bool
+is_host_char(char c)
+{
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.';
+}
+
+std::string
+fold_case(std::string_view name)
+{
+  std::string folded(name);
+  for (char &c : folded) {
+    c = std::tolower(static_cast<unsigned char>(c));
+  }
+  return folded;
+}
+} // namespace
+
+SNINameMatcher::~SNINameMatcher()
+{
+  for (auto &&p : _patterns) {
+    if (p.regex) {
+      pcre_free(p.regex);
+    }
+  }
+}
+
+// '.' is literal and each '*' is a group matching anything. The expression is anchored at both ends and ignores case.
+pcre *
+SNINameMatcher::_compile(std::string_view fqdn)
+{
+  if (fqdn.empty()) {
+    return nullptr;
+  }
+
+  std::string regex;
+  for (char c : fqdn) {
+    if (c == '.') {
+      regex += "\\.";
+    } else if (c == '*') {
+      regex += "(.{0,})";
+    } else {
+      regex += c;
+    }
+  }
+  regex += '$';
+
+  const char *err_ptr;
+  int err_offset = 0;
+  return pcre_compile(regex.c_str(), PCRE_ANCHORED | PCRE_DOLLAR_ENDONLY | PCRE_CASELESS, &err_ptr, &err_offset, nullptr);
+}
+
+uint32_t
+SNINameMatcher::_insert(std::string_view name)
+{
+  uint32_t node = 0;
+  while (true) {
+    auto dot               = name.rfind('.');
+    std::string_view label = dot == std::string_view::npos ? name : name.substr(dot + 1);
+
+    if (auto spot = _edges.find({node, label}); spot != _edges.end()) {
+      node = spot->second;
+    } else {
+      const std::string &stored = _labels.emplace_back(label);
+      _edges.emplace(Edge{node, stored}, static_cast<uint32_t>(_nodes.size()));
+      node = _nodes.size();
+      _nodes.emplace_back();
+    }
+
+    if (dot == std::string_view::npos) {
+      return node;
+    }
+    name = name.substr(0, dot);
+  }
+}
+
+int
+SNINameMatcher::add(std::string_view fqdn)
+{
+  int idx               = _count++;
+  bool wildcard         = fqdn.size() >= 2 && fqdn[0] == '*' && fqdn[1] == '.';
+  std::string_view name = wildcard ? fqdn.substr(2) : fqdn;
+
+  if (fqdn.empty()) {
+    _patterns.push_back({idx, nullptr});
+  } else if (std::all_of(name.begin(), name.end(), is_host_char)) {
+    Node &node = _nodes[_insert(fold_case(name))];
+    int &slot  = wildcard ? node.wildcard : node.exact;
+    if (slot == NO_MATCH) {
+      slot = idx;
+    }
+  } else {
+    // A name can only match if it ends with the labels after the last '*'.
+    auto star   = fqdn.rfind('*');
+    auto suffix = star == std::string_view::npos ? star : fqdn.find('.', star);
+    bool glob   = std::all_of(fqdn.begin(), fqdn.end(), [](char c) { return c == '*' || is_host_char(c); });
+    if (glob && suffix != std::string_view::npos) {
+      _nodes[_insert(fold_case(fqdn.substr(suffix + 1)))].patterns.push_back({idx, _compile(fqdn)});
+    } else {
+      _patterns.push_back({idx, _compile(fqdn)});
+    }
+  }
+  return idx;
+}
+
+int
+SNINameMatcher::find(std::string_view servername, std::vector<std::string> *groups) const
+{
+  int best = NO_MATCH;
+  std::string_view prefix; // what the '*' of the best entry matched, if it is a trie wildcard
+  bool best_is_wildcard = false;
+  int ovector[OVECSIZE];
+  int best_ovector[OVECSIZE];
+  int best_count = 0; // captured strings of the best entry, if it is a pattern
+
+  // Each list is in entry order, so the first match in it is the only one that can be the best.
+  auto try_patterns = [&](const std::vector<Pattern> &patterns) {
+    for (auto &&p : patterns) {
+      if (best != NO_MATCH && p.idx > best) {
+        return;
+      }
+      int count = p.regex ? pcre_exec(p.regex, nullptr, servername.data(), servername.size(), 0, 0, ovector, OVECSIZE) :
+                            (servername.empty() ? 1 : -1);
+      if (count >= 0) {
+        best             = p.idx;
+        best_is_wildcard = false;
+        // reset to max if too many.
+        best_count = count == 0 ? OVECSIZE / 3 : count;
+        std::copy(ovector, ovector + 2 * best_count, best_ovector);
+        return;
+      }
+    }
+  };
+
+  try_patterns(_patterns);
+
+  // the trie holds lower case labels, the patterns and captures use the name as given
+  std::string folded    = fold_case(servername);
+  uint32_t node         = 0;
+  std::string_view rest = folded;
+  while (!servername.empty()) {
+    auto dot  = rest.rfind('.');
+    auto spot = _edges.find({node, dot == std::string_view::npos ? rest : rest.substr(dot + 1)});
+    if (spot == _edges.end()) {
+      break;
+    }
+    node            = spot->second;
+    const Node &hit = _nodes[node];
+
+    if (dot == std::string_view::npos) {
+      if (hit.exact != NO_MATCH && (best == NO_MATCH || hit.exact < best)) {
+        best             = hit.exact;
+        best_is_wildcard = false;
+        best_count       = 0;
+      }
+      break;
+    }
+
+    rest = rest.substr(0, dot);
+    if (hit.wildcard != NO_MATCH && (best == NO_MATCH || hit.wildcard < best)) {
+      best             = hit.wildcard;
+      prefix           = servername.substr(0, rest.size());
+      best_is_wildcard = true;
+      best_count       = 0;
+    }
+    try_patterns(hit.patterns);
+  }
+
+  if (groups) {
+    groups->clear();
+    if (best_is_wildcard) {
+      groups->emplace_back(prefix);
+    }
+    for (int strnum = 1; strnum < best_count; ++strnum) {
+      groups->emplace_back(servername.data() + best_ovector[2 * strnum], best_ovector[2 * strnum + 1] - best_ovector[2 * strnum]);
+    }
+  }
+  return best;
+}
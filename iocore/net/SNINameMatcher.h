@@ -0,0 +1,119 @@
+/** @file
+
+  Server name matching for sni.yaml entries.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <pcre.h>
+
+/**
+   Finds the first of a list of fqdn globs that matches a server name.
+
+   A glob is a host name in which each '*' matches any string, dots included. Exact names and names whose only
+   '*' is a whole leftmost label ("*.example.com") are kept in a trie keyed by labels from the right, so a lookup
+   walks the labels of the server name once no matter how many names are configured. Any other glob is compiled
+   to a regular expression and hung off the trie node of the labels following its last '*', so it is only tried
+   for names with that suffix, and only while it comes before the best match found so far.
+
+   Globs are numbered in the order they are added and a lookup returns the number of the first one that matches
+   the whole server name, as a linear scan of the list would. Names are compared without regard to case.
+ */
+class SNINameMatcher
+{
+public:
+  static constexpr int NO_MATCH = -1;
+
+  SNINameMatcher() = default;
+  ~SNINameMatcher();
+
+  SNINameMatcher(const SNINameMatcher &) = delete;
+  SNINameMatcher &operator=(const SNINameMatcher &) = delete;
+
+  /// Add the glob @a fqdn as the next entry. An empty glob only matches an empty server name.
+  /// @return The number of the entry.
+  int add(std::string_view fqdn);
+
+  /** Find the first entry matching @a servername.
+
+      If @a groups is not @c nullptr it is set to the strings matched by each '*' of the glob.
+
+      @return The number of the entry, or @c NO_MATCH.
+   */
+  int find(std::string_view servername, std::vector<std::string> *groups = nullptr) const;
+
+  /// @return The number of entries.
+  int
+  size() const
+  {
+    return _count;
+  }
+
+private:
+  /// An entry that is matched by a regular expression.
+  struct Pattern {
+    int idx;
+    pcre *regex; ///< nullptr for an empty (or broken) glob, which only matches an empty name.
+  };
+
+  /// A node of the label trie, reached by the labels of a name from the right.
+  struct Node {
+    int exact    = NO_MATCH;       ///< First entry naming exactly this node.
+    int wildcard = NO_MATCH;       ///< First "*." entry for this node, matching names with more labels.
+    std::vector<Pattern> patterns; ///< Globs ending in a '.' and this node, matching names with more labels.
+  };
+
+  /// A trie edge. The label points into @c _labels, or into the server name during a lookup.
+  struct Edge {
+    uint32_t parent;
+    std::string_view label;
+
+    bool
+    operator==(const Edge &that) const
+    {
+      return parent == that.parent && label == that.label;
+    }
+  };
+
+  struct EdgeHash {
+    size_t
+    operator()(const Edge &edge) const
+    {
+      return std::hash<std::string_view>()(edge.label) ^ (static_cast<size_t>(edge.parent) * 0x9E3779B97F4A7C15ULL);
+    }
+  };
+
+  static pcre *_compile(std::string_view fqdn);
+  uint32_t _insert(std::string_view name);
+
+  int _count = 0;
+  std::vector<Node> _nodes{1}; ///< The root is node 0.
+  std::deque<std::string> _labels;
+  std::unordered_map<Edge, uint32_t, EdgeHash> _edges;
+  std::vector<Pattern> _patterns; ///< Globs that cannot be put in the trie, tried for every name.
+};
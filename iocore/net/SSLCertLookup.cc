@@ -155,6 +155,38 @@ transform_lower(std::string_view src, ts::MemSpan<char> dst)
   auto final = std::transform(src.begin(), src.end(), dst.data(), [](char c) -> char { return std::tolower(c); });
   *final++   = '\0';
 }
+
+// The key name index is kept at most half full so probes stay short.
+unsigned
+ticket_index_size(unsigned count)
+{
+  unsigned size = 2;
+  while (size < count * 2) {
+    size <<= 1;
+  }
+  return size;
+}
+
+unsigned *
+ticket_index_slots(const ssl_ticket_key_block *keyblock)
+{
+  return reinterpret_cast<unsigned *>(const_cast<ssl_ticket_key_t *>(keyblock->keys + keyblock->num_keys));
+}
+
+size_t
+ticket_block_size(unsigned count)
+{
+  return sizeof(ssl_ticket_key_block) + count * sizeof(ssl_ticket_key_t) + ticket_index_size(count) * sizeof(unsigned);
+}
+
+unsigned
+ticket_key_name_hash(const unsigned char *key_name)
+{
+  uint64_t lo, hi;
+  memcpy(&lo, key_name, sizeof(lo));
+  memcpy(&hi, key_name + sizeof(lo), sizeof(hi));
+  return static_cast<unsigned>(((lo ^ (hi * 0x9e3779b97f4a7c15ULL)) * 0xff51afd7ed558ccdULL) >> 32);
+}
 } // namespace
 
 // Zero out and free the heap space allocated for ticket keys to avoid leaking secrets.
@@ -164,8 +196,7 @@ ticket_block_free(void *ptr)
 {
   if (ptr) {
     ssl_ticket_key_block *key_block_ptr = static_cast<ssl_ticket_key_block *>(ptr);
-    unsigned num_ticket_keys            = key_block_ptr->num_keys;
-    memset(ptr, 0, sizeof(ssl_ticket_key_block) + num_ticket_keys * sizeof(ssl_ticket_key_t));
+    memset(ptr, 0, ticket_block_size(key_block_ptr->num_keys));
   }
   ats_free(ptr);
 }
@@ -174,14 +205,54 @@ ssl_ticket_key_block *
 ticket_block_alloc(unsigned count)
 {
   ssl_ticket_key_block *ptr;
-  size_t nbytes = sizeof(ssl_ticket_key_block) + count * sizeof(ssl_ticket_key_t);
+  size_t nbytes = ticket_block_size(count);
 
   ptr = static_cast<ssl_ticket_key_block *>(ats_malloc(nbytes));
   memset(ptr, 0, nbytes);
-  ptr->num_keys = count;
+  ptr->num_keys   = count;
+  ptr->index_mask = ticket_index_size(count) - 1;
 
   return ptr;
 }
+
+// Build the key name index once the keys are in place. If two keys share a name the most recent one is found.
+void
+ticket_block_index(ssl_ticket_key_block *keyblock)
+{
+  unsigned *slots = ticket_index_slots(keyblock);
+
+  memset(slots, 0, (keyblock->index_mask + 1) * sizeof(unsigned));
+  for (unsigned i = 0; i < keyblock->num_keys; ++i) {
+    unsigned slot = ticket_key_name_hash(keyblock->keys[i].key_name) & keyblock->index_mask;
+    while (slots[slot] != 0) {
+      if (memcmp(keyblock->keys[slots[slot] - 1].key_name, keyblock->keys[i].key_name, sizeof(keyblock->keys[i].key_name)) == 0) {
+        break;
+      }
+      slot = (slot + 1) & keyblock->index_mask;
+    }
+    if (slots[slot] == 0) {
+      slots[slot] = i + 1;
+    }
+  }
+}
+
+// Return the position of the key named @a key_name, or -1 if there is none.
+int
+ticket_block_find(const ssl_ticket_key_block *keyblock, const unsigned char *key_name)
+{
+  const unsigned *slots = ticket_index_slots(keyblock);
+  unsigned slot         = ticket_key_name_hash(key_name) & keyblock->index_mask;
+
+  while (slots[slot] != 0) {
+    const ssl_ticket_key_t &key = keyblock->keys[slots[slot] - 1];
+    if (memcmp(key.key_name, key_name, sizeof(key.key_name)) == 0) {
+      return slots[slot] - 1;
+    }
+    slot = (slot + 1) & keyblock->index_mask;
+  }
+  return -1;
+}
+
 ssl_ticket_key_block *
 ticket_block_create(char *ticket_key_data, int ticket_key_len)
 {
@@ -205,6 +276,7 @@ ticket_block_create(char *ticket_key_data, int ticket_key_len)
     memcpy(keyblock->keys[i].aes_key, data + sizeof(keyblock->keys[i].key_name) + sizeof(keyblock->keys[i].hmac_secret),
            sizeof(keyblock->keys[i].aes_key));
   }
+  ticket_block_index(keyblock);
 
   return keyblock;
 
@@ -247,11 +319,30 @@ fail:
 #endif /* TS_HAVE_OPENSSL_SESSION_TICKETS */
 }
 
+// Make a block with a new random key in front of the most recent keys of @a keyblock, keeping at most
+// @a max_keys keys. Tickets issued under the keys that are kept can still be resumed.
+ssl_ticket_key_block *
+ticket_block_rotate(const ssl_ticket_key_block *keyblock, unsigned max_keys)
+{
+  unsigned kept                 = keyblock ? std::min(keyblock->num_keys, std::max(max_keys, 1U) - 1) : 0;
+  ssl_ticket_key_block *rotated = ticket_block_alloc(kept + 1);
+
+  RAND_bytes(reinterpret_cast<unsigned char *>(&rotated->keys[0]), sizeof(rotated->keys[0]));
+  if (kept) {
+    memcpy(&rotated->keys[1], keyblock->keys, kept * sizeof(ssl_ticket_key_t));
+  }
+  ticket_block_index(rotated);
+
+  Debug("ssl", "rotated ticket keys, keeping %u previous keys", kept);
+  return rotated;
+}
+
 SSLCertContext::SSLCertContext(SSLCertContext const &other)
 {
   opt        = other.opt;
   userconfig = other.userconfig;
   keyblock   = other.keyblock;
+  lazy       = other.lazy;
   std::lock_guard<std::mutex> lock(other.ctx_mutex);
   ctx = other.ctx;
 }
@@ -263,6 +354,7 @@ SSLCertContext::operator=(SSLCertContext const &other)
     this->opt        = other.opt;
     this->userconfig = other.userconfig;
     this->keyblock   = other.keyblock;
+    this->lazy       = other.lazy;
     std::lock_guard<std::mutex> lock(other.ctx_mutex);
     this->ctx = other.ctx;
   }
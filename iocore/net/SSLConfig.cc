@@ -33,6 +33,7 @@
 
 #include <cstring>
 #include <cmath>
+#include <mutex>
 
 #include "tscore/ink_platform.h"
 #include "tscore/I_Layout.h"
@@ -44,8 +45,10 @@
 #include "P_SSLClientUtils.h"
 #include "P_SSLCertLookup.h"
 #include "SSLDiags.h"
+#include "SSLLazyCert.h"
 #include "SSLSessionCache.h"
 #include "SSLSessionTicket.h"
+#include "SSLStats.h"
 #include "YamlSNIConfig.h"
 
 int SSLConfig::configid                                     = 0;
@@ -70,8 +73,9 @@ uint32_t SSLConfigParams::server_max_early_data      = 0;
 uint32_t SSLConfigParams::server_recv_max_early_data = EARLY_DATA_DEFAULT_SIZE;
 bool SSLConfigParams::server_allow_early_data_params = false;
 
-int SSLConfigParams::async_handshake_enabled = 0;
-char *SSLConfigParams::engine_conf_file      = nullptr;
+int SSLConfigParams::async_handshake_enabled   = 0;
+int SSLConfigParams::async_private_key_threads = 0;
+char *SSLConfigParams::engine_conf_file        = nullptr;
 
 static std::unique_ptr<ConfigUpdateHandler<SSLCertificateConfig>> sslCertUpdate;
 static std::unique_ptr<ConfigUpdateHandler<SSLConfig>> sslConfigUpdate;
@@ -118,6 +122,8 @@ SSLConfigParams::reset()
   ssl_session_cache_timeout            = 0;
   ssl_session_cache_auto_clear         = 1;
   configExitOnLoadError                = 1;
+  server_cert_lazy_load                = 0;
+  server_cert_lazy_cache_size          = 10000;
 }
 
 void
@@ -303,6 +309,9 @@ SSLConfigParams::initialize()
 
   configFilePath = ats_stringdup(RecConfigReadConfigPath("proxy.config.ssl.server.multicert.filename"));
   REC_ReadConfigInteger(configExitOnLoadError, "proxy.config.ssl.server.multicert.exit_on_load_fail");
+  REC_ReadConfigInt32(server_cert_lazy_load, "proxy.config.ssl.server.multicert.lazy_load");
+  REC_ReadConfigInt32(server_cert_lazy_cache_size, "proxy.config.ssl.server.multicert.lazy_cache_size");
+  SSLLazyCert::set_cache_size(server_cert_lazy_cache_size);
 
   REC_ReadConfigStringAlloc(ssl_server_private_key_path, "proxy.config.ssl.server.private_key.path");
   set_paths_helper(ssl_server_private_key_path, nullptr, &serverKeyPathOnly, nullptr);
@@ -344,6 +353,7 @@ SSLConfigParams::initialize()
   ats_free(ssl_ocsp_response_path);
 
   REC_ReadConfigInt32(async_handshake_enabled, "proxy.config.ssl.async.handshake.enabled");
+  REC_ReadConfigInt32(async_private_key_threads, "proxy.config.ssl.async.private_key.threads");
   REC_ReadConfigStringAlloc(engine_conf_file, "proxy.config.ssl.engine.conf_file");
 
   REC_ReadConfigStringAlloc(server_groups_list, "proxy.config.ssl.server.groups_list");
@@ -640,6 +650,47 @@ SSLTicketParams::LoadTicketData(char *ticket_data, int ticket_data_len)
 #endif
 }
 
+// Replace the keys without touching the certificate contexts. A configured key file is read again whether or not it
+// changed, otherwise a random key is put in front of the ones in use, up to proxy.config.ssl.server.ticket_key.ring_size
+// keys in all, so that tickets issued before the rotation still resume.
+bool
+SSLTicketParams::RotateTicket()
+{
+  cleanup();
+#if TS_HAVE_OPENSSL_SESSION_TICKETS
+  ssl_ticket_key_block *keyblock = nullptr;
+
+  SSLConfig::scoped_config params;
+  SSLTicketKeyConfig::scoped_config ticket_params;
+
+  if (REC_ReadConfigStringAlloc(ticket_key_filename, "proxy.config.ssl.server.ticket_key.filename") == REC_ERR_OKAY &&
+      ticket_key_filename != nullptr) {
+    uint32_t elevate_setting = 0;
+    REC_ReadConfigInteger(elevate_setting, "proxy.config.ssl.cert.load_elevated");
+    ElevateAccess elevate_access(elevate_setting ? ElevateAccess::FILE_PRIVILEGE : 0);
+
+    ats_scoped_str ticket_key_path(Layout::relative_to(params->serverCertPathOnly, ticket_key_filename));
+    keyblock = ssl_create_ticket_keyblock(ticket_key_path);
+  } else {
+    int ring_size = 2;
+    REC_ReadConfigInteger(ring_size, "proxy.config.ssl.server.ticket_key.ring_size");
+    keyblock = ticket_block_rotate(ticket_params ? ticket_params->default_global_keyblock : nullptr, ring_size);
+  }
+  if (!keyblock) {
+    Error("Could not rotate ticket key from %s", ticket_key_filename);
+    return false;
+  }
+  default_global_keyblock = keyblock;
+  load_time               = time(nullptr);
+  SSL_INCREMENT_DYN_STAT(ssl_total_ticket_keys_renewed_stat);
+
+  Note("session ticket keys rotated, %u keys in use", keyblock->num_keys);
+  return true;
+#else
+  return false;
+#endif
+}
+
 void
 SSLTicketKeyConfig::startup()
 {
@@ -684,6 +735,44 @@ SSLTicketKeyConfig::reconfigure_data(char *ticket_data, int ticket_data_len)
   return true;
 }
 
+bool
+SSLTicketKeyConfig::rotate()
+{
+  // Serialize rotations so that each one builds on the keys published by the one before.
+  static std::mutex rotate_mutex;
+  std::lock_guard<std::mutex> lock(rotate_mutex);
+
+  SSLTicketParams *ticketKey = new SSLTicketParams();
+  if (!ticketKey->RotateTicket()) {
+    delete ticketKey;
+    return false;
+  }
+  configid = configProcessor.set(configid, ticketKey);
+  return true;
+}
+
+namespace
+{
+// Rotates the ticket keys on an ET_TASK thread, where the ticket key configuration is also reloaded.
+struct SSLTicketKeyRotateCont : public Continuation {
+  SSLTicketKeyRotateCont() : Continuation(new_ProxyMutex()) { SET_HANDLER(&SSLTicketKeyRotateCont::rotate); }
+
+  int
+  rotate(int /* event */, void * /* data */)
+  {
+    SSLTicketKeyConfig::rotate();
+    delete this;
+    return EVENT_DONE;
+  }
+};
+} // namespace
+
+void
+SSLTicketKeyConfig::schedule_rotate()
+{
+  eventProcessor.schedule_imm(new SSLTicketKeyRotateCont(), ET_TASK);
+}
+
 void
 SSLTicketParams::cleanup()
 {
@@ -0,0 +1,287 @@
+/** @file
+
+  Server certificates whose SSL_CTX is built on first use.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "SSLLazyCert.h"
+
+#include <algorithm>
+
+#include "tscore/ink_cap.h"
+#include "P_EventSystem.h"
+#include "P_UnixNet.h"
+#include "P_SSLConfig.h"
+#include "P_SSLNetVConnection.h"
+#include "SSLStats.h"
+
+namespace
+{
+// The LRU list of loaded contexts, most recently used first. Entries unlink themselves when they are destroyed,
+// so a certificate configuration that is replaced does not keep its contexts in memory.
+std::mutex lru_mutex;
+std::list<SSLLazyCert *> lru;
+size_t lru_limit = 10000;
+} // namespace
+
+/// Builds the context on an ET_TASK thread.
+struct SSLLazyCert::Loader : public Continuation {
+  explicit Loader(std::shared_ptr<SSLLazyCert> cert) : Continuation(new_ProxyMutex()), _cert(std::move(cert))
+  {
+    SET_HANDLER(&Loader::mainEvent);
+  }
+
+  int
+  mainEvent(int /* event */, Event * /* e */)
+  {
+    _cert->_load();
+    delete this;
+    return EVENT_DONE;
+  }
+
+  std::shared_ptr<SSLLazyCert> _cert;
+};
+
+/// Reschedules the handshakes of one net thread that wait on a context.
+struct SSLLazyCert::Wakeup : public Continuation {
+  Wakeup(std::shared_ptr<SSLLazyCert> cert, EThread *thread)
+    : Continuation(get_NetHandler(thread)->mutex), _cert(std::move(cert)), _thread(thread)
+  {
+    SET_HANDLER(&Wakeup::mainEvent);
+  }
+
+  int
+  mainEvent(int /* event */, Event * /* e */)
+  {
+    _cert->_wake(_thread);
+    delete this;
+    return EVENT_DONE;
+  }
+
+  std::shared_ptr<SSLLazyCert> _cert;
+  EThread *_thread;
+};
+
+SSLLazyCert::SSLLazyCert(shared_SSLMultiCertConfigParams settings, SSLMultiCertConfigLoader::CertLoadData data,
+                         std::set<std::string> names)
+  : _settings(std::move(settings)), _data(std::move(data)), _names(std::move(names))
+{
+}
+
+SSLLazyCert::~SSLLazyCert()
+{
+  std::lock_guard<std::mutex> lock(lru_mutex);
+  if (_in_lru) {
+    lru.erase(_lru_pos);
+  }
+}
+
+shared_SSL_CTX
+SSLLazyCert::acquire(SSLNetVConnection *vc, bool &wait)
+{
+  shared_SSL_CTX ctx;
+  bool load = false;
+
+  wait = false;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    switch (_state) {
+    case State::LOADED:
+      ctx = _ctx;
+      break;
+    case State::FAILED:
+      return nullptr;
+    case State::UNLOADED:
+      _state = State::LOADING;
+      load   = true;
+      // fall through
+    case State::LOADING:
+      _waiters.push_back(vc);
+      vc->set_lazy_cert_wait(shared_from_this());
+      wait = true;
+      break;
+    }
+  }
+
+  if (ctx) {
+    this->_touch();
+    return ctx;
+  }
+
+  SSL_INCREMENT_DYN_STAT(ssl_lazy_cert_handshake_waits_stat);
+  if (load) {
+    Debug("ssl", "loading certificate %s on first use", _data.cert_names_list.empty() ? "" : _data.cert_names_list[0].c_str());
+    eventProcessor.schedule_imm(new Loader(shared_from_this()), ET_TASK);
+  }
+  return nullptr;
+}
+
+shared_SSL_CTX
+SSLLazyCert::loaded()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _ctx;
+}
+
+void
+SSLLazyCert::cancel(SSLNetVConnection *vc)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _waiters.erase(std::remove(_waiters.begin(), _waiters.end(), vc), _waiters.end());
+}
+
+void
+SSLLazyCert::_load()
+{
+  SSLConfig::scoped_config params;
+  shared_SSL_CTX ctx;
+  std::vector<EThread *> threads;
+
+  {
+    // Certificates may only be readable with elevated access, as at startup.
+    uint32_t elevate_setting = 0;
+    REC_ReadConfigInteger(elevate_setting, "proxy.config.ssl.cert.load_elevated");
+    ElevateAccess elevate_access(elevate_setting ? ElevateAccess::FILE_PRIVILEGE : 0);
+
+    SSLMultiCertConfigLoader loader(params);
+    ctx = loader.init_lazy_ssl_ctx(_data, _settings, _names);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _ctx   = ctx;
+    _state = ctx ? State::LOADED : State::FAILED;
+    for (auto vc : _waiters) {
+      if (std::find(threads.begin(), threads.end(), vc->thread) == threads.end()) {
+        threads.push_back(vc->thread);
+      }
+    }
+  }
+
+  if (ctx) {
+    SSL_INCREMENT_DYN_STAT(ssl_lazy_cert_loads_stat);
+    this->_insert();
+  } else {
+    SSL_INCREMENT_DYN_STAT(ssl_lazy_cert_load_failures_stat);
+    Error("failed to load certificate %s on first use", _data.cert_names_list.empty() ? "" : _data.cert_names_list[0].c_str());
+  }
+
+  for (auto thread : threads) {
+    thread->schedule_imm(new Wakeup(shared_from_this(), thread));
+  }
+}
+
+void
+SSLLazyCert::_wake(EThread *thread)
+{
+  std::vector<SSLNetVConnection *> ready;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto split = std::stable_partition(_waiters.begin(), _waiters.end(), [thread](auto vc) { return vc->thread != thread; });
+    ready.assign(split, _waiters.end());
+    _waiters.erase(split, _waiters.end());
+  }
+
+  // The certificate callback runs again and picks up the context, or falls back if loading failed.
+  for (auto vc : ready) {
+    vc->set_lazy_cert_wait(nullptr);
+    vc->readReschedule(vc->nh);
+  }
+}
+
+void
+SSLLazyCert::_evict()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_state == State::LOADED) {
+    _ctx   = nullptr;
+    _state = State::UNLOADED;
+    SSL_INCREMENT_DYN_STAT(ssl_lazy_cert_evictions_stat);
+  }
+}
+
+void
+SSLLazyCert::_touch()
+{
+  ink_hrtime now = Thread::get_hrtime();
+  if (now - _touched.load(std::memory_order_relaxed) < HRTIME_SECOND) {
+    return;
+  }
+  _touched.store(now, std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(lru_mutex);
+  if (_in_lru) {
+    lru.splice(lru.begin(), lru, _lru_pos);
+  }
+}
+
+void
+SSLLazyCert::_insert()
+{
+  std::vector<std::shared_ptr<SSLLazyCert>> victims;
+
+  {
+    std::lock_guard<std::mutex> lock(lru_mutex);
+    if (_in_lru) {
+      lru.splice(lru.begin(), lru, _lru_pos);
+    } else {
+      lru.push_front(this);
+      _lru_pos = lru.begin();
+      _in_lru  = true;
+    }
+    this->_trim(victims);
+  }
+
+  for (auto &victim : victims) {
+    victim->_evict();
+  }
+}
+
+/// Take entries off the LRU list until it fits. Must be called with the LRU lock held.
+void
+SSLLazyCert::_trim(std::vector<std::shared_ptr<SSLLazyCert>> &victims)
+{
+  while (lru.size() > lru_limit) {
+    SSLLazyCert *victim = lru.back();
+    victim->_in_lru     = false;
+    lru.pop_back();
+    // An entry being destroyed has nothing left to release.
+    if (auto cert = victim->weak_from_this().lock()) {
+      victims.push_back(std::move(cert));
+    }
+  }
+}
+
+void
+SSLLazyCert::set_cache_size(int n)
+{
+  std::vector<std::shared_ptr<SSLLazyCert>> victims;
+
+  {
+    std::lock_guard<std::mutex> lock(lru_mutex);
+    lru_limit = std::max(n, 1);
+    _trim(victims);
+  }
+
+  for (auto &victim : victims) {
+    victim->_evict();
+  }
+}
@@ -0,0 +1,101 @@
+/** @file
+
+  Server certificates whose SSL_CTX is built on first use.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tscore/ink_hrtime.h"
+#include "P_SSLCertLookup.h"
+#include "P_SSLUtils.h"
+
+class EThread;
+class SSLNetVConnection;
+
+/**
+   A certificate line of ssl_multicert.config whose SSL_CTX is only built when a handshake needs it.
+
+   With proxy.config.ssl.server.multicert.lazy_load set, SSLMultiCertConfigLoader reads the certificates just to
+   index their names and puts one of these in each SSLCertContext instead of a context. The first handshake for
+   one of the names pauses in the certificate callback while the context is built on an ET_TASK thread. Every
+   handshake waiting on it is then rescheduled on its own thread and finds the context loaded.
+
+   Loaded contexts are kept on a process wide LRU list of proxy.config.ssl.server.multicert.lazy_cache_size
+   entries. A context that falls off the end is released and built again the next time it is asked for.
+ */
+class SSLLazyCert : public std::enable_shared_from_this<SSLLazyCert>
+{
+public:
+  SSLLazyCert(shared_SSLMultiCertConfigParams settings, SSLMultiCertConfigLoader::CertLoadData data, std::set<std::string> names);
+  ~SSLLazyCert();
+
+  /** Get the context for the handshake on @a vc.
+
+      If the context is not loaded, loading is started, @a wait is set and @c nullptr is returned. The handshake
+      must pause; @a vc is rescheduled once loading is done. If loading failed @c nullptr is returned and @a wait
+      is not set.
+   */
+  shared_SSL_CTX acquire(SSLNetVConnection *vc, bool &wait);
+
+  /// @return The context if it is loaded, without loading it.
+  shared_SSL_CTX loaded();
+
+  /// Stop waiting on behalf of @a vc, which is being closed. Must be called on the thread of @a vc.
+  void cancel(SSLNetVConnection *vc);
+
+  /// Set the number of loaded contexts to keep.
+  static void set_cache_size(int n);
+
+private:
+  enum class State { UNLOADED, LOADING, LOADED, FAILED };
+
+  struct Loader;
+  struct Wakeup;
+
+  void _load();
+  void _wake(EThread *thread);
+  void _evict();
+  void _touch();
+  void _insert();
+  static void _trim(std::vector<std::shared_ptr<SSLLazyCert>> &victims);
+
+  shared_SSLMultiCertConfigParams _settings;
+  SSLMultiCertConfigLoader::CertLoadData _data;
+  std::set<std::string> _names;
+
+  std::mutex _mutex; ///< Protects the members below. Never held while taking the LRU lock.
+  State _state = State::UNLOADED;
+  shared_SSL_CTX _ctx;
+  std::vector<SSLNetVConnection *> _waiters; ///< Paused handshakes, removed on their own thread.
+
+  // Protected by the LRU lock.
+  std::list<SSLLazyCert *>::iterator _lru_pos;
+  bool _in_lru = false;
+  std::atomic<ink_hrtime> _touched{0}; ///< Limits LRU updates for a busy context to one a second.
+};
@@ -28,6 +28,7 @@
 #include "P_OCSPStapling.h"
 #include "P_SSLSNI.h"
 #include "SSLStats.h"
+#include "SSLPrivateKeyOffload.h"
 
 //
 // Global Data
@@ -62,6 +63,8 @@ SSLNetProcessor::start(int, size_t stacksize)
   SSLInitializeLibrary();
   SSLConfig::startup();
   SSLPostConfigInitialize();
+  // Before the certificates are loaded, so that their keys are offloaded.
+  SSLPrivateKeyOffloadStart(SSLConfigParams::async_private_key_threads, stacksize);
   SNIConfig::startup();
 
   if (!SSLCertificateConfig::startup()) {
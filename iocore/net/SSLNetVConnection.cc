@@ -40,6 +40,7 @@
 #include "P_SSLSNI.h"
 #include "BIO_fastopen.h"
 #include "SSLStats.h"
+#include "SSLLazyCert.h"
 #include "SSLInternal.h"
 #include "P_ALPNSupport.h"
 
@@ -174,7 +175,20 @@ make_ssl_connection(SSL_CTX *ctx, SSLNetVConnection *netvc)
     } else {
       netvc->initialize_handshake_buffers();
       BIO *rbio = BIO_new(BIO_s_mem());
-      BIO *wbio = BIO_new_fd(netvc->get_socket(), BIO_NOCLOSE);
+      BIO *wbio;
+#if TS_HAS_KTLS
+      // OpenSSL moves the write key into the kernel at the end of the
+      // handshake, which only a socket BIO supports. The read side stays
+      // in user space since the handshake is read through a memory BIO.
+      if (netvc->options.f_ktls) {
+        SSL_set_options(ssl, SSL_OP_ENABLE_KTLS);
+        wbio = BIO_new_socket(netvc->get_socket(), BIO_NOCLOSE);
+      } else {
+        wbio = BIO_new_fd(netvc->get_socket(), BIO_NOCLOSE);
+      }
+#else
+      wbio = BIO_new_fd(netvc->get_socket(), BIO_NOCLOSE);
+#endif
       BIO_set_mem_eof_return(wbio, -1);
       SSL_set_bio(ssl, rbio, wbio);
 
@@ -760,8 +774,7 @@ SSLNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf
 
   do {
     // What is remaining left in the next block?
-    l                   = buf.reader()->block_read_avail();
-    char *current_block = buf.reader()->start();
+    l = buf.reader()->block_read_avail();
 
     // check if to amount to write exceeds that in this buffer
     int64_t wavail = towrite - total_written;
@@ -770,6 +783,33 @@ SSLNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf
       l = wavail;
     }
 
+    // A file range from the cache, only ever handed to a kTLS connection.
+    // The kernel splits it into records itself.
+    if (l > 0 && buf.reader()->block->is_file_range()) {
+      ink_assert(ktlsSend);
+      redoWriteSize      = 0;
+      IOBufferBlock *b   = buf.reader()->block.get();
+      off_t offset       = b->file_offset() + buf.reader()->start_offset;
+      try_to_write       = l;
+      num_really_written = 0;
+      // the cache took the range back, the rest of the object is lost
+      if (!b->data->hold_file_range()) {
+        err                = SSL_ERROR_NONE;
+        num_really_written = -EIO;
+        break;
+      }
+      err = SSLSendFile(ssl, b->data->_fd, offset, l, num_really_written);
+      b->data->unhold_file_range();
+      if (num_really_written > 0) {
+        total_written += num_really_written;
+        buf.reader()->consume(num_really_written);
+        NET_SUM_DYN_STAT(net_zero_copy_bytes_stat, num_really_written);
+      }
+      NET_INCREMENT_DYN_STAT(net_calls_to_write_stat);
+      continue;
+    }
+    char *current_block = buf.reader()->start();
+
     // TS-2365: If the SSL max record size is set and we have
     // more data than that, break this into smaller write
     // operations.
@@ -924,6 +964,11 @@ SSLNetVConnection::clear()
 {
   _serverName.reset();
 
+  if (lazyCertWait) {
+    lazyCertWait->cancel(this);
+    lazyCertWait.reset();
+  }
+
   if (ssl != nullptr) {
     SSL_free(ssl);
     ssl = nullptr;
@@ -936,6 +981,7 @@ SSLNetVConnection::clear()
   sslTotalBytesSent           = 0;
   sslClientRenegotiationAbort = false;
   sslSessionCacheHit          = false;
+  ktlsSend                    = false;
 
   curHook         = nullptr;
   hookOpRequested = SSL_HOOK_OP_DEFAULT;
@@ -1298,6 +1344,16 @@ SSLNetVConnection::sslServerHandShakeEvent(int &err)
       SSL_INCREMENT_DYN_STAT_EX(ssl_total_handshake_time_stat, ssl_handshake_time);
       SSL_INCREMENT_DYN_STAT(ssl_total_success_handshake_count_in_stat);
     }
+
+#if TS_HAS_KTLS
+    // OpenSSL quietly keeps the records in user space if the kernel or the
+    // negotiated cipher can't take them.
+    if (options.f_ktls) {
+      ktlsSend = BIO_get_ktls_send(SSL_get_wbio(ssl));
+      SSLVCDebug(this, "kernel TLS send %s for %s", ktlsSend ? "enabled" : "not available", SSL_get_cipher_name(ssl));
+      SSL_INCREMENT_DYN_STAT(ktlsSend ? ssl_ktls_send_connections_stat : ssl_ktls_fallback_stat);
+    }
+#endif
     {
       const unsigned char *proto = nullptr;
       unsigned len               = 0;
@@ -0,0 +1,349 @@
+/** @file
+
+  Private key operations of inbound TLS handshakes run on a crypto thread pool.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "SSLPrivateKeyOffload.h"
+
+#include "tscore/ink_config.h"
+#include "P_EventSystem.h"
+#include "P_SSLConfig.h"
+#include "SSLDiags.h"
+#include "SSLStats.h"
+
+#if TS_USE_TLS_ASYNC && HAVE_EVENTFD
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <openssl/async.h>
+#include <openssl/ec.h>
+#include <openssl/rsa.h>
+
+namespace
+{
+using rsa_crypt_func = int (*)(int flen, const unsigned char *from, unsigned char *to, RSA *rsa, int padding);
+using ec_sign_func   = int (*)(int type, const unsigned char *dgst, int dlen, unsigned char *sig, unsigned int *siglen,
+                             const BIGNUM *kinv, const BIGNUM *r, EC_KEY *eckey);
+
+EventType ET_SSL_CRYPTO = -1;
+RSA_METHOD *offload_rsa_method;
+EC_KEY_METHOD *offload_ec_method;
+rsa_crypt_func rsa_priv_enc;
+rsa_crypt_func rsa_priv_dec;
+ec_sign_func ec_sign;
+
+/// Identifies our wait fd in the ASYNC_WAIT_CTX of a connection.
+const char wait_key = 0;
+
+/// The eventfd a connection waits on. It is closed once both the connection and the last operation are done with it.
+struct WakeFd {
+  explicit WakeFd(int fd) : fd(fd) {}
+  ~WakeFd() { close(fd); }
+
+  int fd;
+};
+
+struct PrivateKeyOp {
+  std::function<int(PrivateKeyOp &)> run;
+  std::vector<unsigned char> in;
+  std::vector<unsigned char> out;
+  unsigned int outlen = 0;
+  int result          = -1;
+  std::shared_ptr<WakeFd> wake;
+  std::atomic<bool> done{false};
+};
+
+/// Runs one operation on an ET_SSL_CRYPTO thread and wakes the connection.
+struct PrivateKeyTask : public Continuation {
+  explicit PrivateKeyTask(std::shared_ptr<PrivateKeyOp> op) : Continuation(new_ProxyMutex()), _op(std::move(op))
+  {
+    SET_HANDLER(&PrivateKeyTask::mainEvent);
+  }
+
+  int
+  mainEvent(int /* event */, Event * /* e */)
+  {
+    ink_hrtime start = Thread::get_hrtime_updated();
+    _op->result      = _op->run(*_op);
+    SSL_INCREMENT_DYN_STAT_EX(ssl_private_key_offload_busy_time_stat, Thread::get_hrtime_updated() - start);
+    SSL_DECREMENT_DYN_STAT(ssl_private_key_offload_queue_depth_stat);
+
+    // The connection may be gone once done is set, so only the fd is used after that.
+    std::shared_ptr<WakeFd> wake = std::move(_op->wake);
+    uint64_t one                 = 1;
+    _op->done.store(true, std::memory_order_release);
+    if (write(wake->fd, &one, sizeof(one)) != sizeof(one)) {
+      Warning("failed to wake a handshake waiting for a private key operation: %s", strerror(errno));
+    }
+
+    delete this;
+    return EVENT_DONE;
+  }
+
+  std::shared_ptr<PrivateKeyOp> _op;
+};
+
+void
+wake_fd_cleanup(ASYNC_WAIT_CTX * /* ctx */, const void * /* key */, OSSL_ASYNC_FD /* fd */, void *custom)
+{
+  delete static_cast<std::shared_ptr<WakeFd> *>(custom);
+}
+
+/**
+   Run @a op on a crypto thread if called in an ASYNC job, pausing the job until it is done, or inline otherwise.
+
+   The operation keeps its own copies of its input and output so that it stays valid if the connection is closed
+   while the job is paused.
+ */
+int
+offload(std::shared_ptr<PrivateKeyOp> op)
+{
+  ASYNC_JOB *job = ASYNC_get_current_job();
+  if (job == nullptr) {
+    return op->run(*op);
+  }
+
+  ASYNC_WAIT_CTX *waitctx = ASYNC_get_wait_ctx(job);
+  OSSL_ASYNC_FD fd;
+  void *custom = nullptr;
+  if (!ASYNC_WAIT_CTX_get_fd(waitctx, &wait_key, &fd, &custom)) {
+    fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+      return op->run(*op);
+    }
+    auto wake = new std::shared_ptr<WakeFd>(std::make_shared<WakeFd>(fd));
+    if (!ASYNC_WAIT_CTX_set_wait_fd(waitctx, &wait_key, fd, wake, wake_fd_cleanup)) {
+      delete wake;
+      return op->run(*op);
+    }
+    custom = wake;
+  }
+  op->wake = *static_cast<std::shared_ptr<WakeFd> *>(custom);
+
+  SSL_INCREMENT_DYN_STAT(ssl_private_key_offload_ops_stat);
+  SSL_INCREMENT_DYN_STAT(ssl_private_key_offload_queue_depth_stat);
+  eventProcessor.schedule_imm(new PrivateKeyTask(op), ET_SSL_CRYPTO);
+
+  // The net thread resumes the job when the fd is signalled, after done is set.
+  while (!op->done.load(std::memory_order_acquire)) {
+    ASYNC_pause_job();
+  }
+
+  uint64_t count;
+  if (read(fd, &count, sizeof(count)) < 0) {
+    Debug("ssl", "no wake up pending on fd %d for a private key operation", fd);
+  }
+  return op->result;
+}
+
+int
+rsa_crypt(rsa_crypt_func func, int flen, const unsigned char *from, unsigned char *to, RSA *rsa, int padding)
+{
+  auto op = std::make_shared<PrivateKeyOp>();
+
+  op->in.assign(from, from + flen);
+  op->out.resize(RSA_size(rsa));
+  RSA_up_ref(rsa);
+  op->run = [func, rsa, padding](PrivateKeyOp &o) {
+    int result = func(o.in.size(), o.in.data(), o.out.data(), rsa, padding);
+    RSA_free(rsa);
+    return result;
+  };
+
+  int result = offload(op);
+  if (result > 0) {
+    memcpy(to, op->out.data(), result);
+  }
+  return result;
+}
+
+int
+offload_rsa_priv_enc(int flen, const unsigned char *from, unsigned char *to, RSA *rsa, int padding)
+{
+  return rsa_crypt(rsa_priv_enc, flen, from, to, rsa, padding);
+}
+
+int
+offload_rsa_priv_dec(int flen, const unsigned char *from, unsigned char *to, RSA *rsa, int padding)
+{
+  return rsa_crypt(rsa_priv_dec, flen, from, to, rsa, padding);
+}
+
+int
+offload_ec_sign(int type, const unsigned char *dgst, int dlen, unsigned char *sig, unsigned int *siglen, const BIGNUM *kinv,
+                const BIGNUM *r, EC_KEY *eckey)
+{
+  // Precomputed values are never passed by libssl, do not bother copying them.
+  if (kinv != nullptr || r != nullptr) {
+    return ec_sign(type, dgst, dlen, sig, siglen, kinv, r, eckey);
+  }
+
+  auto op = std::make_shared<PrivateKeyOp>();
+
+  op->in.assign(dgst, dgst + dlen);
+  op->out.resize(ECDSA_size(eckey));
+  EC_KEY_up_ref(eckey);
+  op->run = [type, eckey](PrivateKeyOp &o) {
+    int result = ec_sign(type, o.in.data(), o.in.size(), o.out.data(), &o.outlen, nullptr, nullptr, eckey);
+    EC_KEY_free(eckey);
+    return result;
+  };
+
+  int result = offload(op);
+  if (result == 1) {
+    memcpy(sig, op->out.data(), op->outlen);
+    *siglen = op->outlen;
+  }
+  return result;
+}
+
+/// @return A copy of @a pkey using the offload method, or @c nullptr if it is not a built in RSA or EC key.
+EVP_PKEY *
+offload_key(EVP_PKEY *pkey)
+{
+  EVP_PKEY *offloaded = nullptr;
+
+  switch (EVP_PKEY_base_id(pkey)) {
+  case EVP_PKEY_RSA: {
+    RSA *rsa = EVP_PKEY_get1_RSA(pkey);
+    if (rsa == nullptr || RSA_get0_engine(rsa) != nullptr || RSA_get_method(rsa) != RSA_PKCS1_OpenSSL()) {
+      RSA_free(rsa);
+      break;
+    }
+    offloaded = EVP_PKEY_new();
+    if (offloaded == nullptr || !RSA_set_method(rsa, offload_rsa_method) || !EVP_PKEY_assign_RSA(offloaded, rsa)) {
+      RSA_free(rsa);
+      EVP_PKEY_free(offloaded);
+      offloaded = nullptr;
+    }
+    break;
+  }
+  case EVP_PKEY_EC: {
+    EC_KEY *eckey = EVP_PKEY_get1_EC_KEY(pkey);
+    if (eckey == nullptr || EC_KEY_get0_engine(eckey) != nullptr || EC_KEY_get_method(eckey) != EC_KEY_OpenSSL()) {
+      EC_KEY_free(eckey);
+      break;
+    }
+    offloaded = EVP_PKEY_new();
+    if (offloaded == nullptr || !EC_KEY_set_method(eckey, offload_ec_method) || !EVP_PKEY_assign_EC_KEY(offloaded, eckey)) {
+      EC_KEY_free(eckey);
+      EVP_PKEY_free(offloaded);
+      offloaded = nullptr;
+    }
+    break;
+  }
+  default:
+    break;
+  }
+
+  return offloaded;
+}
+} // namespace
+
+void
+SSLPrivateKeyOffloadStart(int n_threads, size_t stacksize)
+{
+  if (n_threads <= 0 || !SSLConfigParams::async_handshake_enabled) {
+    if (n_threads > 0) {
+      Warning("proxy.config.ssl.async.private_key.threads requires proxy.config.ssl.async.handshake.enabled");
+    }
+    return;
+  }
+
+  rsa_priv_enc       = RSA_meth_get_priv_enc(RSA_PKCS1_OpenSSL());
+  rsa_priv_dec       = RSA_meth_get_priv_dec(RSA_PKCS1_OpenSSL());
+  offload_rsa_method = RSA_meth_dup(RSA_PKCS1_OpenSSL());
+  if (offload_rsa_method == nullptr || !RSA_meth_set1_name(offload_rsa_method, "ATS offloaded RSA") ||
+      !RSA_meth_set_priv_enc(offload_rsa_method, offload_rsa_priv_enc) ||
+      !RSA_meth_set_priv_dec(offload_rsa_method, offload_rsa_priv_dec)) {
+    SSLError("failed to set up the RSA private key offload method");
+    return;
+  }
+
+  int (*sign_setup)(EC_KEY *, BN_CTX *, BIGNUM **, BIGNUM **);
+  ECDSA_SIG *(*sign_sig)(const unsigned char *, int, const BIGNUM *, const BIGNUM *, EC_KEY *);
+  EC_KEY_METHOD_get_sign(EC_KEY_OpenSSL(), &ec_sign, &sign_setup, &sign_sig);
+  offload_ec_method = EC_KEY_METHOD_new(EC_KEY_OpenSSL());
+  if (offload_ec_method == nullptr) {
+    SSLError("failed to set up the EC private key offload method");
+    return;
+  }
+  EC_KEY_METHOD_set_sign(offload_ec_method, offload_ec_sign, sign_setup, sign_sig);
+
+  ET_SSL_CRYPTO = eventProcessor.spawn_event_threads("ET_SSL_CRYPTO", n_threads, stacksize);
+  Note("offloading TLS private key operations to %d threads", n_threads);
+}
+
+bool
+SSLOffloadPrivateKeys(SSL_CTX *ctx)
+{
+  if (ET_SSL_CRYPTO < 0) {
+    return true;
+  }
+
+  // Each certificate of a dual RSA / ECDSA context has its own key.
+  int more = SSL_CTX_set_current_cert(ctx, SSL_CERT_SET_FIRST);
+  for (; more == 1; more = SSL_CTX_set_current_cert(ctx, SSL_CERT_SET_NEXT)) {
+    EVP_PKEY *pkey = SSL_CTX_get0_privatekey(ctx);
+    if (pkey == nullptr) {
+      continue;
+    }
+    EVP_PKEY *offloaded = offload_key(pkey);
+    if (offloaded == nullptr) {
+      Debug("ssl", "private key of type %d is not offloaded", EVP_PKEY_base_id(pkey));
+      continue;
+    }
+    int ok = SSL_CTX_use_PrivateKey(ctx, offloaded);
+    EVP_PKEY_free(offloaded);
+    if (!ok) {
+      SSLError("failed to offload the server private key");
+      return false;
+    }
+  }
+  SSL_CTX_set_current_cert(ctx, SSL_CERT_SET_FIRST);
+
+  return true;
+}
+
+#else /* !(TS_USE_TLS_ASYNC && HAVE_EVENTFD) */
+
+void
+SSLPrivateKeyOffloadStart(int n_threads, size_t /* stacksize */)
+{
+  if (n_threads > 0) {
+    Warning("proxy.config.ssl.async.private_key.threads is not supported by this build");
+  }
+}
+
+bool
+SSLOffloadPrivateKeys(SSL_CTX * /* ctx */)
+{
+  return true;
+}
+
+#endif
@@ -0,0 +1,43 @@
+/** @file
+
+  Private key operations of inbound TLS handshakes run on a crypto thread pool.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <openssl/ssl.h>
+
+/*
+   With proxy.config.ssl.async.handshake.enabled the handshake of an inbound connection runs in an OpenSSL ASYNC
+   job. SSLOffloadPrivateKeys() gives the RSA and EC keys of a server context a method that, inside such a job,
+   queues the signature or decryption to the ET_SSL_CRYPTO threads and pauses the job. The connection waits on an
+   eventfd registered with the job, exactly as it would for an asynchronous engine, and is resumed by the net
+   thread once the crypto thread signals it. Outside of a job the operation is done inline as usual.
+ */
+
+/// Start @a n_threads crypto threads. Does nothing if @a n_threads is 0 or asynchronous handshakes are disabled.
+void SSLPrivateKeyOffloadStart(int n_threads, size_t stacksize);
+
+/// Replace the private keys of @a ctx with ones whose operations are offloaded, if offloading is started.
+/// @return @c false if a key could not be replaced.
+bool SSLOffloadPrivateKeys(SSL_CTX *ctx);
@@ -37,23 +37,14 @@
 #include "tscpp/util/TextView.h"
 #include "tscore/I_Layout.h"
 #include <sstream>
-#include <pcre.h>
 
 static ConfigUpdateHandler<SNIConfig> *sniConfigUpdate;
-static constexpr int OVECSIZE{30};
 
 const NextHopProperty *
 SNIConfigParams::getPropertyConfig(const std::string &servername) const
 {
-  const NextHopProperty *nps = nullptr;
-  for (auto &&item : next_hop_list) {
-    if (pcre_exec(item.match, nullptr, servername.c_str(), servername.length(), 0, 0, nullptr, 0) >= 0) {
-      // Found a match
-      nps = &item.prop;
-      break;
-    }
-  }
-  return nps;
+  int idx = fqdn_matcher.find(servername);
+  return idx == SNINameMatcher::NO_MATCH ? nullptr : &next_hop_list[idx].prop;
 }
 
 void
@@ -61,7 +52,7 @@ SNIConfigParams::loadSNIConfig()
 {
   for (auto &item : Y_sni.items) {
     auto ai = sni_action_list.emplace(sni_action_list.end());
-    ai->setGlobName(item.fqdn);
+    fqdn_matcher.add(item.fqdn);
     Debug("ssl", "name: %s", item.fqdn.data());
 
     // set SNI based actions to be called in the ssl_servername_only callback
@@ -99,7 +90,6 @@ SNIConfigParams::loadSNIConfig()
                      params->clientCACertPath);
     }
 
-    nps->setGlobName(item.fqdn);
     nps->prop.verifyServerPolicy     = item.verify_server_policy;
     nps->prop.verifyServerProperties = item.verify_server_properties;
     nps->prop.tls_upstream           = item.tls_upstream;
@@ -113,44 +103,17 @@ SNIConfigParams::SNIConfigParams() {}
 std::pair<const actionVector *, ActionItem::Context>
 SNIConfigParams::get(const std::string &servername) const
 {
-  int ovector[OVECSIZE];
   ActionItem::Context context;
+  std::vector<std::string> groups;
 
-  for (const auto &retval : sni_action_list) {
-    int length = servername.length();
-    if (retval.match == nullptr && length == 0) {
-      return {&retval.actions, context};
-    } else if (auto offset = pcre_exec(retval.match, nullptr, servername.c_str(), length, 0, 0, ovector, OVECSIZE); offset >= 0) {
-      if (offset == 1) {
-        // first pair identify the portion of the subject string matched by the entire pattern
-        if (ovector[0] == 0 && ovector[1] == length) {
-          // full match
-          return {&retval.actions, context};
-        } else {
-          continue;
-        }
-      }
-      // If contains groups
-      if (offset == 0) {
-        // reset to max if too many.
-        offset = OVECSIZE / 3;
-      }
-
-      const char *psubStrMatchStr = nullptr;
-      std::vector<std::string> groups;
-      for (int strnum = 1; strnum < offset; strnum++) {
-        pcre_get_substring(servername.c_str(), ovector, offset, strnum, &(psubStrMatchStr));
-        groups.emplace_back(psubStrMatchStr);
-      }
-      context._fqdn_wildcard_captured_groups = std::move(groups);
-      if (psubStrMatchStr) {
-        pcre_free_substring(psubStrMatchStr);
-      }
-
-      return {&retval.actions, context};
-    }
+  int idx = fqdn_matcher.find(servername, &groups);
+  if (idx == SNINameMatcher::NO_MATCH) {
+    return {nullptr, context};
+  }
+  if (!groups.empty()) {
+    context._fqdn_wildcard_captured_groups = std::move(groups);
   }
-  return {nullptr, context};
+  return {&sni_action_list[idx].actions, context};
 }
 
 int
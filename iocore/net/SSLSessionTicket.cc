@@ -87,31 +87,31 @@ ssl_callback_session_ticket(SSL *ssl, unsigned char *keyname, unsigned char *iv,
     SSL_INCREMENT_DYN_STAT(ssl_total_tickets_created_stat);
     return 1;
   } else if (enc == 0) {
-    for (unsigned i = 0; i < keyblock->num_keys; ++i) {
-      if (memcmp(keyname, keyblock->keys[i].key_name, sizeof(keyblock->keys[i].key_name)) == 0) {
-        EVP_DecryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), nullptr, keyblock->keys[i].aes_key, iv);
-        HMAC_Init_ex(hctx, keyblock->keys[i].hmac_secret, sizeof(keyblock->keys[i].hmac_secret), evp_md_func, nullptr);
-
-        Debug("ssl_session_ticket", "verify the ticket for an existing session.");
-        // Increase the total number of decrypted tickets.
-        SSL_INCREMENT_DYN_STAT(ssl_total_tickets_verified_stat);
-
-        if (i != 0) { // The number of tickets decrypted with "older" keys.
-          SSL_INCREMENT_DYN_STAT(ssl_total_tickets_verified_old_key_stat);
-        }
+    int i = ticket_block_find(keyblock, keyname);
+    if (i >= 0) {
+      const ssl_ticket_key_t &key = keyblock->keys[i];
+      EVP_DecryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), nullptr, key.aes_key, iv);
+      HMAC_Init_ex(hctx, key.hmac_secret, sizeof(key.hmac_secret), evp_md_func, nullptr);
+
+      Debug("ssl_session_ticket", "verify the ticket for an existing session.");
+      // Increase the total number of decrypted tickets.
+      SSL_INCREMENT_DYN_STAT(ssl_total_tickets_verified_stat);
+
+      if (i != 0) { // The number of tickets decrypted with "older" keys.
+        SSL_INCREMENT_DYN_STAT(ssl_total_tickets_verified_old_key_stat);
+      }
 
-        netvc.setSSLSessionCacheHit(true);
+      netvc.setSSLSessionCacheHit(true);
 
 #ifdef TLS1_3_VERSION
-        if (SSL_version(ssl) >= TLS1_3_VERSION) {
-          Debug("ssl_session_ticket", "make sure tickets are only used once.");
-          return 2;
-        }
+      if (SSL_version(ssl) >= TLS1_3_VERSION) {
+        Debug("ssl_session_ticket", "make sure tickets are only used once.");
+        return 2;
+      }
 #endif
 
-        // When we decrypt with an "older" key, encrypt the ticket again with the most recent key.
-        return (i == 0) ? 1 : 2;
-      }
+      // When we decrypt with an "older" key, encrypt the ticket again with the most recent key.
+      return (i == 0) ? 1 : 2;
     }
 
     Debug("ssl_session_ticket", "keyname is not consistent.");
@@ -191,6 +191,30 @@ SSLInitializeStatistics()
   RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_sni_name_set_failure", RECD_COUNTER, RECP_PERSISTENT,
                      (int)ssl_sni_name_set_failure, RecRawStatSyncCount);
 
+  // kernel TLS stats
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ktls_send_connections", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_ktls_send_connections_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ktls_fallback", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_ktls_fallback_stat, RecRawStatSyncCount);
+
+  // lazily loaded server certificate stats
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.lazy_cert_loads", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_lazy_cert_loads_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.lazy_cert_load_failures", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_lazy_cert_load_failures_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.lazy_cert_evictions", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_lazy_cert_evictions_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.lazy_cert_handshake_waits", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_lazy_cert_handshake_waits_stat, RecRawStatSyncCount);
+
+  // private key offload stats
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.private_key_offload_ops", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_private_key_offload_ops_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.private_key_offload_queue_depth", RECD_INT, RECP_NON_PERSISTENT,
+                     (int)ssl_private_key_offload_queue_depth_stat, RecRawStatSyncSum);
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.private_key_offload_busy_time", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_private_key_offload_busy_time_stat, RecRawStatSyncSum);
+
   // ocsp stapling stats
   RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_ocsp_revoked_cert_stat", RECD_COUNTER, RECP_PERSISTENT,
                      (int)ssl_ocsp_revoked_cert_stat, RecRawStatSyncCount);
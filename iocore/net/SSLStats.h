@@ -100,6 +100,21 @@ enum SSL_Stats {
   ssl_ocsp_refreshed_cert_stat,
   ssl_ocsp_refresh_cert_failure_stat,
 
+  /* kernel TLS stats */
+  ssl_ktls_send_connections_stat,
+  ssl_ktls_fallback_stat,
+
+  /* lazily loaded server certificate stats */
+  ssl_lazy_cert_loads_stat,
+  ssl_lazy_cert_load_failures_stat,
+  ssl_lazy_cert_evictions_stat,
+  ssl_lazy_cert_handshake_waits_stat,
+
+  /* private key operations offloaded to the crypto threads */
+  ssl_private_key_offload_ops_stat,
+  ssl_private_key_offload_queue_depth_stat,
+  ssl_private_key_offload_busy_time_stat,
+
   /* SSL/TLS versions */
   ssl_total_sslv3,
   ssl_total_tlsv1,
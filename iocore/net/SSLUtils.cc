@@ -42,6 +42,8 @@
 #include "SSLDynlock.h"
 #include "SSLDiags.h"
 #include "SSLStats.h"
+#include "SSLLazyCert.h"
+#include "SSLPrivateKeyOffload.h"
 
 #include <string>
 #include <unistd.h>
@@ -309,6 +311,15 @@ set_context_cert(SSL *ssl)
     cc = lookup->find(const_cast<char *>(servername));
     if (cc) {
       ctx = cc->getCtx();
+      if (!ctx && cc->lazy) {
+        bool wait = false;
+        ctx       = cc->lazy->acquire(netvc, wait);
+        if (wait) {
+          Debug("ssl", "set_context_cert waiting for the certificate for '%s' to load", servername);
+          retval = -1;
+          goto done;
+        }
+      }
     }
     if (cc && ctx && SSLCertContextOption::OPT_TUNNEL == cc->opt && netvc->get_is_transparent()) {
       netvc->attributes = HttpProxyPort::TRANSPORT_BLIND_TUNNEL;
@@ -1241,7 +1252,7 @@ SSLMultiCertConfigLoader::init_server_ssl_ctx(CertLoadData const &data, const SS
     }
 
     if (sslMultCertSettings->cert) {
-      if (!SSLMultiCertConfigLoader::load_certs(ctx, data, params, sslMultCertSettings)) {
+      if (!SSLMultiCertConfigLoader::load_certs(ctx, data, params, sslMultCertSettings) || !SSLOffloadPrivateKeys(ctx)) {
         goto fail;
       }
     }
@@ -1421,11 +1432,22 @@ SSLMultiCertConfigLoader::_store_ssl_ctx(SSLCertLookup *lookup, const shared_SSL
     i++;
   }
 
-  shared_SSL_CTX ctx(this->init_server_ssl_ctx(data, sslMultCertSettings.get(), common_names), SSL_CTX_free);
+  // Lines that are only reached by server name can wait for their context until a handshake asks for it.
+  bool lazy = params->server_cert_lazy_load && sslMultCertSettings && sslMultCertSettings->cert && !sslMultCertSettings->addr &&
+              sslMultCertSettings->opt == SSLCertContextOption::OPT_NONE;
 
-  if (!ctx || !sslMultCertSettings || !this->_store_single_ssl_ctx(lookup, sslMultCertSettings, ctx, common_names)) {
-    lookup->is_valid = false;
-    retval           = false;
+  if (lazy) {
+    if (!this->_store_lazy_ssl_ctx(lookup, sslMultCertSettings, data, common_names)) {
+      lookup->is_valid = false;
+      retval           = false;
+    }
+  } else {
+    shared_SSL_CTX ctx(this->init_server_ssl_ctx(data, sslMultCertSettings.get(), common_names), SSL_CTX_free);
+
+    if (!ctx || !sslMultCertSettings || !this->_store_single_ssl_ctx(lookup, sslMultCertSettings, ctx, common_names)) {
+      lookup->is_valid = false;
+      retval           = false;
+    }
   }
 
   for (auto iter = unique_names.begin(); retval && iter != unique_names.end(); ++iter) {
@@ -1437,6 +1459,14 @@ SSLMultiCertConfigLoader::_store_ssl_ctx(SSLCertLookup *lookup, const shared_SSL
     single_data.ca_list.push_back(i < data.ca_list.size() ? data.ca_list[i] : "");
     single_data.ocsp_list.push_back(i < data.ocsp_list.size() ? data.ocsp_list[i] : "");
 
+    if (lazy) {
+      if (!this->_store_lazy_ssl_ctx(lookup, sslMultCertSettings, single_data, iter->second)) {
+        lookup->is_valid = false;
+        retval           = false;
+      }
+      continue;
+    }
+
     shared_SSL_CTX unique_ctx(this->init_server_ssl_ctx(single_data, sslMultCertSettings.get(), iter->second), SSL_CTX_free);
     if (!unique_ctx || !this->_store_single_ssl_ctx(lookup, sslMultCertSettings, unique_ctx, iter->second)) {
       lookup->is_valid = false;
@@ -1506,6 +1536,48 @@ SSLMultiCertConfigLoader::_store_single_ssl_ctx(SSLCertLookup *lookup, const sha
   return ctx.get();
 }
 
+/**
+   Index @a names with a context that is built by SSLLazyCert when a handshake first needs it.
+ */
+bool
+SSLMultiCertConfigLoader::_store_lazy_ssl_ctx(SSLCertLookup *lookup, const shared_SSLMultiCertConfigParams sslMultCertSettings,
+                                              CertLoadData const &data, std::set<std::string> &names)
+{
+  bool inserted = false;
+  SSLCertContext cc(nullptr, sslMultCertSettings);
+
+  cc.lazy = std::make_shared<SSLLazyCert>(sslMultCertSettings, data, names);
+  for (auto sni_name : names) {
+    if (SSLMultiCertConfigLoader::index_certificate(lookup, cc, sni_name.c_str())) {
+      inserted = true;
+    }
+  }
+
+  return inserted;
+}
+
+/**
+   Build the context of a certificate indexed by _store_lazy_ssl_ctx(), set up as _store_single_ssl_ctx() would.
+ */
+shared_SSL_CTX
+SSLMultiCertConfigLoader::init_lazy_ssl_ctx(CertLoadData const &data, const shared_SSLMultiCertConfigParams &sslMultCertSettings,
+                                            std::set<std::string> &names)
+{
+  shared_SSL_CTX ctx(this->init_server_ssl_ctx(data, sslMultCertSettings.get(), names), SSL_CTX_free);
+
+  if (ctx) {
+    // Named contexts do not keep a key block; tickets are handled with the default one.
+    if (sslMultCertSettings->session_ticket_enabled != 0) {
+      ticket_block_free(ssl_context_enable_tickets(ctx.get(), nullptr));
+    }
+    if (SSLConfigParams::init_ssl_ctx_cb) {
+      SSLConfigParams::init_ssl_ctx_cb(ctx.get(), true);
+    }
+  }
+
+  return ctx;
+}
+
 static bool
 ssl_extract_certificate(const matcher_line *line_info, SSLMultiCertConfigParams *sslMultCertSettings)
 {
@@ -1732,6 +1804,38 @@ SSLWriteBuffer(SSL *ssl, const void *buf, int64_t nbytes, int64_t &nwritten)
   return ssl_error;
 }
 
+ssl_error_t
+SSLSendFile(SSL *ssl, int fd, off_t offset, int64_t nbytes, int64_t &nwritten)
+{
+  nwritten = 0;
+
+  if (unlikely(nbytes == 0)) {
+    return SSL_ERROR_NONE;
+  }
+#if TS_HAS_KTLS
+  ERR_clear_error();
+
+  ossl_ssize_t ret = SSL_sendfile(ssl, fd, offset, static_cast<size_t>(nbytes), 0);
+  if (ret > 0) {
+    nwritten = ret;
+    return SSL_ERROR_NONE;
+  }
+  int ssl_error = SSL_get_error(ssl, static_cast<int>(ret));
+  if (ssl_error == SSL_ERROR_SSL && is_debug_tag_set("ssl.error.write")) {
+    char tempbuf[512];
+    unsigned long e = ERR_peek_last_error();
+    ERR_error_string_n(e, tempbuf, sizeof(tempbuf));
+    Debug("ssl.error.write", "SSL sendfile returned %zd, ssl_error=%d, ERR_get_error=%ld (%s)", ret, ssl_error, e, tempbuf);
+  }
+  return ssl_error;
+#else
+  (void)ssl;
+  (void)fd;
+  (void)offset;
+  return SSL_ERROR_SSL;
+#endif
+}
+
 ssl_error_t
 SSLReadBuffer(SSL *ssl, void *buf, int64_t nbytes, int64_t &nread)
 {
@@ -101,6 +101,7 @@ public:
     // Cleanup the active and keep-alive queues periodically
     nh.manage_active_queue(true); // close any connections over the active timeout
     nh.manage_keep_alive_queue();
+    nh.manage_zero_copy_linger(now);
 
     return 0;
   }
@@ -605,6 +606,37 @@ NetHandler::configure_per_thread_values()
         threads);
 }
 
+// Keep a closed socket open until the kernel is done transmitting from the buffers its zero copy
+// sends pinned. Freeing them earlier would put whatever reuses the memory on the wire.
+void
+NetHandler::linger_zero_copy(int fd, ZeroCopySend &sends)
+{
+  socketManager.shutdown(fd, 1);
+  zero_copy_linger.emplace_back();
+  zero_copy_linger.back().fd       = fd;
+  zero_copy_linger.back().deadline = Thread::get_hrtime() + HRTIME_SECONDS(ZERO_COPY_LINGER_TIMEOUT);
+  zero_copy_linger.back().sends.take(sends);
+}
+
+void
+NetHandler::manage_zero_copy_linger(ink_hrtime now)
+{
+  for (auto it = zero_copy_linger.begin(); it != zero_copy_linger.end();) {
+    it->sends.reap(it->fd, this->thread);
+    if (it->sends.pending()) {
+      if (it->deadline > now) {
+        ++it;
+        continue;
+      }
+      // The peer stopped acknowledging, reset the connection so the kernel drops the data first.
+      struct linger l = {1, 0};
+      safe_setsockopt(it->fd, SOL_SOCKET, SO_LINGER, reinterpret_cast<char *>(&l), sizeof(l));
+    }
+    socketManager.close(it->fd);
+    it = zero_copy_linger.erase(it);
+  }
+}
+
 void
 NetHandler::manage_keep_alive_queue()
 {
@@ -95,6 +95,7 @@ net_accept(NetAccept *na, void *ep, bool blockable)
     vc->action_     = *na->action_;
     vc->set_is_transparent(na->opt.f_inbound_transparent);
     vc->set_is_proxy_protocol(na->opt.f_proxy_protocol);
+    vc->options.f_ktls = na->opt.f_ktls;
     vc->set_context(NET_VCONNECTION_IN);
     if (na->opt.f_mptcp) {
       vc->set_mptcp_state(); // Try to get the MPTCP state, and update accordingly
@@ -121,7 +122,7 @@ net_accept(NetAccept *na, void *ep, bool blockable)
         vc->handleEvent(EVENT_NONE, e);
       }
     } else {
-      t = eventProcessor.assign_thread(na->opt.etype);
+      t = eventProcessor.assign_thread(na->opt.etype, e->ethread->numa_node);
       h = get_NetHandler(t);
       // Assign NetHandler->mutex to NetVC
       vc->mutex = h->mutex;
@@ -342,6 +343,7 @@ NetAccept::do_blocking_accept(EThread *t)
     vc->options.packet_mark = opt.packet_mark;
     vc->options.packet_tos  = opt.packet_tos;
     vc->options.ip_family   = opt.ip_family;
+    vc->options.f_ktls      = opt.f_ktls;
     vc->apply_options();
     vc->set_context(NET_VCONNECTION_IN);
     if (opt.f_mptcp) {
@@ -356,7 +358,8 @@ NetAccept::do_blocking_accept(EThread *t)
 #endif
     SET_CONTINUATION_HANDLER(vc, (NetVConnHandler)&UnixNetVConnection::acceptEvent);
 
-    EThread *localt = eventProcessor.assign_thread(opt.etype);
+    // Keep the connection on the NUMA node where it was accepted, if placement is on.
+    EThread *localt = eventProcessor.assign_thread(opt.etype, eventProcessor.current_numa_node());
     NetHandler *h   = get_NetHandler(localt);
     // Assign NetHandler->mutex to NetVC
     vc->mutex = h->mutex;
@@ -492,6 +495,7 @@ NetAccept::acceptFastEvent(int event, void *ep)
     vc->options.packet_mark = opt.packet_mark;
     vc->options.packet_tos  = opt.packet_tos;
     vc->options.ip_family   = opt.ip_family;
+    vc->options.f_ktls      = opt.f_ktls;
     vc->apply_options();
     vc->set_context(NET_VCONNECTION_IN);
     if (opt.f_mptcp) {
@@ -52,6 +52,7 @@ NetProcessor::AcceptOptions::reset()
   tfo_queue_length      = 0;
   f_inbound_transparent = false;
   f_mptcp               = false;
+  f_ktls                = false;
   f_proxy_protocol      = false;
   return *this;
 }
@@ -887,6 +887,10 @@ UnixNetVConnection::set_enabled(VIO *vio)
 void
 UnixNetVConnection::net_read_io(NetHandler *nh, EThread *lthread)
 {
+  // Zero copy completions wake the socket with an error event.
+  if (zero_copy.pending()) {
+    zero_copy.reap(con.fd, lthread);
+  }
   read_from_net(nh, this, lthread);
 }
 
@@ -907,11 +911,41 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
   int64_t try_to_write       = 0;
   IOBufferReader *tmp_reader = buf.reader()->clone();
 
+  if (zero_copy.pending()) {
+    zero_copy.reap(con.fd, thread);
+  }
+
   do {
     IOVec tiovec[NET_MAX_IOV];
+    IOBufferData *tdata[NET_MAX_IOV];
     unsigned niov = 0;
     try_to_write  = 0;
 
+    // A file range from the cache goes from the page cache to the socket
+    // without passing through user space.
+    if (tmp_reader->block_read_avail() > 0 && tmp_reader->block->is_file_range()) {
+      IOBufferBlock *b = tmp_reader->block.get();
+      off_t offset     = b->file_offset() + tmp_reader->start_offset;
+      try_to_write     = std::min(tmp_reader->block_read_avail(), towrite - total_written);
+      tmp_reader->consume(try_to_write);
+
+      // the cache took the range back, the rest of the object is lost
+      if (!b->data->hold_file_range()) {
+        r = -EIO;
+        break;
+      }
+      r = socketManager.sendfile(con.fd, b->data->_fd, offset, try_to_write);
+      b->data->unhold_file_range();
+      ProxyMutex *mutex = thread->mutex.get();
+      if (r > 0) {
+        buf.reader()->consume(r);
+        total_written += r;
+        NET_SUM_DYN_STAT(net_zero_copy_bytes_stat, r);
+      }
+      NET_INCREMENT_DYN_STAT(net_calls_to_write_stat);
+      continue;
+    }
+
     while (niov < NET_MAX_IOV) {
       int64_t wavail = towrite - total_written - try_to_write;
       int64_t len    = tmp_reader->block_read_avail();
@@ -921,6 +955,11 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
         break;
       }
 
+      // File ranges are written on their own, see above.
+      if (tmp_reader->block->is_file_range()) {
+        break;
+      }
+
       // Check if the amount to write exceeds that in this buffer.
       if (len > wavail) {
         len = wavail;
@@ -933,6 +972,7 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
       // build an iov entry
       tiovec[niov].iov_len  = len;
       tiovec[niov].iov_base = tmp_reader->start();
+      tdata[niov]           = tmp_reader->block->data.get();
       niov++;
 
       try_to_write += len;
@@ -967,6 +1007,17 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
         this->con.is_connected = true;
       }
 
+    } else if (zero_copy.wants(try_to_write)) {
+      struct msghdr msg;
+
+      ink_zero(msg);
+      msg.msg_iov    = &tiovec[0];
+      msg.msg_iovlen = niov;
+
+      r = zero_copy.send(con.fd, &msg, tdata, niov, thread);
+      if (r == -ENOBUFS || r == -EOPNOTSUPP) {
+        r = socketManager.writev(con.fd, &tiovec[0], niov);
+      }
     } else {
       r = socketManager.writev(con.fd, &tiovec[0], niov);
     }
@@ -1327,8 +1378,16 @@ UnixNetVConnection::free(EThread *t)
   // close socket fd
   if (con.fd != NO_FD) {
     NET_SUM_GLOBAL_DYN_STAT(net_connections_currently_open_stat, -1);
+    if (zero_copy.pending()) {
+      zero_copy.reap(con.fd, t);
+    }
+    if (zero_copy.pending()) {
+      get_NetHandler(t)->linger_zero_copy(con.fd, zero_copy);
+      con.fd = NO_FD;
+    }
   }
   con.close();
+  zero_copy.clear();
 
   clear();
   SET_CONTINUATION_HANDLER(this, (NetVConnHandler)&UnixNetVConnection::startEvent);
@@ -1404,6 +1463,8 @@ UnixNetVConnection::migrateToCurrentThread(Continuation *cont, EThread *t)
     netvc = sslvc;
   } else {
     netvc = static_cast<UnixNetVConnection *>(netProcessor.allocate_vc(t));
+    // The socket's zero copy sends go with it.
+    netvc->zero_copy.take(this->zero_copy);
     if (netvc->populate(hold_con, cont, save_ssl) != EVENT_DONE) {
       netvc->do_io_close();
       netvc = nullptr;
@@ -99,10 +99,15 @@ UnixUDPConnection::callbackHandler(int event, void *data)
 
 void
 UDPConnection::bindToThread(Continuation *c)
+{
+  this->bindToThread(c, eventProcessor.assign_thread(ET_UDP));
+}
+
+void
+UDPConnection::bindToThread(Continuation *c, EThread *t)
 {
   UnixUDPConnection *uc = (UnixUDPConnection *)this;
   // add to new connections queue for EThread.
-  EThread *t = eventProcessor.assign_thread(ET_UDP);
   ink_assert(t);
   ink_assert(get_UDPNetHandler(t));
   uc->ethread = t;
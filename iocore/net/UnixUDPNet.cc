@@ -37,6 +37,21 @@
 #include "P_Net.h"
 #include "P_UDPNet.h"
 
+#include <atomic>
+
+#if defined(linux)
+#include <netinet/udp.h>
+#endif
+
+#if defined(UDP_SEGMENT)
+#define HAVE_UDP_GSO 1
+#else
+#define HAVE_UDP_GSO 0
+#endif
+
+// Also the most segments the kernel takes in one GSO send (UDP_MAX_SEGMENTS)
+static constexpr int UDP_SEND_MAX_IOV = 64;
+
 using UDPNetContHandler = int (UDPNetHandler::*)(int, void *);
 
 inkcoreapi ClassAllocator<UDPPacketInternal> udpPacketAllocator("udpPacketAllocator");
@@ -735,7 +750,8 @@ HardError:
 }
 
 Action *
-UDPNetProcessor::UDPBind(Continuation *cont, sockaddr const *addr, int send_bufsize, int recv_bufsize)
+UDPNetProcessor::UDPBind(Continuation *cont, sockaddr const *addr, int send_bufsize, int recv_bufsize, EThread *thread,
+                         bool reuse_port)
 {
   int res              = 0;
   int fd               = -1;
@@ -799,6 +815,18 @@ UDPNetProcessor::UDPBind(Continuation *cont, sockaddr const *addr, int send_bufs
     }
   }
 
+  if (reuse_port) {
+#ifdef SO_REUSEPORT
+    if ((res = safe_setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, SOCKOPT_ON, sizeof(int))) < 0) {
+      goto Lerror;
+    }
+#else
+    Debug("udpnet", "SO_REUSEPORT is not supported");
+    res = -1;
+    goto Lerror;
+#endif
+  }
+
   if (ats_is_ip6(addr) && (res = safe_setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, SOCKOPT_ON, sizeof(int))) < 0) {
     goto Lerror;
   }
@@ -824,7 +852,11 @@ UDPNetProcessor::UDPBind(Continuation *cont, sockaddr const *addr, int send_bufs
 
   Debug("udpnet", "UDPNetProcessor::UDPBind: %p fd=%d", n, fd);
   n->setBinding(&myaddr.sa);
-  n->bindToThread(cont);
+  if (thread) {
+    n->bindToThread(cont, thread);
+  } else {
+    n->bindToThread(cont);
+  }
 
   pc = get_UDPPollCont(n->ethread);
   pd = pc->pollDescriptor;
@@ -954,13 +986,76 @@ sendPackets:
   }
 }
 
+// Turned on when a GSO send fails because the kernel or the NIC can't segment, every segmented
+// packet is sent datagram by datagram after that. Shared by all the UDP threads.
+static std::atomic<bool> udp_gso_failed{false};
+
+static int
+udp_sendmsg(int fd, struct msghdr *msg)
+{
+  int n, count = 0;
+
+  while (true) {
+    // stupid Linux problem: sendmsg can return EAGAIN
+    n = ::sendmsg(fd, msg, 0);
+    if ((n >= 0) || ((n < 0) && (errno != EAGAIN))) {
+      // send succeeded or some random error happened.
+      if (n < 0) {
+        int e = errno;
+        Debug("udp-send", "Error: %s (%d)", strerror(e), e);
+        errno = e;
+      }
+
+      break;
+    }
+    if (errno == EAGAIN) {
+      ++count;
+      if ((g_udp_numSendRetries > 0) && (count >= g_udp_numSendRetries)) {
+        // tried too many times; give up
+        Debug("udpnet", "Send failed: too many retries");
+        break;
+      }
+    }
+  }
+
+  return n;
+}
+
+static void
+udp_send_segments(int fd, struct msghdr *msg, const struct iovec *iov, int iov_len, uint16_t segment_size)
+{
+  struct iovec seg_iov[UDP_SEND_MAX_IOV];
+  int i      = 0;
+  size_t off = 0;
+
+  while (i < iov_len) {
+    int n       = 0;
+    size_t left = segment_size;
+    while (left > 0 && i < iov_len) {
+      size_t len          = std::min(left, iov[i].iov_len - off);
+      seg_iov[n].iov_base = static_cast<char *>(iov[i].iov_base) + off;
+      seg_iov[n].iov_len  = len;
+      ++n;
+      left -= len;
+      off += len;
+      if (off == iov[i].iov_len) {
+        ++i;
+        off = 0;
+      }
+    }
+    msg->msg_iov    = seg_iov;
+    msg->msg_iovlen = n;
+    udp_sendmsg(fd, msg);
+  }
+}
+
 void
 UDPQueue::SendUDPPacket(UDPPacketInternal *p, int32_t /* pktLen ATS_UNUSED */)
 {
   struct msghdr msg;
-  struct iovec iov[32];
+  struct iovec iov[UDP_SEND_MAX_IOV];
   int real_len = 0;
-  int n, count, iov_len = 0;
+  int iov_len  = 0;
 
   p->conn->lastSentPktStartTime = p->delivery_time;
   Debug("udp-send", "Sending %p", p);
@@ -975,6 +1070,10 @@ UDPQueue::SendUDPPacket(UDPPacketInternal *p, int32_t /* pktLen ATS_UNUSED */)
   iov_len         = 0;
 
   for (IOBufferBlock *b = p->chain.get(); b != nullptr; b = b->next.get()) {
+    if (iov_len == UDP_SEND_MAX_IOV) {
+      Debug("udp-send", "Dropping the tail of %p, more than %d blocks", p, UDP_SEND_MAX_IOV);
+      break;
+    }
     iov[iov_len].iov_base = static_cast<caddr_t>(b->start());
     iov[iov_len].iov_len  = b->size();
     real_len += iov[iov_len].iov_len;
@@ -983,27 +1082,35 @@ UDPQueue::SendUDPPacket(UDPPacketInternal *p, int32_t /* pktLen ATS_UNUSED */)
   msg.msg_iov    = iov;
   msg.msg_iovlen = iov_len;
 
-  count = 0;
-  while (true) {
-    // stupid Linux problem: sendmsg can return EAGAIN
-    n = ::sendmsg(p->conn->getFd(), &msg, 0);
-    if ((n >= 0) || ((n < 0) && (errno != EAGAIN))) {
-      // send succeeded or some random error happened.
-      if (n < 0) {
-        Debug("udp-send", "Error: %s (%d)", strerror(errno), errno);
-      }
+  if (p->segment_size == 0 || real_len <= p->segment_size) {
+    udp_sendmsg(p->conn->getFd(), &msg);
+    return;
+  }
 
-      break;
-    }
-    if (errno == EAGAIN) {
-      ++count;
-      if ((g_udp_numSendRetries > 0) && (count >= g_udp_numSendRetries)) {
-        // tried too many times; give up
-        Debug("udpnet", "Send failed: too many retries");
-        break;
-      }
+#if HAVE_UDP_GSO && !defined(solaris)
+  if (!udp_gso_failed.load(std::memory_order_relaxed)) {
+    char control[CMSG_SPACE(sizeof(uint16_t))] = {0};
+    msg.msg_control                             = control;
+    msg.msg_controllen                          = sizeof(control);
+
+    struct cmsghdr *cm                           = CMSG_FIRSTHDR(&msg);
+    cm->cmsg_level                               = SOL_UDP;
+    cm->cmsg_type                                = UDP_SEGMENT;
+    cm->cmsg_len                                 = CMSG_LEN(sizeof(uint16_t));
+    *reinterpret_cast<uint16_t *>(CMSG_DATA(cm)) = p->segment_size;
+
+    if (udp_sendmsg(p->conn->getFd(), &msg) >= 0 ||
+        (errno != EIO && errno != EINVAL && errno != ENOPROTOOPT && errno != EOPNOTSUPP)) {
+      return;
     }
+    Debug("udp-send", "GSO is not available (%d), sending datagrams one by one", errno);
+    udp_gso_failed.store(true, std::memory_order_relaxed);
+    msg.msg_control    = nullptr;
+    msg.msg_controllen = 0;
   }
+#endif
+
+  udp_send_segments(p->conn->getFd(), &msg, iov, iov_len, p->segment_size);
 }
 
 void
@@ -0,0 +1,164 @@
+/** @file
+
+  MSG_ZEROCOPY transmit support for socket writes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_Net.h"
+#include "P_ZeroCopySend.h"
+
+#if defined(linux) && defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+#include <linux/errqueue.h>
+#define HAVE_ZERO_COPY_SEND 1
+#else
+#define HAVE_ZERO_COPY_SEND 0
+#endif
+
+int64_t net_zero_copy_send_min_size = 0;
+
+int64_t
+ZeroCopySend::send(int fd, struct msghdr *msg, IOBufferData *const *data, unsigned ndata, EThread *t)
+{
+#if HAVE_ZERO_COPY_SEND
+  ProxyMutex *mutex = t->mutex.get();
+
+  if (!_enabled) {
+    int on = 1;
+    if (safe_setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, reinterpret_cast<char *>(&on), sizeof(on)) < 0) {
+      Debug("zero_copy", "SO_ZEROCOPY failed on socket %d, errno=%d", fd, errno);
+      NET_INCREMENT_DYN_STAT(net_zero_copy_send_fallbacks_stat);
+      _disabled = true;
+      return -EOPNOTSUPP;
+    }
+    _enabled = true;
+  }
+
+  int64_t r = socketManager.sendmsg(fd, msg, MSG_ZEROCOPY);
+  if (r == -ENOBUFS) {
+    // Over the optmem limit for pinned pages, the caller copies this one.
+    NET_INCREMENT_DYN_STAT(net_zero_copy_send_fallbacks_stat);
+  } else if (r >= 0) {
+    pin(data, ndata);
+  }
+  return r;
+#else
+  (void)fd;
+  (void)msg;
+  (void)data;
+  (void)ndata;
+  (void)t;
+  return -EOPNOTSUPP;
+#endif
+}
+
+void
+ZeroCopySend::reap(int fd, EThread *t)
+{
+#if HAVE_ZERO_COPY_SEND
+  ProxyMutex *mutex = t->mutex.get();
+
+  while (!_pending.empty()) {
+    char control[128];
+    struct msghdr msg;
+
+    ink_zero(msg);
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+    if (socketManager.recvmsg(fd, &msg, MSG_ERRQUEUE) < 0) {
+      break;
+    }
+
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm != nullptr; cm = CMSG_NXTHDR(&msg, cm)) {
+      if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+            (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR))) {
+        continue;
+      }
+      const struct sock_extended_err *ee = reinterpret_cast<const struct sock_extended_err *>(CMSG_DATA(cm));
+      if (ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY || ee->ee_errno != 0) {
+        continue;
+      }
+
+      bool copied = ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED;
+      uint32_t n  = complete(ee->ee_info, ee->ee_data, copied);
+      NET_SUM_DYN_STAT(net_zero_copy_send_completions_stat, n);
+      if (copied) {
+        NET_SUM_DYN_STAT(net_zero_copy_send_copied_stat, n);
+      }
+    }
+  }
+#else
+  (void)fd;
+  (void)t;
+#endif
+}
+
+void
+ZeroCopySend::pin(IOBufferData *const *data, unsigned ndata)
+{
+  uint32_t seq = _next_seq++;
+  for (unsigned i = 0; i < ndata; ++i) {
+    _pending.emplace_back();
+    _pending.back().seq  = seq;
+    _pending.back().data = data[i];
+  }
+}
+
+uint32_t
+ZeroCopySend::complete(uint32_t lo, uint32_t hi, bool copied)
+{
+  if (copied) {
+    // The route can not transmit from user pages (loopback, no scatter-gather), so the kernel
+    // copied anyway. Don't pay for the page pinning on this socket again.
+    _disabled = true;
+  }
+  for (auto &p : _pending) {
+    if (static_cast<int32_t>(p.seq - hi) > 0) {
+      break;
+    }
+    if (static_cast<int32_t>(p.seq - lo) >= 0) {
+      p.done = true;
+    }
+  }
+
+  // Completions normally arrive in order, but only data that no earlier send still needs is freed.
+  while (!_pending.empty() && _pending.front().done) {
+    _pending.pop_front();
+  }
+  return hi - lo + 1;
+}
+
+void
+ZeroCopySend::take(ZeroCopySend &that)
+{
+  _pending  = std::move(that._pending);
+  _next_seq = that._next_seq;
+  _enabled  = that._enabled;
+  _disabled = that._disabled;
+  that.clear();
+}
+
+void
+ZeroCopySend::clear()
+{
+  _pending.clear();
+  _next_seq = 0;
+  _enabled  = false;
+  _disabled = false;
+}
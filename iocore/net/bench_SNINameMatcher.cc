@@ -0,0 +1,188 @@
+/** @file
+
+  sni.yaml server name lookup benchmark.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+/****************************************************************************
+
+   bench_SNINameMatcher.cc
+
+   Description:
+
+   Looks up server names in a large sni.yaml style list of fqdn globs, once
+   with SNINameMatcher and once with a regular expression per entry tried in
+   order, which is how entries were matched before, and reports the cost of
+   each. It fails if the two disagree on any name.
+
+   Usage: bench_SNINameMatcher [names] [lookups]
+
+   A quarter of the names are "*." wildcards, one in a thousand is a glob
+   with a '*' inside a label and the rest are exact names. Lookups are spread
+   over exact, wildcard and glob hits and names that match nothing. The
+   regular expression scan is run for a hundredth of the lookups as it is
+   linear in the number of names. Defaults are 100000 names and 1000000
+   lookups.
+
+ ****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "SNINameMatcher.h"
+
+namespace
+{
+constexpr int OVECSIZE{30};
+
+std::string
+name_for(int i)
+{
+  if (i % 1000 == 999) {
+    return "edge*-" + std::to_string(i) + ".cdn" + std::to_string(i / 1000) + ".example.org";
+  } else if (i % 4 == 0) {
+    return "*.zone" + std::to_string(i) + ".example.net";
+  }
+  return "host" + std::to_string(i) + ".svc" + std::to_string(i % 1000) + ".example.com";
+}
+
+std::string
+query_for(int i, int n_names)
+{
+  int target = i % n_names;
+  int glob   = target - target % 1000 + 999;
+  switch (i % 5) {
+  case 0:
+    return "nohost" + std::to_string(target) + ".example.com";
+  case 1:
+    return "edge" + std::to_string(i) + "-" + std::to_string(glob) + ".cdn" + std::to_string(glob / 1000) + ".example.org";
+  default:
+    break;
+  }
+  if (target % 4 == 0) {
+    return "a" + std::to_string(i) + ".b.zone" + std::to_string(target) + ".example.net";
+  }
+  return name_for(target);
+}
+
+/// The expression SNINameMatcher uses for a glob it cannot put in its trie.
+pcre *
+compile(const std::string &fqdn)
+{
+  std::string regex;
+  for (char c : fqdn) {
+    if (c == '.') {
+      regex += "\\.";
+    } else if (c == '*') {
+      regex += "(.{0,})";
+    } else {
+      regex += c;
+    }
+  }
+  regex += '$';
+
+  const char *err_ptr;
+  int err_offset = 0;
+  return pcre_compile(regex.c_str(), PCRE_ANCHORED | PCRE_DOLLAR_ENDONLY, &err_ptr, &err_offset, nullptr);
+}
+
+int
+scan(const std::vector<pcre *> &regexes, const std::string &servername, std::vector<std::string> &groups)
+{
+  int ovector[OVECSIZE];
+
+  groups.clear();
+  for (size_t i = 0; i < regexes.size(); ++i) {
+    int count = pcre_exec(regexes[i], nullptr, servername.data(), servername.size(), 0, 0, ovector, OVECSIZE);
+    if (count >= 0) {
+      for (int strnum = 1; strnum < count; ++strnum) {
+        groups.emplace_back(servername.data() + ovector[2 * strnum], ovector[2 * strnum + 1] - ovector[2 * strnum]);
+      }
+      return i;
+    }
+  }
+  return SNINameMatcher::NO_MATCH;
+}
+
+double
+ns_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  int n_names   = argc > 1 ? atoi(argv[1]) : 100000;
+  int n_lookups = argc > 2 ? atoi(argv[2]) : 1000000;
+  int n_scans   = std::max(n_lookups / 100, 1);
+
+  SNINameMatcher matcher;
+  std::vector<pcre *> regexes;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_names; ++i) {
+    matcher.add(name_for(i));
+  }
+  double trie_load = ns_since(start);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_names; ++i) {
+    regexes.push_back(compile(name_for(i)));
+  }
+  double regex_load = ns_since(start);
+
+  std::vector<std::string> queries;
+  for (int i = 0; i < n_lookups; ++i) {
+    queries.push_back(query_for(i, n_names));
+  }
+
+  std::vector<std::string> groups;
+  int hits = 0;
+  start    = std::chrono::steady_clock::now();
+  for (auto &&q : queries) {
+    hits += matcher.find(q, &groups) != SNINameMatcher::NO_MATCH;
+  }
+  double trie_ns = ns_since(start) / n_lookups;
+
+  std::vector<std::string> expected;
+  int mismatches = 0;
+  start          = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_scans; ++i) {
+    int idx = scan(regexes, queries[i], expected);
+    mismatches += matcher.find(queries[i], &groups) != idx || groups != expected;
+  }
+  double scan_ns = ns_since(start) / n_scans;
+
+  printf("%d names, %d lookups, %d hits\n", n_names, n_lookups, hits);
+  printf("trie:  load %8.1f ms  lookup %12.1f ns\n", trie_load / 1e6, trie_ns);
+  printf("regex: load %8.1f ms  lookup %12.1f ns\n", regex_load / 1e6, scan_ns);
+  printf("%d mismatches in %d lookups\n", mismatches, n_scans);
+
+  for (auto regex : regexes) {
+    pcre_free(regex);
+  }
+  return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+}
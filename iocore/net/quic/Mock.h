@@ -419,7 +419,7 @@ public:
   }
 
   virtual void
-  on_packet_sent(size_t bytes_sent) override
+  on_packet_sent(QUICPacketInfo &sent_packet) override
   {
   }
   virtual void
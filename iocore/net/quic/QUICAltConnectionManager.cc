@@ -107,7 +107,12 @@ QUICAltConnectionManager::AltConnectionInfo
 QUICAltConnectionManager::_generate_next_alt_con_info()
 {
   QUICConnectionId conn_id;
-  conn_id.randomize();
+  if (this->_qc->direction() == NET_VCONNECTION_IN) {
+    // Keep routing packets for the connection to the socket that owns it
+    conn_id.randomize(this->_qc->connection_id().route());
+  } else {
+    conn_id.randomize();
+  }
   QUICStatelessResetToken token(conn_id, this->_instance_id);
   AltConnectionInfo aci = {++this->_alt_quic_connection_id_seq_num, conn_id, token, {false}};
 
@@ -0,0 +1,483 @@
+/** @file
+ *
+ *  BBR congestion control for QUIC
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <tscore/Diags.h>
+#include <QUICBBRCongestionController.h>
+
+#define QUICCCDebug(fmt, ...)                                                                                             \
+  Debug("quic_cc",                                                                                                        \
+        "[%s] "                                                                                                           \
+        "state: %d window: %" PRIu32 " bytes: %" PRIu32 " bw: %" PRIu64 " min_rtt: %" PRId64 " " fmt,                     \
+        this->_context.connection_info()->cids().data(), static_cast<int>(this->_state), this->_congestion_window,         \
+        this->_bytes_in_flight, this->_max_bw, this->_min_rtt, ##__VA_ARGS__)
+
+// Gains, 2/ln(2) lets Startup double the delivery rate every round
+static constexpr double STARTUP_PACING_GAIN = 2.77;
+static constexpr double DRAIN_PACING_GAIN   = 0.35;
+static constexpr double PROBE_UP_GAIN       = 1.25;
+static constexpr double PROBE_DOWN_GAIN     = 0.9;
+static constexpr double CWND_GAIN           = 2.0;
+static constexpr double PROBE_UP_CWND_GAIN  = 2.25;
+static constexpr double PACING_MARGIN       = 0.01;
+
+// Startup is done after three rounds that did not grow the bandwidth by a quarter
+static constexpr double FULL_BW_GROWTH  = 1.25;
+static constexpr uint32_t FULL_BW_COUNT = 3;
+
+// A round that loses more than this share of its data is lossy, the window backs off by beta. Startup
+// also wants a few losses, so that a single random loss does not end it.
+static constexpr double LOSS_THRESH               = 0.02;
+static constexpr double BETA                      = 0.7;
+static constexpr double HEADROOM                  = 0.85;
+static constexpr uint32_t STARTUP_FULL_LOSS_COUNT = 6;
+
+static constexpr ink_hrtime MIN_RTT_FILTER_LEN  = HRTIME_SECONDS(10);
+static constexpr ink_hrtime PROBE_RTT_INTERVAL  = HRTIME_SECONDS(5);
+static constexpr ink_hrtime PROBE_RTT_DURATION  = HRTIME_MSECONDS(200);
+static constexpr ink_hrtime PROBE_WAIT_BASE     = HRTIME_SECONDS(2);
+static constexpr ink_hrtime PROBE_WAIT_INCREASE = HRTIME_MSECONDS(125);
+
+QUICBBRCongestionController::QUICBBRCongestionController(QUICCCContext &context) : _cc_mutex(new_ProxyMutex()), _context(context)
+{
+  auto &cc_config            = context.cc_config();
+  this->_k_max_datagram_size = cc_config.max_datagram_size();
+  this->_k_initial_window    = cc_config.initial_window();
+  this->_k_minimum_window    = std::max(cc_config.minimum_window(), 4 * this->_k_max_datagram_size);
+
+  this->reset();
+}
+
+void
+QUICBBRCongestionController::on_packet_sent(QUICPacketInfo &sent_packet)
+{
+  SCOPED_MUTEX_LOCK(lock, this->_cc_mutex, this_ethread());
+  if (this->_extra_packets_count > 0) {
+    --this->_extra_packets_count;
+  }
+
+  if (this->_bytes_in_flight == 0) {
+    // The rate sample intervals start over after an idle period
+    this->_first_sent_time = sent_packet.time_sent;
+    this->_delivered_time  = sent_packet.time_sent;
+  }
+  sent_packet.delivered       = this->_delivered;
+  sent_packet.delivered_time  = this->_delivered_time;
+  sent_packet.first_sent_time = this->_first_sent_time;
+
+  this->_bytes_in_flight += sent_packet.sent_bytes;
+}
+
+void
+QUICBBRCongestionController::on_packet_acked(const QUICPacketInfo &acked_packet)
+{
+  SCOPED_MUTEX_LOCK(lock, this->_cc_mutex, this_ethread());
+  ink_hrtime now = Thread::get_hrtime();
+
+  this->_bytes_in_flight -= acked_packet.sent_bytes;
+  this->_update_model(acked_packet, now);
+  this->_update_state(now);
+  this->_update_congestion_window(acked_packet.sent_bytes);
+}
+
+void
+QUICBBRCongestionController::_start_round()
+{
+  this->_inflight_latest       = this->_delivered - this->_round_delivered_start;
+  this->_next_round_delivered  = this->_delivered;
+  this->_round_delivered_start = this->_delivered;
+  this->_round_lost            = 0;
+  this->_round_lossy           = false;
+  this->_round_start           = true;
+  ++this->_round_count;
+
+  this->_bw_filter[this->_round_count % BW_FILTER_ROUNDS] = 0;
+  this->_max_bw                                           = 0;
+  for (auto bw : this->_bw_filter) {
+    this->_max_bw = std::max(this->_max_bw, bw);
+  }
+}
+
+void
+QUICBBRCongestionController::_update_model(const QUICPacketInfo &acked_packet, ink_hrtime now)
+{
+  this->_delivered += acked_packet.sent_bytes;
+  this->_delivered_time = now;
+
+  // Delivery rate over the longer of the send and the ack intervals of the packet, so that
+  // neither a burst of sends nor a burst of acks overestimates it
+  uint64_t bw = 0;
+  if (acked_packet.delivered_time != 0 && acked_packet.sent_bytes > 0) {
+    ink_hrtime interval = std::max(acked_packet.time_sent - acked_packet.first_sent_time, now - acked_packet.delivered_time);
+    if (interval > 0 && interval >= this->_min_rtt) {
+      bw = (this->_delivered - acked_packet.delivered) * HRTIME_SECOND / interval;
+    }
+  }
+  this->_first_sent_time = acked_packet.time_sent;
+
+  this->_round_start = false;
+  if (acked_packet.delivered >= this->_next_round_delivered) {
+    this->_start_round();
+  }
+
+  uint64_t &slot = this->_bw_filter[this->_round_count % BW_FILTER_ROUNDS];
+  slot           = std::max(slot, bw);
+  this->_max_bw  = std::max(this->_max_bw, bw);
+
+  ink_hrtime rtt           = now - acked_packet.time_sent;
+  this->_probe_rtt_expired = now > this->_probe_rtt_min_stamp + PROBE_RTT_INTERVAL;
+  if (rtt > 0 && (this->_probe_rtt_min_delay == 0 || rtt < this->_probe_rtt_min_delay || this->_probe_rtt_expired)) {
+    this->_probe_rtt_min_delay = rtt;
+    this->_probe_rtt_min_stamp = now;
+  }
+  if (this->_probe_rtt_min_delay > 0 &&
+      (this->_min_rtt == 0 || this->_probe_rtt_min_delay < this->_min_rtt || now > this->_min_rtt_stamp + MIN_RTT_FILTER_LEN)) {
+    this->_min_rtt       = this->_probe_rtt_min_delay;
+    this->_min_rtt_stamp = this->_probe_rtt_min_stamp;
+  }
+}
+
+void
+QUICBBRCongestionController::_update_state(ink_hrtime now)
+{
+  switch (this->_state) {
+  case State::STARTUP:
+    if (this->_round_start && !this->_filled_pipe) {
+      if (this->_max_bw >= this->_full_bw * FULL_BW_GROWTH) {
+        this->_full_bw       = this->_max_bw;
+        this->_full_bw_count = 0;
+      } else if (++this->_full_bw_count >= FULL_BW_COUNT) {
+        this->_filled_pipe = true;
+      }
+    }
+    if (this->_filled_pipe) {
+      this->_enter(State::DRAIN, now);
+    }
+    break;
+  case State::DRAIN:
+    if (this->_bytes_in_flight <= this->_bdp(1.0)) {
+      this->_enter(State::PROBE_BW_DOWN, now);
+    }
+    break;
+  case State::PROBE_BW_DOWN:
+    if (this->_bytes_in_flight <= std::min<uint64_t>(this->_bdp(1.0), this->_inflight_hi * HEADROOM)) {
+      this->_enter(State::PROBE_BW_CRUISE, now);
+    }
+    break;
+  case State::PROBE_BW_CRUISE:
+    // A deterministic spread of the wait keeps flows sharing a bottleneck from probing in sync
+    if (now - this->_state_start >= PROBE_WAIT_BASE + (this->_cycle_count % 8) * PROBE_WAIT_INCREASE) {
+      this->_enter(State::PROBE_BW_REFILL, now);
+    }
+    break;
+  case State::PROBE_BW_REFILL:
+    if (this->_round_count >= this->_probe_up_round_end) {
+      this->_enter(State::PROBE_BW_UP, now);
+    }
+    break;
+  case State::PROBE_BW_UP:
+    // Raise the cap on data in flight faster every round it does not cause loss
+    if (this->_round_start && this->_inflight_hi != UINT64_MAX &&
+        this->_bytes_in_flight + this->_k_max_datagram_size >= this->_inflight_hi) {
+      this->_inflight_hi += static_cast<uint64_t>(this->_k_max_datagram_size) << std::min<uint32_t>(this->_probe_up_rounds, 30);
+      ++this->_probe_up_rounds;
+    }
+    if (now - this->_state_start > this->_min_rtt && this->_bytes_in_flight >= this->_bdp(PROBE_UP_GAIN)) {
+      this->_enter(State::PROBE_BW_DOWN, now);
+    }
+    break;
+  case State::PROBE_RTT:
+    if (this->_probe_rtt_done_at == 0 && this->_bytes_in_flight <= std::max(this->_bdp(0.5), uint64_t(this->_k_minimum_window))) {
+      this->_probe_rtt_done_at   = now + PROBE_RTT_DURATION;
+      this->_probe_rtt_round_end = this->_round_count + 1;
+    } else if (this->_probe_rtt_done_at != 0 && now >= this->_probe_rtt_done_at &&
+               this->_round_count >= this->_probe_rtt_round_end) {
+      this->_probe_rtt_min_stamp = now;
+      this->_congestion_window   = std::max(this->_congestion_window, this->_prior_cwnd);
+      this->_enter(this->_filled_pipe ? State::PROBE_BW_DOWN : State::STARTUP, now);
+    }
+    break;
+  }
+
+  if (this->_state != State::PROBE_RTT && this->_probe_rtt_expired) {
+    this->_enter(State::PROBE_RTT, now);
+  }
+}
+
+void
+QUICBBRCongestionController::_enter(State state, ink_hrtime now)
+{
+  this->_state       = state;
+  this->_state_start = now;
+
+  switch (state) {
+  case State::PROBE_BW_DOWN:
+    ++this->_cycle_count;
+    break;
+  case State::PROBE_BW_REFILL:
+    // Forget the short term bound, the probe finds out again whether the loss was noise
+    this->_inflight_lo        = UINT64_MAX;
+    this->_probe_up_round_end = this->_round_count + 1;
+    break;
+  case State::PROBE_BW_UP:
+    this->_probe_up_rounds = 0;
+    break;
+  case State::PROBE_RTT:
+    this->_prior_cwnd        = this->_congestion_window;
+    this->_probe_rtt_done_at = 0;
+    break;
+  default:
+    break;
+  }
+  QUICCCDebug("state changed");
+}
+
+void
+QUICBBRCongestionController::_update_congestion_window(uint32_t acked_bytes)
+{
+  // Three extra packets absorb delayed and aggregated acks
+  uint64_t target = this->_bdp(this->_cwnd_gain()) + 3 * this->_k_max_datagram_size;
+  uint64_t cwnd   = this->_congestion_window;
+
+  if (this->_filled_pipe) {
+    cwnd = std::min(cwnd + acked_bytes, target);
+  } else if (cwnd < target || this->_delivered < this->_k_initial_window) {
+    cwnd += acked_bytes;
+  }
+
+  if (this->_state == State::PROBE_RTT) {
+    cwnd = std::min(cwnd, std::max(this->_bdp(0.5), uint64_t(this->_k_minimum_window)));
+  }
+  if (this->_state == State::PROBE_BW_UP) {
+    cwnd = std::min(cwnd, this->_inflight_hi);
+  } else if (this->_inflight_hi != UINT64_MAX) {
+    cwnd = std::min<uint64_t>(cwnd, this->_inflight_hi * HEADROOM);
+  }
+  cwnd = std::min(cwnd, this->_inflight_lo);
+
+  this->_congestion_window = std::max<uint64_t>(std::min<uint64_t>(cwnd, UINT32_MAX), this->_k_minimum_window);
+}
+
+void
+QUICBBRCongestionController::_on_lossy_round(uint64_t inflight)
+{
+  this->_round_lossy = true;
+
+  switch (this->_state) {
+  case State::STARTUP:
+    this->_filled_pipe = true;
+    this->_inflight_hi = std::max(this->_bdp(1.0), inflight);
+    this->_enter(State::DRAIN, Thread::get_hrtime());
+    break;
+  case State::PROBE_BW_UP:
+  case State::PROBE_BW_REFILL:
+    this->_inflight_hi = inflight;
+    this->_enter(State::PROBE_BW_DOWN, Thread::get_hrtime());
+    break;
+  default:
+    // Never below what the last round delivered, so that random loss can't spiral the bound down
+    this->_inflight_lo = std::max<uint64_t>(std::min<uint64_t>(this->_congestion_window, this->_inflight_lo) * BETA,
+                                            std::max<uint64_t>(this->_inflight_latest, this->_k_minimum_window));
+    break;
+  }
+
+  uint64_t bound           = std::min(this->_inflight_hi, this->_inflight_lo);
+  this->_congestion_window = std::max<uint64_t>(std::min<uint64_t>(this->_congestion_window, bound), this->_k_minimum_window);
+  QUICCCDebug("lossy round, inflight_hi: %" PRIu64 " inflight_lo: %" PRIu64, this->_inflight_hi, this->_inflight_lo);
+}
+
+void
+QUICBBRCongestionController::on_packets_lost(const std::map<QUICPacketNumber, QUICPacketInfo *> &lost_packets)
+{
+  if (lost_packets.empty()) {
+    return;
+  }
+
+  SCOPED_MUTEX_LOCK(lock, this->_cc_mutex, this_ethread());
+  uint64_t lost = 0;
+  for (auto &lost_packet : lost_packets) {
+    lost += lost_packet.second->sent_bytes;
+  }
+  uint64_t inflight = this->_bytes_in_flight;
+  this->_bytes_in_flight -= lost;
+  this->_round_lost += lost;
+
+  // The loss rate is taken against the larger of the flight and what the round delivered so far, so
+  // that a single random loss early in a round does not count as a lossy round
+  uint64_t base = std::max(inflight, this->_delivered - this->_round_delivered_start + this->_round_lost);
+  if (!this->_round_lossy && this->_round_lost > LOSS_THRESH * base &&
+      (this->_state != State::STARTUP || this->_round_lost >= STARTUP_FULL_LOSS_COUNT * this->_k_max_datagram_size)) {
+    this->_on_lossy_round(inflight);
+  }
+}
+
+void
+QUICBBRCongestionController::process_ecn(const QUICPacketInfo &acked_largest_packet, const QUICAckFrame::EcnSection *ecn_section)
+{
+  SCOPED_MUTEX_LOCK(lock, this->_cc_mutex, this_ethread());
+  if (ecn_section->ecn_ce_count() > this->_ecn_ce_counter) {
+    this->_ecn_ce_counter = ecn_section->ecn_ce_count();
+    if (!this->_round_lossy) {
+      this->_on_lossy_round(this->_bytes_in_flight);
+    }
+  }
+}
+
+uint64_t
+QUICBBRCongestionController::_bdp(double gain) const
+{
+  if (this->_min_rtt == 0 || this->_max_bw == 0) {
+    return gain * this->_k_initial_window;
+  }
+  return gain * this->_max_bw * this->_min_rtt / HRTIME_SECOND;
+}
+
+double
+QUICBBRCongestionController::_pacing_gain() const
+{
+  switch (this->_state) {
+  case State::STARTUP:
+    return STARTUP_PACING_GAIN;
+  case State::DRAIN:
+    return DRAIN_PACING_GAIN;
+  case State::PROBE_BW_DOWN:
+    return PROBE_DOWN_GAIN;
+  case State::PROBE_BW_UP:
+    return PROBE_UP_GAIN;
+  default:
+    return 1.0;
+  }
+}
+
+double
+QUICBBRCongestionController::_cwnd_gain() const
+{
+  return this->_state == State::PROBE_BW_UP ? PROBE_UP_CWND_GAIN : CWND_GAIN;
+}
+
+uint64_t
+QUICBBRCongestionController::pacing_rate() const
+{
+  if (this->_max_bw == 0) {
+    // No delivery rate sample yet, pace the initial window over the RTT the loss detector assumes
+    ink_hrtime srtt = this->_context.rtt_provider()->smoothed_rtt();
+    if (srtt <= 0) {
+      return 0;
+    }
+    return STARTUP_PACING_GAIN * this->_k_initial_window * HRTIME_SECOND / srtt;
+  }
+  return this->_pacing_gain() * this->_max_bw * (1.0 - PACING_MARGIN);
+}
+
+uint32_t
+QUICBBRCongestionController::credit() const
+{
+  if (this->_extra_packets_count) {
+    return UINT32_MAX;
+  }
+
+  if (this->_bytes_in_flight >= this->_congestion_window) {
+    QUICCCDebug("Congestion control pending");
+    return 0;
+  }
+  return this->_congestion_window - this->_bytes_in_flight;
+}
+
+void
+QUICBBRCongestionController::add_extra_credit()
+{
+  ++this->_extra_packets_count;
+}
+
+void
+QUICBBRCongestionController::reset()
+{
+  SCOPED_MUTEX_LOCK(lock, this->_cc_mutex, this_ethread());
+
+  this->_state             = State::STARTUP;
+  this->_state_start       = 0;
+  this->_bytes_in_flight   = 0;
+  this->_congestion_window = this->_k_initial_window;
+  this->_prior_cwnd        = 0;
+
+  this->_delivered       = 0;
+  this->_delivered_time  = 0;
+  this->_first_sent_time = 0;
+
+  this->_round_count           = 0;
+  this->_next_round_delivered  = 0;
+  this->_round_start           = false;
+  this->_round_delivered_start = 0;
+  this->_round_lost            = 0;
+  this->_round_lossy           = false;
+  this->_inflight_latest       = 0;
+
+  std::fill(std::begin(this->_bw_filter), std::end(this->_bw_filter), 0);
+  this->_max_bw              = 0;
+  this->_min_rtt             = 0;
+  this->_min_rtt_stamp       = 0;
+  this->_probe_rtt_min_delay = 0;
+  this->_probe_rtt_min_stamp = Thread::get_hrtime();
+  this->_probe_rtt_expired   = false;
+  this->_inflight_hi         = UINT64_MAX;
+  this->_inflight_lo         = UINT64_MAX;
+
+  this->_filled_pipe   = false;
+  this->_full_bw       = 0;
+  this->_full_bw_count = 0;
+
+  this->_cycle_count         = 0;
+  this->_probe_up_rounds     = 0;
+  this->_probe_up_round_end  = 0;
+  this->_probe_rtt_done_at   = 0;
+  this->_probe_rtt_round_end = 0;
+}
+
+QUICBBRCongestionController::State
+QUICBBRCongestionController::state() const
+{
+  return this->_state;
+}
+
+uint32_t
+QUICBBRCongestionController::bytes_in_flight() const
+{
+  return this->_bytes_in_flight;
+}
+
+uint32_t
+QUICBBRCongestionController::congestion_window() const
+{
+  return this->_congestion_window;
+}
+
+uint64_t
+QUICBBRCongestionController::max_bw() const
+{
+  return this->_max_bw;
+}
+
+ink_hrtime
+QUICBBRCongestionController::min_rtt() const
+{
+  return this->_min_rtt;
+}
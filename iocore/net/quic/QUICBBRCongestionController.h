@@ -0,0 +1,139 @@
+/** @file
+ *
+ *  BBR congestion control for QUIC
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "QUICLossDetector.h"
+
+/**
+ * A BBRv2 style model based congestion controller (draft-cardwell-iccrg-bbr-congestion-control).
+ *
+ * The sender estimates the bottleneck bandwidth from the delivery rate of acked packets and the
+ * propagation delay from the minimum RTT, then paces at that rate and keeps about two BDPs in
+ * flight. Loss does not shrink the window directly like Reno. Instead, a round that loses more
+ * than 2% of its data caps the data in flight at what it was when the loss happened, which keeps
+ * the sender out of shallow buffers without giving up the bandwidth of a randomly lossy path.
+ *
+ * This keeps the core state machine of BBRv2 (Startup, Drain, the four ProbeBW phases and ProbeRTT)
+ * and its long and short term bounds on data in flight, but leaves out the short term bandwidth
+ * bound and the ECN alpha estimate. An ECN-CE mark is treated as one lossy round.
+ */
+class QUICBBRCongestionController : public QUICCongestionController
+{
+public:
+  enum class State {
+    STARTUP,
+    DRAIN,
+    PROBE_BW_DOWN,
+    PROBE_BW_CRUISE,
+    PROBE_BW_REFILL,
+    PROBE_BW_UP,
+    PROBE_RTT,
+  };
+
+  QUICBBRCongestionController(QUICCCContext &context);
+  virtual ~QUICBBRCongestionController() {}
+  void on_packet_sent(QUICPacketInfo &sent_packet) override;
+  void on_packet_acked(const QUICPacketInfo &acked_packet) override;
+  void on_packets_lost(const std::map<QUICPacketNumber, QUICPacketInfo *> &packets) override;
+  void process_ecn(const QUICPacketInfo &acked_largest_packet, const QUICAckFrame::EcnSection *ecn_section) override;
+  void add_extra_credit() override;
+  void reset() override;
+  uint32_t credit() const override;
+  uint64_t pacing_rate() const override;
+
+  // Debug
+  State state() const;
+  uint32_t bytes_in_flight() const;
+  uint32_t congestion_window() const;
+  uint64_t max_bw() const;
+  ink_hrtime min_rtt() const;
+
+private:
+  static constexpr int BW_FILTER_ROUNDS = 10;
+
+  Ptr<ProxyMutex> _cc_mutex;
+
+  uint64_t _bdp(double gain) const;
+  void _enter(State state, ink_hrtime now);
+  void _start_round();
+  void _update_model(const QUICPacketInfo &acked_packet, ink_hrtime now);
+  void _update_state(ink_hrtime now);
+  void _update_congestion_window(uint32_t acked_bytes);
+  void _on_lossy_round(uint64_t inflight);
+  double _pacing_gain() const;
+  double _cwnd_gain() const;
+
+  uint32_t _extra_packets_count = 0;
+
+  // Values will be loaded from records.config via QUICConfig at constructor
+  uint32_t _k_max_datagram_size = 0;
+  uint32_t _k_initial_window    = 0;
+  uint32_t _k_minimum_window    = 0;
+
+  State _state                = State::STARTUP;
+  ink_hrtime _state_start     = 0;
+  uint32_t _bytes_in_flight   = 0;
+  uint32_t _congestion_window = 0;
+  uint32_t _prior_cwnd        = 0;
+  uint32_t _ecn_ce_counter    = 0;
+
+  // Delivery rate sampling
+  uint64_t _delivered         = 0;
+  ink_hrtime _delivered_time  = 0;
+  ink_hrtime _first_sent_time = 0;
+
+  // Round trips, counted in packet timed rounds
+  uint64_t _round_count           = 0;
+  uint64_t _next_round_delivered  = 0;
+  bool _round_start               = false;
+  uint64_t _round_delivered_start = 0;
+  uint64_t _round_lost            = 0;
+  bool _round_lossy               = false;
+  uint64_t _inflight_latest       = 0;
+
+  // The model
+  uint64_t _bw_filter[BW_FILTER_ROUNDS] = {0};
+  uint64_t _max_bw                      = 0;
+  ink_hrtime _min_rtt                   = 0;
+  ink_hrtime _min_rtt_stamp             = 0;
+  ink_hrtime _probe_rtt_min_delay       = 0;
+  ink_hrtime _probe_rtt_min_stamp       = 0;
+  bool _probe_rtt_expired               = false;
+  uint64_t _inflight_hi                 = UINT64_MAX;
+  uint64_t _inflight_lo                 = UINT64_MAX;
+
+  // Startup
+  bool _filled_pipe       = false;
+  uint64_t _full_bw       = 0;
+  uint32_t _full_bw_count = 0;
+
+  // ProbeBW and ProbeRTT
+  uint32_t _cycle_count         = 0;
+  uint32_t _probe_up_rounds     = 0;
+  uint64_t _probe_up_round_end  = 0;
+  ink_hrtime _probe_rtt_done_at = 0;
+  uint64_t _probe_rtt_round_end = 0;
+
+  QUICCCContext &_context;
+};
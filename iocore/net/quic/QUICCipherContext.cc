@@ -0,0 +1,73 @@
+/** @file
+
+  Cipher contexts reused across QUIC packets protected with the same key
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <cstring>
+
+#include "QUICCipherContext.h"
+
+QUICCipherContext::~QUICCipherContext()
+{
+  if (this->_ctx) {
+    EVP_CIPHER_CTX_free(this->_ctx);
+  }
+}
+
+EVP_CIPHER_CTX *
+QUICCipherContext::get(const EVP_CIPHER *cipher, const uint8_t *key, bool encrypt, size_t iv_len)
+{
+  size_t key_len = EVP_CIPHER_key_length(cipher);
+
+  if (this->_ctx && this->_cipher == cipher && this->_encrypt == encrypt && this->_iv_len == iv_len &&
+      memcmp(this->_key, key, key_len) == 0) {
+    return this->_ctx;
+  }
+
+  if (this->_ctx == nullptr) {
+    if (!(this->_ctx = EVP_CIPHER_CTX_new())) {
+      return nullptr;
+    }
+  } else {
+    EVP_CIPHER_CTX_reset(this->_ctx);
+  }
+  this->_cipher = nullptr;
+
+  if (!EVP_CipherInit_ex(this->_ctx, cipher, nullptr, nullptr, nullptr, encrypt)) {
+    return nullptr;
+  }
+  if (EVP_CIPHER_flags(cipher) & EVP_CIPH_FLAG_AEAD_CIPHER) {
+    if (!EVP_CIPHER_CTX_ctrl(this->_ctx, EVP_CTRL_AEAD_SET_IVLEN, iv_len, nullptr)) {
+      return nullptr;
+    }
+  }
+  if (!EVP_CipherInit_ex(this->_ctx, nullptr, nullptr, key, nullptr, encrypt)) {
+    return nullptr;
+  }
+  EVP_CIPHER_CTX_set_padding(this->_ctx, 0);
+
+  this->_cipher  = cipher;
+  this->_encrypt = encrypt;
+  this->_iv_len  = iv_len;
+  memcpy(this->_key, key, key_len);
+
+  return this->_ctx;
+}
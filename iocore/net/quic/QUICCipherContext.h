@@ -0,0 +1,60 @@
+/** @file
+
+  Cipher contexts reused across QUIC packets protected with the same key
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <openssl/evp.h>
+
+/**
+ * An EVP cipher context that stays set up with the last key it was given.
+ *
+ * Setting up a context allocates it and expands the key, which costs more than protecting a short
+ * packet with AES-GCM. Packet protection asks for the context with the key of every packet, and only
+ * a new cipher or new key bytes set it up again, so most packets just set their nonce.
+ */
+class QUICCipherContext
+{
+public:
+  QUICCipherContext() = default;
+  ~QUICCipherContext();
+
+  QUICCipherContext(const QUICCipherContext &) = delete;
+  QUICCipherContext &operator=(const QUICCipherContext &) = delete;
+
+  /**
+   * Returns the context set up to encrypt or decrypt with @a cipher and @a key, or nullptr on failure.
+   *
+   * Block ciphers are set up without padding. AEAD ciphers are set up for a @a iv_len byte nonce, which
+   * the caller sets with EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, nonce, -1) for each packet.
+   */
+  EVP_CIPHER_CTX *get(const EVP_CIPHER *cipher, const uint8_t *key, bool encrypt, size_t iv_len = 0);
+
+private:
+  EVP_CIPHER_CTX *_ctx      = nullptr;
+  const EVP_CIPHER *_cipher = nullptr;
+  bool _encrypt             = false;
+  size_t _iv_len            = 0;
+  uint8_t _key[EVP_MAX_KEY_LENGTH];
+};
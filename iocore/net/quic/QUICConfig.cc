@@ -179,6 +179,20 @@ QUICConfigParams::initialize()
   REC_EstablishStaticConfigInt32U(this->_cc_persistent_congestion_threshold,
                                   "proxy.config.quic.congestion_control.persistent_congestion_threshold");
 
+  char *algorithm = nullptr;
+  REC_ReadConfigStringAlloc(algorithm, "proxy.config.quic.congestion_control.algorithm");
+  if (algorithm == nullptr || strcasecmp(algorithm, "newreno") == 0) {
+    this->_cc_algorithm = QUICCongestionControlAlgorithm::NEW_RENO;
+  } else if (strcasecmp(algorithm, "cubic") == 0) {
+    this->_cc_algorithm = QUICCongestionControlAlgorithm::CUBIC;
+  } else if (strcasecmp(algorithm, "bbr") == 0) {
+    this->_cc_algorithm = QUICCongestionControlAlgorithm::BBR;
+  } else {
+    Warning("unknown proxy.config.quic.congestion_control.algorithm '%s', using newreno", algorithm);
+    this->_cc_algorithm = QUICCongestionControlAlgorithm::NEW_RENO;
+  }
+  ats_free(algorithm);
+
   this->_client_ssl_ctx = quic_init_client_ssl_ctx(this);
 }
 
@@ -429,6 +443,12 @@ QUICConfigParams::cc_persistent_congestion_threshold() const
   return _cc_persistent_congestion_threshold;
 }
 
+QUICCongestionControlAlgorithm
+QUICConfigParams::cc_algorithm() const
+{
+  return _cc_algorithm;
+}
+
 uint8_t
 QUICConfigParams::scid_len()
 {
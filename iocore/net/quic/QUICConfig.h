@@ -28,6 +28,8 @@
 #include "ProxyConfig.h"
 #include "P_SSLCertLookup.h"
 
+#include "QUICTypes.h"
+
 class QUICConfigParams : public ConfigInfo
 {
 public:
@@ -84,6 +86,7 @@ public:
   uint32_t cc_minimum_window() const;
   float cc_loss_reduction_factor() const;
   uint32_t cc_persistent_congestion_threshold() const;
+  QUICCongestionControlAlgorithm cc_algorithm() const;
 
   static int connection_table_size();
   static uint8_t scid_len();
@@ -143,6 +146,7 @@ private:
   uint32_t _cc_minimum_window_scale            = 2;  // Actual minimum window size is this value multiplied by the _cc_default_mss
   float _cc_loss_reduction_factor              = 0.5;
   uint32_t _cc_persistent_congestion_threshold = 3;
+  QUICCongestionControlAlgorithm _cc_algorithm = QUICCongestionControlAlgorithm::NEW_RENO;
 };
 
 class QUICConfig
@@ -36,6 +36,10 @@ struct QUICPacketInfo {
   QUICPacketType type;
   std::vector<QUICFrameInfo> frames;
   QUICPacketNumberSpace pn_space;
+  // delivery rate sampling, filled in by the congestion controller
+  uint64_t delivered         = 0;
+  ink_hrtime delivered_time  = 0;
+  ink_hrtime first_sent_time = 0;
   // end
 };
 
@@ -43,11 +47,18 @@ class QUICCongestionController
 {
 public:
   virtual ~QUICCongestionController() {}
-  virtual void on_packet_sent(size_t bytes_sent)                                                                    = 0;
+  virtual void on_packet_sent(QUICPacketInfo &sent_packet)                                                          = 0;
   virtual void on_packet_acked(const QUICPacketInfo &acked_packet)                                                  = 0;
   virtual void process_ecn(const QUICPacketInfo &acked_largest_packet, const QUICAckFrame::EcnSection *ecn_section) = 0;
   virtual void on_packets_lost(const std::map<QUICPacketNumber, QUICPacketInfo *> &packets)                         = 0;
   virtual void add_extra_credit()                                                                                   = 0;
   virtual void reset()                                                                                              = 0;
   virtual uint32_t credit() const                                                                                   = 0;
+
+  // Bytes per second the sender should spread its packets at, 0 sends them as fast as credit() allows.
+  virtual uint64_t
+  pacing_rate() const
+  {
+    return 0;
+  }
 };
@@ -0,0 +1,165 @@
+/** @file
+ *
+ *  CUBIC congestion control for QUIC
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cmath>
+
+#include <tscore/Diags.h>
+#include <QUICCubicCongestionController.h>
+
+#define QUICCCDebug(fmt, ...)                                                                                               \
+  Debug("quic_cc",                                                                                                          \
+        "[%s] "                                                                                                             \
+        "window: %" PRIu32 " bytes: %" PRIu32 " ssthresh: %" PRIu32 " w_max: %.0f " fmt,                                    \
+        this->_context.connection_info()->cids().data(), this->_congestion_window, this->_bytes_in_flight, this->_ssthresh, \
+        this->_w_max, ##__VA_ARGS__)
+
+// [RFC 8312] 5.  Constants, alpha is the Reno-friendly increase per window acked
+static constexpr double CUBIC_C     = 0.4;
+static constexpr double CUBIC_BETA  = 0.7;
+static constexpr double CUBIC_ALPHA = 3.0 * (1.0 - CUBIC_BETA) / (1.0 + CUBIC_BETA);
+
+// Pacing runs ahead of the window so that pacing alone never limits the window growth
+static constexpr double SLOW_START_PACING_GAIN           = 2.0;
+static constexpr double CONGESTION_AVOIDANCE_PACING_GAIN = 1.25;
+
+QUICCubicCongestionController::QUICCubicCongestionController(QUICCCContext &context) : QUICNewRenoCongestionController(context)
+{
+  this->reset();
+}
+
+double
+QUICCubicCongestionController::_w_cubic(double t) const
+{
+  // W_cubic(t) = C*(t-K)^3 + W_max, with the window in segments
+  double d = t - this->_k;
+  return CUBIC_C * d * d * d * this->_k_max_datagram_size + this->_w_max;
+}
+
+void
+QUICCubicCongestionController::on_packet_acked(const QUICPacketInfo &acked_packet)
+{
+  SCOPED_MUTEX_LOCK(lock, this->_cc_mutex, this_ethread());
+  this->_bytes_in_flight -= acked_packet.sent_bytes;
+  if (this->_in_congestion_recovery(acked_packet.time_sent)) {
+    return;
+  }
+
+  if (this->_congestion_window < this->_ssthresh) {
+    this->_congestion_window += acked_packet.sent_bytes;
+    QUICCCDebug("slow start window changed");
+    return;
+  }
+
+  double cwnd    = this->_congestion_window;
+  ink_hrtime now = Thread::get_hrtime();
+  if (this->_epoch_start == 0) {
+    // First ack of a congestion avoidance epoch
+    this->_epoch_start = now;
+    if (cwnd < this->_w_max) {
+      this->_k = std::cbrt((this->_w_max - cwnd) / this->_k_max_datagram_size / CUBIC_C);
+    } else {
+      this->_k     = 0.0;
+      this->_w_max = cwnd;
+    }
+    this->_w_est          = cwnd;
+    this->_cwnd_remainder = 0.0;
+  }
+
+  // [RFC 8312] 4.1.  The target is where the curve will be one RTT from now
+  double t      = static_cast<double>(now - this->_epoch_start + this->_context.rtt_provider()->smoothed_rtt()) / HRTIME_SECOND;
+  double target = std::min(std::max(this->_w_cubic(t), cwnd), 1.5 * cwnd);
+
+  // [RFC 8312] 4.2.  TCP-Friendly Region
+  this->_w_est += CUBIC_ALPHA * this->_k_max_datagram_size * acked_packet.sent_bytes / cwnd;
+
+  if (this->_w_est > target) {
+    this->_cwnd_remainder += this->_w_est - cwnd;
+  } else {
+    // [RFC 8312] 4.3. and 4.4.  Concave and convex regions
+    this->_cwnd_remainder += (target - cwnd) * acked_packet.sent_bytes / cwnd;
+  }
+  if (this->_cwnd_remainder >= 1.0) {
+    uint32_t inc = static_cast<uint32_t>(this->_cwnd_remainder);
+    this->_congestion_window += inc;
+    this->_cwnd_remainder -= inc;
+  }
+  QUICCCDebug("congestion avoidance window changed");
+}
+
+void
+QUICCubicCongestionController::_congestion_event(ink_hrtime sent_time)
+{
+  if (this->_in_congestion_recovery(sent_time)) {
+    return;
+  }
+
+  this->_congestion_recovery_start_time = Thread::get_hrtime();
+
+  // [RFC 8312] 4.6.  Fast Convergence
+  double cwnd = this->_congestion_window;
+  if (cwnd < this->_w_max) {
+    this->_w_max = cwnd * (1.0 + CUBIC_BETA) / 2.0;
+  } else {
+    this->_w_max = cwnd;
+  }
+
+  // [RFC 8312] 4.5.  Multiplicative Decrease
+  this->_congestion_window = std::max(static_cast<uint32_t>(cwnd * CUBIC_BETA), this->_k_minimum_window);
+  this->_ssthresh          = this->_congestion_window;
+  this->_epoch_start       = 0;
+  QUICCCDebug("congestion event");
+}
+
+void
+QUICCubicCongestionController::_persistent_congestion()
+{
+  // [RFC 8312] 4.7.  Timeout, the curve starts over from the minimum window
+  this->_congestion_window = this->_k_minimum_window;
+  this->_w_max             = 0.0;
+  this->_epoch_start       = 0;
+}
+
+void
+QUICCubicCongestionController::reset()
+{
+  QUICNewRenoCongestionController::reset();
+
+  SCOPED_MUTEX_LOCK(lock, this->_cc_mutex, this_ethread());
+  this->_w_max          = 0.0;
+  this->_k              = 0.0;
+  this->_w_est          = 0.0;
+  this->_cwnd_remainder = 0.0;
+  this->_epoch_start    = 0;
+}
+
+uint64_t
+QUICCubicCongestionController::pacing_rate() const
+{
+  ink_hrtime srtt = this->_context.rtt_provider()->smoothed_rtt();
+  if (srtt <= 0) {
+    return 0;
+  }
+
+  double gain = this->_congestion_window < this->_ssthresh ? SLOW_START_PACING_GAIN : CONGESTION_AVOIDANCE_PACING_GAIN;
+  return static_cast<uint64_t>(gain * this->_congestion_window * HRTIME_SECOND / srtt);
+}
@@ -0,0 +1,57 @@
+/** @file
+ *
+ *  CUBIC congestion control for QUIC
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include "QUICLossDetector.h"
+
+/**
+ * CUBIC (RFC 8312) on top of the NewReno recovery logic.
+ *
+ * Slow start, recovery periods, ECN and persistent congestion work as in NewReno. Congestion
+ * avoidance grows the window along a cubic function of the time since the last reduction, which
+ * gets back to the previous maximum within a few seconds no matter how long the RTT is, and a
+ * reduction only takes 30% off the window.
+ */
+class QUICCubicCongestionController : public QUICNewRenoCongestionController
+{
+public:
+  QUICCubicCongestionController(QUICCCContext &context);
+  void on_packet_acked(const QUICPacketInfo &acked_packet) override;
+  void reset() override;
+  uint64_t pacing_rate() const override;
+
+protected:
+  void _congestion_event(ink_hrtime sent_time) override;
+  void _persistent_congestion() override;
+
+private:
+  double _w_cubic(double t) const;
+
+  // [RFC 8312] 4.1.  Window Increase Function, in bytes
+  double _w_max           = 0.0;
+  double _k               = 0.0;
+  double _w_est           = 0.0;
+  double _cwnd_remainder  = 0.0;
+  ink_hrtime _epoch_start = 0;
+};
@@ -51,6 +51,36 @@ read_varint(uint8_t *&pos, size_t len, uint64_t &field, size_t &field_len)
   return true;
 }
 
+// The data of STREAM and CRYPTO frames refers to the payload of the received packet when there is one, so parsing
+// them doesn't copy or allocate a buffer
+static Ptr<IOBufferBlock>
+data_block(const QUICPacket *packet, const uint8_t *data, uint64_t data_len)
+{
+  Ptr<IOBufferBlock> block;
+
+  IOBufferBlock *payload = packet ? packet->payload_block() : nullptr;
+  if (payload) {
+    const uint8_t *start = reinterpret_cast<const uint8_t *>(payload->start());
+    if (start <= data && data + data_len <= start + payload->size()) {
+      block = make_ptr<IOBufferBlock>(payload->clone());
+      block->consume(data - start);
+      block->_end = block->_start + data_len;
+      return block;
+    }
+  }
+
+  block = make_ptr<IOBufferBlock>(new_IOBufferBlock());
+  block->alloc();
+  ink_assert(static_cast<uint64_t>(block->write_avail()) > data_len);
+  memcpy(block->start(), data, data_len);
+  block->fill(data_len);
+  return block;
+}
+
+// Copies of STREAM and CRYPTO frames are held by streams until the data is in order
+static Allocator quicStreamFrameAllocator("quicStreamFrameAllocator", sizeof(QUICStreamFrame));
+static Allocator quicCryptoFrameAllocator("quicCryptoFrameAllocator", sizeof(QUICCryptoFrame));
+
 QUICFrameType
 QUICFrame::type() const
 {
@@ -152,6 +182,19 @@ QUICStreamFrame::QUICStreamFrame(const uint8_t *buf, size_t len, const QUICPacke
   this->parse(buf, len, packet);
 }
 
+void *
+QUICStreamFrame::operator new(size_t size)
+{
+  ink_assert(size == sizeof(QUICStreamFrame));
+  return quicStreamFrameAllocator.alloc_void();
+}
+
+void
+QUICStreamFrame::operator delete(void *p)
+{
+  quicStreamFrameAllocator.free_void(p);
+}
+
 QUICStreamFrame::QUICStreamFrame(const QUICStreamFrame &o)
   : QUICFrame(o),
     _block(make_ptr<IOBufferBlock>(o._block->clone())),
@@ -198,11 +241,7 @@ QUICStreamFrame::parse(const uint8_t *buf, size_t len, const QUICPacket *packet)
   }
 
   this->_valid = true;
-  this->_block = make_ptr<IOBufferBlock>(new_IOBufferBlock());
-  this->_block->alloc();
-  ink_assert(static_cast<uint64_t>(this->_block->write_avail()) > data_len);
-  memcpy(this->_block->start(), pos, data_len);
-  this->_block->fill(data_len);
+  this->_block = data_block(packet, pos, data_len);
   pos += data_len;
   this->_size = FRAME_SIZE(pos);
 }
@@ -397,6 +436,19 @@ QUICCryptoFrame::QUICCryptoFrame(const uint8_t *buf, size_t len, const QUICPacke
   this->parse(buf, len, packet);
 }
 
+void *
+QUICCryptoFrame::operator new(size_t size)
+{
+  ink_assert(size == sizeof(QUICCryptoFrame));
+  return quicCryptoFrameAllocator.alloc_void();
+}
+
+void
+QUICCryptoFrame::operator delete(void *p)
+{
+  quicCryptoFrameAllocator.free_void(p);
+}
+
 QUICCryptoFrame::QUICCryptoFrame(const QUICCryptoFrame &o)
   : QUICFrame(o), _offset(o._offset), _block(make_ptr<IOBufferBlock>(o._block->clone()))
 {
@@ -425,11 +477,7 @@ QUICCryptoFrame::parse(const uint8_t *buf, size_t len, const QUICPacket *packet)
   }
 
   this->_valid = true;
-  this->_block = make_ptr<IOBufferBlock>(new_IOBufferBlock());
-  this->_block->alloc();
-  ink_assert(static_cast<uint64_t>(this->_block->write_avail()) > data_len);
-  memcpy(this->_block->start(), pos, data_len);
-  this->_block->fill(data_len);
+  this->_block = data_block(packet, pos, data_len);
   pos += data_len;
   this->_size = FRAME_SIZE(pos);
 }
@@ -574,7 +622,7 @@ QUICAckFrame::parse(const uint8_t *buf, size_t len, const QUICPacket *packet)
     return;
   }
 
-  this->_ack_block_section = new AckBlockSection(first_ack_block);
+  this->_ack_block_section.reset(first_ack_block);
   for (size_t i = 0; i < ack_block_count; i++) {
     uint64_t gap           = 0;
     uint64_t add_ack_block = 0;
@@ -587,15 +635,16 @@ QUICAckFrame::parse(const uint8_t *buf, size_t len, const QUICPacket *packet)
       return;
     }
 
-    this->_ack_block_section->add_ack_block({gap, add_ack_block});
+    this->_ack_block_section.add_ack_block({gap, add_ack_block});
   }
 
   if (has_ecn) {
-    this->_ecn_section = new EcnSection(pos, LEFT_SPACE(pos));
-    if (!this->_ecn_section->valid()) {
+    this->_ecn_section     = EcnSection(pos, LEFT_SPACE(pos));
+    this->_has_ecn_section = true;
+    if (!this->_ecn_section.valid()) {
       return;
     }
-    pos += this->_ecn_section->size();
+    pos += this->_ecn_section.size();
   }
 
   this->_valid = true;
@@ -608,20 +657,14 @@ QUICAckFrame::QUICAckFrame(QUICPacketNumber largest_acknowledged, uint64_t ack_d
 {
   this->_largest_acknowledged = largest_acknowledged;
   this->_ack_delay            = ack_delay;
-  this->_ack_block_section    = new AckBlockSection(first_ack_block);
+  this->_ack_block_section.reset(first_ack_block);
 }
 
 void
 QUICAckFrame::_reset()
 {
-  if (this->_ack_block_section) {
-    delete this->_ack_block_section;
-    this->_ack_block_section = nullptr;
-  }
-  if (this->_ecn_section) {
-    delete this->_ecn_section;
-    this->_ecn_section = nullptr;
-  }
+  this->_ack_block_section.reset(0);
+  this->_has_ecn_section = false;
 
   this->_largest_acknowledged = 0;
   this->_ack_delay            = 0;
@@ -631,17 +674,7 @@ QUICAckFrame::_reset()
   this->_size                 = 0;
 }
 
-QUICAckFrame::~QUICAckFrame()
-{
-  if (this->_ack_block_section) {
-    delete this->_ack_block_section;
-    this->_ack_block_section = nullptr;
-  }
-  if (this->_ecn_section) {
-    delete this->_ecn_section;
-    this->_ecn_section = nullptr;
-  }
-}
+QUICAckFrame::~QUICAckFrame() {}
 
 QUICFrameType
 QUICAckFrame::type() const
@@ -658,13 +691,11 @@ QUICAckFrame::size() const
   }
 
   size_t pre_len = 1 + QUICVariableInt::size(this->_largest_acknowledged) + QUICVariableInt::size(this->_ack_delay) +
-                   QUICVariableInt::size(this->_ack_block_section->count());
-  if (this->_ack_block_section) {
-    pre_len += this->_ack_block_section->size();
-  }
+                   QUICVariableInt::size(this->_ack_block_section.count());
+  pre_len += this->_ack_block_section.size();
 
-  if (this->_ecn_section) {
-    return pre_len + this->_ecn_section->size();
+  if (this->_has_ecn_section) {
+    return pre_len + this->_ecn_section.size();
   }
 
   return pre_len;
@@ -704,7 +735,7 @@ QUICAckFrame::to_io_buffer_block(size_t limit) const
   block->fill(n);
 
   // First Ack Range (i) + Ack Ranges (*)
-  block->next = this->_ack_block_section->to_io_buffer_block(limit - n);
+  block->next = this->_ack_block_section.to_io_buffer_block(limit - n);
 
   return block;
 }
@@ -738,31 +769,31 @@ QUICAckFrame::ack_delay() const
 uint64_t
 QUICAckFrame::ack_block_count() const
 {
-  return this->_ack_block_section->count();
+  return this->_ack_block_section.count();
 }
 
 QUICAckFrame::AckBlockSection *
 QUICAckFrame::ack_block_section()
 {
-  return this->_ack_block_section;
+  return &this->_ack_block_section;
 }
 
 const QUICAckFrame::AckBlockSection *
 QUICAckFrame::ack_block_section() const
 {
-  return this->_ack_block_section;
+  return &this->_ack_block_section;
 }
 
 QUICAckFrame::EcnSection *
 QUICAckFrame::ecn_section()
 {
-  return this->_ecn_section;
+  return this->_has_ecn_section ? &this->_ecn_section : nullptr;
 }
 
 const QUICAckFrame::EcnSection *
 QUICAckFrame::ecn_section() const
 {
-  return this->_ecn_section;
+  return this->_has_ecn_section ? &this->_ecn_section : nullptr;
 }
 
 //
@@ -823,6 +854,13 @@ QUICAckFrame::AckBlock::size() const
 //
 // QUICAckFrame::AckBlockSection
 //
+void
+QUICAckFrame::AckBlockSection::reset(uint64_t first_ack_block)
+{
+  this->_first_ack_block = first_ack_block;
+  this->_ack_blocks.clear();
+}
+
 uint8_t
 QUICAckFrame::AckBlockSection::count() const
 {
@@ -91,6 +91,15 @@ public:
                   QUICFrameGenerator *owner = nullptr);
   QUICStreamFrame(const QUICStreamFrame &o);
 
+  // Copies made with new come from a freelist, frames created in place still take a buffer
+  static void *operator new(size_t size);
+  static void *
+  operator new(size_t, void *ptr)
+  {
+    return ptr;
+  }
+  static void operator delete(void *p);
+
   virtual QUICFrameType type() const override;
   virtual size_t size() const override;
   virtual bool is_flow_controlled() const override;
@@ -135,6 +144,15 @@ public:
   QUICCryptoFrame(Ptr<IOBufferBlock> &block, QUICOffset offset, QUICFrameId id = 0, QUICFrameGenerator *owner = nullptr);
   QUICCryptoFrame(const QUICCryptoFrame &o);
 
+  // Copies made with new come from a freelist, frames created in place still take a buffer
+  static void *operator new(size_t size);
+  static void *
+  operator new(size_t, void *ptr)
+  {
+    return ptr;
+  }
+  static void operator delete(void *p);
+
   virtual QUICFrameType type() const override;
   virtual size_t size() const override;
   virtual Ptr<IOBufferBlock> to_io_buffer_block(size_t limit) const override;
@@ -223,6 +241,7 @@ public:
     };
 
     AckBlockSection(uint64_t first_ack_block) : _first_ack_block(first_ack_block) {}
+    void reset(uint64_t first_ack_block);
     uint8_t count() const;
     size_t size() const;
     Ptr<IOBufferBlock> to_io_buffer_block(size_t limit) const;
@@ -241,6 +260,7 @@ public:
   class EcnSection
   {
   public:
+    EcnSection() {}
     EcnSection(const uint8_t *buf, size_t len);
     size_t size() const;
     bool valid() const;
@@ -282,10 +302,12 @@ public:
 private:
   virtual void _reset() override;
 
+  // The sections are kept across parses so that a reused frame doesn't allocate
   QUICPacketNumber _largest_acknowledged = 0;
   uint64_t _ack_delay                    = 0;
-  AckBlockSection *_ack_block_section    = nullptr;
-  EcnSection *_ecn_section               = nullptr;
+  AckBlockSection _ack_block_section     = {0};
+  EcnSection _ecn_section;
+  bool _has_ecn_section = false;
 };
 
 //
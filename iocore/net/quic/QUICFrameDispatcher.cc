@@ -77,7 +77,7 @@ QUICFrameDispatcher::receive_frames(QUICEncryptionLevel level, const uint8_t *pa
       ack_only = false;
     }
 
-    std::vector<QUICFrameHandler *> handlers = this->_handlers[static_cast<uint8_t>(type)];
+    const std::vector<QUICFrameHandler *> &handlers = this->_handlers[static_cast<uint8_t>(type)];
     for (auto h : handlers) {
       error = h->handle_frame(level, frame);
       // TODO: is there any case to continue this loop even if error?
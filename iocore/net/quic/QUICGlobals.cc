@@ -92,6 +92,12 @@ QUIC::_register_stats()
   // Transfered packet counts
   RecRegisterRawStat(quic_rsb, RECT_PROCESS, "proxy.process.quic.total_packets_sent", RECD_INT, RECP_PERSISTENT,
                      static_cast<int>(QUICStats::total_packets_sent_stat), RecRawStatSyncSum);
+
+  // Pacing and send batching
+  RecRegisterRawStat(quic_rsb, RECT_PROCESS, "proxy.process.quic.avg_pacing_delay", RECD_FLOAT, RECP_PERSISTENT,
+                     static_cast<int>(QUICStats::pacing_delay_stat), RecRawStatSyncAvg);
+  RecRegisterRawStat(quic_rsb, RECT_PROCESS, "proxy.process.quic.avg_send_burst_size", RECD_FLOAT, RECP_PERSISTENT,
+                     static_cast<int>(QUICStats::send_burst_size_stat), RecRawStatSyncAvg);
   // RecRegisterRawStat(quic_rsb, RECT_PROCESS, "proxy.process.quic.total_packets_retransmitted", RECD_INT, RECP_PERSISTENT,
   //                              static_cast<int>(quic_total_packets_retransmitted_stat), RecRawStatSyncSum);
   // RecRegisterRawStat(quic_rsb, RECT_PROCESS, "proxy.process.quic.total_packets_received", RECD_INT, RECP_PERSISTENT,
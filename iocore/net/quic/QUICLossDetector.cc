@@ -138,6 +138,7 @@ QUICLossDetector::on_packet_sent(QUICPacketInfoUPtr packet_info, bool in_flight)
   bool is_crypto_packet          = packet_info->is_crypto_packet;
   ink_hrtime now                 = packet_info->time_sent;
   size_t sent_bytes              = packet_info->sent_bytes;
+  QUICPacketInfo &sent_packet    = *packet_info;
 
   QUICLDDebug("%s packet sent : %" PRIu64 " bytes: %lu ack_eliciting: %d", QUICDebugNames::pn_space(packet_info->pn_space),
               packet_number, sent_bytes, ack_eliciting);
@@ -152,7 +153,7 @@ QUICLossDetector::on_packet_sent(QUICPacketInfoUPtr packet_info, bool in_flight)
     if (ack_eliciting) {
       this->_time_of_last_sent_ack_eliciting_packet = now;
     }
-    this->_cc->on_packet_sent(sent_bytes);
+    this->_cc->on_packet_sent(sent_packet);
     this->_set_loss_detection_timer();
   }
 }
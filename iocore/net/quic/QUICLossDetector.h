@@ -61,7 +61,7 @@ class QUICNewRenoCongestionController : public QUICCongestionController
 public:
   QUICNewRenoCongestionController(QUICCCContext &context);
   virtual ~QUICNewRenoCongestionController() {}
-  void on_packet_sent(size_t bytes_sent) override;
+  void on_packet_sent(QUICPacketInfo &sent_packet) override;
   void on_packet_acked(const QUICPacketInfo &acked_packet) override;
   virtual void on_packets_lost(const std::map<QUICPacketNumber, QUICPacketInfo *> &packets) override;
   void process_ecn(const QUICPacketInfo &acked_largest_packet, const QUICAckFrame::EcnSection *ecn_section) override;
@@ -77,10 +77,11 @@ public:
 
   void add_extra_credit() override;
 
-private:
+protected:
   Ptr<ProxyMutex> _cc_mutex;
 
-  void _congestion_event(ink_hrtime sent_time);
+  virtual void _congestion_event(ink_hrtime sent_time);
+  virtual void _persistent_congestion();
   bool _in_persistent_congestion(const std::map<QUICPacketNumber, QUICPacketInfo *> &lost_packets,
                                  QUICPacketInfo *largest_lost_packet);
   bool _in_window_lost(const std::map<QUICPacketNumber, QUICPacketInfo *> &lost_packets, QUICPacketInfo *largest_lost_packet,
@@ -52,14 +52,14 @@ QUICNewRenoCongestionController::QUICNewRenoCongestionController(QUICCCContext &
 }
 
 void
-QUICNewRenoCongestionController::on_packet_sent(size_t bytes_sent)
+QUICNewRenoCongestionController::on_packet_sent(QUICPacketInfo &sent_packet)
 {
   SCOPED_MUTEX_LOCK(lock, this->_cc_mutex, this_ethread());
   if (this->_extra_packets_count > 0) {
     --this->_extra_packets_count;
   }
 
-  this->_bytes_in_flight += bytes_sent;
+  this->_bytes_in_flight += sent_packet.sent_bytes;
 }
 
 bool
@@ -168,10 +168,16 @@ QUICNewRenoCongestionController::on_packets_lost(const std::map<QUICPacketNumber
 
   // Collapse congestion window if persistent congestion
   if (this->_in_persistent_congestion(lost_packets, largest_lost_packet)) {
-    this->_congestion_window = this->_k_minimum_window;
+    this->_persistent_congestion();
   }
 }
 
+void
+QUICNewRenoCongestionController::_persistent_congestion()
+{
+  this->_congestion_window = this->_k_minimum_window;
+}
+
 bool
 QUICNewRenoCongestionController::check_credit() const
 {
@@ -230,24 +236,18 @@ bool
 QUICNewRenoCongestionController::_in_window_lost(const std::map<QUICPacketNumber, QUICPacketInfo *> &lost_packets,
                                                  QUICPacketInfo *largest_lost_packet, ink_hrtime period) const
 {
-  // check whether packets are continuous. return true if all continuous packets are in period
+  // check whether packets are continuous. return true if the continuous packets up to the largest
+  // lost one were sent over more than the period, a single lost packet is never persistent congestion
   QUICPacketNumber next_expected = UINT64_MAX;
+  ink_hrtime first_sent          = 0;
   for (auto &it : lost_packets) {
-    if (it.second->time_sent >= largest_lost_packet->time_sent - period) {
-      if (next_expected == UINT64_MAX) {
-        next_expected = it.second->packet_number + 1;
-        continue;
-      }
-
-      if (next_expected != it.second->packet_number) {
-        return false;
-      }
-
-      next_expected = it.second->packet_number + 1;
+    if (next_expected != it.second->packet_number) {
+      first_sent = it.second->time_sent;
     }
+    next_expected = it.second->packet_number + 1;
   }
 
-  return next_expected == UINT64_MAX ? false : true;
+  return largest_lost_packet->time_sent - first_sent > period;
 }
 
 void
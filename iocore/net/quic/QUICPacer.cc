@@ -0,0 +1,50 @@
+/** @file
+
+  Paces QUIC packet sends at the rate of the congestion controller
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "QUICPacer.h"
+
+bool
+QUICPacer::can_send(ink_hrtime now) const
+{
+  return this->_next_send_time <= now;
+}
+
+void
+QUICPacer::on_packet_sent(ink_hrtime now, uint32_t bytes, uint64_t rate)
+{
+  if (rate == 0) {
+    // The controller has no estimate yet, don't hold anything back
+    this->_next_send_time = 0;
+    return;
+  }
+
+  this->_next_send_time = std::max(this->_next_send_time, now - this->_burst_interval) + bytes * HRTIME_SECOND / rate;
+}
+
+ink_hrtime
+QUICPacer::next_send_time() const
+{
+  return this->_next_send_time;
+}
@@ -0,0 +1,51 @@
+/** @file
+
+  Paces QUIC packet sends at the rate of the congestion controller
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "tscore/ink_hrtime.h"
+
+/**
+ * Spreads packet sends over time at the rate the congestion controller asks for.
+ *
+ * Each send pushes the earliest time of the next one by the time the bytes take at that rate. Up
+ * to a burst interval of sending time can be saved up while the connection has nothing to send,
+ * so a sender that is woken by a timer can still fill that timer interval.
+ */
+class QUICPacer
+{
+public:
+  QUICPacer() = default;
+  QUICPacer(ink_hrtime burst_interval) : _burst_interval(burst_interval) {}
+
+  bool can_send(ink_hrtime now) const;
+  void on_packet_sent(ink_hrtime now, uint32_t bytes, uint64_t rate);
+  ink_hrtime next_send_time() const;
+
+private:
+  // The interval of the write ready timer of QUICNetVConnection
+  ink_hrtime _burst_interval = HRTIME_MSECONDS(2);
+  ink_hrtime _next_send_time = 0;
+};
@@ -43,6 +43,18 @@ ClassAllocator<QUICPacketShortHeader> quicPacketShortHeaderAllocator("quicPacket
 static constexpr int LONG_HDR_OFFSET_CONNECTION_ID = 6;
 static constexpr int LONG_HDR_OFFSET_VERSION       = 1;
 
+// Wraps a buffer from ats_malloc in a block, the block takes it over without copying
+static Ptr<IOBufferBlock>
+to_io_buffer_block(ats_unique_buf buf, size_t len)
+{
+  Ptr<IOBufferBlock> block;
+  if (buf) {
+    block = make_ptr<IOBufferBlock>(new_IOBufferBlock());
+    block->set(new_xmalloc_IOBufferData(buf.release(), len), len);
+  }
+  return block;
+}
+
 //
 // QUICPacketHeader
 //
@@ -50,7 +62,7 @@ const uint8_t *
 QUICPacketHeader::buf()
 {
   if (this->_buf) {
-    return this->_buf.get();
+    return this->_raw_buf();
   } else {
     // TODO Reuse serialzied data if nothing has changed
     this->store(this->_serialized, &this->_buf_len);
@@ -63,6 +75,12 @@ QUICPacketHeader::buf()
   }
 }
 
+uint8_t *
+QUICPacketHeader::_raw_buf() const
+{
+  return reinterpret_cast<uint8_t *>(this->_buf->start());
+}
+
 const IpEndpoint &
 QUICPacketHeader::from() const
 {
@@ -88,21 +106,27 @@ QUICPacketHeader::packet_size() const
 }
 
 QUICPacketHeaderUPtr
-QUICPacketHeader::load(const IpEndpoint from, const IpEndpoint to, ats_unique_buf buf, size_t len, QUICPacketNumber base)
+QUICPacketHeader::load(const IpEndpoint from, const IpEndpoint to, Ptr<IOBufferBlock> buf, QUICPacketNumber base)
 {
   QUICPacketHeaderUPtr header = QUICPacketHeaderUPtr(nullptr, &QUICPacketHeaderDeleter::delete_null_header);
-  if (QUICInvariants::is_long_header(buf.get())) {
+  if (QUICInvariants::is_long_header(reinterpret_cast<uint8_t *>(buf->start()))) {
     QUICPacketLongHeader *long_header = quicPacketLongHeaderAllocator.alloc();
-    new (long_header) QUICPacketLongHeader(from, to, std::move(buf), len, base);
+    new (long_header) QUICPacketLongHeader(from, to, buf, base);
     header = QUICPacketHeaderUPtr(long_header, &QUICPacketHeaderDeleter::delete_long_header);
   } else {
     QUICPacketShortHeader *short_header = quicPacketShortHeaderAllocator.alloc();
-    new (short_header) QUICPacketShortHeader(from, to, std::move(buf), len, base);
+    new (short_header) QUICPacketShortHeader(from, to, buf, base);
     header = QUICPacketHeaderUPtr(short_header, &QUICPacketHeaderDeleter::delete_short_header);
   }
   return header;
 }
 
+QUICPacketHeaderUPtr
+QUICPacketHeader::load(const IpEndpoint from, const IpEndpoint to, ats_unique_buf buf, size_t len, QUICPacketNumber base)
+{
+  return QUICPacketHeader::load(from, to, to_io_buffer_block(std::move(buf), len), base);
+}
+
 QUICPacketHeaderUPtr
 QUICPacketHeader::build(QUICPacketType type, QUICKeyPhase key_phase, QUICConnectionId destination_cid, QUICConnectionId source_cid,
                         QUICPacketNumber packet_number, QUICPacketNumber base_packet_number, QUICVersion version, bool crypto,
@@ -165,12 +189,13 @@ QUICPacketHeader::clone() const
 // QUICPacketLongHeader
 //
 
-QUICPacketLongHeader::QUICPacketLongHeader(const IpEndpoint from, const IpEndpoint to, ats_unique_buf buf, size_t len,
+QUICPacketLongHeader::QUICPacketLongHeader(const IpEndpoint from, const IpEndpoint to, Ptr<IOBufferBlock> buf,
                                            QUICPacketNumber base)
-  : QUICPacketHeader(from, to, std::move(buf), len, base)
+  : QUICPacketHeader(from, to, buf, base)
 {
   this->_key_phase = QUICTypeUtil::key_phase(this->type());
-  uint8_t *raw_buf = this->_buf.get();
+  uint8_t *raw_buf = this->_raw_buf();
+  size_t len       = this->_buf_len;
 
   uint8_t dcil = 0;
   uint8_t scil = 0;
@@ -253,7 +278,7 @@ QUICPacketLongHeader::type() const
 {
   if (this->_buf) {
     QUICPacketType type = QUICPacketType::UNINITIALIZED;
-    QUICPacketLongHeader::type(type, this->_buf.get(), this->_buf_len);
+    QUICPacketLongHeader::type(type, this->_raw_buf(), this->_buf_len);
     return type;
   } else {
     return this->_type;
@@ -475,7 +500,7 @@ QUICPacketLongHeader::version() const
 {
   if (this->_buf) {
     QUICVersion version = 0;
-    QUICPacketLongHeader::version(version, this->_buf.get(), this->_buf_len);
+    QUICPacketLongHeader::version(version, this->_raw_buf(), this->_buf_len);
     return version;
   } else {
     return this->_version;
@@ -486,7 +511,7 @@ const uint8_t *
 QUICPacketLongHeader::payload() const
 {
   if (this->_buf) {
-    uint8_t *raw = this->_buf.get();
+    uint8_t *raw = this->_raw_buf();
     return raw + this->_payload_offset;
   } else {
     return this->_payload.get();
@@ -503,7 +528,7 @@ const uint8_t *
 QUICPacketLongHeader::token() const
 {
   if (this->_buf) {
-    uint8_t *raw = this->_buf.get();
+    uint8_t *raw = this->_raw_buf();
     return raw + this->_token_offset;
   } else {
     return this->_token.get();
@@ -633,15 +658,16 @@ QUICPacketLongHeader::store(uint8_t *buf, size_t *len) const
 // QUICPacketShortHeader
 //
 
-QUICPacketShortHeader::QUICPacketShortHeader(const IpEndpoint from, const IpEndpoint to, ats_unique_buf buf, size_t len,
+QUICPacketShortHeader::QUICPacketShortHeader(const IpEndpoint from, const IpEndpoint to, Ptr<IOBufferBlock> buf,
                                              QUICPacketNumber base)
-  : QUICPacketHeader(from, to, std::move(buf), len, base)
+  : QUICPacketHeader(from, to, buf, base)
 {
-  QUICInvariants::dcid(this->_connection_id, this->_buf.get(), len);
+  size_t len = this->_buf_len;
+  QUICInvariants::dcid(this->_connection_id, this->_raw_buf(), len);
 
   int offset               = 1 + this->_connection_id.length();
-  this->_packet_number_len = QUICTypeUtil::read_QUICPacketNumberLen(this->_buf.get());
-  QUICPacketNumber src     = QUICTypeUtil::read_QUICPacketNumber(this->_buf.get() + offset, this->_packet_number_len);
+  this->_packet_number_len = QUICTypeUtil::read_QUICPacketNumberLen(this->_raw_buf());
+  QUICPacketNumber src     = QUICTypeUtil::read_QUICPacketNumber(this->_raw_buf() + offset, this->_packet_number_len);
   QUICPacket::decode_packet_number(this->_packet_number, src, this->_packet_number_len, this->_base_packet_number);
   this->_payload_length = len - (1 + QUICConnectionId::SCID_LEN + this->_packet_number_len);
 }
@@ -694,7 +720,7 @@ QUICPacketShortHeader::destination_cid() const
 {
   if (this->_buf) {
     QUICConnectionId dcid = QUICConnectionId::ZERO();
-    QUICInvariants::dcid(dcid, this->_buf.get(), this->_buf_len);
+    QUICInvariants::dcid(dcid, this->_raw_buf(), this->_buf_len);
     return dcid;
   } else {
     return _connection_id;
@@ -729,7 +755,7 @@ const uint8_t *
 QUICPacketShortHeader::payload() const
 {
   if (this->_buf) {
-    return this->_buf.get() + this->size();
+    return this->_raw_buf() + this->size();
   } else {
     return this->_payload.get();
   }
@@ -740,7 +766,7 @@ QUICPacketShortHeader::key_phase() const
 {
   if (this->_buf) {
     QUICKeyPhase phase = QUICKeyPhase::INITIAL;
-    QUICPacketShortHeader::key_phase(phase, this->_buf.get(), this->_buf_len);
+    QUICPacketShortHeader::key_phase(phase, this->_raw_buf(), this->_buf_len);
     return phase;
   } else {
     return this->_key_phase;
@@ -815,19 +841,36 @@ QUICPacketShortHeader::store(uint8_t *buf, size_t *len) const
 QUICPacket::QUICPacket() {}
 
 QUICPacket::QUICPacket(UDPConnection *udp_con, QUICPacketHeaderUPtr header, ats_unique_buf payload, size_t payload_len)
-  : _udp_con(udp_con), _header(std::move(header)), _payload(std::move(payload)), _payload_size(payload_len)
+  : _udp_con(udp_con),
+    _header(std::move(header)),
+    _payload(to_io_buffer_block(std::move(payload), payload_len)),
+    _payload_size(payload_len)
+{
+}
+
+QUICPacket::QUICPacket(UDPConnection *udp_con, QUICPacketHeaderUPtr header, Ptr<IOBufferBlock> payload)
+  : _udp_con(udp_con), _header(std::move(header)), _payload(payload), _payload_size(payload ? payload->size() : 0)
 {
 }
 
 QUICPacket::QUICPacket(QUICPacketHeaderUPtr header, ats_unique_buf payload, size_t payload_len, bool ack_eliciting, bool probing)
   : _header(std::move(header)),
-    _payload(std::move(payload)),
+    _payload(to_io_buffer_block(std::move(payload), payload_len)),
     _payload_size(payload_len),
     _is_ack_eliciting(ack_eliciting),
     _is_probing_packet(probing)
 {
 }
 
+QUICPacket::QUICPacket(QUICPacketHeaderUPtr header, Ptr<IOBufferBlock> payload, bool ack_eliciting, bool probing)
+  : _header(std::move(header)),
+    _payload(payload),
+    _payload_size(payload ? payload->size() : 0),
+    _is_ack_eliciting(ack_eliciting),
+    _is_probing_packet(probing)
+{
+}
+
 QUICPacket::~QUICPacket()
 {
   this->_header = nullptr;
@@ -893,6 +936,16 @@ QUICPacket::header() const
 
 const uint8_t *
 QUICPacket::payload() const
+{
+  if (this->_payload) {
+    return reinterpret_cast<const uint8_t *>(this->_payload->start());
+  } else {
+    return nullptr;
+  }
+}
+
+IOBufferBlock *
+QUICPacket::payload_block() const
 {
   return this->_payload.get();
 }
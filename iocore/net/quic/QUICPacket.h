@@ -55,8 +55,8 @@ using QUICPacketHeaderUPtr        = std::unique_ptr<QUICPacketHeader, QUICPacket
 class QUICPacketHeader
 {
 public:
-  QUICPacketHeader(const IpEndpoint from, const IpEndpoint to, ats_unique_buf buf, size_t len, QUICPacketNumber base)
-    : _from(from), _to(to), _buf(std::move(buf)), _buf_len(len), _base_packet_number(base)
+  QUICPacketHeader(const IpEndpoint from, const IpEndpoint to, Ptr<IOBufferBlock> buf, QUICPacketNumber base)
+    : _from(from), _to(to), _buf(buf), _buf_len(buf->size()), _base_packet_number(base)
   {
   }
   ~QUICPacketHeader() {}
@@ -120,8 +120,10 @@ public:
   /*
    * Load data from a buffer and create a QUICPacketHeader
    *
-   * This creates either a QUICPacketShortHeader or a QUICPacketLongHeader.
+   * This creates either a QUICPacketShortHeader or a QUICPacketLongHeader. The header keeps a reference to the block and reads
+   * the fields from it, nothing is copied.
    */
+  static QUICPacketHeaderUPtr load(const IpEndpoint from, const IpEndpoint to, Ptr<IOBufferBlock> buf, QUICPacketNumber base);
   static QUICPacketHeaderUPtr load(const IpEndpoint from, const IpEndpoint to, ats_unique_buf buf, size_t len,
                                    QUICPacketNumber base);
 
@@ -190,8 +192,9 @@ protected:
   const IpEndpoint _to   = {};
 
   // These two are used only if the instance was created with a buffer
-  ats_unique_buf _buf = {nullptr};
-  size_t _buf_len     = 0;
+  Ptr<IOBufferBlock> _buf;
+  size_t _buf_len = 0;
+  uint8_t *_raw_buf() const;
 
   // These are used only if the instance was created without a buffer
   uint8_t _serialized[MAX_PACKET_HEADER_LEN];
@@ -211,7 +214,7 @@ class QUICPacketLongHeader : public QUICPacketHeader
 public:
   QUICPacketLongHeader() : QUICPacketHeader(){};
   virtual ~QUICPacketLongHeader(){};
-  QUICPacketLongHeader(const IpEndpoint from, const IpEndpoint to, ats_unique_buf buf, size_t len, QUICPacketNumber base);
+  QUICPacketLongHeader(const IpEndpoint from, const IpEndpoint to, Ptr<IOBufferBlock> buf, QUICPacketNumber base);
   QUICPacketLongHeader(QUICPacketType type, QUICKeyPhase key_phase, const QUICConnectionId &destination_cid,
                        const QUICConnectionId &source_cid, QUICPacketNumber packet_number, QUICPacketNumber base_packet_number,
                        QUICVersion version, bool crypto, ats_unique_buf buf, size_t len,
@@ -264,7 +267,7 @@ class QUICPacketShortHeader : public QUICPacketHeader
 public:
   QUICPacketShortHeader() : QUICPacketHeader(){};
   virtual ~QUICPacketShortHeader(){};
-  QUICPacketShortHeader(const IpEndpoint from, const IpEndpoint to, ats_unique_buf buf, size_t len, QUICPacketNumber base);
+  QUICPacketShortHeader(const IpEndpoint from, const IpEndpoint to, Ptr<IOBufferBlock> buf, QUICPacketNumber base);
   QUICPacketShortHeader(QUICPacketType type, QUICKeyPhase key_phase, QUICPacketNumber packet_number,
                         QUICPacketNumber base_packet_number, ats_unique_buf buf, size_t len);
   QUICPacketShortHeader(QUICPacketType type, QUICKeyPhase key_phase, const QUICConnectionId &connection_id,
@@ -332,6 +335,7 @@ public:
    * However,  QUICPacket class itself doesn't care about whether the payload is protected (encrypted) or not.
    */
   QUICPacket(UDPConnection *udp_con, QUICPacketHeaderUPtr header, ats_unique_buf payload, size_t payload_len);
+  QUICPacket(UDPConnection *udp_con, QUICPacketHeaderUPtr header, Ptr<IOBufferBlock> payload);
 
   QUICPacket(QUICPacketHeaderUPtr header, ats_unique_buf payload, size_t payload_len, std::vector<QUICFrameInfo> &frames);
 
@@ -343,6 +347,7 @@ public:
    * However, QUICPacket class itself doesn't care about whether the payload is protected (encrypted) or not.
    */
   QUICPacket(QUICPacketHeaderUPtr header, ats_unique_buf payload, size_t payload_len, bool ack_eliciting, bool probing);
+  QUICPacket(QUICPacketHeaderUPtr header, Ptr<IOBufferBlock> payload, bool ack_eliciting, bool probing);
 
   QUICPacket(QUICPacketHeaderUPtr header, ats_unique_buf payload, size_t payload_len, bool ack_eliciting, bool probing,
              std::vector<QUICFrameInfo> &frames);
@@ -359,6 +364,10 @@ public:
   QUICVersion version() const;
   const QUICPacketHeader &header() const;
   const uint8_t *payload() const;
+  /*
+   * The block that holds the payload, frames parsed from the payload may keep a reference to it instead of copying their data
+   */
+  IOBufferBlock *payload_block() const;
   bool is_ack_eliciting() const;
   bool is_crypto_packet() const;
   bool is_probing_packet() const;
@@ -392,9 +401,9 @@ public:
 private:
   UDPConnection *_udp_con      = nullptr;
   QUICPacketHeaderUPtr _header = QUICPacketHeaderUPtr(nullptr, &QUICPacketHeaderDeleter::delete_null_header);
-  ats_unique_buf _payload      = ats_unique_buf(nullptr);
-  size_t _payload_size         = 0;
-  bool _is_ack_eliciting       = false;
+  Ptr<IOBufferBlock> _payload;
+  size_t _payload_size   = 0;
+  bool _is_ack_eliciting = false;
   bool _is_probing_packet      = false;
 };
 
@@ -62,14 +62,13 @@ QUICPacketFactory::create_null_packet()
 }
 
 QUICPacketUPtr
-QUICPacketFactory::create(UDPConnection *udp_con, IpEndpoint from, IpEndpoint to, ats_unique_buf buf, size_t len,
+QUICPacketFactory::create(UDPConnection *udp_con, IpEndpoint from, IpEndpoint to, Ptr<IOBufferBlock> buf,
                           QUICPacketNumber base_packet_number, QUICPacketCreationResult &result)
 {
-  size_t max_plain_txt_len = 2048;
-  ats_unique_buf plain_txt = ats_unique_malloc(max_plain_txt_len);
-  size_t plain_txt_len     = 0;
+  // The packet holds the decrypted block itself, unprotected packets just reference the received block
+  Ptr<IOBufferBlock> plain_txt;
 
-  QUICPacketHeaderUPtr header = QUICPacketHeader::load(from, to, std::move(buf), len, base_packet_number);
+  QUICPacketHeaderUPtr header = QUICPacketHeader::load(from, to, buf, base_packet_number);
 
   QUICConnectionId dcid = header->destination_cid();
   QUICConnectionId scid = header->source_cid();
@@ -79,17 +78,16 @@ QUICPacketFactory::create(UDPConnection *udp_con, IpEndpoint from, IpEndpoint to
   if (header->has_version() && !QUICTypeUtil::is_supported_version(header->version())) {
     if (header->type() == QUICPacketType::VERSION_NEGOTIATION) {
       // version of VN packet is 0x00000000
-      // This packet is unprotected. Just copy the payload
-      result = QUICPacketCreationResult::SUCCESS;
-      memcpy(plain_txt.get(), header->payload(), header->payload_size());
-      plain_txt_len = header->payload_size();
+      // This packet is unprotected. Just reference the payload
+      plain_txt = QUICPacketFactory::_slice_payload(buf, *header);
+      result    = QUICPacketCreationResult::SUCCESS;
     } else {
       // We can't decrypt packets that have unknown versions
       // What we can use is invariant field of Long Header - version, dcid, and scid
       result = QUICPacketCreationResult::UNSUPPORTED;
     }
   } else {
-    Ptr<IOBufferBlock> plain         = make_ptr<IOBufferBlock>(new_IOBufferBlock());
+    Ptr<IOBufferBlock> plain;
     Ptr<IOBufferBlock> protected_ibb = make_ptr<IOBufferBlock>(new_IOBufferBlock());
     protected_ibb->set_internal(reinterpret_cast<void *>(const_cast<uint8_t *>(header->payload())), header->payload_size(),
                                 BUFFER_SIZE_NOT_ALLOCATED);
@@ -100,18 +98,16 @@ QUICPacketFactory::create(UDPConnection *udp_con, IpEndpoint from, IpEndpoint to
     switch (header->type()) {
     case QUICPacketType::STATELESS_RESET:
     case QUICPacketType::RETRY:
-      // These packets are unprotected. Just copy the payload
-      memcpy(plain_txt.get(), header->payload(), header->payload_size());
-      plain_txt_len = header->payload_size();
-      result        = QUICPacketCreationResult::SUCCESS;
+      // These packets are unprotected. Just reference the payload
+      plain_txt = QUICPacketFactory::_slice_payload(buf, *header);
+      result    = QUICPacketCreationResult::SUCCESS;
       break;
     case QUICPacketType::PROTECTED:
       if (this->_pp_key_info.is_decryption_key_available(header->key_phase())) {
         plain = this->_pp_protector.unprotect(header_ibb, protected_ibb, header->packet_number(), header->key_phase());
         if (plain != nullptr) {
-          memcpy(plain_txt.get(), plain->buf(), plain->size());
-          plain_txt_len = plain->size();
-          result        = QUICPacketCreationResult::SUCCESS;
+          plain_txt = plain;
+          result    = QUICPacketCreationResult::SUCCESS;
         } else {
           result = QUICPacketCreationResult::FAILED;
         }
@@ -124,9 +120,8 @@ QUICPacketFactory::create(UDPConnection *udp_con, IpEndpoint from, IpEndpoint to
         if (QUICTypeUtil::is_supported_version(header->version())) {
           plain = this->_pp_protector.unprotect(header_ibb, protected_ibb, header->packet_number(), header->key_phase());
           if (plain != nullptr) {
-            memcpy(plain_txt.get(), plain->buf(), plain->size());
-            plain_txt_len = plain->size();
-            result        = QUICPacketCreationResult::SUCCESS;
+            plain_txt = plain;
+            result    = QUICPacketCreationResult::SUCCESS;
           } else {
             result = QUICPacketCreationResult::FAILED;
           }
@@ -141,9 +136,8 @@ QUICPacketFactory::create(UDPConnection *udp_con, IpEndpoint from, IpEndpoint to
       if (this->_pp_key_info.is_decryption_key_available(QUICKeyPhase::HANDSHAKE)) {
         plain = this->_pp_protector.unprotect(header_ibb, protected_ibb, header->packet_number(), header->key_phase());
         if (plain != nullptr) {
-          memcpy(plain_txt.get(), plain->buf(), plain->size());
-          plain_txt_len = plain->size();
-          result        = QUICPacketCreationResult::SUCCESS;
+          plain_txt = plain;
+          result    = QUICPacketCreationResult::SUCCESS;
         } else {
           result = QUICPacketCreationResult::FAILED;
         }
@@ -155,9 +149,8 @@ QUICPacketFactory::create(UDPConnection *udp_con, IpEndpoint from, IpEndpoint to
       if (this->_pp_key_info.is_decryption_key_available(QUICKeyPhase::ZERO_RTT)) {
         plain = this->_pp_protector.unprotect(header_ibb, protected_ibb, header->packet_number(), header->key_phase());
         if (plain != nullptr) {
-          memcpy(plain_txt.get(), plain->buf(), plain->size());
-          plain_txt_len = plain->size();
-          result        = QUICPacketCreationResult::SUCCESS;
+          plain_txt = plain;
+          result    = QUICPacketCreationResult::SUCCESS;
         } else {
           result = QUICPacketCreationResult::IGNORED;
         }
@@ -174,7 +167,7 @@ QUICPacketFactory::create(UDPConnection *udp_con, IpEndpoint from, IpEndpoint to
   QUICPacket *packet = nullptr;
   if (result == QUICPacketCreationResult::SUCCESS || result == QUICPacketCreationResult::UNSUPPORTED) {
     packet = quicPacketAllocator.alloc();
-    new (packet) QUICPacket(udp_con, std::move(header), std::move(plain_txt), plain_txt_len);
+    new (packet) QUICPacket(udp_con, std::move(header), plain_txt);
   }
 
   return QUICPacketUPtr(packet, &QUICPacketDeleter::delete_packet);
@@ -298,12 +291,14 @@ QUICPacketFactory::create_stateless_reset_packet(QUICConnectionId connection_id,
 QUICPacketUPtr
 QUICPacketFactory::_create_unprotected_packet(QUICPacketHeaderUPtr header)
 {
-  ats_unique_buf cleartext = ats_unique_malloc(2048);
-  size_t cleartext_len     = header->payload_size();
+  size_t cleartext_len         = header->payload_size();
+  Ptr<IOBufferBlock> cleartext = make_ptr<IOBufferBlock>(new_IOBufferBlock());
+  cleartext->alloc(iobuffer_size_to_index(cleartext_len));
+  memcpy(cleartext->start(), header->payload(), cleartext_len);
+  cleartext->fill(cleartext_len);
 
-  memcpy(cleartext.get(), header->payload(), cleartext_len);
   QUICPacket *packet = quicPacketAllocator.alloc();
-  new (packet) QUICPacket(std::move(header), std::move(cleartext), cleartext_len, false, false);
+  new (packet) QUICPacket(std::move(header), cleartext, false, false);
 
   return QUICPacketUPtr(packet, &QUICPacketDeleter::delete_packet);
 }
@@ -329,10 +324,8 @@ QUICPacketFactory::_create_encrypted_packet(QUICPacketHeaderUPtr header, bool re
   Ptr<IOBufferBlock> protected_payload =
     this->_pp_protector.protect(header_ibb, payload_ibb, header->packet_number(), header->key_phase());
   if (protected_payload != nullptr) {
-    ats_unique_buf cipher_txt = ats_unique_malloc(protected_payload->size());
-    memcpy(cipher_txt.get(), protected_payload->buf(), protected_payload->size());
     packet = quicPacketAllocator.alloc();
-    new (packet) QUICPacket(std::move(header), std::move(cipher_txt), protected_payload->size(), retransmittable, probing);
+    new (packet) QUICPacket(std::move(header), protected_payload, retransmittable, probing);
   } else {
     QUICDebug(dcid, scid, "Failed to encrypt a packet");
   }
@@ -340,6 +333,15 @@ QUICPacketFactory::_create_encrypted_packet(QUICPacketHeaderUPtr header, bool re
   return QUICPacketUPtr(packet, &QUICPacketDeleter::delete_packet);
 }
 
+Ptr<IOBufferBlock>
+QUICPacketFactory::_slice_payload(const Ptr<IOBufferBlock> &buf, const QUICPacketHeader &header)
+{
+  Ptr<IOBufferBlock> payload = make_ptr<IOBufferBlock>(buf->clone());
+  payload->consume(header.payload() - reinterpret_cast<uint8_t *>(buf->start()));
+  payload->_end = payload->_start + header.payload_size();
+  return payload;
+}
+
 void
 QUICPacketFactory::set_version(QUICVersion negotiated_version)
 {
@@ -31,20 +31,97 @@
 bool
 QUICPacketHeaderProtector::protect(uint8_t *unprotected_packet, size_t unprotected_packet_len, int dcil) const
 {
-  // Do nothing if the packet is VN
-  if (QUICInvariants::is_long_header(unprotected_packet)) {
-    QUICVersion version;
-    QUICPacketLongHeader::version(version, unprotected_packet, unprotected_packet_len);
-    if (version == 0x0) {
-      return true;
+  return this->protect(&unprotected_packet, &unprotected_packet_len, 1, dcil);
+}
+
+bool
+QUICPacketHeaderProtector::protect(uint8_t *const *unprotected_packets, const size_t *unprotected_packet_lens, int n,
+                                   int dcil) const
+{
+  uint8_t samples[MAX_MASK_BATCH * SAMPLE_LEN];
+  uint8_t masks[MAX_MASK_BATCH * SAMPLE_LEN];
+  uint8_t *batch[MAX_MASK_BATCH];
+  size_t batch_lens[MAX_MASK_BATCH];
+  bool succeeded = true;
+
+  int i = 0;
+  while (i < n) {
+    // Collect the following packets that are protected with the same key
+    QUICKeyPhase batch_phase = QUICKeyPhase::PHASE_0;
+    int batch_size           = 0;
+    for (; i < n && batch_size < MAX_MASK_BATCH; ++i) {
+      uint8_t *packet   = unprotected_packets[i];
+      size_t packet_len = unprotected_packet_lens[i];
+
+      QUICKeyPhase phase;
+      if (!this->_protection_phase(phase, packet, packet_len)) {
+        continue;
+      }
+      if (batch_size > 0 && phase != batch_phase) {
+        break;
+      }
+
+      uint8_t sample_offset;
+      if (!this->_calc_sample_offset(&sample_offset, packet, packet_len, dcil)) {
+        Debug("v_quic_pne", "Failed to calculate a sample offset");
+        succeeded = false;
+        continue;
+      }
+
+      batch_phase = phase;
+      memcpy(samples + batch_size * SAMPLE_LEN, packet + sample_offset, SAMPLE_LEN);
+      batch[batch_size]      = packet;
+      batch_lens[batch_size] = packet_len;
+      ++batch_size;
+    }
+    if (batch_size == 0) {
+      continue;
+    }
+
+    const EVP_CIPHER *aead = this->_pp_key_info.get_cipher_for_hp(batch_phase);
+    if (!aead) {
+      Debug("quic_pne", "Failed to encrypt a packet number: keys for %s is not ready", QUICDebugNames::key_phase(batch_phase));
+      succeeded = false;
+      continue;
+    }
+
+    const uint8_t *key = this->_pp_key_info.encryption_key_for_hp(batch_phase);
+    if (!key) {
+      Debug("quic_pne", "Failed to encrypt a packet number: keys for %s is not ready", QUICDebugNames::key_phase(batch_phase));
+      succeeded = false;
+      continue;
+    }
+
+    if (!this->_generate_masks(masks, samples, batch_size, this->_encryption_ctx[static_cast<int>(batch_phase)], key, aead)) {
+      Debug("v_quic_pne", "Failed to generate a mask");
+      succeeded = false;
+      continue;
+    }
+
+    for (int j = 0; j < batch_size; ++j) {
+      if (!this->_protect(batch[j], batch_lens[j], masks + j * SAMPLE_LEN, dcil)) {
+        Debug("quic_pne", "Failed to encrypt a packet number");
+      }
     }
   }
 
-  QUICKeyPhase phase;
+  return succeeded;
+}
+
+bool
+QUICPacketHeaderProtector::_protection_phase(QUICKeyPhase &phase, const uint8_t *packet, size_t packet_len) const
+{
   QUICPacketType type;
-  if (QUICInvariants::is_long_header(unprotected_packet)) {
-    QUICPacketLongHeader::key_phase(phase, unprotected_packet, unprotected_packet_len);
-    QUICPacketLongHeader::type(type, unprotected_packet, unprotected_packet_len);
+
+  if (QUICInvariants::is_long_header(packet)) {
+    // Do nothing if the packet is VN
+    QUICVersion version;
+    QUICPacketLongHeader::version(version, packet, packet_len);
+    if (version == 0x0) {
+      return false;
+    }
+    QUICPacketLongHeader::key_phase(phase, packet, packet_len);
+    QUICPacketLongHeader::type(type, packet, packet_len);
   } else {
     // This is a kind of hack. For short header we need to use the same key for header protection regardless of the key phase.
     phase = QUICKeyPhase::PHASE_0;
@@ -54,34 +131,6 @@ QUICPacketHeaderProtector::protect(uint8_t *unprotected_packet, size_t unprotect
   Debug("v_quic_pne", "Protecting a packet number of %s packet using %s", QUICDebugNames::packet_type(type),
         QUICDebugNames::key_phase(phase));
 
-  const EVP_CIPHER *aead = this->_pp_key_info.get_cipher_for_hp(phase);
-  if (!aead) {
-    Debug("quic_pne", "Failed to encrypt a packet number: keys for %s is not ready", QUICDebugNames::key_phase(phase));
-    return false;
-  }
-
-  const uint8_t *key = this->_pp_key_info.encryption_key_for_hp(phase);
-  if (!key) {
-    Debug("quic_pne", "Failed to encrypt a packet number: keys for %s is not ready", QUICDebugNames::key_phase(phase));
-    return false;
-  }
-
-  uint8_t sample_offset;
-  if (!this->_calc_sample_offset(&sample_offset, unprotected_packet, unprotected_packet_len, dcil)) {
-    Debug("v_quic_pne", "Failed to calculate a sample offset");
-    return false;
-  }
-
-  uint8_t mask[EVP_MAX_BLOCK_LENGTH];
-  if (!this->_generate_mask(mask, unprotected_packet + sample_offset, key, aead)) {
-    Debug("v_quic_pne", "Failed to generate a mask");
-    return false;
-  }
-
-  if (!this->_protect(unprotected_packet, unprotected_packet_len, mask, dcil)) {
-    Debug("quic_pne", "Failed to encrypt a packet number");
-  }
-
   return true;
 }
 
@@ -134,8 +183,9 @@ QUICPacketHeaderProtector::unprotect(uint8_t *protected_packet, size_t protected
     return false;
   }
 
-  uint8_t mask[EVP_MAX_BLOCK_LENGTH];
-  if (!this->_generate_mask(mask, protected_packet + sample_offset, key, aead)) {
+  uint8_t mask[SAMPLE_LEN];
+  QUICCipherContext &ctx = this->_decryption_ctx[static_cast<int>(phase)];
+  if (!this->_generate_masks(mask, protected_packet + sample_offset, 1, ctx, key, aead)) {
     Debug("v_quic_pne", "Failed to generate a mask");
     return false;
   }
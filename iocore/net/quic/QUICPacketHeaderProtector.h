@@ -25,6 +25,7 @@
 
 #include "QUICTypes.h"
 #include "QUICKeyGenerator.h"
+#include "QUICCipherContext.h"
 
 class QUICPacketProtectionKeyInfo;
 
@@ -35,13 +36,30 @@ public:
 
   bool unprotect(uint8_t *protected_packet, size_t protected_packet_len) const;
   bool protect(uint8_t *unprotected_packet, size_t unprotected_packet_len, int dcil) const;
+  /**
+   * Protects the headers of @a n packets. The masks of consecutive packets protected with the same key are generated with
+   * one cipher call, so AES can work on several samples in parallel.
+   */
+  bool protect(uint8_t *const *unprotected_packets, const size_t *unprotected_packet_lens, int n, int dcil) const;
 
 private:
+  static constexpr int SAMPLE_LEN     = 16;
+  static constexpr int MAX_MASK_BATCH = 16;
+
   const QUICPacketProtectionKeyInfo &_pp_key_info;
 
+  // Indexed by QUICKeyPhase
+  mutable QUICCipherContext _encryption_ctx[5];
+  mutable QUICCipherContext _decryption_ctx[5];
+
+  bool _protection_phase(QUICKeyPhase &phase, const uint8_t *packet, size_t packet_len) const;
   bool _calc_sample_offset(uint8_t *sample_offset, const uint8_t *protected_packet, size_t protected_packet_len, int dcil) const;
 
-  bool _generate_mask(uint8_t *mask, const uint8_t *sample, const uint8_t *key, const EVP_CIPHER *cipher) const;
+  /**
+   * Generates a SAMPLE_LEN byte mask for each of the @a n samples of SAMPLE_LEN bytes at @a samples.
+   */
+  bool _generate_masks(uint8_t *masks, const uint8_t *samples, int n, QUICCipherContext &ctx, const uint8_t *key,
+                       const EVP_CIPHER *cipher) const;
 
   bool _unprotect(uint8_t *packet, size_t packet_len, const uint8_t *mask) const;
   bool _protect(uint8_t *packet, size_t packet_len, const uint8_t *mask, int dcil) const;
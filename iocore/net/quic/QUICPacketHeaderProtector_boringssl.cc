@@ -24,7 +24,8 @@
 #include "QUICPacketHeaderProtector.h"
 
 bool
-QUICPacketHeaderProtector::_generate_mask(uint8_t *mask, const uint8_t *sample, const uint8_t *key, const EVP_CIPHER *cipher) const
+QUICPacketHeaderProtector::_generate_masks(uint8_t *masks, const uint8_t *samples, int n, QUICCipherContext &ctx,
+                                           const uint8_t *key, const EVP_CIPHER *cipher) const
 {
   ink_assert(!"not implemented");
   return false;
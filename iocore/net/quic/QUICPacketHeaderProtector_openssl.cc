@@ -24,30 +24,33 @@
 #include "QUICPacketHeaderProtector.h"
 
 bool
-QUICPacketHeaderProtector::_generate_mask(uint8_t *mask, const uint8_t *sample, const uint8_t *key, const EVP_CIPHER *cipher) const
+QUICPacketHeaderProtector::_generate_masks(uint8_t *masks, const uint8_t *samples, int n, QUICCipherContext &ctx,
+                                           const uint8_t *key, const EVP_CIPHER *cipher) const
 {
   static constexpr unsigned char FIVE_ZEROS[] = {0x00, 0x00, 0x00, 0x00, 0x00};
-  EVP_CIPHER_CTX *ctx                         = EVP_CIPHER_CTX_new();
 
-  if (!ctx || !EVP_EncryptInit_ex(ctx, cipher, nullptr, key, sample)) {
+  EVP_CIPHER_CTX *cipher_ctx = ctx.get(cipher, key, true);
+  if (!cipher_ctx) {
     return false;
   }
 
   int len = 0;
   if (cipher == EVP_chacha20()) {
-    if (!EVP_EncryptUpdate(ctx, mask, &len, FIVE_ZEROS, sizeof(FIVE_ZEROS))) {
-      return false;
+    // The sample is the counter and nonce of ChaCha20, so each mask needs its own call
+    for (int i = 0; i < n; ++i) {
+      if (!EVP_EncryptInit_ex(cipher_ctx, nullptr, nullptr, nullptr, samples + i * SAMPLE_LEN)) {
+        return false;
+      }
+      if (!EVP_EncryptUpdate(cipher_ctx, masks + i * SAMPLE_LEN, &len, FIVE_ZEROS, sizeof(FIVE_ZEROS))) {
+        return false;
+      }
     }
   } else {
-    if (!EVP_EncryptUpdate(ctx, mask, &len, sample, 16)) {
+    // AES-ECB encrypts each sample into its mask independently, so all of them go in one call
+    if (!EVP_EncryptUpdate(cipher_ctx, masks, &len, samples, n * SAMPLE_LEN) || len != n * SAMPLE_LEN) {
       return false;
     }
   }
-  if (!EVP_EncryptFinal_ex(ctx, mask + len, &len)) {
-    return false;
-  }
-
-  EVP_CIPHER_CTX_free(ctx);
 
   return true;
 }
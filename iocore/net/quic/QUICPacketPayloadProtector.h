@@ -26,6 +26,7 @@
 #include "I_IOBuffer.h"
 #include "QUICTypes.h"
 #include "QUICKeyGenerator.h"
+#include "QUICCipherContext.h"
 
 class QUICPacketProtectionKeyInfo;
 
@@ -42,12 +43,16 @@ public:
 private:
   const QUICPacketProtectionKeyInfo &_pp_key_info;
 
+  // Indexed by QUICKeyPhase
+  mutable QUICCipherContext _encryption_ctx[5];
+  mutable QUICCipherContext _decryption_ctx[5];
+
   bool _unprotect(uint8_t *plain, size_t &plain_len, size_t max_plain_len, const uint8_t *protected_payload,
-                  size_t protected_payload_len, uint64_t pkt_num, const uint8_t *ad, size_t ad_len, const uint8_t *key,
-                  const uint8_t *iv, size_t iv_len, const EVP_CIPHER *cipher, size_t tag_len) const;
+                  size_t protected_payload_len, uint64_t pkt_num, QUICKeyPhase phase, const uint8_t *ad, size_t ad_len,
+                  const uint8_t *key, const uint8_t *iv, size_t iv_len, const EVP_CIPHER *cipher, size_t tag_len) const;
   bool _protect(uint8_t *protected_payload, size_t &protected_payload_len, size_t max_protected_payload_len,
-                const Ptr<IOBufferBlock> plain, uint64_t pkt_num, const uint8_t *ad, size_t ad_len, const uint8_t *key,
-                const uint8_t *iv, size_t iv_len, const EVP_CIPHER *cipher, size_t tag_len) const;
+                const Ptr<IOBufferBlock> plain, uint64_t pkt_num, QUICKeyPhase phase, const uint8_t *ad, size_t ad_len,
+                const uint8_t *key, const uint8_t *iv, size_t iv_len, const EVP_CIPHER *cipher, size_t tag_len) const;
 
   void _gen_nonce(uint8_t *nonce, size_t &nonce_len, uint64_t pkt_num, const uint8_t *iv, size_t iv_len) const;
 };
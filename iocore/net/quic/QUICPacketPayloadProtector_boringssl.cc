@@ -29,8 +29,8 @@
 
 bool
 QUICPacketPayloadProtector::_protect(uint8_t *protected_payload, size_t &protected_payload_len, size_t max_protecgted_payload_len,
-                                     const Ptr<IOBufferBlock> plain, uint64_t pkt_num, const uint8_t *ad, size_t ad_len,
-                                     const uint8_t *key, const uint8_t *iv, size_t iv_len, const EVP_CIPHER *cipher,
+                                     const Ptr<IOBufferBlock> plain, uint64_t pkt_num, QUICKeyPhase phase, const uint8_t *ad,
+                                     size_t ad_len, const uint8_t *key, const uint8_t *iv, size_t iv_len, const EVP_CIPHER *cipher,
                                      size_t tag_len) const
 {
   ink_assert(!"not implemented");
@@ -39,9 +39,9 @@ QUICPacketPayloadProtector::_protect(uint8_t *protected_payload, size_t &protect
 
 bool
 QUICPacketPayloadProtector::_unprotect(uint8_t *plain, size_t &plain_len, size_t max_plain_len, const uint8_t *protected_payload,
-                                       size_t protected_payload_len, uint64_t pkt_num, const uint8_t *ad, size_t ad_len,
-                                       const uint8_t *key, const uint8_t *iv, size_t iv_len, const EVP_CIPHER *cipher,
-                                       size_t tag_len) const
+                                       size_t protected_payload_len, uint64_t pkt_num, QUICKeyPhase phase, const uint8_t *ad,
+                                       size_t ad_len, const uint8_t *key, const uint8_t *iv, size_t iv_len,
+                                       const EVP_CIPHER *cipher, size_t tag_len) const
 {
   ink_assert(!"not implemented");
   return false;
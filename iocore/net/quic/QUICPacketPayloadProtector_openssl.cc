@@ -29,8 +29,8 @@ static constexpr char tag[] = "quic_ppp";
 
 bool
 QUICPacketPayloadProtector::_protect(uint8_t *cipher, size_t &cipher_len, size_t max_cipher_len, const Ptr<IOBufferBlock> plain,
-                                     uint64_t pkt_num, const uint8_t *ad, size_t ad_len, const uint8_t *key, const uint8_t *iv,
-                                     size_t iv_len, const EVP_CIPHER *aead, size_t tag_len) const
+                                     uint64_t pkt_num, QUICKeyPhase phase, const uint8_t *ad, size_t ad_len, const uint8_t *key,
+                                     const uint8_t *iv, size_t iv_len, const EVP_CIPHER *aead, size_t tag_len) const
 {
   EVP_CIPHER_CTX *aead_ctx;
   int len;
@@ -39,16 +39,11 @@ QUICPacketPayloadProtector::_protect(uint8_t *cipher, size_t &cipher_len, size_t
 
   this->_gen_nonce(nonce, nonce_len, pkt_num, iv, iv_len);
 
-  if (!(aead_ctx = EVP_CIPHER_CTX_new())) {
+  // The context keeps the key schedule of the phase, only the nonce changes per packet
+  if (!(aead_ctx = this->_encryption_ctx[static_cast<int>(phase)].get(aead, key, true, nonce_len))) {
     return false;
   }
-  if (!EVP_EncryptInit_ex(aead_ctx, aead, nullptr, nullptr, nullptr)) {
-    return false;
-  }
-  if (!EVP_CIPHER_CTX_ctrl(aead_ctx, EVP_CTRL_AEAD_SET_IVLEN, nonce_len, nullptr)) {
-    return false;
-  }
-  if (!EVP_EncryptInit_ex(aead_ctx, nullptr, nullptr, key, nonce)) {
+  if (!EVP_EncryptInit_ex(aead_ctx, nullptr, nullptr, nullptr, nonce)) {
     return false;
   }
   if (!EVP_EncryptUpdate(aead_ctx, nullptr, &len, ad, ad_len)) {
@@ -58,7 +53,10 @@ QUICPacketPayloadProtector::_protect(uint8_t *cipher, size_t &cipher_len, size_t
   cipher_len           = 0;
   Ptr<IOBufferBlock> b = plain;
   while (b) {
-    if (!EVP_EncryptUpdate(aead_ctx, cipher + cipher_len, &len, reinterpret_cast<unsigned char *>(b->buf()), b->size())) {
+    if (max_cipher_len < cipher_len + b->size()) {
+      return false;
+    }
+    if (!EVP_EncryptUpdate(aead_ctx, cipher + cipher_len, &len, reinterpret_cast<unsigned char *>(b->start()), b->size())) {
       return false;
     }
     cipher_len += len;
@@ -78,15 +76,14 @@ QUICPacketPayloadProtector::_protect(uint8_t *cipher, size_t &cipher_len, size_t
   }
   cipher_len += tag_len;
 
-  EVP_CIPHER_CTX_free(aead_ctx);
-
   return true;
 }
 
 bool
 QUICPacketPayloadProtector::_unprotect(uint8_t *plain, size_t &plain_len, size_t max_plain_len, const uint8_t *cipher,
-                                       size_t cipher_len, uint64_t pkt_num, const uint8_t *ad, size_t ad_len, const uint8_t *key,
-                                       const uint8_t *iv, size_t iv_len, const EVP_CIPHER *aead, size_t tag_len) const
+                                       size_t cipher_len, uint64_t pkt_num, QUICKeyPhase phase, const uint8_t *ad, size_t ad_len,
+                                       const uint8_t *key, const uint8_t *iv, size_t iv_len, const EVP_CIPHER *aead,
+                                       size_t tag_len) const
 {
   EVP_CIPHER_CTX *aead_ctx;
   int len;
@@ -95,16 +92,10 @@ QUICPacketPayloadProtector::_unprotect(uint8_t *plain, size_t &plain_len, size_t
 
   this->_gen_nonce(nonce, nonce_len, pkt_num, iv, iv_len);
 
-  if (!(aead_ctx = EVP_CIPHER_CTX_new())) {
+  if (!(aead_ctx = this->_decryption_ctx[static_cast<int>(phase)].get(aead, key, false, nonce_len))) {
     return false;
   }
-  if (!EVP_DecryptInit_ex(aead_ctx, aead, nullptr, nullptr, nullptr)) {
-    return false;
-  }
-  if (!EVP_CIPHER_CTX_ctrl(aead_ctx, EVP_CTRL_AEAD_SET_IVLEN, nonce_len, nullptr)) {
-    return false;
-  }
-  if (!EVP_DecryptInit_ex(aead_ctx, nullptr, nullptr, key, nonce)) {
+  if (!EVP_DecryptInit_ex(aead_ctx, nullptr, nullptr, nullptr, nonce)) {
     return false;
   }
   if (!EVP_DecryptUpdate(aead_ctx, nullptr, &len, ad, ad_len)) {
@@ -115,6 +106,9 @@ QUICPacketPayloadProtector::_unprotect(uint8_t *plain, size_t &plain_len, size_t
     return false;
   }
   cipher_len -= tag_len;
+  if (max_plain_len < cipher_len) {
+    return false;
+  }
   if (!EVP_DecryptUpdate(aead_ctx, plain, &len, cipher, cipher_len)) {
     return false;
   }
@@ -126,8 +120,6 @@ QUICPacketPayloadProtector::_unprotect(uint8_t *plain, size_t &plain_len, size_t
 
   int ret = EVP_DecryptFinal_ex(aead_ctx, plain + len, &len);
 
-  EVP_CIPHER_CTX_free(aead_ctx);
-
   if (ret > 0) {
     plain_len += len;
     return true;
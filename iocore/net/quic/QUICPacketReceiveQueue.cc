@@ -49,8 +49,7 @@ QUICPacketReceiveQueue::dequeue(QUICPacketCreationResult &result)
   QUICPacketUPtr quic_packet = QUICPacketFactory::create_null_packet();
   UDPPacket *udp_packet      = nullptr;
 
-  // FIXME: avoid this copy
-  // Copy payload of UDP packet to this->_payload once
+  // Take the payload of UDP packet as this->_payload once, it's only copied if it spans several blocks
   if (!this->_payload) {
     udp_packet = this->_queue.dequeue();
     if (!udp_packet) {
@@ -63,22 +62,27 @@ QUICPacketReceiveQueue::dequeue(QUICPacketCreationResult &result)
     this->_from        = udp_packet->from;
     this->_to          = udp_packet->to;
     this->_payload_len = udp_packet->getPktLength();
-    this->_payload     = ats_unique_malloc(this->_payload_len);
     IOBufferBlock *b   = udp_packet->getIOBlockChain();
-    size_t written     = 0;
-    while (b) {
-      memcpy(this->_payload.get() + written, b->buf(), b->read_avail());
-      written += b->read_avail();
-      b = b->next.get();
+    if (b->next) {
+      this->_payload = make_ptr<IOBufferBlock>(new_IOBufferBlock());
+      this->_payload->alloc(iobuffer_size_to_index(this->_payload_len));
+      while (b) {
+        memcpy(this->_payload->end(), b->start(), b->read_avail());
+        this->_payload->fill(b->read_avail());
+        b = b->next.get();
+      }
+    } else {
+      this->_payload = b;
     }
   }
 
-  ats_unique_buf pkt  = {nullptr};
+  Ptr<IOBufferBlock> pkt;
   size_t pkt_len      = 0;
   QUICPacketType type = QUICPacketType::UNINITIALIZED;
+  uint8_t *payload    = reinterpret_cast<uint8_t *>(this->_payload->start());
 
-  if (QUICInvariants::is_long_header(this->_payload.get())) {
-    uint8_t *buf         = this->_payload.get() + this->_offset;
+  if (QUICInvariants::is_long_header(payload)) {
+    uint8_t *buf         = payload + this->_offset;
     size_t remaining_len = this->_payload_len - this->_offset;
 
     if (QUICInvariants::is_long_header(buf)) {
@@ -91,13 +95,12 @@ QUICPacketReceiveQueue::dequeue(QUICPacketCreationResult &result)
         result  = QUICPacketCreationResult::UNSUPPORTED;
         pkt_len = remaining_len;
       } else {
-        QUICPacketLongHeader::type(type, this->_payload.get() + this->_offset, remaining_len);
+        QUICPacketLongHeader::type(type, buf, remaining_len);
         if (type == QUICPacketType::RETRY) {
           pkt_len = remaining_len;
         } else {
-          if (!QUICPacketLongHeader::packet_length(pkt_len, this->_payload.get() + this->_offset, remaining_len)) {
-            this->_payload.release();
-            this->_payload     = nullptr;
+          if (!QUICPacketLongHeader::packet_length(pkt_len, buf, remaining_len)) {
+            this->_payload.clear();
             this->_payload_len = 0;
             this->_offset      = 0;
 
@@ -112,44 +115,45 @@ QUICPacketReceiveQueue::dequeue(QUICPacketCreationResult &result)
     }
 
     if (pkt_len < this->_payload_len) {
-      pkt = ats_unique_malloc(pkt_len);
-      memcpy(pkt.get(), this->_payload.get() + this->_offset, pkt_len);
+      // Coalesced packets share the block, each of them is a slice of it
+      pkt = make_ptr<IOBufferBlock>(this->_payload->clone());
+      pkt->consume(this->_offset);
+      pkt->_end = pkt->_start + pkt_len;
       this->_offset += pkt_len;
 
       if (this->_offset >= this->_payload_len) {
-        this->_payload.release();
-        this->_payload     = nullptr;
+        this->_payload.clear();
         this->_payload_len = 0;
         this->_offset      = 0;
       }
     } else {
-      pkt                = std::move(this->_payload);
-      pkt_len            = this->_payload_len;
-      this->_payload     = nullptr;
+      pkt     = this->_payload;
+      pkt_len = this->_payload_len;
+      this->_payload.clear();
       this->_payload_len = 0;
       this->_offset      = 0;
     }
   } else {
     if (!this->_packet_factory.is_ready_to_create_protected_packet() && udp_packet) {
       this->enqueue(udp_packet);
-      this->_payload.release();
-      this->_payload     = nullptr;
+      this->_payload.clear();
       this->_payload_len = 0;
       this->_offset      = 0;
       result             = QUICPacketCreationResult::NOT_READY;
       return quic_packet;
     }
-    pkt                = std::move(this->_payload);
-    pkt_len            = this->_payload_len;
-    this->_payload     = nullptr;
+    pkt     = this->_payload;
+    pkt_len = this->_payload_len;
+    this->_payload.clear();
     this->_payload_len = 0;
     this->_offset      = 0;
     type               = QUICPacketType::PROTECTED;
   }
 
-  if (this->_ph_protector.unprotect(pkt.get(), pkt_len)) {
-    quic_packet = this->_packet_factory.create(this->_udp_con, this->_from, this->_to, std::move(pkt), pkt_len,
-                                               this->_largest_received_packet_number, result);
+  // The header is unprotected in place, the packet keeps referring to the received buffer
+  if (this->_ph_protector.unprotect(reinterpret_cast<uint8_t *>(pkt->start()), pkt_len)) {
+    quic_packet = this->_packet_factory.create(this->_udp_con, this->_from, this->_to, pkt, this->_largest_received_packet_number,
+                                               result);
   } else {
     // ZERO_RTT might be rejected
     if (type == QUICPacketType::ZERO_RTT_PROTECTED) {
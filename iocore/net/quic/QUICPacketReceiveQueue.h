@@ -45,10 +45,10 @@ private:
   QUICPacketFactory &_packet_factory;
   QUICPacketHeaderProtector &_ph_protector;
   QUICPacketNumber _largest_received_packet_number = 0;
-  // FIXME: workaround code for coalescing packets
-  ats_unique_buf _payload = {nullptr};
-  size_t _payload_len     = 0;
-  size_t _offset          = 0;
+  // Payload of the UDP packet being processed, coalesced packets are sliced from it
+  Ptr<IOBufferBlock> _payload;
+  size_t _payload_len = 0;
+  size_t _offset      = 0;
   UDPConnection *_udp_con;
   IpEndpoint _from;
   IpEndpoint _to;
@@ -29,6 +29,8 @@ extern RecRawStatBlock *quic_rsb;
 
 enum class QUICStats {
   total_packets_sent_stat,
+  pacing_delay_stat,
+  send_burst_size_stat,
   count,
 };
 
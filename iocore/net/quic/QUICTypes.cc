@@ -29,6 +29,7 @@
 #include <openssl/hmac.h>
 
 uint8_t QUICConnectionId::SCID_LEN = 0;
+uint8_t QUICConnectionId::ROUTES   = 1;
 
 // TODO: move to somewhere in lib/ts/
 int
@@ -621,6 +622,45 @@ QUICConnectionId::randomize()
   this->_len = QUICConnectionId::SCID_LEN;
 }
 
+void
+QUICConnectionId::randomize(uint8_t route)
+{
+  this->randomize();
+  if (QUICConnectionId::ROUTES > 1) {
+    // Keep the random part of the first byte, but never wrap it past 255
+    uint8_t base = this->_id[0] - this->_id[0] % QUICConnectionId::ROUTES;
+    if (base + route > UINT8_MAX) {
+      base -= QUICConnectionId::ROUTES;
+    }
+    this->_id[0] = base + route;
+  }
+}
+
+uint8_t
+QUICConnectionId::route() const
+{
+  return this->_id[0] % QUICConnectionId::ROUTES;
+}
+
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+std::vector<sock_filter>
+QUICConnectionId::route_program()
+{
+  // Load the first byte of the DCID, which follows the header form byte in short headers and the version and the DCID length
+  // in long headers, and take it modulo ROUTES. The kernel falls back to its 4-tuple hash if the result is past the sockets
+  // bound so far.
+  return {
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0),
+    BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x80, 0, 2),
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, QUICInvariants::LH_DCID_OFFSET),
+    BPF_JUMP(BPF_JMP | BPF_JA, 1, 0, 0),
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, QUICInvariants::SH_DCID_OFFSET),
+    BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, QUICConnectionId::ROUTES),
+    BPF_STMT(BPF_RET | BPF_A, 0),
+  };
+}
+#endif
+
 uint64_t
 QUICConnectionId::_hashcode() const
 {
@@ -38,6 +38,11 @@
 #include "tscore/ink_inet.h"
 #include "openssl/evp.h"
 
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+#include <vector>
+#include <linux/filter.h>
+#endif
+
 using QUICPacketNumber = uint64_t;
 using QUICVersion      = uint32_t;
 using QUICStreamId     = uint64_t;
@@ -223,6 +228,11 @@ class QUICConnectionId
 {
 public:
   static uint8_t SCID_LEN;
+  /**
+   * Number of sockets a server reads its port with. Connection IDs issued by a server keep the index of the socket that owns
+   * the connection in the first byte modulo this, so that packets for a connection can be steered to the same socket.
+   */
+  static uint8_t ROUTES;
 
   static const int MIN_LENGTH_FOR_INITIAL = 8;
   static const int MAX_LENGTH             = 20;
@@ -264,6 +274,17 @@ public:
   uint8_t length() const;
   bool is_zero() const;
   void randomize();
+  /**
+   * Same as randomize(), but the first byte modulo ROUTES is @a route.
+   */
+  void randomize(uint8_t route);
+  uint8_t route() const;
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+  /**
+   * Classic BPF program for SO_ATTACH_REUSEPORT_CBPF that returns route() of the DCID of a packet.
+   */
+  static std::vector<sock_filter> route_program();
+#endif
 
 private:
   uint64_t _hashcode() const;
@@ -539,6 +560,12 @@ public:
   virtual ink_hrtime initial_rtt() const    = 0;
 };
 
+enum class QUICCongestionControlAlgorithm {
+  NEW_RENO,
+  CUBIC,
+  BBR,
+};
+
 class QUICCCConfig
 {
 public:
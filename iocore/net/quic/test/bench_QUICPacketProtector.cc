@@ -0,0 +1,233 @@
+/** @file
+
+  Micro benchmark for QUIC packet protection
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+/****************************************************************************
+
+   bench_QUICPacketProtector.cc
+
+   Description:
+
+   Protects and unprotects 1-RTT packets the way a connection sending and
+   receiving a flight of full sized packets does and reports packets/sec.
+
+   Usage: bench_QUICPacketProtector [packets]
+
+   Each step runs twice. "before" sets up a new cipher context for every
+   packet like packet protection used to, "after" goes through
+   QUICPacketPayloadProtector and QUICPacketHeaderProtector, which keep a
+   context per key and generate the header protection masks of a flight
+   together. Defaults to 1000000 packets for each loop.
+
+ ****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "tscore/I_Layout.h"
+#include "tscore/Diags.h"
+#include "I_EventSystem.h"
+#include "RecordsConfig.h"
+
+#include "QUICConfig.h"
+#include "QUICPacketHeaderProtector.h"
+#include "QUICPacketPayloadProtector.h"
+#include "QUICPacketProtectionKeyInfo.h"
+
+namespace
+{
+constexpr size_t PACKET_LEN  = 1200;
+constexpr size_t HEADER_LEN  = 1 + 18 + 4; // Short header with an 18 byte DCID and a 4 byte packet number
+constexpr size_t TAG_LEN     = EVP_GCM_TLS_TAG_LEN;
+constexpr size_t PAYLOAD_LEN = PACKET_LEN - HEADER_LEN - TAG_LEN;
+constexpr int FLIGHT         = 16;
+
+const uint8_t KEY[]    = {0x1f, 0x36, 0x96, 0x13, 0xdd, 0x76, 0xd5, 0x46, 0x77, 0x30, 0xef, 0xcb, 0xe3, 0xb1, 0xa2, 0x2d};
+const uint8_t IV[]     = {0xfa, 0x04, 0x4b, 0x2f, 0x42, 0xa3, 0xfd, 0x3b, 0x46, 0xfb, 0x25, 0x5c};
+const uint8_t HP_KEY[] = {0x9f, 0x50, 0x44, 0x9e, 0x04, 0xa0, 0xe8, 0x10, 0x28, 0x3a, 0x1e, 0x99, 0x33, 0xad, 0xed, 0xd2};
+
+void
+setup_keys(QUICPacketProtectionKeyInfo &key_info, bool encryption)
+{
+  key_info.set_cipher(EVP_aes_128_gcm(), TAG_LEN);
+  key_info.set_cipher_for_hp(EVP_aes_128_ecb());
+  if (encryption) {
+    memcpy(key_info.encryption_key(QUICKeyPhase::PHASE_0), KEY, sizeof(KEY));
+    memcpy(key_info.encryption_iv(QUICKeyPhase::PHASE_0), IV, sizeof(IV));
+    *key_info.encryption_iv_len(QUICKeyPhase::PHASE_0) = sizeof(IV);
+    memcpy(key_info.encryption_key_for_hp(QUICKeyPhase::PHASE_0), HP_KEY, sizeof(HP_KEY));
+    key_info.set_encryption_key_available(QUICKeyPhase::PHASE_0);
+  } else {
+    memcpy(key_info.decryption_key(QUICKeyPhase::PHASE_0), KEY, sizeof(KEY));
+    memcpy(key_info.decryption_iv(QUICKeyPhase::PHASE_0), IV, sizeof(IV));
+    *key_info.decryption_iv_len(QUICKeyPhase::PHASE_0) = sizeof(IV);
+    memcpy(key_info.decryption_key_for_hp(QUICKeyPhase::PHASE_0), HP_KEY, sizeof(HP_KEY));
+    key_info.set_decryption_key_available(QUICKeyPhase::PHASE_0);
+  }
+}
+
+// Packet protection as it was done before contexts were kept per key
+bool
+seal_with_new_context(uint8_t *out, const uint8_t *ad, size_t ad_len, const uint8_t *plain, size_t plain_len, uint64_t pkt_num)
+{
+  uint8_t nonce[sizeof(IV)];
+  memcpy(nonce, IV, sizeof(IV));
+  for (int i = 0; i < 8; ++i) {
+    nonce[sizeof(IV) - 1 - i] ^= pkt_num >> (8 * i);
+  }
+
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  int len             = 0;
+  int out_len         = 0;
+
+  bool ok = EVP_EncryptInit_ex(ctx, EVP_aes_128_gcm(), nullptr, nullptr, nullptr) &&
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, sizeof(nonce), nullptr) &&
+            EVP_EncryptInit_ex(ctx, nullptr, nullptr, KEY, nonce) && EVP_EncryptUpdate(ctx, nullptr, &len, ad, ad_len) &&
+            EVP_EncryptUpdate(ctx, out, &out_len, plain, plain_len) && EVP_EncryptFinal_ex(ctx, out + out_len, &len) &&
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, TAG_LEN, out + out_len + len);
+  EVP_CIPHER_CTX_free(ctx);
+  return ok;
+}
+
+bool
+mask_with_new_context(uint8_t *packet)
+{
+  uint8_t mask[EVP_MAX_BLOCK_LENGTH];
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  int len             = 0;
+
+  bool ok = EVP_EncryptInit_ex(ctx, EVP_aes_128_ecb(), nullptr, HP_KEY, nullptr) &&
+            EVP_EncryptUpdate(ctx, mask, &len, packet + HEADER_LEN, 16) && EVP_EncryptFinal_ex(ctx, mask + len, &len);
+  EVP_CIPHER_CTX_free(ctx);
+
+  packet[0] ^= mask[0] & 0x1f;
+  for (int i = 0; i < 4; ++i) {
+    packet[HEADER_LEN - 4 + i] ^= mask[1 + i];
+  }
+  return ok;
+}
+
+double
+elapsed(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void
+report(const char *name, double ns, int n_packets)
+{
+  printf("%-12s %10.1f ms %8.1f ns/packet %10.0f packets/s\n", name, ns / 1e6, ns / n_packets, n_packets / ns * 1e9);
+}
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  int n_packets = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (n_packets <= 0) {
+    fprintf(stderr, "Usage: %s [packets]\n", argv[0]);
+    return 1;
+  }
+  n_packets = (n_packets + FLIGHT - 1) / FLIGHT * FLIGHT;
+
+  BaseLogFile *base_log_file = new BaseLogFile("stderr");
+  diags                      = new Diags("bench_QUICPacketProtector", "" /* tags */, "" /* actions */, base_log_file);
+  Layout::create();
+  RecProcessInit(RECM_STAND_ALONE);
+  LibRecordsConfigInit();
+  QUICConfig::startup();
+
+  EThread *thread = new EThread();
+  thread->set_specific();
+  init_buffer_allocators(0);
+
+  QUICPacketProtectionKeyInfo sender_keys;
+  QUICPacketProtectionKeyInfo receiver_keys;
+  setup_keys(sender_keys, true);
+  setup_keys(receiver_keys, false);
+  QUICPacketPayloadProtector pp_protector(sender_keys);
+  QUICPacketPayloadProtector pp_unprotector(receiver_keys);
+  QUICPacketHeaderProtector ph_protector(sender_keys);
+
+  // A flight of short header packets
+  static uint8_t flight[FLIGHT][PACKET_LEN];
+  uint8_t *packets[FLIGHT];
+  size_t packet_lens[FLIGHT];
+  for (int i = 0; i < FLIGHT; ++i) {
+    memset(flight[i], 0x5a, PACKET_LEN);
+    flight[i][0]   = 0x43;
+    packets[i]     = flight[i];
+    packet_lens[i] = PACKET_LEN;
+  }
+
+  Ptr<IOBufferBlock> header = make_ptr<IOBufferBlock>(new_IOBufferBlock());
+  header->set_internal(flight[0], HEADER_LEN, BUFFER_SIZE_NOT_ALLOCATED);
+  Ptr<IOBufferBlock> payload = make_ptr<IOBufferBlock>(new_IOBufferBlock());
+  payload->set_internal(flight[0] + HEADER_LEN, PAYLOAD_LEN, BUFFER_SIZE_NOT_ALLOCATED);
+
+  printf("%d packets of %zu bytes, AES-128-GCM, %d packets per flight\n", n_packets, PACKET_LEN, FLIGHT);
+
+  uint64_t failures = 0;
+  static uint8_t out[PACKET_LEN];
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_packets; ++i) {
+    failures += !seal_with_new_context(out, flight[0], HEADER_LEN, flight[0] + HEADER_LEN, PAYLOAD_LEN, i);
+  }
+  report("seal before", elapsed(start), n_packets);
+
+  Ptr<IOBufferBlock> sealed;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_packets; ++i) {
+    sealed = pp_protector.protect(header, payload, i, QUICKeyPhase::PHASE_0);
+    failures += !sealed;
+  }
+  report("seal after", elapsed(start), n_packets);
+
+  Ptr<IOBufferBlock> opened;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_packets; ++i) {
+    opened = pp_unprotector.unprotect(header, sealed, n_packets - 1, QUICKeyPhase::PHASE_0);
+    failures += !opened;
+  }
+  report("open after", elapsed(start), n_packets);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_packets; ++i) {
+    failures += !mask_with_new_context(packets[i % FLIGHT]);
+  }
+  report("hp before", elapsed(start), n_packets);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n_packets; i += FLIGHT) {
+    failures += !ph_protector.protect(packets, packet_lens, FLIGHT, HEADER_LEN - 5);
+  }
+  report("hp after", elapsed(start), n_packets);
+
+  if (failures) {
+    printf("%" PRIu64 " packets failed\n", failures);
+    return 1;
+  }
+
+  return 0;
+}
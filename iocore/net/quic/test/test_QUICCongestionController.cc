@@ -0,0 +1,307 @@
+/** @file
+ *
+ *  A brief file description
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cstdio>
+#include <deque>
+#include <random>
+
+#include "catch.hpp"
+
+#include "QUICLossDetector.h"
+#include "QUICCubicCongestionController.h"
+#include "QUICBBRCongestionController.h"
+#include "QUICPacer.h"
+#include "Mock.h"
+
+namespace
+{
+// The controllers and the pacer read the time from Thread::get_hrtime(), the simulation moves it
+class SimClock : public Thread
+{
+public:
+  static void
+  set(ink_hrtime t)
+  {
+    cur_time = t;
+  }
+};
+
+class SimCCConfig : public QUICCCConfig
+{
+  uint32_t
+  max_datagram_size() const override
+  {
+    return 1200;
+  }
+
+  uint32_t
+  initial_window() const override
+  {
+    return 12000;
+  }
+
+  uint32_t
+  minimum_window() const override
+  {
+    return 2400;
+  }
+
+  float
+  loss_reduction_factor() const override
+  {
+    return 0.5;
+  }
+
+  uint32_t
+  persistent_congestion_threshold() const override
+  {
+    return 3;
+  }
+};
+
+class SimContext : public QUICCCContext
+{
+public:
+  SimContext() { this->_rtt_measure.init(this->_ld_config); }
+
+  QUICConnectionInfoProvider *
+  connection_info() const override
+  {
+    return const_cast<MockQUICConnectionInfoProvider *>(&this->_info);
+  }
+
+  QUICCCConfig &
+  cc_config() const override
+  {
+    return const_cast<SimCCConfig &>(this->_cc_config);
+  }
+
+  QUICRTTProvider *
+  rtt_provider() const override
+  {
+    return const_cast<QUICRTTMeasure *>(&this->_rtt_measure);
+  }
+
+  QUICRTTMeasure &
+  rtt_measure()
+  {
+    return this->_rtt_measure;
+  }
+
+private:
+  MockQUICConnectionInfoProvider _info;
+  MockQUICLDConfig _ld_config;
+  SimCCConfig _cc_config;
+  QUICRTTMeasure _rtt_measure;
+};
+
+struct LinkProfile {
+  const char *name;
+  uint64_t bandwidth; ///< Bottleneck rate in bits per second
+  ink_hrtime delay;   ///< One way propagation delay
+  double loss;        ///< Random loss behind the bottleneck
+  uint64_t queue;     ///< Bottleneck buffer in bytes, drop tail
+};
+
+struct SimResult {
+  uint64_t delivered = 0;
+  uint64_t lost      = 0;
+
+  double
+  goodput(ink_hrtime duration) const
+  {
+    return static_cast<double>(this->delivered) * 8 / (static_cast<double>(duration) / HRTIME_SECOND) / 1000000;
+  }
+};
+
+constexpr ink_hrtime SIM_TICK           = HRTIME_USECONDS(100);
+constexpr ink_hrtime SIM_DURATION       = HRTIME_SECONDS(10);
+constexpr uint32_t SIM_PACKET_SIZE      = 1200;
+constexpr uint32_t SIM_PACKET_THRESHOLD = 3;
+
+const char *
+algorithm_name(QUICCongestionControlAlgorithm algorithm)
+{
+  switch (algorithm) {
+  case QUICCongestionControlAlgorithm::CUBIC:
+    return "cubic";
+  case QUICCongestionControlAlgorithm::BBR:
+    return "bbr";
+  default:
+    return "newreno";
+  }
+}
+
+/**
+ * One bulk sender over a single bottleneck link. Time moves in fixed ticks and the loss is drawn
+ * from a seeded generator, so a run always gives the same result. Every packet is acked on its own
+ * and the link is FIFO, so acks come back in packet number order. Losses are found by the packet
+ * and time thresholds of the loss detector, and a tail with no acks for a PTO is declared lost.
+ */
+SimResult
+simulate(QUICCongestionControlAlgorithm algorithm, const LinkProfile &link)
+{
+  SimClock::set(HRTIME_SECOND);
+
+  SimContext context;
+  std::unique_ptr<QUICCongestionController> cc;
+  switch (algorithm) {
+  case QUICCongestionControlAlgorithm::CUBIC:
+    cc = std::make_unique<QUICCubicCongestionController>(context);
+    break;
+  case QUICCongestionControlAlgorithm::BBR:
+    cc = std::make_unique<QUICBBRCongestionController>(context);
+    break;
+  default:
+    cc = std::make_unique<QUICNewRenoCongestionController>(context);
+    break;
+  }
+  QUICPacer pacer;
+  std::mt19937 rng(1);
+
+  std::map<QUICPacketNumber, QUICPacketInfo> outstanding;
+  std::deque<std::pair<ink_hrtime, QUICPacketNumber>> acks;
+  QUICPacketNumber next_pn       = 0;
+  QUICPacketNumber largest_acked = 0;
+  ink_hrtime link_free           = 0;
+  SimResult result;
+
+  ink_hrtime start = Thread::get_hrtime();
+  for (ink_hrtime now = start; now < start + SIM_DURATION; now += SIM_TICK) {
+    SimClock::set(now);
+
+    // Acks
+    bool acked = false;
+    while (!acks.empty() && acks.front().first <= now) {
+      auto it = outstanding.find(acks.front().second);
+      acks.pop_front();
+      if (it == outstanding.end()) {
+        // Declared lost before the ack came back
+        continue;
+      }
+      context.rtt_measure().update_rtt(now - it->second.time_sent, 0);
+      result.delivered += it->second.sent_bytes;
+      cc->on_packet_acked(it->second);
+      largest_acked = std::max(largest_acked, it->first);
+      outstanding.erase(it);
+      acked = true;
+    }
+
+    // Losses
+    std::map<QUICPacketNumber, QUICPacketInfo *> lost;
+    QUICRTTMeasure &rtt   = context.rtt_measure();
+    ink_hrtime loss_delay = std::max(rtt.smoothed_rtt(), rtt.latest_rtt()) * 9 / 8;
+    for (auto &it : outstanding) {
+      bool below_largest = acked && it.first < largest_acked;
+      if ((below_largest && (it.first + SIM_PACKET_THRESHOLD <= largest_acked || it.second.time_sent + loss_delay <= now)) ||
+          (rtt.smoothed_rtt() > 0 && it.second.time_sent + rtt.current_pto_period() <= now)) {
+        lost.emplace(it.first, &it.second);
+      } else {
+        break;
+      }
+    }
+    if (!lost.empty()) {
+      cc->on_packets_lost(lost);
+      for (auto &it : lost) {
+        result.lost += it.second->sent_bytes;
+        outstanding.erase(it.first);
+      }
+    }
+
+    // Sends
+    while (cc->credit() > 0 && pacer.can_send(now)) {
+      QUICPacketNumber pn  = next_pn++;
+      QUICPacketInfo &info = outstanding[pn];
+      info.packet_number   = pn;
+      info.time_sent       = now;
+      info.ack_eliciting   = true;
+      info.in_flight       = true;
+      info.sent_bytes      = SIM_PACKET_SIZE;
+      info.type            = QUICPacketType::PROTECTED;
+      info.pn_space        = QUICPacketNumberSpace::ApplicationData;
+      cc->on_packet_sent(info);
+      pacer.on_packet_sent(now, SIM_PACKET_SIZE, cc->pacing_rate());
+
+      uint64_t queued = link_free > now ? (link_free - now) * link.bandwidth / 8 / HRTIME_SECOND : 0;
+      if (queued + SIM_PACKET_SIZE > link.queue) {
+        continue;
+      }
+      link_free = std::max(link_free, now) + SIM_PACKET_SIZE * 8 * HRTIME_SECOND / link.bandwidth;
+      if (rng() < link.loss * std::mt19937::max()) {
+        continue;
+      }
+      acks.emplace_back(link_free + 2 * link.delay, pn);
+    }
+  }
+
+  return result;
+}
+
+const LinkProfile profiles[] = {
+  {"high bdp", 50000000, HRTIME_MSECONDS(30), 0.001, 375000},
+  {"lossy", 20000000, HRTIME_USECONDS(12500), 0.01, 62500},
+  {"shallow buffer", 100000000, HRTIME_MSECONDS(5), 0.0, 30000},
+};
+
+const QUICCongestionControlAlgorithm algorithms[] = {
+  QUICCongestionControlAlgorithm::NEW_RENO,
+  QUICCongestionControlAlgorithm::CUBIC,
+  QUICCongestionControlAlgorithm::BBR,
+};
+
+} // namespace
+
+TEST_CASE("QUICCongestionController_SimulatedLink", "[quic]")
+{
+  // The controllers log every ack
+  diags->config.enabled[DiagsTagType_Debug] = false;
+
+  double goodput[3][3];
+  std::printf("%-16s %-8s %14s %10s\n", "link", "cc", "goodput(Mbps)", "loss(%)");
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      SimResult r   = simulate(algorithms[j], profiles[i]);
+      goodput[i][j] = r.goodput(SIM_DURATION);
+      std::printf("%-16s %-8s %14.2f %10.2f\n", profiles[i].name, algorithm_name(algorithms[j]), goodput[i][j],
+                  100.0 * r.lost / (r.delivered + r.lost));
+
+      CHECK(goodput[i][j] > 0);
+      CHECK(goodput[i][j] <= profiles[i].bandwidth / 1000000.0);
+    }
+  }
+
+  // BBR does not take random loss for congestion
+  CHECK(goodput[1][2] > goodput[1][0]);
+}
+
+TEST_CASE("QUICCongestionController_Deterministic", "[quic]")
+{
+  diags->config.enabled[DiagsTagType_Debug] = false;
+
+  for (auto algorithm : algorithms) {
+    SimResult a = simulate(algorithm, profiles[1]);
+    SimResult b = simulate(algorithm, profiles[1]);
+    CHECK(a.delivered == b.delivered);
+    CHECK(a.lost == b.lost);
+  }
+}
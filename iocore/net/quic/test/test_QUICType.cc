@@ -144,3 +144,83 @@ TEST_CASE("QUICType", "[quic]")
     CHECK(token1.cid() == token2.cid());
   }
 }
+
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+// Runs the instructions QUICConnectionId::route_program() uses on @a packet the way the kernel does.
+static uint32_t
+run_route_program(const std::vector<sock_filter> &code, const uint8_t *packet, size_t len)
+{
+  uint32_t a = 0;
+  for (size_t pc = 0; pc < code.size(); ++pc) {
+    const sock_filter &insn = code[pc];
+    switch (insn.code) {
+    case BPF_LD | BPF_B | BPF_ABS:
+      if (insn.k >= len) {
+        return 0; // out of bounds loads drop the packet
+      }
+      a = packet[insn.k];
+      break;
+    case BPF_JMP | BPF_JSET | BPF_K:
+      pc += (a & insn.k) ? insn.jt : insn.jf;
+      break;
+    case BPF_JMP | BPF_JA:
+      pc += insn.k;
+      break;
+    case BPF_ALU | BPF_MOD | BPF_K:
+      a %= insn.k;
+      break;
+    case BPF_RET | BPF_A:
+      return a;
+    default:
+      FAIL("unexpected instruction " << insn.code);
+    }
+  }
+  FAIL("the program does not return");
+  return 0;
+}
+#endif
+
+TEST_CASE("QUICConnectionId routes", "[quic]")
+{
+  uint8_t saved_routes = QUICConnectionId::ROUTES;
+  uint8_t saved_len    = QUICConnectionId::SCID_LEN;
+  QUICConnectionId::SCID_LEN = 8;
+
+  for (uint8_t routes : {1, 2, 3, 4, 7, 16, 255}) {
+    QUICConnectionId::ROUTES = routes;
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    std::vector<sock_filter> code = QUICConnectionId::route_program();
+#endif
+    for (unsigned route = 0; route < routes; ++route) {
+      INFO("routes: " << static_cast<int>(routes) << " route: " << route);
+      bool seen_high = false;
+      for (int i = 0; i < 64; ++i) {
+        QUICConnectionId cid;
+        cid.randomize(route);
+        REQUIRE(cid.length() == 8);
+        CHECK(cid.route() == route);
+        seen_high |= static_cast<const uint8_t *>(cid)[0] >= 128;
+
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+        // Long header: form bit, version, DCID length, DCID, SCID length, SCID
+        uint8_t long_header[32] = {0xc0, 0xff, 0x00, 0x00, 0x17, cid.length()};
+        memcpy(long_header + QUICInvariants::LH_DCID_OFFSET, cid, cid.length());
+        long_header[QUICInvariants::LH_DCID_OFFSET + cid.length()] = 0;
+        CHECK(run_route_program(code, long_header, sizeof(long_header)) == route);
+
+        // Short header: flags, DCID, packet number and payload
+        uint8_t short_header[32] = {0x40};
+        memcpy(short_header + QUICInvariants::SH_DCID_OFFSET, cid, cid.length());
+        CHECK(run_route_program(code, short_header, sizeof(short_header)) == route);
+#endif
+      }
+      // The random part of the first byte is kept
+      if (routes < 128) {
+        CHECK(seen_high);
+      }
+    }
+  }
+
+  QUICConnectionId::ROUTES   = saved_routes;
+  QUICConnectionId::SCID_LEN = saved_len;
+}
@@ -0,0 +1,151 @@
+/** @file
+
+  Catch based unit tests for SNINameMatcher
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "SNINameMatcher.h"
+
+using Groups = std::vector<std::string>;
+
+TEST_CASE("exact and wildcard names", "[sni]")
+{
+  SNINameMatcher m;
+  REQUIRE(m.add("www.example.com") == 0);
+  REQUIRE(m.add("*.example.com") == 1);
+  REQUIRE(m.add("example.org") == 2);
+  REQUIRE(m.size() == 3);
+
+  CHECK(m.find("www.example.com") == 0);
+  CHECK(m.find("mail.example.com") == 1);
+  CHECK(m.find("a.b.example.com") == 1);
+  CHECK(m.find("example.org") == 2);
+  // a "*." wildcard needs at least one more label
+  CHECK(m.find("example.com") == SNINameMatcher::NO_MATCH);
+  CHECK(m.find("www.example.org") == SNINameMatcher::NO_MATCH);
+  CHECK(m.find("com") == SNINameMatcher::NO_MATCH);
+  CHECK(m.find("") == SNINameMatcher::NO_MATCH);
+}
+
+TEST_CASE("the first entry in file order wins", "[sni]")
+{
+  SNINameMatcher m;
+  m.add("*.example.com");
+  m.add("www.example.com");
+  m.add("w*.example.com");
+  m.add("*.www.example.com");
+  m.add("*.*.example.com");
+
+  CHECK(m.find("www.example.com") == 0);
+  CHECK(m.find("a.www.example.com") == 0);
+
+  SNINameMatcher n;
+  n.add("w*.example.com");
+  n.add("www.example.com");
+  n.add("*.example.com");
+  n.add("*.www.example.com");
+
+  CHECK(n.find("www.example.com") == 0);
+  CHECK(n.find("mail.example.com") == 2);
+  // "w*" does not match the first label of a.www.example.com
+  CHECK(n.find("a.www.example.com") == 2);
+  CHECK(n.find("b.mail.example.com") == 2);
+
+  SNINameMatcher o;
+  o.add("*.www.example.com");
+  o.add("*.example.com");
+  CHECK(o.find("a.www.example.com") == 0);
+  CHECK(o.find("a.mail.example.com") == 1);
+}
+
+TEST_CASE("names are compared without regard to case", "[sni]")
+{
+  SNINameMatcher m;
+  m.add("WWW.Example.com");
+  m.add("*.Example.NET");
+  m.add("Edge*.CDN.example.org");
+
+  CHECK(m.find("www.example.com") == 0);
+  CHECK(m.find("WWW.EXAMPLE.COM") == 0);
+  CHECK(m.find("mail.example.net") == 1);
+  CHECK(m.find("edge1.cdn.EXAMPLE.org") == 2);
+
+  // captures come from the name as it was given
+  Groups groups;
+  CHECK(m.find("Mail.EXAMPLE.net", &groups) == 1);
+  CHECK(groups == Groups{"Mail"});
+  CHECK(m.find("EDGE7.cdn.example.org", &groups) == 2);
+  CHECK(groups == Groups{"7"});
+}
+
+TEST_CASE("captured groups for tunnel_route", "[sni]")
+{
+  SNINameMatcher m;
+  m.add("*.example.com");
+  m.add("edge*-*.cdn.example.org");
+  m.add("*.*.example.net");
+  m.add("exact.example.org");
+
+  Groups groups;
+  CHECK(m.find("www.example.com", &groups) == 0);
+  CHECK(groups == Groups{"www"});
+  CHECK(m.find("a.b.example.com", &groups) == 0);
+  CHECK(groups == Groups{"a.b"});
+  CHECK(m.find("edge12-west.cdn.example.org", &groups) == 1);
+  CHECK(groups == Groups{"12", "west"});
+  CHECK(m.find("one.two.example.net", &groups) == 2);
+  CHECK(groups == Groups{"one", "two"});
+
+  // no '*', no groups, and a miss clears them
+  CHECK(m.find("exact.example.org", &groups) == 3);
+  CHECK(groups.empty());
+  CHECK(m.find("www.example.com", &groups) == 0);
+  CHECK(m.find("nothing.here", &groups) == SNINameMatcher::NO_MATCH);
+  CHECK(groups.empty());
+}
+
+// These matched a prefix of the server name before globs were anchored at the end.
+TEST_CASE("globs match the whole name", "[sni]")
+{
+  SNINameMatcher m;
+  m.add("*.example.com");
+  m.add("example.org");
+  m.add("edge*.cdn.example.net");
+
+  CHECK(m.find("www.example.com.evil.net") == SNINameMatcher::NO_MATCH);
+  CHECK(m.find("example.org.au") == SNINameMatcher::NO_MATCH);
+  CHECK(m.find("edge1.cdn.example.net.evil.net") == SNINameMatcher::NO_MATCH);
+  CHECK(m.find("xexample.org") == SNINameMatcher::NO_MATCH);
+  CHECK(m.find("www.xexample.com") == SNINameMatcher::NO_MATCH);
+}
+
+TEST_CASE("an empty name only matches an empty entry", "[sni]")
+{
+  SNINameMatcher m;
+  m.add("*.example.com");
+  m.add("");
+
+  CHECK(m.find("") == 1);
+  CHECK(m.find("www.example.com") == 0);
+  CHECK(m.find("example.org") == SNINameMatcher::NO_MATCH);
+}
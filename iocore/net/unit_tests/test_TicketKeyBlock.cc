@@ -0,0 +1,181 @@
+/** @file
+
+  Catch based unit tests for the session ticket key blocks
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "tscore/Diags.h"
+#include "P_SSLCertLookup.h"
+
+using KeyName  = std::vector<unsigned char>;
+using KeyBlock = std::unique_ptr<ssl_ticket_key_block, decltype(&ticket_block_free)>;
+
+static KeyName
+key_name(unsigned n)
+{
+  KeyName name(sizeof(ssl_ticket_key_t::key_name), 0);
+  memcpy(name.data(), "name", 4);
+  memcpy(name.data() + 8, &n, sizeof(n));
+  return name;
+}
+
+// A block of keys named after @a names, with secrets telling the keys apart.
+static KeyBlock
+make_block(const std::vector<unsigned> &names)
+{
+  KeyBlock block(ticket_block_alloc(names.size()), &ticket_block_free);
+  for (unsigned i = 0; i < names.size(); ++i) {
+    memcpy(block->keys[i].key_name, key_name(names[i]).data(), sizeof(block->keys[i].key_name));
+    memset(block->keys[i].hmac_secret, i, sizeof(block->keys[i].hmac_secret));
+    memset(block->keys[i].aes_key, ~i, sizeof(block->keys[i].aes_key));
+  }
+  ticket_block_index(block.get());
+  return block;
+}
+
+static int
+find(const KeyBlock &block, unsigned n)
+{
+  return ticket_block_find(block.get(), key_name(n).data());
+}
+
+TEST_CASE("find every key of a block", "[ticket]")
+{
+  for (unsigned count = 1; count <= 100; ++count) {
+    INFO("keys: " << count);
+    std::vector<unsigned> names;
+    for (unsigned i = 0; i < count; ++i) {
+      names.push_back(i * 7919);
+    }
+    KeyBlock block = make_block(names);
+    REQUIRE(block->num_keys == count);
+    // at most half full
+    REQUIRE(block->index_mask + 1 >= 2 * count);
+
+    for (unsigned i = 0; i < count; ++i) {
+      CHECK(find(block, names[i]) == static_cast<int>(i));
+    }
+    // names that are not in the block
+    CHECK(find(block, 1) == -1);
+    CHECK(find(block, count * 7919) == -1);
+    unsigned char zero[sizeof(ssl_ticket_key_t::key_name)] = {0};
+    CHECK(ticket_block_find(block.get(), zero) == -1);
+  }
+}
+
+TEST_CASE("a duplicate key name finds the most recent key", "[ticket]")
+{
+  KeyBlock block = make_block({10, 11, 10, 12, 11, 10, 13});
+
+  CHECK(find(block, 10) == 0);
+  CHECK(find(block, 11) == 1);
+  CHECK(find(block, 12) == 3);
+  CHECK(find(block, 13) == 6);
+  CHECK(find(block, 14) == -1);
+
+  KeyBlock same = make_block({5, 5, 5, 5});
+  CHECK(find(same, 5) == 0);
+  CHECK(find(same, 6) == -1);
+
+  // the block as read from a ticket key file
+  std::vector<ssl_ticket_key_t> file(3);
+  for (unsigned i = 0; i < file.size(); ++i) {
+    memcpy(file[i].key_name, key_name(i == 2 ? 0 : i + 1).data(), sizeof(file[i].key_name));
+    memset(file[i].hmac_secret, i, sizeof(file[i].hmac_secret));
+    memset(file[i].aes_key, i, sizeof(file[i].aes_key));
+  }
+  KeyBlock created(ticket_block_create(reinterpret_cast<char *>(file.data()), file.size() * sizeof(ssl_ticket_key_t)),
+                   &ticket_block_free);
+  REQUIRE(created);
+  CHECK(find(created, 1) == 0);
+  CHECK(find(created, 2) == 1);
+  CHECK(find(created, 0) == 2);
+}
+
+TEST_CASE("rotation keeps the most recent keys", "[ticket]")
+{
+  for (unsigned count : {1, 2, 3, 8}) {
+    for (unsigned ring_size : {0, 1, 2, 3, 4, 16}) {
+      INFO("keys: " << count << " ring size: " << ring_size);
+      std::vector<unsigned> names;
+      for (unsigned i = 0; i < count; ++i) {
+        names.push_back(100 + i);
+      }
+      KeyBlock block = make_block(names);
+      KeyBlock rotated(ticket_block_rotate(block.get(), ring_size), &ticket_block_free);
+
+      unsigned kept = std::min(count, std::max(ring_size, 1U) - 1);
+      REQUIRE(rotated->num_keys == kept + 1);
+
+      // the new key comes first and is found under its own name
+      CHECK(ticket_block_find(rotated.get(), rotated->keys[0].key_name) == 0);
+      for (unsigned i = 0; i < count; ++i) {
+        CHECK(memcmp(rotated->keys[0].key_name, block->keys[i].key_name, sizeof(block->keys[i].key_name)) != 0);
+      }
+
+      // followed by the previous keys, newest first, and the oldest ones are dropped
+      for (unsigned i = 0; i < count; ++i) {
+        if (i < kept) {
+          CHECK(memcmp(&rotated->keys[i + 1], &block->keys[i], sizeof(ssl_ticket_key_t)) == 0);
+          CHECK(find(rotated, names[i]) == static_cast<int>(i + 1));
+        } else {
+          CHECK(find(rotated, names[i]) == -1);
+        }
+      }
+    }
+  }
+
+  // a first key
+  KeyBlock first(ticket_block_rotate(nullptr, 4), &ticket_block_free);
+  REQUIRE(first->num_keys == 1);
+  CHECK(ticket_block_find(first.get(), first->keys[0].key_name) == 0);
+
+  // rotating again and again keeps a ring of keys
+  constexpr unsigned RING_SIZE = 3;
+  std::vector<KeyName> issued;
+  KeyBlock block = make_block({1});
+  issued.push_back(key_name(1));
+  for (int round = 0; round < 10; ++round) {
+    block = KeyBlock(ticket_block_rotate(block.get(), RING_SIZE), &ticket_block_free);
+    issued.emplace(issued.begin(), block->keys[0].key_name, block->keys[0].key_name + sizeof(block->keys[0].key_name));
+
+    INFO("round " << round);
+    REQUIRE(block->num_keys == std::min<size_t>(issued.size(), RING_SIZE));
+    for (unsigned i = 0; i < issued.size(); ++i) {
+      CHECK(ticket_block_find(block.get(), issued[i].data()) == (i < RING_SIZE ? static_cast<int>(i) : -1));
+    }
+  }
+}
+
+int
+main(int argc, const char **argv)
+{
+  BaseLogFile *blf = new BaseLogFile("stdout");
+  diags            = new Diags("test_TicketKeyBlock", nullptr, nullptr, blf);
+
+  return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,254 @@
+/** @file
+
+  Catch based unit tests for the MSG_ZEROCOPY completion bookkeeping
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <vector>
+
+#include "tscore/I_Layout.h"
+
+#include "I_EventSystem.h"
+#include "RecordsConfig.h"
+#include "P_ZeroCopySend.h"
+
+#include "diags.i"
+
+class ZeroCopySendTest
+{
+public:
+  static void
+  set_next_seq(ZeroCopySend &zc, uint32_t seq)
+  {
+    zc._next_seq = seq;
+  }
+};
+
+// The data of one send per entry, held here too so the tests can see when the sends let go of it.
+class Sends
+{
+public:
+  explicit Sends(ZeroCopySend &zc) : _zc(zc) {}
+
+  // A send of @a ndata buffers.
+  void
+  send(unsigned ndata = 1)
+  {
+    std::vector<IOBufferData *> data;
+    for (unsigned i = 0; i < ndata; ++i) {
+      _data.emplace_back(new_IOBufferData(BUFFER_SIZE_INDEX_128));
+      data.push_back(_data.back().get());
+    }
+    _zc.pin(data.data(), data.size());
+    _ndata.push_back(ndata);
+  }
+
+  // Whether the data of the @a i th send is still pinned.
+  bool
+  pinned(unsigned i) const
+  {
+    unsigned first = 0;
+    for (unsigned j = 0; j < i; ++j) {
+      first += _ndata[j];
+    }
+    bool held = _data[first]->refcount() > 1;
+    for (unsigned j = first; j < first + _ndata[i]; ++j) {
+      CHECK((_data[j]->refcount() > 1) == held);
+    }
+    return held;
+  }
+
+private:
+  ZeroCopySend &_zc;
+  std::vector<Ptr<IOBufferData>> _data;
+  std::vector<unsigned> _ndata;
+};
+
+TEST_CASE("ZeroCopySend completions in order", "[net][zero_copy]")
+{
+  ZeroCopySend zc;
+  Sends sends(zc);
+  for (int i = 0; i < 5; ++i) {
+    sends.send(i % 2 + 1);
+  }
+  REQUIRE(zc.pending());
+
+  CHECK(zc.complete(0, 0, false) == 1);
+  CHECK(!sends.pinned(0));
+  CHECK(sends.pinned(1));
+
+  CHECK(zc.complete(1, 3, false) == 3);
+  for (unsigned i = 1; i <= 3; ++i) {
+    CHECK(!sends.pinned(i));
+  }
+  CHECK(sends.pinned(4));
+
+  CHECK(zc.complete(4, 4, false) == 1);
+  CHECK(!sends.pinned(4));
+  CHECK(!zc.pending());
+}
+
+TEST_CASE("ZeroCopySend completions out of order", "[net][zero_copy]")
+{
+  ZeroCopySend zc;
+  Sends sends(zc);
+  for (int i = 0; i < 6; ++i) {
+    sends.send();
+  }
+
+  // an earlier send still holds the front, nothing is released
+  zc.complete(2, 3, false);
+  zc.complete(5, 5, false);
+  for (unsigned i = 0; i < 6; ++i) {
+    CHECK(sends.pinned(i));
+  }
+
+  zc.complete(0, 1, false);
+  for (unsigned i = 0; i < 4; ++i) {
+    CHECK(!sends.pinned(i));
+  }
+  CHECK(sends.pinned(4));
+  CHECK(sends.pinned(5));
+
+  // a repeated range changes nothing
+  zc.complete(0, 3, false);
+  CHECK(sends.pinned(4));
+
+  zc.complete(4, 4, false);
+  CHECK(!sends.pinned(4));
+  CHECK(!sends.pinned(5));
+  CHECK(!zc.pending());
+}
+
+TEST_CASE("ZeroCopySend completions wrap", "[net][zero_copy]")
+{
+  ZeroCopySend zc;
+  Sends sends(zc);
+  ZeroCopySendTest::set_next_seq(zc, UINT32_MAX - 1);
+  // sequence numbers UINT32_MAX - 1, UINT32_MAX, 0, 1 and 2
+  for (int i = 0; i < 5; ++i) {
+    sends.send();
+  }
+
+  SECTION("one range across the wrap")
+  {
+    // ee_data < ee_info
+    CHECK(zc.complete(UINT32_MAX - 1, 1, false) == 4);
+    for (unsigned i = 0; i < 4; ++i) {
+      CHECK(!sends.pinned(i));
+    }
+    CHECK(sends.pinned(4));
+    CHECK(zc.complete(2, 2, false) == 1);
+    CHECK(!zc.pending());
+  }
+
+  SECTION("ranges on either side of the wrap")
+  {
+    CHECK(zc.complete(UINT32_MAX, 1, false) == 3);
+    for (unsigned i = 0; i < 5; ++i) {
+      CHECK(sends.pinned(i));
+    }
+    CHECK(zc.complete(UINT32_MAX - 1, UINT32_MAX - 1, false) == 1);
+    for (unsigned i = 0; i < 4; ++i) {
+      CHECK(!sends.pinned(i));
+    }
+    CHECK(sends.pinned(4));
+    CHECK(zc.complete(2, 2, false) == 1);
+    CHECK(!zc.pending());
+  }
+}
+
+TEST_CASE("ZeroCopySend copied completions", "[net][zero_copy]")
+{
+  net_zero_copy_send_min_size = 1024;
+  ZeroCopySend zc;
+  Sends sends(zc);
+  sends.send();
+  sends.send();
+
+  CHECK(zc.wants(4096));
+  CHECK(!zc.wants(100));
+
+  // the data is released like any other completion, and the socket stops asking for zero copy
+  CHECK(zc.complete(0, 0, true) == 1);
+  CHECK(!sends.pinned(0));
+  CHECK(sends.pinned(1));
+  CHECK(!zc.wants(4096));
+
+  zc.complete(1, 1, false);
+  CHECK(!zc.pending());
+  CHECK(!zc.wants(4096));
+
+  // a new socket asks again
+  zc.clear();
+  CHECK(zc.wants(4096));
+  net_zero_copy_send_min_size = 0;
+  CHECK(!zc.wants(4096));
+}
+
+TEST_CASE("ZeroCopySend hands its sends over", "[net][zero_copy]")
+{
+  ZeroCopySend zc;
+  Sends sends(zc);
+  ZeroCopySendTest::set_next_seq(zc, UINT32_MAX);
+  sends.send();
+  sends.send();
+
+  ZeroCopySend linger;
+  linger.take(zc);
+  CHECK(!zc.pending());
+  CHECK(linger.pending());
+  CHECK(sends.pinned(0));
+
+  // the numbering goes on from where it was
+  Sends more(linger);
+  more.send();
+  CHECK(linger.complete(UINT32_MAX, 0, false) == 2);
+  CHECK(!sends.pinned(0));
+  CHECK(!sends.pinned(1));
+  CHECK(more.pinned(0));
+  CHECK(linger.complete(1, 1, false) == 1);
+  CHECK(!more.pinned(0));
+  CHECK(!linger.pending());
+}
+
+struct EventProcessorListener : Catch::TestEventListenerBase {
+  using TestEventListenerBase::TestEventListenerBase;
+
+  void
+  testRunStarting(Catch::TestRunInfo const &testRunInfo) override
+  {
+    Layout::create();
+    init_diags("", nullptr);
+    RecProcessInit(RECM_STAND_ALONE);
+    LibRecordsConfigInit();
+
+    ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+    eventProcessor.start(1);
+
+    EThread *main_thread = new EThread;
+    main_thread->set_specific();
+  }
+};
+
+CATCH_REGISTER_LISTENER(EventProcessorListener);
@@ -255,6 +255,8 @@ public:
   bool m_transparent_passthrough = false;
   /// True if MPTCP is enabled on this port.
   bool m_mptcp = false;
+  /// True if TLS records are sent by the kernel on this port.
+  bool m_ktls = false;
   /// Local address for inbound connections (listen address).
   IpAddr m_inbound_ip;
   /// Local address for outbound connections (to origin server).
@@ -420,6 +422,7 @@ public:
   static const char *const OPT_HOST_RES_PREFIX;         ///< Set DNS family preference.
   static const char *const OPT_PROTO_PREFIX;            ///< Transport layer protocols.
   static const char *const OPT_MPTCP;                   ///< MPTCP.
+  static const char *const OPT_KTLS;                    ///< Kernel TLS.
 
   static std::vector<self> &m_global; ///< Global ("default") data.
 
@@ -182,6 +182,7 @@ const char *const HttpProxyPort::OPT_BLIND_TUNNEL            = "blind";
 const char *const HttpProxyPort::OPT_COMPRESSED              = "compressed";
 const char *const HttpProxyPort::OPT_MPTCP                   = "mptcp";
 const char *const HttpProxyPort::OPT_QUIC                    = "quic";
+const char *const HttpProxyPort::OPT_KTLS                    = "ktls";
 
 // File local constants.
 namespace
@@ -432,6 +433,12 @@ HttpProxyPort::processOptions(const char *opts)
       } else {
         Warning("Multipath TCP requested [%s] in port descriptor '%s' but it is not supported by this host.", item, opts);
       }
+    } else if (0 == strcasecmp(OPT_KTLS, item)) {
+#if TS_HAS_KTLS
+      m_ktls = true;
+#else
+      Warning("Kernel TLS requested [%s] in port descriptor '%s' but the TLS library does not support it.", item, opts);
+#endif
     } else if (nullptr != (value = this->checkPrefix(item, OPT_HOST_RES_PREFIX, OPT_HOST_RES_PREFIX_LEN))) {
       this->processFamilyPreference(value);
       host_res_set_p = true;
@@ -443,6 +450,11 @@ HttpProxyPort::processOptions(const char *opts)
     }
   }
 
+  if (m_ktls && TRANSPORT_SSL != m_type) {
+    Warning("Kernel TLS requested in port descriptor '%s' but the port is not an SSL port.", opts);
+    m_ktls = false;
+  }
+
   bool in_ip_set_p = m_inbound_ip.isValid();
 
   if (af_set_p) {
@@ -625,6 +637,10 @@ HttpProxyPort::print(char *out, size_t n)
     zret += snprintf(out + zret, n - zret, ":%s", OPT_MPTCP);
   }
 
+  if (m_ktls) {
+    zret += snprintf(out + zret, n - zret, ":%s", OPT_KTLS);
+  }
+
   if (m_transparent_passthrough) {
     zret += snprintf(out + zret, n - zret, ":%s", OPT_TRANSPARENT_PASSTHROUGH);
   }
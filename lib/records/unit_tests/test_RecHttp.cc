@@ -24,6 +24,7 @@
 
 #include "catch.hpp"
 
+#include "tscore/ink_config.h"
 #include "tscore/BufferWriter.h"
 #include "records/I_RecHttp.h"
 #include "test_Diags.h"
@@ -96,4 +97,22 @@ TEST_CASE("RecHttp", "[librecords][RecHttp]")
     REQUIRE(view.find(":ssl") != TextView::npos);
     REQUIRE(view.find(":proto") == TextView::npos); // it's default, should not have this.
   }
+
+  SECTION("ktls")
+  {
+    HttpProxyPort::loadValue(ports, "4443:ssl:ktls 8080:ktls");
+    REQUIRE(ports.size() == 2);
+    REQUIRE(ports[1].m_ktls == false);
+#if TS_HAS_KTLS
+    char buff[256];
+    ports[0].print(buff, sizeof(buff));
+    std::string_view view{buff};
+    REQUIRE(ports[0].m_ktls == true);
+    REQUIRE(view.find(":ktls") != TextView::npos);
+    REQUIRE(cdiag->messages.size() == 1);
+#else
+    REQUIRE(ports[0].m_ktls == false);
+    REQUIRE(cdiag->messages.size() == 2);
+#endif
+  }
 }
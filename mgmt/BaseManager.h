@@ -59,6 +59,7 @@
 #define MGMT_EVENT_DRAIN 10013
 #define MGMT_EVENT_HOST_STATUS_UP 10014
 #define MGMT_EVENT_HOST_STATUS_DOWN 10015
+#define MGMT_EVENT_SSL_TICKET_KEY_ROTATE 10016
 
 /***********************************************************************
  *
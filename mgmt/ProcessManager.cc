@@ -463,6 +463,9 @@ ProcessManager::handleMgmtMsgFromLM(MgmtMessageHdr *mh)
   case MGMT_EVENT_HOST_STATUS_DOWN:
     executeMgmtCallback(MGMT_EVENT_HOST_STATUS_DOWN, payload);
     break;
+  case MGMT_EVENT_SSL_TICKET_KEY_ROTATE:
+    executeMgmtCallback(MGMT_EVENT_SSL_TICKET_KEY_ROTATE, {});
+    break;
   case MGMT_EVENT_ROLL_LOG_FILES:
     executeMgmtCallback(MGMT_EVENT_ROLL_LOG_FILES, {});
     break;
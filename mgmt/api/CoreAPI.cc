@@ -491,6 +491,18 @@ LifecycleMessage(const char *tag, void const *data, size_t data_size)
   lmgmt->signalEvent(MGMT_EVENT_LIFECYCLE_MESSAGE, tag);
   return TS_ERR_OKAY;
 }
+
+/*-------------------------------------------------------------------------
+ * SslTicketKeyRotate
+ *-------------------------------------------------------------------------
+ * Rotate the TLS session ticket keys of traffic_server.
+ */
+TSMgmtError
+SslTicketKeyRotate()
+{
+  lmgmt->signalEvent(MGMT_EVENT_SSL_TICKET_KEY_ROTATE, "rotateTicketKeys");
+  return TS_ERR_OKAY;
+}
 /**************************************************************************
  * RECORD OPERATIONS
  *************************************************************************/
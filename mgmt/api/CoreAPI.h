@@ -53,6 +53,7 @@ TSMgmtError Stop(unsigned options);
 TSMgmtError Drain(unsigned options);                                               // drain requests of traffic_server
 TSMgmtError StorageDeviceCmdOffline(const char *dev);                              // Storage device operation.
 TSMgmtError LifecycleMessage(const char *tag, void const *data, size_t data_size); // Lifecycle alert to plugins.
+TSMgmtError SslTicketKeyRotate();                                                  // rotate TLS session ticket keys
 
 /***************************************************************************
  * Record Operations
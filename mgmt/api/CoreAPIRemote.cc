@@ -500,6 +500,21 @@ LifecycleMessage(const char *tag, void const *data, size_t data_size)
   return (ret == TS_ERR_OKAY) ? parse_generic_response(OpType::LIFECYCLE_MESSAGE, main_socket_fd) : ret;
 }
 
+/*-------------------------------------------------------------------------
+ * SslTicketKeyRotate
+ *-------------------------------------------------------------------------
+ * Rotate the TLS session ticket keys of the traffic_server process.
+ */
+TSMgmtError
+SslTicketKeyRotate()
+{
+  TSMgmtError ret;
+  OpType optype = OpType::SSL_TICKET_KEY_ROTATE;
+
+  ret = MGMTAPI_SEND_MESSAGE(main_socket_fd, OpType::SSL_TICKET_KEY_ROTATE, &optype);
+  return (ret == TS_ERR_OKAY) ? parse_generic_response(OpType::SSL_TICKET_KEY_ROTATE, main_socket_fd) : ret;
+}
+
 /***************************************************************************
  * Record Operations
  ***************************************************************************/
@@ -840,6 +840,12 @@ TSLifecycleMessage(const char *tag, void const *data, size_t data_size)
   return LifecycleMessage(tag, data, data_size);
 }
 
+tsapi TSMgmtError
+TSSslTicketKeyRotate()
+{
+  return SslTicketKeyRotate();
+}
+
 /* NOTE: user must deallocate the memory for the string returned */
 char *
 TSGetErrorMessage(TSMgmtError err_id)
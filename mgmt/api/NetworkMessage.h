@@ -56,6 +56,7 @@ enum class OpType : MgmtMarshallInt {
   LIFECYCLE_MESSAGE,
   HOST_STATUS_UP,
   HOST_STATUS_DOWN,
+  SSL_TICKET_KEY_ROTATE,
   UNDEFINED_OP /* This must be last */
 };
 
@@ -1008,6 +1008,27 @@ handle_lifecycle_message(int fd, void *req, size_t reqlen)
 
   return send_mgmt_response(fd, OpType::LIFECYCLE_MESSAGE, &err);
 }
+
+/**************************************************************************
+ * handle_ssl_ticket_key_rotate
+ *
+ * purpose: handle request to rotate the TLS session ticket keys
+ * output: TS_ERR_xx
+ * note: None
+ *************************************************************************/
+static TSMgmtError
+handle_ssl_ticket_key_rotate(int fd, void *req, size_t reqlen)
+{
+  MgmtMarshallInt optype;
+  MgmtMarshallInt err;
+
+  err = recv_mgmt_request(req, reqlen, OpType::SSL_TICKET_KEY_ROTATE, &optype);
+  if (err == TS_ERR_OKAY) {
+    lmgmt->signalEvent(MGMT_EVENT_SSL_TICKET_KEY_ROTATE, "rotateTicketKeys");
+  }
+
+  return send_mgmt_response(fd, OpType::SSL_TICKET_KEY_ROTATE, &err);
+}
 /**************************************************************************/
 
 struct control_message_handler {
@@ -1040,6 +1061,7 @@ static const control_message_handler handlers[] = {
   /* LIFECYCLE_MESSAGE          */ {MGMT_API_PRIVILEGED, handle_lifecycle_message},
   /* HOST_STATUS_UP             */ {MGMT_API_PRIVILEGED, handle_host_status_up},
   /* HOST_STATUS_DOWN           */ {MGMT_API_PRIVILEGED, handle_host_status_down},
+  /* SSL_TICKET_KEY_ROTATE      */ {MGMT_API_PRIVILEGED, handle_ssl_ticket_key_rotate},
 };
 
 // This should use countof(), but we need a constexpr :-/
@@ -385,6 +385,11 @@ tsapi TSMgmtError TSStorageDeviceCmdOffline(const char *dev);
  */
 tsapi TSMgmtError TSLifecycleMessage(const char *tag, void const *data, size_t data_size);
 
+/* TSSslTicketKeyRotate: Rotate the TLS session ticket keys of the traffic_server process.
+ * @return Success
+ */
+tsapi TSMgmtError TSSslTicketKeyRotate();
+
 /* TSGetErrorMessage: convert error id to error message
  * Input:  error id (defined in TSMgmtError)
  * Output: corresponding error message (allocated memory)
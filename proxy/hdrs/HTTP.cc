@@ -1914,6 +1914,11 @@ HTTPCacheAlt::copy(HTTPCacheAlt *to_copy)
   memcpy(&m_object_key[0], &to_copy->m_object_key[0], CRYPTO_HASH_SIZE);
   m_object_size[0] = to_copy->m_object_size[0];
   m_object_size[1] = to_copy->m_object_size[1];
+  m_vary_state     = to_copy->m_vary_state;
+  if (m_vary_state) {
+    m_vary_names  = to_copy->m_vary_names;
+    m_vary_values = to_copy->m_vary_values;
+  }
 
   if (to_copy->m_request_hdr.valid()) {
     m_request_hdr.copy(&to_copy->m_request_hdr);
@@ -1952,6 +1957,9 @@ HTTPCacheAlt::copy_frag_offsets_from(HTTPCacheAlt *src)
 }
 
 const int HTTP_ALT_MARSHAL_SIZE = HdrHeapMarshalBlocks{ts::round_up(sizeof(HTTPCacheAlt))};
+// Alternates written before cache version 24.3 have no Vary fingerprint hashes.
+const int HTTP_ALT_MARSHAL_SIZE_V24 = HdrHeapMarshalBlocks{
+  ts::round_up(sizeof(HTTPCacheAlt) - sizeof(HTTPCacheAlt::m_vary_names) - sizeof(HTTPCacheAlt::m_vary_values))};
 
 void
 HTTPInfo::create()
@@ -2020,6 +2028,10 @@ HTTPInfo::marshal(char *buf, int len)
   marshal_alt->m_writeable     = 0;
   marshal_alt->m_unmarshal_len = -1;
   marshal_alt->m_ext_buffer    = nullptr;
+  if (!m_alt->m_vary_state) {
+    marshal_alt->m_vary_names  = 0;
+    marshal_alt->m_vary_values = 0;
+  }
   buf += HTTP_ALT_MARSHAL_SIZE;
   used += HTTP_ALT_MARSHAL_SIZE;
 
@@ -2063,9 +2075,10 @@ HTTPInfo::marshal(char *buf, int len)
   return used;
 }
 
-int
-HTTPInfo::unmarshal(char *buf, int len, RefCountObj *block_ref)
+static int
+unmarshal_alt(char *buf, int len, RefCountObj *block_ref, int alt_size)
 {
+  using FragOffset  = HTTPCacheAlt::FragOffset;
   HTTPCacheAlt *alt = reinterpret_cast<HTTPCacheAlt *>(buf);
   int orig_len      = len;
 
@@ -2083,7 +2096,7 @@ HTTPInfo::unmarshal(char *buf, int len, RefCountObj *block_ref)
   ink_assert(alt->m_unmarshal_len < 0);
   alt->m_magic = CACHE_ALT_MAGIC_ALIVE;
   ink_assert(alt->m_writeable == 0);
-  len -= HTTP_ALT_MARSHAL_SIZE;
+  len -= alt_size;
 
   if (alt->m_frag_offset_count > HTTPCacheAlt::N_INTEGRAL_FRAG_OFFSETS) {
     alt->m_frag_offsets = reinterpret_cast<FragOffset *>(buf + reinterpret_cast<intptr_t>(alt->m_frag_offsets));
@@ -2130,6 +2143,24 @@ HTTPInfo::unmarshal(char *buf, int len, RefCountObj *block_ref)
   return alt->m_unmarshal_len;
 }
 
+int
+HTTPInfo::unmarshal(char *buf, int len, RefCountObj *block_ref)
+{
+  return unmarshal_alt(buf, len, block_ref, HTTP_ALT_MARSHAL_SIZE);
+}
+
+int
+HTTPInfo::unmarshal_v24_2(char *buf, int len, RefCountObj *block_ref)
+{
+  HTTPCacheAlt *alt = reinterpret_cast<HTTPCacheAlt *>(buf);
+
+  // No Vary fingerprint, the state was padding.
+  if (alt->m_magic == CACHE_ALT_MAGIC_MARSHALED) {
+    alt->m_vary_state = 0;
+  }
+  return unmarshal_alt(buf, len, block_ref, HTTP_ALT_MARSHAL_SIZE_V24);
+}
+
 int
 HTTPInfo::unmarshal_v24_1(char *buf, int len, RefCountObj *block_ref)
 {
@@ -2148,9 +2179,10 @@ HTTPInfo::unmarshal_v24_1(char *buf, int len, RefCountObj *block_ref)
   }
 
   ink_assert(alt->m_unmarshal_len < 0);
-  alt->m_magic = CACHE_ALT_MAGIC_ALIVE;
+  alt->m_magic      = CACHE_ALT_MAGIC_ALIVE;
+  alt->m_vary_state = 0;
   ink_assert(alt->m_writeable == 0);
-  len -= HTTP_ALT_MARSHAL_SIZE;
+  len -= HTTP_ALT_MARSHAL_SIZE_V24;
 
   if (alt->m_frag_offset_count > HTTPCacheAlt::N_INTEGRAL_FRAG_OFFSETS) {
     // stuff that didn't fit in the integral slots.
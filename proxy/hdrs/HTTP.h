@@ -1351,6 +1351,10 @@ struct HTTPCacheAlt {
   int32_t m_object_key[sizeof(CryptoHash) / sizeof(int32_t)];
   int32_t m_object_size[2];
 
+  /// Vary fingerprint state, see HttpTransactCache::SetVaryFingerprint. 0 if there is none.
+  /// This takes what was padding in alternates written before cache version 24.3.
+  uint32_t m_vary_state = 0;
+
   HTTPHdr m_request_hdr;
   HTTPHdr m_response_hdr;
 
@@ -1381,6 +1385,12 @@ struct HTTPCacheAlt {
   //  since our ownership model requires explicit
   //  destroys and ref count pointers defeat this
   RefCountObj *m_ext_buffer = nullptr;
+
+  // Vary fingerprint hashes, valid only if m_vary_state is set. Alternates
+  //  written before cache version 24.3 end before these, so for those
+  //  these overlay whatever follows the alternate.
+  uint64_t m_vary_names  = 0;
+  uint64_t m_vary_values = 0;
 };
 
 class HTTPInfo
@@ -1419,6 +1429,7 @@ public:
   inkcoreapi int marshal(char *buf, int len);
   static int unmarshal(char *buf, int len, RefCountObj *block_ref);
   static int unmarshal_v24_1(char *buf, int len, RefCountObj *block_ref);
+  static int unmarshal_v24_2(char *buf, int len, RefCountObj *block_ref);
   void set_buffer_reference(RefCountObj *block_ref);
   int get_handle(char *buf, int len);
 
@@ -1513,6 +1524,25 @@ public:
     m_alt->m_response_received_time = t;
   }
 
+  /// Get the Vary fingerprint, returning its state or 0 if there is none.
+  uint32_t
+  vary_fingerprint_get(uint64_t *names, uint64_t *values)
+  {
+    if (m_alt->m_vary_state) {
+      *names  = m_alt->m_vary_names;
+      *values = m_alt->m_vary_values;
+    }
+    return m_alt->m_vary_state;
+  }
+  void
+  vary_fingerprint_set(uint32_t state, uint64_t names, uint64_t values)
+  {
+    ink_assert(m_alt->m_writeable);
+    m_alt->m_vary_state  = state;
+    m_alt->m_vary_names  = names;
+    m_alt->m_vary_values = values;
+  }
+
   /// Get the fragment table.
   FragOffset *get_frag_table();
   /// Get the # of fragment offsets
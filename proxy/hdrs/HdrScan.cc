@@ -0,0 +1,140 @@
+/** @file
+
+  Vectorized character scanning for the HTTP/MIME parsers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <cstring>
+#include <cstdint>
+
+#include "HdrScan.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define HDR_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+// Two passes, memchr is already vectorized by the C library for a single character.
+const char *
+scan_lf_or_nul_scalar(const char *s, const char *e)
+{
+  const char *lf = static_cast<const char *>(memchr(s, '\n', e - s));
+  if (lf == nullptr) {
+    lf = e;
+  }
+  const char *nul = static_cast<const char *>(memchr(s, '\0', lf - s));
+  return nul ? nul : lf;
+}
+
+#if HDR_SCAN_X86
+const char *
+scan_lf_or_nul_sse2(const char *s, const char *e)
+{
+  const __m128i lf  = _mm_set1_epi8('\n');
+  const __m128i nul = _mm_setzero_si128();
+
+  for (; e - s >= 16; s += 16) {
+    __m128i v     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+    unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, nul)));
+    if (mask) {
+      return s + __builtin_ctz(mask);
+    }
+  }
+  for (; s < e; ++s) {
+    if (*s == '\n' || *s == '\0') {
+      return s;
+    }
+  }
+  return e;
+}
+
+__attribute__((target("avx2"))) const char *
+scan_lf_or_nul_avx2(const char *s, const char *e)
+{
+  const __m256i lf  = _mm256_set1_epi8('\n');
+  const __m256i nul = _mm256_setzero_si256();
+
+  for (; e - s >= 32; s += 32) {
+    __m256i v     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+    unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, nul)));
+    if (mask) {
+      return s + __builtin_ctz(mask);
+    }
+  }
+  return scan_lf_or_nul_sse2(s, e);
+}
+#endif
+
+HdrScanISA scan_isa = hdr_scan_isa_detect();
+
+} // namespace
+
+HdrScanISA
+hdr_scan_isa_detect()
+{
+#if HDR_SCAN_X86
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") ? HDR_SCAN_AVX2 : HDR_SCAN_SSE2;
+#else
+  return HDR_SCAN_SCALAR;
+#endif
+}
+
+HdrScanISA
+hdr_scan_isa()
+{
+  return scan_isa;
+}
+
+HdrScanISA
+hdr_scan_isa_set(HdrScanISA isa)
+{
+  HdrScanISA best = hdr_scan_isa_detect();
+  scan_isa        = isa > best ? best : isa;
+  return scan_isa;
+}
+
+const char *
+hdr_scan_isa_name(HdrScanISA isa)
+{
+  switch (isa) {
+  case HDR_SCAN_SSE2:
+    return "sse2";
+  case HDR_SCAN_AVX2:
+    return "avx2";
+  default:
+    return "scalar";
+  }
+}
+
+const char *
+hdr_scan_lf_or_nul(const char *s, const char *e)
+{
+#if HDR_SCAN_X86
+  if (scan_isa == HDR_SCAN_AVX2) {
+    return scan_lf_or_nul_avx2(s, e);
+  } else if (scan_isa == HDR_SCAN_SSE2) {
+    return scan_lf_or_nul_sse2(s, e);
+  }
+#endif
+  return scan_lf_or_nul_scalar(s, e);
+}
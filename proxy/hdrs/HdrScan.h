@@ -0,0 +1,54 @@
+/** @file
+
+  Vectorized character scanning for the HTTP/MIME parsers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+/// Instruction set used by the scanning functions.
+enum HdrScanISA {
+  HDR_SCAN_SCALAR = 0, ///< Portable code, separate searches for each character.
+  HDR_SCAN_SSE2,       ///< 16 bytes per step.
+  HDR_SCAN_AVX2,       ///< 32 bytes per step.
+};
+
+/// @return The best instruction set supported by the CPU.
+HdrScanISA hdr_scan_isa_detect();
+
+/// @return The instruction set currently in use.
+HdrScanISA hdr_scan_isa();
+
+/** Select the instruction set for the scanning functions.
+
+    This is only meant for tests and benchmarks. @a isa is lowered to what the CPU supports.
+
+    @return The instruction set actually selected.
+*/
+HdrScanISA hdr_scan_isa_set(HdrScanISA isa);
+
+/// @return A printable name for @a isa.
+const char *hdr_scan_isa_name(HdrScanISA isa);
+
+/** Find the end of a line.
+
+    @return A pointer to the first LF or NUL in [@a s, @a e), or @a e if there is none.
+*/
+const char *hdr_scan_lf_or_nul(const char *s, const char *e);
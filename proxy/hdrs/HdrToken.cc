@@ -22,10 +22,10 @@
  */
 
 #include "tscore/ink_platform.h"
-#include "tscore/HashFNV.h"
 #include "tscore/Diags.h"
 #include "tscore/ink_memory.h"
 #include <cstdio>
+#include <string_view>
 #include "tscore/Allocator.h"
 #include "HTTP.h"
 #include "HdrToken.h"
@@ -40,7 +40,7 @@
  You want a regexp like 'Accept' after "greedier" choices so it doesn't match 'Accept-Ranges' earlier than
  it should. The regexp are anchored (^Accept), but I dont see a way with the current system to
  match the word ONLY without making _hdrtoken_strs a real PCRE, but then that breaks the hashing
- hdrtoken_hash("^Accept$") != hdrtoken_hash("Accept")
+ hdrtoken_phash("^Accept$") != hdrtoken_phash("Accept")
 
  So, the current hack is to have "Accept" follow "Accept-.*", lame, I know
 
@@ -258,48 +258,13 @@ uint32_t hdrtoken_str_flags[SIZEOF(_hdrtoken_strs)];           // wks_idx -> fla
 
 DFA *hdrtoken_strs_dfa = nullptr;
 
-/***********************************************************************
- *                                                                     *
- *                        H A S H    T A B L E                         *
- *                                                                     *
- ***********************************************************************/
-
-#define HDRTOKEN_HASH_TABLE_SIZE 65536
-
-struct HdrTokenHashBucket {
-  const char *wks;
-  uint32_t hash;
-};
-
-HdrTokenHashBucket hdrtoken_hash_table[HDRTOKEN_HASH_TABLE_SIZE];
-
-/**
-  basic FNV hash
-**/
-#define TINY_MASK(x) (((uint32_t)1 << (x)) - 1)
-
-inline uint32_t
-hash_to_slot(uint32_t hash)
-{
-  return ((hash >> 15) ^ hash) & TINY_MASK(15);
-}
-
-inline uint32_t
-hdrtoken_hash(const unsigned char *string, unsigned int length)
-{
-  ATSHash32FNV1a fnv;
-  fnv.update(string, length, ATSHash::nocase());
-  fnv.final();
-  return fnv.get();
-}
-
 /*-------------------------------------------------------------------------
   -------------------------------------------------------------------------*/
 
 // WARNING:  Indexes into this array are stored on disk for cached objects.  New strings must be added at the end of the array to
 // avoid changing the indexes of pre-existing entries, unless the cache format version number is increased.
 //
-static const char *_hdrtoken_commonly_tokenized_strs[] = {
+static constexpr std::string_view _hdrtoken_commonly_tokenized_strs[] = {
   // MIME Field names
   "Accept-Charset", "Accept-Encoding", "Accept-Language", "Accept-Ranges", "Accept", "Age", "Allow",
   "Approved", // NNTP
@@ -370,37 +335,97 @@ static const char *_hdrtoken_commonly_tokenized_strs[] = {
 /*-------------------------------------------------------------------------
   -------------------------------------------------------------------------*/
 
-void
-hdrtoken_hash_init()
+/***********************************************************************
+ *                                                                     *
+ *                       P E R F E C T    H A S H                      *
+ *                                                                     *
+ ***********************************************************************/
+
+/*
+ The commonly tokenized strings are hashed into a small table at compile
+ time. The build searches for a seed that gives every string its own slot,
+ so a lookup is one hash, one table load and one string compare.
+*/
+
+#define HDRTOKEN_PHASH_BITS 12
+#define HDRTOKEN_PHASH_SIZE (1 << HDRTOKEN_PHASH_BITS)
+#define HDRTOKEN_PHASH_MAX_SEEDS 4096
+
+static constexpr int HDRTOKEN_NUM_COMMON = SIZEOF(_hdrtoken_commonly_tokenized_strs);
+
+/**
+  FNV-1a over the case folded bytes, salted with @a seed. Folding with 0x20
+  also merges some punctuation, which is harmless as hits are confirmed.
+**/
+static constexpr uint32_t
+hdrtoken_phash(const char *string, int length, uint32_t seed)
 {
-  uint32_t i;
-  int num_collisions;
+  uint32_t hash = 0x811c9dc5 ^ seed;
+  for (int i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(string[i]) | 0x20;
+    hash *= 0x01000193;
+  }
+  return hash;
+}
 
-  memset(hdrtoken_hash_table, 0, sizeof(hdrtoken_hash_table));
-  num_collisions = 0;
+static constexpr uint32_t
+hdrtoken_phash_slot(uint32_t hash)
+{
+  return (hash ^ (hash >> 16)) & (HDRTOKEN_PHASH_SIZE - 1);
+}
 
-  for (i = 0; i < static_cast<int> SIZEOF(_hdrtoken_commonly_tokenized_strs); i++) {
-    // convert the common string to the well-known token
-    unsigned const char *wks;
-    int wks_idx =
-      hdrtoken_tokenize_dfa(_hdrtoken_commonly_tokenized_strs[i], static_cast<int>(strlen(_hdrtoken_commonly_tokenized_strs[i])),
-                            reinterpret_cast<const char **>(&wks));
-    ink_release_assert(wks_idx >= 0);
+struct HdrTokenPerfectHash {
+  uint32_t seed = 0;
+  bool found    = false;
+  int16_t slots[HDRTOKEN_PHASH_SIZE]{}; // slot -> index in _hdrtoken_commonly_tokenized_strs, or -1
+};
 
-    uint32_t hash = hdrtoken_hash(wks, hdrtoken_str_lengths[wks_idx]);
-    uint32_t slot = hash_to_slot(hash);
+static constexpr HdrTokenPerfectHash
+hdrtoken_phash_build()
+{
+  HdrTokenPerfectHash table;
 
-    if (hdrtoken_hash_table[slot].wks) {
-      printf("ERROR: hdrtoken_hash_table[%u] collision: '%s' replacing '%s'\n", slot, reinterpret_cast<const char *>(wks),
-             hdrtoken_hash_table[slot].wks);
-      ++num_collisions;
+  for (uint32_t seed = 0; seed < HDRTOKEN_PHASH_MAX_SEEDS; ++seed) {
+    for (auto &slot : table.slots) {
+      slot = -1;
+    }
+    bool collision = false;
+    for (int i = 0; i < HDRTOKEN_NUM_COMMON && !collision; ++i) {
+      std::string_view str = _hdrtoken_commonly_tokenized_strs[i];
+      uint32_t slot        = hdrtoken_phash_slot(hdrtoken_phash(str.data(), static_cast<int>(str.size()), seed));
+      if (table.slots[slot] >= 0) {
+        collision = true;
+      } else {
+        table.slots[slot] = static_cast<int16_t>(i);
+      }
+    }
+    if (!collision) {
+      table.seed  = seed;
+      table.found = true;
+      break;
     }
-    hdrtoken_hash_table[slot].wks  = reinterpret_cast<const char *>(wks);
-    hdrtoken_hash_table[slot].hash = hash;
   }
 
-  if (num_collisions > 0) {
-    abort();
+  return table;
+}
+
+static constexpr HdrTokenPerfectHash hdrtoken_phash_table = hdrtoken_phash_build();
+static_assert(hdrtoken_phash_table.found, "no perfect hash seed for _hdrtoken_commonly_tokenized_strs, raise HDRTOKEN_PHASH_BITS");
+
+// common string index -> well-known string, filled in by hdrtoken_hash_init()
+static const char *hdrtoken_common_wks[HDRTOKEN_NUM_COMMON];
+
+void
+hdrtoken_hash_init()
+{
+  for (int i = 0; i < HDRTOKEN_NUM_COMMON; i++) {
+    // convert the common string to the well-known token
+    const char *wks;
+    int wks_idx = hdrtoken_tokenize_dfa(_hdrtoken_commonly_tokenized_strs[i].data(),
+                                        static_cast<int>(_hdrtoken_commonly_tokenized_strs[i].size()), &wks);
+    ink_release_assert(wks_idx >= 0);
+    ink_release_assert(hdrtoken_str_lengths[wks_idx] == static_cast<int>(_hdrtoken_commonly_tokenized_strs[i].size()));
+    hdrtoken_common_wks[i] = wks;
   }
 }
 
@@ -554,7 +579,6 @@ int
 hdrtoken_tokenize(const char *string, int string_len, const char **wks_string_out)
 {
   int wks_idx;
-  HdrTokenHashBucket *bucket;
 
   ink_assert(string != nullptr);
 
@@ -566,16 +590,17 @@ hdrtoken_tokenize(const char *string, int string_len, const char **wks_string_ou
     return wks_idx;
   }
 
-  uint32_t hash = hdrtoken_hash(reinterpret_cast<const unsigned char *>(string), static_cast<unsigned int>(string_len));
-  uint32_t slot = hash_to_slot(hash);
-
-  bucket = &(hdrtoken_hash_table[slot]);
-  if ((bucket->wks != nullptr) && (bucket->hash == hash) && (hdrtoken_wks_to_length(bucket->wks) == string_len)) {
-    wks_idx = hdrtoken_wks_to_index(bucket->wks);
-    if (wks_string_out) {
-      *wks_string_out = bucket->wks;
+  int common_idx =
+    hdrtoken_phash_table.slots[hdrtoken_phash_slot(hdrtoken_phash(string, string_len, hdrtoken_phash_table.seed))];
+  if (common_idx >= 0) {
+    const char *wks = hdrtoken_common_wks[common_idx];
+    if (wks && (hdrtoken_wks_to_length(wks) == string_len) && (strncasecmp(wks, string, string_len) == 0)) {
+      wks_idx = hdrtoken_wks_to_index(wks);
+      if (wks_string_out) {
+        *wks_string_out = wks;
+      }
+      return wks_idx;
     }
-    return wks_idx;
   }
 
   Debug("hdr_token", "Did not find a WKS for '%.*s'", string_len, string);
@@ -32,6 +32,7 @@
 #include <algorithm>
 #include "MIME.h"
 #include "HdrHeap.h"
+#include "HdrScan.h"
 #include "HdrToken.h"
 #include "HdrUtils.h"
 #include "HttpCompat.h"
@@ -440,9 +441,24 @@ mime_hdr_presence_unset(MIMEHdrImpl *h, int well_known_str_index)
  *                  S L O T    A C C E L E R A T O R S                 *
  *                                                                     *
  ***********************************************************************/
+/// Bit for a non-WKS field name in MIMEHdrImpl::m_name_filter.
+static inline uint32_t
+mime_hdr_name_filter_bit(const char *name, int length)
+{
+  uint32_t h = 0x811c9dc5;
+  for (int i = 0; i < length; ++i) {
+    h ^= static_cast<uint8_t>(name[i]) | 0x20;
+    h *= 0x01000193;
+  }
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  return 1u << (h >> 27);
+}
+
 inline void
 mime_hdr_init_accelerators_and_presence_bits(MIMEHdrImpl *mh)
 {
+  mh->m_name_filter          = 0;
   mh->m_presence_bits        = 0;
   mh->m_slot_accelerators[0] = 0xFFFFFFFF;
   mh->m_slot_accelerators[1] = 0xFFFFFFFF;
@@ -484,12 +500,14 @@ mime_hdr_set_accelerators_and_presence_bits(MIMEHdrImpl *mh, MIMEField *field)
 {
   int slot_id;
   ptrdiff_t slot_num;
+
+  ink_assert(mh);
+
   if (field->m_wks_idx < 0) {
+    mh->m_name_filter |= mime_hdr_name_filter_bit(field->m_ptr_name, field->m_len_name);
     return;
   }
 
-  ink_assert(mh);
-
   mime_hdr_presence_set(mh, field->m_wks_idx);
 
   slot_id = hdrtoken_index_to_slotid(field->m_wks_idx);
@@ -547,6 +565,20 @@ mime_hdr_reset_accelerators_and_presence_bits(MIMEHdrImpl *mh)
   }
 }
 
+/// Rebuild only the name filter, for headers whose filter was disabled on unmarshal.
+static void
+mime_hdr_name_filter_recompute(MIMEHdrImpl *mh)
+{
+  mh->m_name_filter = 0;
+  for (MIMEFieldBlockImpl *fblock = &(mh->m_first_fblock); fblock != nullptr; fblock = fblock->m_next) {
+    for (MIMEField *field = fblock->m_field_slots, *limit = field + fblock->m_freetop; field < limit; ++field) {
+      if (field->is_live() && field->m_wks_idx < 0) {
+        mh->m_name_filter |= mime_hdr_name_filter_bit(field->m_ptr_name, field->m_len_name);
+      }
+    }
+  }
+}
+
 int
 checksum_block(const char *s, int len)
 {
@@ -1151,6 +1183,10 @@ mime_hdr_copy_onto(MIMEHdrImpl *s_mh, HdrHeap *s_heap, MIMEHdrImpl *d_mh, HdrHea
 
   mime_hdr_field_block_list_adjust(block_count, &(s_mh->m_first_fblock), &(d_mh->m_first_fblock));
 
+  if (d_mh->m_name_filter == UINT32_MAX) {
+    mime_hdr_name_filter_recompute(d_mh);
+  }
+
   MIME_HDR_SANITY_CHECK(s_mh);
   MIME_HDR_SANITY_CHECK(d_mh);
 }
@@ -1365,6 +1401,21 @@ mime_hdr_field_find(MIMEHdrImpl *mh, const char *field_name_str, int field_name_
 #endif
     return f;
   } else {
+    // Names that spell a well-known string can use the presence bits and
+    // slot accelerators, since attached fields always carry their WKS index.
+    const char *wks = nullptr;
+    if (hdrtoken_tokenize(field_name_str, field_name_len, &wks) >= 0) {
+      return mime_hdr_field_find(mh, wks, field_name_len);
+    }
+
+    // Names are never removed from the filter, so a clear bit is a sure miss.
+    if ((mh->m_name_filter & mime_hdr_name_filter_bit(field_name_str, field_name_len)) == 0) {
+#if TRACK_FIELD_FIND_CALLS
+      Debug("http", "mime_hdr_field_find(hdr 0x%X, field %.*s): MISS (due to name filter)", mh, field_name_len, field_name_str);
+#endif
+      return nullptr;
+    }
+
     MIMEField *f = _mime_hdr_field_list_search_by_string(mh, field_name_str, field_name_len);
 
     ink_assert((f == nullptr) || f->is_live());
@@ -2351,7 +2402,8 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
   // Need this for handling dangling CR.
   static const char RAW_CR{ParseRules::CHAR_CR};
 
-  auto text = input;
+  auto text    = input;
+  bool saw_nul = false; // NUL in the scanned text, only the INSIDE state consumes anything but CR/LF.
   while (PARSE_RESULT_CONT == zret && !text.empty()) {
     switch (m_state) {
     case MIME_PARSE_BEFORE: // waiting to find a field.
@@ -2386,9 +2438,14 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
       }
       break;
     case MIME_PARSE_INSIDE: {
-      auto lf_off = text.find(ParseRules::CHAR_LF);
-      if (lf_off != TextView::npos) {
-        text.remove_prefix(lf_off + 1); // drop up to and including LF
+      // Look for the end of line and embedded NULs in a single pass.
+      const char *eol = hdr_scan_lf_or_nul(text.data(), text.data_end());
+      while (eol != text.data_end() && *eol == '\0') {
+        saw_nul = true;
+        eol     = hdr_scan_lf_or_nul(eol + 1, text.data_end());
+      }
+      if (eol != text.data_end()) {
+        text.remove_prefix(eol - text.data() + 1); // drop up to and including LF
         if (LINE == scan_type) {
           zret    = PARSE_RESULT_OK;
           m_state = MIME_PARSE_BEFORE;
@@ -2475,7 +2532,7 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
   }
 
   // Make sure there are no null characters in the input scanned so far
-  if (zret != PARSE_RESULT_ERROR && TextView::npos != parsed_text.find('\0')) {
+  if (zret != PARSE_RESULT_ERROR && saw_nul) {
     zret = PARSE_RESULT_ERROR;
   }
 
@@ -3763,6 +3820,9 @@ MIMEHdrImpl::unmarshal(intptr_t offset)
 {
   HDR_UNMARSHAL_PTR(m_fblock_list_tail, MIMEFieldBlockImpl, offset);
   m_first_fblock.unmarshal(offset);
+  // The field blocks after the first are not unmarshalled yet, and older
+  // caches stored padding here, so disable the filter until the next reset.
+  m_name_filter = UINT32_MAX;
 }
 
 void
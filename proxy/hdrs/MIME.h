@@ -252,7 +252,10 @@ struct MIMECooked {
  ***********************************************************************/
 
 struct MIMEHdrImpl : public HdrHeapObjImpl {
-  // HdrHeapObjImpl is 4 bytes, so this will result in 4 bytes padding
+  // HdrHeapObjImpl is 4 bytes, so this fills what would otherwise be padding
+  // and does not change the marshalled layout. One bit per non-WKS field name,
+  // see mime_hdr_name_filter_bit(). All bits set means "unknown".
+  uint32_t m_name_filter;
   uint64_t m_presence_bits;
   uint32_t m_slot_accelerators[4];
 
@@ -36,6 +36,7 @@
 
 #include "HTTP.h"
 #include "HttpCompat.h"
+#include "HdrScan.h"
 
 // replaces test_http_parser_eos_boundary_cases
 TEST_CASE("HdrTestHttpParse", "[proxy][hdrtest]")
@@ -91,6 +92,56 @@ TEST_CASE("HdrTestHttpParse", "[proxy][hdrtest]")
   }
 }
 
+TEST_CASE("HdrScan", "[proxy][hdrscan]")
+{
+  static const std::array<ts::TextView, 4> requests = {{
+    {"GET /index.html HTTP/1.0\r\nUser-Agent: foobar\r\n\r\n"},
+    {"POST /a/rather/long/path/to/cross/a/couple/of/vectors.html?query=string HTTP/1.1\r\nHost: example.com\r\n\r\n"},
+    {"GET /index.html HTTP/1.0\r\nUser-Agent: foo\0bar\r\n\r\n", 49},
+    {"GET /index.html HTTP/1.0\r\nX-Folded: first\r\n  second\r\n\r\n"},
+  }};
+  std::string base(100, 'x');
+  HdrScanISA best = hdr_scan_isa_detect();
+
+  for (int isa = HDR_SCAN_SCALAR; isa <= best; ++isa) {
+    REQUIRE(hdr_scan_isa_set(static_cast<HdrScanISA>(isa)) == isa);
+
+    // The end of line must be found at every offset, from every start.
+    for (size_t pos = 0; pos < base.size(); ++pos) {
+      for (char c : {'\n', '\0'}) {
+        std::string text = base;
+        text[pos]        = c;
+        for (size_t start = 0; start <= pos; ++start) {
+          REQUIRE(hdr_scan_lf_or_nul(text.data() + start, text.data() + text.size()) == text.data() + pos);
+        }
+        REQUIRE(hdr_scan_lf_or_nul(text.data(), text.data() + pos) == text.data() + pos);
+      }
+    }
+
+    // Parsing must not depend on the instruction set.
+    HTTPParser parser;
+    http_parser_init(&parser);
+    for (auto const &msg : requests) {
+      HTTPHdr req_hdr;
+      HdrHeap *heap = new_HdrHeap(HdrHeap::DEFAULT_SIZE + 64); // extra to prevent proxy allocation.
+      req_hdr.create(HTTP_TYPE_REQUEST, heap);
+      http_parser_clear(&parser);
+
+      auto start = msg.data();
+      auto ret   = req_hdr.parse_req(&parser, &start, msg.data_end(), true);
+      if (msg.find('\0') != ts::TextView::npos) {
+        REQUIRE(ret == PARSE_RESULT_ERROR);
+      } else {
+        REQUIRE(ret == PARSE_RESULT_DONE);
+        REQUIRE(start == msg.data_end());
+      }
+      req_hdr.destroy();
+    }
+    http_parser_clear(&parser);
+  }
+  hdr_scan_isa_set(best);
+}
+
 TEST_CASE("MIMEScanner_fragments", "[proxy][mimescanner_fragments]")
 {
   constexpr ts::TextView const message = "GET /index.html HTTP/1.0\r\n";
@@ -247,3 +247,56 @@ TEST_CASE("MimeParsers", "[proxy][mimeparsers]")
   std::printf("Date1: %d\n", d1);
   std::printf("Date2: %d\n", d2);
 }
+
+TEST_CASE("MimeFieldFind", "[proxy][mimefind]")
+{
+  // tokenizing is case insensitive and exact
+  CHECK(hdrtoken_tokenize("accept-encoding", 15) == MIME_WKSIDX_ACCEPT_ENCODING);
+  CHECK(hdrtoken_tokenize("ACCEPT", 6) == MIME_WKSIDX_ACCEPT);
+  CHECK(hdrtoken_tokenize("Accept-", 7) == -1);
+  CHECK(hdrtoken_tokenize("Accept-Encodinh", 15) == -1);
+  CHECK(hdrtoken_tokenize("X-Not-Well-Known", 16) == -1);
+  CHECK(hdrtoken_tokenize("", 0) == -1);
+  for (int i = 0; i < hdrtoken_num_wks; ++i) {
+    const char *wks = hdrtoken_index_to_wks(i);
+    std::string copy(wks, hdrtoken_index_to_length(i));
+    int idx = hdrtoken_tokenize(copy.data(), copy.size());
+    CHECK((idx == -1 || idx == i));
+  }
+
+  MIMEHdr hdr;
+  hdr.create(nullptr);
+
+  char name[32];
+  for (int i = 0; i < 40; ++i) {
+    int len = snprintf(name, sizeof(name), "X-Field-%d", i);
+    hdr.field_attach(hdr.field_create(name, len));
+  }
+  hdr.field_attach(hdr.field_create(MIME_FIELD_CACHE_CONTROL, MIME_LEN_CACHE_CONTROL));
+  hdr.field_attach(hdr.field_create("Host", 4));
+
+  for (int i = 0; i < 40; ++i) {
+    int len = snprintf(name, sizeof(name), "x-field-%d", i);
+    MIMEField *field = hdr.field_find(name, len);
+    REQUIRE(field != nullptr);
+    CHECK(field->name_get().size() == static_cast<size_t>(len));
+  }
+  for (int i = 40; i < 80; ++i) {
+    int len = snprintf(name, sizeof(name), "X-Field-%d", i);
+    CHECK(hdr.field_find(name, len) == nullptr);
+  }
+
+  // plain strings that spell well-known names take the accelerated path
+  CHECK(hdr.field_find("cache-control", 13) != nullptr);
+  CHECK(hdr.field_find(MIME_FIELD_HOST, MIME_LEN_HOST) != nullptr);
+  CHECK(hdr.field_find("Pragma", 6) == nullptr);
+
+  // names stay findable after the filter is rebuilt
+  hdr.m_mime->m_name_filter = UINT32_MAX;
+  hdr.m_mime->recompute_accelerators_and_presence_bits();
+  CHECK(hdr.m_mime->m_name_filter != UINT32_MAX);
+  CHECK(hdr.field_find("X-Field-7", 9) != nullptr);
+  CHECK(hdr.field_find("X-Field-77", 10) == nullptr);
+
+  hdr.destroy();
+}
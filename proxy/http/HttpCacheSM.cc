@@ -172,6 +172,14 @@ HttpCacheSM::state_cache_open_write(int event, void *data)
     break;
 
   case CACHE_EVENT_OPEN_WRITE_FAILED:
+    if ((intptr_t)data == -ECACHE_NOT_ADMITTED) {
+      // the admission filter keeps this document off the disk, retrying
+      // would only count as another access
+      Debug("http_cache", "[%" PRId64 "] [state_cache_open_write] document not admitted", master_sm->sm_id);
+      open_write_cb = true;
+      master_sm->handleEvent(event, data);
+      break;
+    }
     if (master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY) {
       // fall back to open_read_tries
       // Note that when CACHE_WL_FAIL_ACTION_READ_RETRY is configured, max_cache_open_write_retries
@@ -2479,7 +2479,9 @@ HttpSM::state_cache_open_write(int event, void *data)
       t_state.cache_info.write_lock_state  = HttpTransact::CACHE_WL_FAIL;
       break;
     }
-    if (t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_DEFAULT) {
+    // not admitted to the cache is not a lock failure, just don't write
+    if (t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_DEFAULT ||
+        (intptr_t)data == -ECACHE_NOT_ADMITTED) {
       t_state.cache_info.write_lock_state = HttpTransact::CACHE_WL_FAIL;
       break;
     } else {
@@ -5952,6 +5954,7 @@ HttpSM::issue_cache_update()
     t_state.cache_info.object_store.response_received_time_set(t_state.response_received_time);
     ink_assert(t_state.cache_info.object_store.request_sent_time_get() > 0);
     ink_assert(t_state.cache_info.object_store.response_received_time_get() > 0);
+    HttpTransactCache::SetVaryFingerprint(t_state.txn_conf, &t_state.cache_info.object_store);
     cache_sm.cache_write_vc->set_http_info(&t_state.cache_info.object_store);
     t_state.cache_info.object_store.clear();
   }
@@ -6203,6 +6206,18 @@ HttpSM::setup_cache_read_transfer()
     doc_size += hdr_size;
   }
 
+  // The body can go from the cache span to the socket untouched only if the
+  // client connection is the sole reader of the buffer and writes it as is,
+  // in the clear or with records built by the kernel.
+  if (!t_state.client_info.receive_chunked_response && ua_txn->is_chunked_encoding_supported()) {
+    NetVConnection *netvc     = ua_txn->get_netvc();
+    SSLNetVConnection *ssl_vc = dynamic_cast<SSLNetVConnection *>(netvc);
+    if (dynamic_cast<UnixNetVConnection *>(netvc) != nullptr && (ssl_vc == nullptr || ssl_vc->is_ktls_send()) &&
+        cache_sm.cache_read_vc->set_zero_copy()) {
+      SMDebug("http", "[%" PRId64 "] serving cache hit with zero copy", sm_id);
+    }
+  }
+
   HttpTunnelProducer *p = tunnel.add_producer(cache_sm.cache_read_vc, doc_size, buf_start, &HttpSM::tunnel_handler_cache_read,
                                               HT_CACHE_READ, "cache read");
   tunnel.add_consumer(ua_entry->vc, cache_sm.cache_read_vc, &HttpSM::tunnel_handler_ua, HT_HTTP_CLIENT, "user agent");
@@ -6259,6 +6274,7 @@ HttpSM::setup_cache_write_transfer(HttpCacheSM *c_sm, VConnection *source_vc, HT
 
   store_info->request_sent_time_set(t_state.request_sent_time);
   store_info->response_received_time_set(t_state.response_received_time);
+  HttpTransactCache::SetVaryFingerprint(t_state.txn_conf, store_info);
 
   c_sm->cache_write_vc->set_http_info(store_info);
   store_info->clear();
@@ -29,7 +29,9 @@
 #include <ctime>
 #include "HTTP.h"
 #include "HttpCompat.h"
+#include "HdrUtils.h"
 #include "tscore/InkErrno.h"
+#include "tscore/HashFNV.h"
 
 /**
   Find the pointer and length of an etag, after stripping off any leading
@@ -150,6 +152,82 @@ is_empty(char *s)
   return (s[0] == NUL);
 }
 
+// HTTPCacheAlt::m_vary_state bits. The fingerprint depends on the configuration that exempts fields
+// from Vary matching, so that is recorded with it.
+enum {
+  VARY_STATE_VALID    = 1 << 0,
+  VARY_STATE_SKIP_UA  = 1 << 1,
+  VARY_STATE_SKIP_AE  = 1 << 2,
+  VARY_STATE_WILDCARD = 1 << 3, ///< Vary: *, never matches.
+};
+
+struct ClientVaryFingerprint {
+  bool valid      = false;
+  uint64_t names  = 0;
+  uint64_t values = 0;
+};
+
+static uint32_t
+vary_fingerprint_state(const OverridableHttpConfigParams *http_config_params)
+{
+  return VARY_STATE_VALID | (http_config_params->global_user_agent_header ? VARY_STATE_SKIP_UA : 0) |
+         (http_config_params->ignore_accept_encoding_mismatch ? VARY_STATE_SKIP_AE : 0);
+}
+
+static uint32_t
+calc_alt_vary_fingerprint(const OverridableHttpConfigParams *http_config_params, CacheHTTPInfo *info, uint64_t *names,
+                          uint64_t *values)
+{
+  uint32_t state = vary_fingerprint_state(http_config_params);
+
+  if (!HttpTransactCache::CalcVaryFingerprint(http_config_params, info->request_get(), info->response_get(), names, values)) {
+    state |= VARY_STATE_WILDCARD;
+  }
+  return state;
+}
+
+// Check whether the selecting headers of @a client_request match those of the alternate @a info
+// by comparing Vary fingerprints. The alternate fingerprint is the one stored when it was written,
+// @a client caches the fingerprint of the client request for the most recent set of Vary fields.
+static bool
+vary_fingerprint_match(const OverridableHttpConfigParams *http_config_params, HTTPHdr *client_request, CacheHTTPInfo *info,
+                       ClientVaryFingerprint &client)
+{
+  uint64_t names  = 0;
+  uint64_t values = 0;
+  uint32_t state  = info->vary_fingerprint_get(&names, &values);
+
+  // Alternates written without a fingerprint, or under other settings, need it computed here.
+  if ((state & ~VARY_STATE_WILDCARD) != vary_fingerprint_state(http_config_params)) {
+    state = calc_alt_vary_fingerprint(http_config_params, info, &names, &values);
+  }
+  if (state & VARY_STATE_WILDCARD) {
+    return false;
+  }
+
+  if (!client.valid || client.names != names) {
+    client.valid = true;
+    HttpTransactCache::CalcVaryFingerprint(http_config_params, client_request, info->response_get(), &client.names, &client.values);
+  }
+  return client.values == values;
+}
+
+/**
+  Store the Vary fingerprint of the alternate @a info, to be written with it.
+
+  @a info must be writeable, its request and response as they will be cached.
+
+*/
+void
+HttpTransactCache::SetVaryFingerprint(const OverridableHttpConfigParams *http_config_params, HTTPInfo *info)
+{
+  uint64_t names  = 0;
+  uint64_t values = 0;
+  uint32_t state  = calc_alt_vary_fingerprint(http_config_params, info, &names, &values);
+
+  info->vary_fingerprint_set(state, names, values);
+}
+
 /**
   Given a set of alternates, select the best match.
 
@@ -159,6 +237,9 @@ is_empty(char *s)
   keeping with "quality is job 1", subsequent matches will only be
   considered if their quality is equal to the quality of the first match.
 
+  With more than one alternate only those whose Vary fingerprint matches the
+  client request are scored, the others would fail CalcVariability anyway.
+
   @return index in cache alternates vector.
 
 */
@@ -189,6 +270,11 @@ HttpTransactCache::SelectFromAlternates(CacheHTTPInfoVector *cache_vector, HTTPH
     return 0;
   }
 
+  // Plugins on the select alternate hook may force any alternate, so they always see all of them.
+  bool use_fingerprint = alt_count > 1 && client_request->method_get_wksidx() != HTTP_WKSIDX_PURGE &&
+                         http_global_hooks->get(TS_HTTP_SELECT_ALT_HOOK) == nullptr;
+  ClientVaryFingerprint client_fingerprint;
+
   for (int i = 0; i < alt_count; i++) {
     float Q;
     CacheHTTPInfo *obj       = cache_vector->get(i);
@@ -199,6 +285,11 @@ HttpTransactCache::SelectFromAlternates(CacheHTTPInfoVector *cache_vector, HTTPH
       ink_assert(cached_request->valid());
       ink_assert(cached_response->valid());
 
+      if (use_fingerprint && !vary_fingerprint_match(http_config_params, client_request, obj, client_fingerprint)) {
+        Debug("http_match", "[SelectFromAlternates] alternate %d does not match the Vary fingerprint", i);
+        continue;
+      }
+
       Q = calculate_quality_of_match(http_config_params, client_request, cached_request, cached_response);
 
       if (alt_count > 1) {
@@ -1211,6 +1302,89 @@ HttpTransactCache::CalcVariability(const OverridableHttpConfigParams *http_confi
   return variability;
 }
 
+// Hash the values of a Vary selecting header so that values HttpCompat::do_vary_header_values_match
+// considers equal hash the same.
+static void
+hash_vary_field_values(ATSHash64FNV1a &hash, MIMEField *field)
+{
+  // A missing field only matches a missing field.
+  uint8_t present = field != nullptr;
+  hash.update(&present, sizeof(present));
+  if (field == nullptr) {
+    return;
+  }
+
+  HdrCsvIter iter;
+  int count = iter.count_values(field);
+  int len;
+  hash.update(&count, sizeof(count));
+  for (const char *val = iter.get_first(field, &len); val != nullptr; val = iter.get_next(&len)) {
+    // Values are compared case insensitively up to the first end of word.
+    int n = 0;
+    while (n < len && !ParseRules::is_eow(val[n])) {
+      ++n;
+    }
+    hash.update(&len, sizeof(len));
+    hash.update(val, n, ATSHash::nocase());
+  }
+}
+
+/**
+  Fingerprint the request headers selected by the Vary header of a cached response.
+
+  @a names is set to a hash of the Vary fields that CalcVariability would check
+  and @a values to a hash of the values of those fields in @a request. Two
+  requests that CalcVariability considers equivalent have the same @a values for
+  the same response, so different fingerprints mean the alternate varies. Equal
+  fingerprints may still collide and must be confirmed by CalcVariability.
+
+  @return @c false if the response varies on every field (Vary: *).
+
+*/
+bool
+HttpTransactCache::CalcVaryFingerprint(const OverridableHttpConfigParams *http_config_params, HTTPHdr *request,
+                                       HTTPHdr *obj_origin_server_response, uint64_t *names, uint64_t *values)
+{
+  ATSHash64FNV1a name_hash;
+  ATSHash64FNV1a value_hash;
+
+  if (obj_origin_server_response->presence(MIME_PRESENCE_VARY)) {
+    StrList vary_list;
+
+    if (obj_origin_server_response->value_get_comma_list(MIME_FIELD_VARY, MIME_LEN_VARY, &vary_list) > 0) {
+      for (Str *field = vary_list.head; field != nullptr; field = field->next) {
+        if (field->len == 0) {
+          continue;
+        }
+        if (((field->str[0] == '*') && (field->str[1] == NUL))) {
+          return false;
+        }
+        // Same exemptions as CalcVariability.
+        if (http_config_params->global_user_agent_header && !strcasecmp(const_cast<char *>(field->str), "User-Agent")) {
+          continue;
+        }
+        if (http_config_params->ignore_accept_encoding_mismatch && !strcasecmp(const_cast<char *>(field->str), "Accept-Encoding")) {
+          continue;
+        }
+
+        name_hash.update(field->str, field->len + 1, ATSHash::nocase());
+
+        const char *field_name_str = hdrtoken_string_to_wks(field->str, field->len);
+        if (field_name_str == nullptr) {
+          field_name_str = field->str;
+        }
+        hash_vary_field_values(value_hash, request->field_find(field_name_str, field->len));
+      }
+    }
+  }
+
+  name_hash.final();
+  value_hash.final();
+  *names  = name_hash.get();
+  *values = value_hash.get();
+  return true;
+}
+
 /**
   If the request has If-modified-since or If-none-match,
   HTTP_STATUS_NOT_MODIFIED is returned if both or the existing one
@@ -78,6 +78,11 @@ public:
   static Variability_t CalcVariability(const OverridableHttpConfigParams *http_config_params, HTTPHdr *client_request,
                                        HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response);
 
+  static bool CalcVaryFingerprint(const OverridableHttpConfigParams *http_config_params, HTTPHdr *request,
+                                  HTTPHdr *obj_origin_server_response, uint64_t *names, uint64_t *values);
+
+  static void SetVaryFingerprint(const OverridableHttpConfigParams *http_config_params, HTTPInfo *info);
+
   static HTTPStatus match_response_to_request_conditionals(HTTPHdr *ua_request, HTTPHdr *c_response,
                                                            ink_time_t response_received_time);
 };
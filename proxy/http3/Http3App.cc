@@ -319,21 +319,21 @@ Http3SettingsHandler::handle_frame(std::shared_ptr<const Http3Frame> frame)
   // TODO: Add length check: the maximum number of values are 2^62 - 1, but some fields have shorter maximum than it.
   if (settings_frame->contains(Http3SettingsId::HEADER_TABLE_SIZE)) {
     uint64_t header_table_size = settings_frame->get(Http3SettingsId::HEADER_TABLE_SIZE);
-    this->_session->remote_qpack()->update_max_table_size(header_table_size);
+    this->_session->local_qpack()->update_max_table_size(std::min<uint64_t>(header_table_size, UINT16_MAX));
 
     Debug("http3", "SETTINGS_HEADER_TABLE_SIZE: %" PRId64, header_table_size);
   }
 
   if (settings_frame->contains(Http3SettingsId::MAX_HEADER_LIST_SIZE)) {
     uint64_t max_header_list_size = settings_frame->get(Http3SettingsId::MAX_HEADER_LIST_SIZE);
-    this->_session->remote_qpack()->update_max_header_list_size(max_header_list_size);
+    this->_session->local_qpack()->update_max_header_list_size(max_header_list_size);
 
     Debug("http3", "SETTINGS_MAX_HEADER_LIST_SIZE: %" PRId64, max_header_list_size);
   }
 
   if (settings_frame->contains(Http3SettingsId::QPACK_BLOCKED_STREAMS)) {
     uint64_t qpack_blocked_streams = settings_frame->get(Http3SettingsId::QPACK_BLOCKED_STREAMS);
-    this->_session->remote_qpack()->update_max_blocking_streams(qpack_blocked_streams);
+    this->_session->local_qpack()->update_max_blocking_streams(qpack_blocked_streams);
 
     Debug("http3", "SETTINGS_QPACK_BLOCKED_STREAMS: %" PRId64, qpack_blocked_streams);
   }
@@ -34,6 +34,7 @@ Http3ConfigParams::initialize()
   REC_EstablishStaticConfigInt32U(this->_header_table_size, "proxy.config.http3.header_table_size");
   REC_EstablishStaticConfigInt32U(this->_max_header_list_size, "proxy.config.http3.max_header_list_size");
   REC_EstablishStaticConfigInt32U(this->_qpack_blocked_streams, "proxy.config.http3.qpack_blocked_streams");
+  REC_EstablishStaticConfigInt32U(this->_qpack_blocked_streams_policy, "proxy.config.http3.qpack_blocked_streams_policy");
   REC_EstablishStaticConfigInt32U(this->_num_placeholders, "proxy.config.http3.num_placeholders");
   REC_EstablishStaticConfigInt32U(this->_max_settings, "proxy.config.http3.max_settings");
 }
@@ -56,6 +57,12 @@ Http3ConfigParams::qpack_blocked_streams() const
   return this->_qpack_blocked_streams;
 }
 
+uint32_t
+Http3ConfigParams::qpack_blocked_streams_policy() const
+{
+  return this->_qpack_blocked_streams_policy;
+}
+
 uint32_t
 Http3ConfigParams::num_placeholders() const
 {
@@ -36,15 +36,17 @@ public:
   uint32_t header_table_size() const;
   uint32_t max_header_list_size() const;
   uint32_t qpack_blocked_streams() const;
+  uint32_t qpack_blocked_streams_policy() const;
   uint32_t num_placeholders() const;
   uint32_t max_settings() const;
 
 private:
-  uint32_t _header_table_size     = 0;
-  uint32_t _max_header_list_size  = 0;
-  uint32_t _qpack_blocked_streams = 0;
-  uint32_t _num_placeholders      = 0;
-  uint32_t _max_settings          = 10;
+  uint32_t _header_table_size            = 0;
+  uint32_t _max_header_list_size         = 0;
+  uint32_t _qpack_blocked_streams        = 0;
+  uint32_t _qpack_blocked_streams_policy = 1;
+  uint32_t _num_placeholders             = 0;
+  uint32_t _max_settings                 = 10;
 };
 
 class Http3Config
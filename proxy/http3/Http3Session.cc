@@ -24,6 +24,7 @@
 #include "Http3Session.h"
 
 #include "Http3.h"
+#include "Http3Config.h"
 
 //
 // HQSession
@@ -141,10 +142,16 @@ HQSession::support_sni() const
 //
 Http3Session::Http3Session(NetVConnection *vc) : HQSession(vc)
 {
+  Http3Config::scoped_config params;
+
+  // The encoder starts with the defaults and follows the SETTINGS of the peer, the decoder uses what we send in our SETTINGS
   this->_local_qpack  = new QPACK(static_cast<QUICNetVConnection *>(vc), HTTP3_DEFAULT_MAX_HEADER_LIST_SIZE,
                                  HTTP3_DEFAULT_HEADER_TABLE_SIZE, HTTP3_DEFAULT_QPACK_BLOCKED_STREAMS);
-  this->_remote_qpack = new QPACK(static_cast<QUICNetVConnection *>(vc), HTTP3_DEFAULT_MAX_HEADER_LIST_SIZE,
-                                  HTTP3_DEFAULT_HEADER_TABLE_SIZE, HTTP3_DEFAULT_QPACK_BLOCKED_STREAMS);
+  this->_remote_qpack = new QPACK(static_cast<QUICNetVConnection *>(vc), params->max_header_list_size(),
+                                  params->header_table_size(), params->qpack_blocked_streams());
+  this->_local_qpack->set_blocked_streams_policy(params->qpack_blocked_streams_policy() ?
+                                                   QPACK::BlockedStreamsPolicy::PEER_LIMIT :
+                                                   QPACK::BlockedStreamsPolicy::NEVER);
 }
 
 Http3Session::~Http3Session()
@@ -30,6 +30,9 @@
 #define QPACKDebug(fmt, ...) Debug("qpack", "[%s] " fmt, this->_qc->cids().data(), ##__VA_ARGS__)
 #define QPACKDTDebug(fmt, ...) Debug("qpack", "" fmt, ##__VA_ARGS__)
 
+// [QPACK] 3.2.1.  Dynamic Table Size, every entry counts 32 bytes on top of its name and value
+static constexpr uint16_t DYNAMIC_TABLE_ENTRY_OVERHEAD = 32;
+
 // qpack-05 Appendix A.
 const QPACK::Header QPACK::StaticTable::STATIC_HEADER_FIELDS[] = {
   {":authority", ""},
@@ -183,8 +186,9 @@ QPACK::encode(uint64_t stream_id, HTTPHdr &header_set, MIOBuffer *header_block,
   }
 
   uint16_t base_index = this->_largest_known_received_index;
+  bool may_block      = this->_may_block_stream();
 
-  // Compress headers and record the largest reference
+  // Compress headers and record the smallest and the largest reference to the dynamic table
   uint16_t referred_index           = 0;
   uint16_t largest_reference        = 0;
   uint16_t smallest_reference       = 0;
@@ -193,16 +197,29 @@ QPACK::encode(uint64_t stream_id, HTTPHdr &header_set, MIOBuffer *header_block,
 
   MIMEFieldIter field_iter;
   for (MIMEField *field = header_set.iter_get_first(&field_iter); field != nullptr; field = header_set.iter_get_next(&field_iter)) {
-    int ret            = this->_encode_header(*field, base_index, compressed_headers, referred_index);
-    largest_reference  = std::max(largest_reference, referred_index);
-    smallest_reference = std::min(smallest_reference, referred_index);
+    int ret = this->_encode_header(*field, base_index, may_block, compressed_headers, referred_index);
     if (ret < 0) {
       compressed_headers->free();
       return ret;
     }
+    if (referred_index) {
+      largest_reference  = std::max(largest_reference, referred_index);
+      smallest_reference = smallest_reference ? std::min(smallest_reference, referred_index) : referred_index;
+    }
+  }
+
+  // Entries are evicted oldest first, so holding the smallest reference keeps every referred entry until the block is acknowledged
+  if (smallest_reference) {
+    struct EntryReference &eref = this->_references[stream_id];
+    if (eref.smallest == 0 || smallest_reference < eref.smallest) {
+      if (eref.smallest) {
+        this->_dynamic_table.unref_entry(eref.smallest);
+      }
+      this->_dynamic_table.ref_entry(smallest_reference);
+      eref.smallest = smallest_reference;
+    }
+    eref.largest = std::max(eref.largest, largest_reference);
   }
-  struct EntryReference eref = {smallest_reference, largest_reference};
-  this->_references.emplace(stream_id, eref);
 
   // Make an IOBufferBlock for Header Data Prefix
   IOBufferBlock *header_data_prefix = new_IOBufferBlock();
@@ -278,6 +295,7 @@ void
 QPACK::update_max_table_size(uint16_t max_table_size)
 {
   this->_max_table_size = max_table_size;
+  this->_dynamic_table.update_size(max_table_size);
 }
 
 void
@@ -286,6 +304,12 @@ QPACK::update_max_blocking_streams(uint16_t max_blocking_streams)
   this->_max_blocking_streams = max_blocking_streams;
 }
 
+void
+QPACK::set_blocked_streams_policy(BlockedStreamsPolicy policy)
+{
+  this->_blocked_streams_policy = policy;
+}
+
 int
 QPACK::_encode_prefix(uint16_t largest_reference, uint16_t base_index, IOBufferBlock *prefix)
 {
@@ -317,8 +341,11 @@ QPACK::_encode_prefix(uint16_t largest_reference, uint16_t base_index, IOBufferB
 }
 
 int
-QPACK::_encode_header(const MIMEField &field, uint16_t base_index, IOBufferBlock *compressed_header, uint16_t &referred_index)
+QPACK::_encode_header(const MIMEField &field, uint16_t base_index, bool may_block, IOBufferBlock *compressed_header,
+                      uint16_t &referred_index)
 {
+  referred_index = 0;
+
   Arena arena;
   int name_len;
   const char *name   = field.name_get(&name_len);
@@ -412,14 +439,18 @@ QPACK::_encode_header(const MIMEField &field, uint16_t base_index, IOBufferBlock
     }
   }
 
+  // An entry the decoder hasn't acknowledged would block the stream, the entry is still there for later header blocks
+  if (!may_block && lookup_result_dynamic.index > this->_largest_known_received_index) {
+    lookup_result_dynamic.match_type = LookupResult::MatchType::NONE;
+  }
+
   // Encode
   if (lookup_result_static.match_type == LookupResult::MatchType::EXACT) {
     this->_encode_indexed_header_field(lookup_result_static.index, base_index, false, compressed_header);
     QPACKDebug("Encoded Indexed Header Field: abs_index=%d, base_index=%d, dynamic_table=%d", lookup_result_static.index,
                base_index, false);
-    referred_index = 0;
   } else if (lookup_result_dynamic.match_type == LookupResult::MatchType::EXACT) {
-    if (lookup_result_dynamic.index < this->_largest_known_received_index) {
+    if (lookup_result_dynamic.index <= this->_largest_known_received_index) {
       this->_encode_indexed_header_field(lookup_result_dynamic.index, base_index, true, compressed_header);
       QPACKDebug("Encoded Indexed Header Field: abs_index=%d, base_index=%d, dynamic_table=%d", lookup_result_dynamic.index,
                  base_index, true);
@@ -429,7 +460,6 @@ QPACK::_encode_header(const MIMEField &field, uint16_t base_index, IOBufferBlock
       QPACKDebug("Encoded Indexed Header With Postbase Index: abs_index=%d, base_index=%d, never_index=%d",
                  lookup_result_dynamic.index, base_index, never_index);
     }
-    this->_dynamic_table.ref_entry(lookup_result_dynamic.index);
     referred_index = lookup_result_dynamic.index;
   } else if (lookup_result_static.match_type == LookupResult::MatchType::NAME) {
     this->_encode_literal_header_field_with_name_ref(lookup_result_static.index, false, base_index, value, value_len, never_index,
@@ -437,7 +467,6 @@ QPACK::_encode_header(const MIMEField &field, uint16_t base_index, IOBufferBlock
     QPACKDebug(
       "Encoded Literal Header Field With Name Ref: abs_index=%d, base_index=%d, dynamic_table=%d, value=%.*s, never_index=%d",
       lookup_result_static.index, base_index, false, value_len, value, never_index);
-    referred_index = 0;
   } else if (lookup_result_dynamic.match_type == LookupResult::MatchType::NAME) {
     if (lookup_result_dynamic.index <= this->_largest_known_received_index) {
       this->_encode_literal_header_field_with_name_ref(lookup_result_dynamic.index, true, base_index, value, value_len, never_index,
@@ -451,7 +480,6 @@ QPACK::_encode_header(const MIMEField &field, uint16_t base_index, IOBufferBlock
       QPACKDebug("Encoded Literal Header Field With Postbase Name Ref: abs_index=%d, base_index=%d, value=%.*s, never_index=%d",
                  lookup_result_dynamic.index, base_index, value_len, value, never_index);
     }
-    this->_dynamic_table.ref_entry(lookup_result_dynamic.index);
     referred_index = lookup_result_dynamic.index;
   } else {
     this->_encode_literal_header_field_without_name_ref(lowered_name, name_len, value, value_len, never_index, compressed_header);
@@ -957,21 +985,38 @@ QPACK::_update_largest_known_received_index_by_insert_count(uint16_t insert_coun
 void
 QPACK::_update_largest_known_received_index_by_stream_id(uint64_t stream_id)
 {
-  uint16_t largest_ref_index = this->_references[stream_id].largest;
-  if (largest_ref_index > this->_largest_known_received_index) {
-    this->_largest_known_received_index = largest_ref_index;
+  auto eref = this->_references.find(stream_id);
+  if (eref != this->_references.end() && eref->second.largest > this->_largest_known_received_index) {
+    this->_largest_known_received_index = eref->second.largest;
   }
 }
 
 void
 QPACK::_update_reference_counts(uint64_t stream_id)
 {
-  uint16_t smallest_ref_index = this->_references[stream_id].smallest;
-  if (smallest_ref_index) {
-    this->_dynamic_table.unref_entry(smallest_ref_index);
+  auto eref = this->_references.find(stream_id);
+  if (eref != this->_references.end() && eref->second.smallest) {
+    this->_dynamic_table.unref_entry(eref->second.smallest);
   }
 }
 
+bool
+QPACK::_may_block_stream()
+{
+  if (this->_blocked_streams_policy == BlockedStreamsPolicy::NEVER) {
+    return false;
+  }
+
+  // A stream is blocked until the decoder acknowledges the largest entry the header block refers to
+  uint16_t blocked_streams = 0;
+  for (const auto &eref : this->_references) {
+    if (eref.second.largest > this->_largest_known_received_index) {
+      ++blocked_streams;
+    }
+  }
+  return blocked_streams < this->_max_blocking_streams;
+}
+
 void
 QPACK::_resume_decode()
 {
@@ -1219,73 +1264,94 @@ QPACK::_attach_header(HTTPHdr &hdr, const char *name, int name_len, const char *
 //
 // DynamicTable
 //
-QPACK::DynamicTable::DynamicTable(uint16_t size) : _available(size), _max_entries(size), _storage(new DynamicTableStorage(size))
+QPACK::DynamicTable::DynamicTable(uint16_t size)
 {
   QPACKDTDebug("Dynamic table size: %u", size);
-  this->_entries      = static_cast<struct DynamicTableEntry *>(ats_malloc(sizeof(struct DynamicTableEntry) * size));
-  this->_entries_head = size - 1;
-  this->_entries_tail = size - 1;
+  this->_allocate(size);
 }
 
 QPACK::DynamicTable::~DynamicTable()
+{
+  this->_release();
+}
+
+void
+QPACK::DynamicTable::_allocate(uint16_t size)
+{
+  this->_capacity    = size;
+  this->_max_size    = size;
+  this->_max_entries = size / DYNAMIC_TABLE_ENTRY_OVERHEAD;
+  if (this->_max_entries) {
+    this->_entries = static_cast<struct DynamicTableEntry *>(ats_malloc(sizeof(struct DynamicTableEntry) * this->_max_entries));
+    this->_storage = new DynamicTableStorage(size);
+  }
+  this->_entries_head  = this->_max_entries ? this->_max_entries - 1 : 0;
+  this->_entries_count = 0;
+  this->_used          = 0;
+}
+
+void
+QPACK::DynamicTable::_release()
 {
   if (this->_storage) {
     delete this->_storage;
     this->_storage = nullptr;
   }
   if (this->_entries) {
-    delete this->_entries;
+    ats_free(this->_entries);
     this->_entries = nullptr;
   }
+  this->_name_index.clear();
+  this->_field_index.clear();
+}
+
+uint16_t
+QPACK::DynamicTable::_position(uint16_t index) const
+{
+  uint16_t distance = this->_entries_inserted - index;
+  ink_assert(distance < this->_entries_count);
+  return (this->_entries_head + this->_max_entries - distance) % this->_max_entries;
 }
 
 const QPACK::LookupResult
 QPACK::DynamicTable::lookup(uint16_t index, const char **name, int *name_len, const char **value, int *value_len)
 {
-  // ink_assert(index >= this->_entries[(this->_entries_tail + 1) % this->_max_entries].index);
-  // ink_assert(index <= this->_entries[this->_entries_head].index);
-  uint16_t pos = (this->_entries_head + (index - this->_entries[this->_entries_head].index)) % this->_max_entries;
-  *name_len    = this->_entries[pos].name_len;
-  *value_len   = this->_entries[pos].value_len;
-  this->_storage->read(this->_entries[pos].offset, name, *name_len, value, *value_len);
+  uint16_t distance = this->_entries_inserted - index;
+  if (distance >= this->_entries_count) {
+    *name      = "";
+    *name_len  = 0;
+    *value     = "";
+    *value_len = 0;
+    return {index, QPACK::LookupResult::MatchType::NONE};
+  }
+
+  const DynamicTableEntry &entry = this->_entries[this->_position(index)];
+  *name_len                      = entry.name_len;
+  *value_len                     = entry.value_len;
+  this->_storage->read(entry.offset, name, *name_len, value, *value_len);
   return {index, QPACK::LookupResult::MatchType::EXACT};
 }
 
 const QPACK::LookupResult
 QPACK::DynamicTable::lookup(const char *name, int name_len, const char *value, int value_len)
 {
-  QPACK::LookupResult::MatchType match_type = QPACK::LookupResult::MatchType::NONE;
-  uint16_t i                                = this->_entries_tail + 1;
-  int end                                   = this->_entries_head;
-  uint16_t candidate_index                  = 0;
-  const char *tmp_name                      = nullptr;
-  const char *tmp_value                     = nullptr;
-
   // DynamicTable is empty
-  if (this->_entries_inserted == 0) {
-    return {candidate_index, match_type};
-  }
-
-  // TODO Use a tree for better perfomance
-  for (; i <= end; i = (i + 1) % this->_max_entries) {
-    if (name_len != 0 && this->_entries[i].name_len == name_len) {
-      this->_storage->read(this->_entries[i].offset, &tmp_name, this->_entries[i].name_len, &tmp_value,
-                           this->_entries[i].value_len);
-      if (memcmp(name, tmp_name, name_len) == 0) {
-        candidate_index = this->_entries[i].index;
-        if (value_len == this->_entries[i].value_len && memcmp(value, tmp_value, value_len) == 0) {
-          // Exact match
-          match_type = QPACK::LookupResult::MatchType::EXACT;
-          break;
-        } else {
-          // Name match -- Keep it for no exact matchs
-          match_type = QPACK::LookupResult::MatchType::NAME;
-        }
-      }
-    }
+  if (this->_entries_count == 0 || name_len == 0) {
+    return {UINT16_C(0), QPACK::LookupResult::MatchType::NONE};
   }
 
-  return {candidate_index, match_type};
+  std::string_view n(name, name_len);
+  auto field = this->_field_index.find({n, std::string_view(value, value_len)});
+  if (field != this->_field_index.end()) {
+    return {field->second, QPACK::LookupResult::MatchType::EXACT};
+  }
+
+  auto name_only = this->_name_index.find(n);
+  if (name_only != this->_name_index.end()) {
+    return {name_only->second, QPACK::LookupResult::MatchType::NAME};
+  }
+
+  return {UINT16_C(0), QPACK::LookupResult::MatchType::NONE};
 }
 
 const QPACK::LookupResult
@@ -1298,10 +1364,48 @@ QPACK::DynamicTable::insert_entry(bool is_static, uint16_t index, const char *va
 
   if (is_static) {
     StaticTable::lookup(index, &name, &name_len, &dummy, &dummy_len);
-  } else {
-    this->lookup(index, &name, &name_len, &dummy, &dummy_len);
+    return this->insert_entry(name, name_len, value, value_len);
   }
-  return this->insert_entry(name, name_len, value, value_len);
+
+  if (this->lookup(index, &name, &name_len, &dummy, &dummy_len).match_type == LookupResult::MatchType::NONE) {
+    return {UINT16_C(0), QPACK::LookupResult::MatchType::NONE};
+  }
+  // The referred entry may be evicted to make space, so the name has to be copied
+  char *duped_name          = ats_strndup(name, name_len);
+  const LookupResult result = this->insert_entry(duped_name, name_len, value, value_len);
+  ats_free(duped_name);
+
+  return result;
+}
+
+bool
+QPACK::DynamicTable::_evict(uint16_t required_len)
+{
+  // Check if we can make enough space without evicting an entry that a stream refers to
+  uint32_t used  = this->_used;
+  uint16_t count = this->_entries_count;
+  uint16_t tail  = (this->_entries_head + this->_max_entries - count + 1) % this->_max_entries;
+  while (used + required_len > this->_max_size) {
+    if (count == 0 || this->_entries[tail].ref_count) {
+      return false;
+    }
+    used -= this->_entries[tail].name_len + this->_entries[tail].value_len + DYNAMIC_TABLE_ENTRY_OVERHEAD;
+    --count;
+    tail = (tail + 1) % this->_max_entries;
+  }
+
+  if (count != this->_entries_count) {
+    QPACKDTDebug("Evict entries: from %u to %u", this->_entries_inserted - this->_entries_count + 1,
+                 this->_entries_inserted - count);
+    while (this->_entries_count > count) {
+      uint16_t oldest = (this->_entries_head + this->_max_entries - this->_entries_count + 1) % this->_max_entries;
+      this->_unindex_entry(this->_entries[oldest]);
+      --this->_entries_count;
+    }
+    this->_used = used;
+  }
+
+  return true;
 }
 
 const QPACK::LookupResult
@@ -1311,42 +1415,59 @@ QPACK::DynamicTable::insert_entry(const char *name, uint16_t name_len, const cha
     return {UINT16_C(0), QPACK::LookupResult::MatchType::NONE};
   }
 
-  // Check if we can make enough space to insert a new entry
-  uint16_t required_len = name_len + value_len;
-  uint16_t available    = this->_available;
-  uint16_t tail         = (this->_entries_tail + 1) % this->_max_entries;
-  while (available < required_len) {
-    if (this->_entries[tail].ref_count) {
-      break;
-    }
-    available += this->_entries[tail].name_len + this->_entries[tail].value_len;
-    tail = (tail + 1) % this->_max_entries;
-  }
-  if (available < required_len) {
+  uint32_t required_len = name_len + value_len + DYNAMIC_TABLE_ENTRY_OVERHEAD;
+  if (required_len > this->_max_size || !this->_evict(required_len)) {
     // We can't insert a new entry because some stream(s) refer an entry that need to be evicted
     return {UINT16_C(0), QPACK::LookupResult::MatchType::NONE};
   }
 
-  // Evict
-  if (this->_available != available) {
-    QPACKDTDebug("Evict entries: from %u to %u", this->_entries[(this->_entries_tail + 1) % this->_max_entries].index,
-                 this->_entries[tail - 1].index);
-    this->_available    = available;
-    this->_entries_tail = tail - 1;
-    QPACKDTDebug("Available size: %u", this->_available);
-  }
-
   // Insert
   this->_entries_head                 = (this->_entries_head + 1) % this->_max_entries;
   this->_entries[this->_entries_head] = {++this->_entries_inserted, this->_storage->write(name, name_len, value, value_len),
                                          name_len, value_len, 0};
-  this->_available -= required_len;
+  ++this->_entries_count;
+  this->_used += required_len;
+  this->_index_entry(this->_entries[this->_entries_head]);
 
   QPACKDTDebug("Insert Entry: entry=%u, index=%u, size=%u", this->_entries_head, this->_entries_inserted, name_len + value_len);
-  QPACKDTDebug("Available size: %u", this->_available);
+  QPACKDTDebug("Available size: %u", this->_max_size - this->_used);
   return {this->_entries_inserted, value_len ? LookupResult::MatchType::EXACT : LookupResult::MatchType::NAME};
 }
 
+void
+QPACK::DynamicTable::_index_entry(const DynamicTableEntry &entry)
+{
+  const char *name;
+  const char *value;
+  this->_storage->read(entry.offset, &name, entry.name_len, &value, entry.value_len);
+
+  // Keys have to be replaced instead of assigned, the old ones point to the storage of the old entries
+  FieldKey key = {std::string_view(name, entry.name_len), std::string_view(value, entry.value_len)};
+  this->_name_index.erase(key.name);
+  this->_name_index.emplace(key.name, entry.index);
+  this->_field_index.erase(key);
+  this->_field_index.emplace(key, entry.index);
+}
+
+void
+QPACK::DynamicTable::_unindex_entry(const DynamicTableEntry &entry)
+{
+  const char *name;
+  const char *value;
+  this->_storage->read(entry.offset, &name, entry.name_len, &value, entry.value_len);
+
+  // A newer entry with the same name or field takes over the key
+  FieldKey key = {std::string_view(name, entry.name_len), std::string_view(value, entry.value_len)};
+  auto n       = this->_name_index.find(key.name);
+  if (n != this->_name_index.end() && n->second == entry.index) {
+    this->_name_index.erase(n);
+  }
+  auto f = this->_field_index.find(key);
+  if (f != this->_field_index.end() && f->second == entry.index) {
+    this->_field_index.erase(f);
+  }
+}
+
 const QPACK::LookupResult
 QPACK::DynamicTable::duplicate_entry(uint16_t current_index)
 {
@@ -1357,7 +1478,9 @@ QPACK::DynamicTable::duplicate_entry(uint16_t current_index)
   char *duped_name;
   char *duped_value;
 
-  this->lookup(current_index, &name, &name_len, &value, &value_len);
+  if (this->lookup(current_index, &name, &name_len, &value, &value_len).match_type == LookupResult::MatchType::NONE) {
+    return {UINT16_C(0), QPACK::LookupResult::MatchType::NONE};
+  }
   // We need to dup name and value to avoid memcpy-param-overlap
   duped_name                = ats_strndup(name, name_len);
   duped_value               = ats_strndup(value, value_len);
@@ -1379,21 +1502,38 @@ QPACK::DynamicTable::should_duplicate(uint16_t index)
 void
 QPACK::DynamicTable::update_size(uint16_t max_size)
 {
-  // TODO Implement it
+  if (max_size > this->_capacity) {
+    if (this->_entries_count) {
+      // Entries can't be moved because the hash indexes point into the storage, grow up to the allocated size only
+      max_size = this->_capacity;
+    } else {
+      this->_release();
+      this->_allocate(max_size);
+      QPACKDTDebug("Dynamic table size: %u", max_size);
+      return;
+    }
+  }
+
+  this->_max_size = max_size;
+  if (this->_max_entries) {
+    this->_evict(0);
+  }
+  QPACKDTDebug("Dynamic table size: %u, available size: %d", max_size, static_cast<int>(max_size) - static_cast<int>(this->_used));
 }
 
 void
 QPACK::DynamicTable::ref_entry(uint16_t index)
 {
-  uint16_t pos = (this->_entries_head + (index - this->_entries[this->_entries_head].index)) % this->_max_entries;
-  ++this->_entries[pos].ref_count;
+  ++this->_entries[this->_position(index)].ref_count;
 }
 
 void
 QPACK::DynamicTable::unref_entry(uint16_t index)
 {
-  uint16_t pos = (this->_entries_head + (index - this->_entries[this->_entries_head].index)) % this->_max_entries;
-  --this->_entries[pos].ref_count;
+  uint16_t distance = this->_entries_inserted - index;
+  if (distance < this->_entries_count) {
+    --this->_entries[this->_position(index)].ref_count;
+  }
 }
 
 uint16_t
@@ -1786,11 +1926,10 @@ QPACK::_read_stream_cancellation(QUICStreamIO &stream_io, uint64_t &stream_id)
 // DynamicTableStorage
 //
 
-QPACK::DynamicTableStorage::DynamicTableStorage(uint16_t size) : _head(size * 2 - 1), _tail(size * 2 - 1)
+QPACK::DynamicTableStorage::DynamicTableStorage(uint16_t size)
 {
-  this->_data_size           = size * 2;
-  this->_data                = reinterpret_cast<uint8_t *>(ats_malloc(this->_data_size));
-  this->_overwrite_threshold = size;
+  this->_data_size = static_cast<uint32_t>(size) * 2;
+  this->_data      = reinterpret_cast<uint8_t *>(ats_malloc(this->_data_size));
 }
 
 QPACK::DynamicTableStorage::~DynamicTableStorage()
@@ -1802,29 +1941,24 @@ QPACK::DynamicTableStorage::~DynamicTableStorage()
 }
 
 void
-QPACK::DynamicTableStorage::read(uint16_t offset, const char **name, uint16_t name_len, const char **value, uint16_t value_len)
+QPACK::DynamicTableStorage::read(uint32_t offset, const char **name, uint16_t name_len, const char **value, uint16_t value_len)
 {
   *name  = reinterpret_cast<const char *>(this->_data + offset);
   *value = reinterpret_cast<const char *>(this->_data + offset + name_len);
 }
 
-uint16_t
+uint32_t
 QPACK::DynamicTableStorage::write(const char *name, uint16_t name_len, const char *value, uint16_t value_len)
 {
-  uint16_t offset = (this->_head + 1) % this->_data_size;
-  memcpy(this->_data + offset, name, name_len);
-  memcpy(this->_data + offset + name_len, value, value_len);
-
-  this->_head = (this->_head + (name_len + value_len)) % this->_data_size;
-  if (this->_head > this->_overwrite_threshold) {
+  // Live entries never take more than half of the data, so wrapping to the beginning doesn't reach them
+  if (this->_head + name_len + value_len > this->_data_size) {
     this->_head = 0;
   }
 
-  return offset;
-}
+  uint32_t offset = this->_head;
+  memcpy(this->_data + offset, name, name_len);
+  memcpy(this->_data + offset + name_len, value, value_len);
+  this->_head += name_len + value_len;
 
-void
-QPACK::DynamicTableStorage::erase(uint16_t name_len, uint16_t value_len)
-{
-  this->_tail = (this->_tail + (name_len + value_len)) % this->_data_size;
+  return offset;
 }
@@ -23,6 +23,9 @@
 
 #pragma once
 
+#include <string_view>
+#include <unordered_map>
+
 #include "I_EventSystem.h"
 #include "I_Event.h"
 #include "tscpp/util/IntrusiveDList.h"
@@ -39,6 +42,11 @@ enum {
 class QPACK : public QUICApplication
 {
 public:
+  enum class BlockedStreamsPolicy {
+    NEVER,     ///< Refer only to entries the decoder has acknowledged
+    PEER_LIMIT ///< Refer to new entries on as many streams as the decoder allows to be blocked
+  };
+
   QPACK(QUICConnection *qc, uint32_t max_header_list_size, uint16_t max_table_size, uint16_t max_blocking_streams);
   virtual ~QPACK();
 
@@ -66,10 +74,13 @@ public:
   void update_max_header_list_size(uint32_t max_header_list_size);
   void update_max_table_size(uint16_t max_table_size);
   void update_max_blocking_streams(uint16_t max_blocking_streams);
+  void set_blocked_streams_policy(BlockedStreamsPolicy policy);
 
   static size_t estimate_header_block_size(const HTTPHdr &header_set);
 
 private:
+  friend class QPACKDynamicTableTest;
+
   struct LookupResult {
     uint16_t index                                  = 0;
     enum MatchType { NONE, NAME, EXACT } match_type = MatchType::NONE;
@@ -95,7 +106,7 @@ private:
 
   struct DynamicTableEntry {
     uint16_t index     = 0;
-    uint16_t offset    = 0;
+    uint32_t offset    = 0;
     uint16_t name_len  = 0;
     uint16_t value_len = 0;
     uint16_t ref_count = 0;
@@ -106,16 +117,14 @@ private:
   public:
     DynamicTableStorage(uint16_t size);
     ~DynamicTableStorage();
-    void read(uint16_t offset, const char **name, uint16_t name_len, const char **value, uint16_t value_len);
-    uint16_t write(const char *name, uint16_t name_len, const char *value, uint16_t value_len);
-    void erase(uint16_t name_len, uint16_t value_len);
+    void read(uint32_t offset, const char **name, uint16_t name_len, const char **value, uint16_t value_len);
+    uint32_t write(const char *name, uint16_t name_len, const char *value, uint16_t value_len);
 
   private:
-    uint16_t _overwrite_threshold = 0;
-    uint8_t *_data                = nullptr;
-    uint16_t _data_size           = 0;
-    uint16_t _head                = 0;
-    uint16_t _tail                = 0;
+    // Twice the table size, so that an entry never wraps around and live entries are never overwritten
+    uint8_t *_data      = nullptr;
+    uint32_t _data_size = 0;
+    uint32_t _head      = 0;
   };
 
   class DynamicTable
@@ -136,15 +145,48 @@ private:
     uint16_t largest_index();
 
   private:
-    uint16_t _available        = 0;
+    // Name and value of an entry, the views point to the storage of the newest entry that has them
+    struct FieldKey {
+      std::string_view name;
+      std::string_view value;
+
+      bool
+      operator==(const FieldKey &o) const
+      {
+        return name == o.name && value == o.value;
+      }
+    };
+
+    struct FieldKeyHash {
+      size_t
+      operator()(const FieldKey &k) const
+      {
+        size_t h = std::hash<std::string_view>()(k.name);
+        return h ^ (std::hash<std::string_view>()(k.value) + 0x9e3779b9 + (h << 6) + (h >> 2));
+      }
+    };
+
+    void _allocate(uint16_t size);
+    void _release();
+    uint16_t _position(uint16_t index) const;
+    bool _evict(uint16_t required_len);
+    void _index_entry(const DynamicTableEntry &entry);
+    void _unindex_entry(const DynamicTableEntry &entry);
+
+    uint16_t _capacity         = 0;
+    uint16_t _max_size         = 0;
+    uint32_t _used             = 0;
     uint16_t _entries_inserted = 0;
 
-    // FIXME It may be better to split this array into small arrays to reduce memory footprint
+    // Ring of entries, _entries_head is the newest one and the oldest one is _entries_count - 1 before it
     struct DynamicTableEntry *_entries = nullptr;
     uint16_t _max_entries              = 0;
     uint16_t _entries_head             = 0;
-    uint16_t _entries_tail             = 0;
+    uint16_t _entries_count            = 0;
     DynamicTableStorage *_storage      = nullptr;
+
+    std::unordered_map<std::string_view, uint16_t> _name_index;
+    std::unordered_map<FieldKey, uint16_t, FieldKeyHash> _field_index;
   };
 
   class DecodeRequest
@@ -234,15 +276,16 @@ private:
   };
 
   struct EntryReference {
-    uint16_t smallest;
-    uint16_t largest;
+    uint16_t smallest = 0;
+    uint16_t largest  = 0;
   };
 
   DynamicTable _dynamic_table;
-  std::map<uint64_t, struct EntryReference> _references;
-  uint32_t _max_header_list_size = 0;
-  uint16_t _max_table_size       = 0;
-  uint16_t _max_blocking_streams = 0;
+  std::unordered_map<uint64_t, struct EntryReference> _references;
+  uint32_t _max_header_list_size               = 0;
+  uint16_t _max_table_size                     = 0;
+  uint16_t _max_blocking_streams               = 0;
+  BlockedStreamsPolicy _blocked_streams_policy = BlockedStreamsPolicy::PEER_LIMIT;
 
   Continuation *_event_handler = nullptr;
   void _resume_decode();
@@ -258,6 +301,7 @@ private:
   void _update_largest_known_received_index_by_stream_id(uint64_t stream_id);
 
   void _update_reference_counts(uint64_t stream_id);
+  bool _may_block_stream();
 
   // Encoder Stream
   int _read_insert_with_name_ref(QUICStreamIO &stream_io, bool &is_static, uint16_t &index, Arena &arena, char **value,
@@ -281,7 +325,8 @@ private:
 
   // Request and Push Streams
   int _encode_prefix(uint16_t largest_reference, uint16_t base_index, IOBufferBlock *prefix);
-  int _encode_header(const MIMEField &field, uint16_t base_index, IOBufferBlock *compressed_header, uint16_t &referred_index);
+  int _encode_header(const MIMEField &field, uint16_t base_index, bool may_block, IOBufferBlock *compressed_header,
+                     uint16_t &referred_index);
   int _encode_indexed_header_field(uint16_t index, uint16_t base_index, bool dynamic_table, IOBufferBlock *compressed_header);
   int _encode_indexed_header_field_with_postbase_index(uint16_t index, uint16_t base_index, bool never_index,
                                                        IOBufferBlock *compressed_header);
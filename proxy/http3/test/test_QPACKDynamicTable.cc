@@ -0,0 +1,247 @@
+/** @file
+ *
+ *  Unit tests for the QPACK dynamic table
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include <cstdio>
+#include <string>
+
+#include "QPACK.h"
+
+class QPACKDynamicTableTest
+{
+public:
+  using DynamicTable = QPACK::DynamicTable;
+  using MatchType    = QPACK::LookupResult::MatchType;
+};
+
+using DynamicTable = QPACKDynamicTableTest::DynamicTable;
+using MatchType    = QPACKDynamicTableTest::MatchType;
+
+// Every entry takes 8 + 32 bytes, so a 256 byte table holds 6 of them in a ring of 8.
+constexpr uint16_t TABLE_SIZE = 256;
+constexpr uint16_t LIVE       = 6;
+constexpr int NAMES           = 3;
+
+static std::string
+name_of(int index, int names = NAMES)
+{
+  char buf[8];
+  snprintf(buf, sizeof(buf), "n%03d", index % names);
+  return buf;
+}
+
+static std::string
+value_of(int index)
+{
+  char buf[8];
+  snprintf(buf, sizeof(buf), "v%03d", index % 1000);
+  return buf;
+}
+
+static uint16_t
+insert(DynamicTable &table, int index, int names = NAMES)
+{
+  std::string name  = name_of(index, names);
+  std::string value = value_of(index);
+  auto result       = table.insert_entry(name.data(), name.size(), value.data(), value.size());
+  CHECK(result.match_type == MatchType::EXACT);
+  return result.index;
+}
+
+static bool
+has_entry(DynamicTable &table, uint16_t index, int names = NAMES)
+{
+  const char *name, *value;
+  int name_len, value_len;
+  if (table.lookup(index, &name, &name_len, &value, &value_len).match_type == MatchType::NONE) {
+    return false;
+  }
+  CHECK(std::string(name, name_len) == name_of(index, names));
+  CHECK(std::string(value, value_len) == value_of(index));
+  return true;
+}
+
+static void
+check_field(DynamicTable &table, const std::string &name, const std::string &value, MatchType match_type, uint16_t index)
+{
+  auto result = table.lookup(name.data(), name.size(), value.data(), value.size());
+  CHECK(result.match_type == match_type);
+  if (match_type != MatchType::NONE) {
+    CHECK(result.index == index);
+  }
+}
+
+TEST_CASE("Dynamic table ring wraps", "[qpack-dt]")
+{
+  DynamicTable table(TABLE_SIZE);
+
+  // Several times around the ring
+  for (int i = 1; i <= 100; ++i) {
+    INFO("inserted " << i);
+    REQUIRE(insert(table, i) == i);
+    REQUIRE(table.largest_index() == i);
+
+    int oldest = i > LIVE ? i - LIVE + 1 : 1;
+    for (int j = oldest; j <= i; ++j) {
+      CHECK(has_entry(table, j));
+    }
+    CHECK(!has_entry(table, oldest - 1));
+    CHECK(!has_entry(table, i + 1));
+
+    for (int j = oldest; j <= i; ++j) {
+      // The newest entry with the name is the one with the largest index
+      uint16_t newest = i - (i - j) % NAMES;
+      check_field(table, name_of(j), value_of(j), MatchType::EXACT, j);
+      check_field(table, name_of(j), "none", MatchType::NAME, newest);
+    }
+    if (oldest > 1) {
+      // An evicted field still matches the name of a newer entry
+      int evicted = oldest - 1;
+      check_field(table, name_of(evicted), value_of(evicted), MatchType::NAME, i - (i - evicted) % NAMES);
+    }
+    check_field(table, "n999", "v000", MatchType::NONE, 0);
+  }
+}
+
+TEST_CASE("Dynamic table lookups after evictions", "[qpack-dt]")
+{
+  DynamicTable table(TABLE_SIZE);
+  const std::string name  = "dupe";
+  const std::string value = "xx";
+
+  SECTION("a duplicated field resolves to the newest copy")
+  {
+    auto first  = table.insert_entry(name.data(), name.size(), value.data(), value.size());
+    auto second = table.insert_entry(name.data(), name.size(), value.data(), value.size());
+    REQUIRE(first.index == 1);
+    REQUIRE(second.index == 2);
+    check_field(table, name, value, MatchType::EXACT, 2);
+
+    // Evicting the first copy keeps the second one indexed
+    for (int i = 3; i <= LIVE + 1; ++i) {
+      REQUIRE(insert(table, i, 1000) == i);
+    }
+    const char *n, *v;
+    int n_len, v_len;
+    CHECK(table.lookup(1, &n, &n_len, &v, &v_len).match_type == MatchType::NONE);
+    check_field(table, name, value, MatchType::EXACT, 2);
+    check_field(table, name, "yy", MatchType::NAME, 2);
+
+    // And evicting that one too drops the field
+    REQUIRE(insert(table, LIVE + 2, 1000) == LIVE + 2);
+    check_field(table, name, value, MatchType::NONE, 0);
+    check_field(table, name, "yy", MatchType::NONE, 0);
+  }
+
+  SECTION("a name reference to the entry that makes room")
+  {
+    for (int i = 1; i <= LIVE; ++i) {
+      REQUIRE(insert(table, i, 1000) == i);
+    }
+    // Inserting with the name of entry 1 evicts entry 1
+    auto result = table.insert_entry(false, 1, "v999", 4);
+    REQUIRE(result.index == LIVE + 1);
+    CHECK(!has_entry(table, 1, 1000));
+    check_field(table, name_of(1, 1000), "v999", MatchType::EXACT, LIVE + 1);
+    check_field(table, name_of(1, 1000), value_of(1), MatchType::NAME, LIVE + 1);
+    for (int i = 2; i <= LIVE; ++i) {
+      CHECK(has_entry(table, i, 1000));
+    }
+  }
+
+  SECTION("a referred entry is not evicted")
+  {
+    for (int i = 1; i <= LIVE; ++i) {
+      REQUIRE(insert(table, i, 1000) == i);
+    }
+    table.ref_entry(1);
+    std::string n = name_of(LIVE + 1, 1000), v = value_of(LIVE + 1);
+    CHECK(table.insert_entry(n.data(), n.size(), v.data(), v.size()).match_type == MatchType::NONE);
+    CHECK(has_entry(table, 1, 1000));
+    table.unref_entry(1);
+    REQUIRE(insert(table, LIVE + 1, 1000) == LIVE + 1);
+    CHECK(!has_entry(table, 1, 1000));
+  }
+}
+
+TEST_CASE("Dynamic table capacity reduction", "[qpack-dt]")
+{
+  DynamicTable table(TABLE_SIZE);
+  for (int i = 1; i <= LIVE; ++i) {
+    REQUIRE(insert(table, i, 1000) == i);
+  }
+
+  // 3 entries take 120 bytes, the oldest ones go
+  table.update_size(120);
+  for (int i = 1; i <= 3; ++i) {
+    CHECK(!has_entry(table, i, 1000));
+    check_field(table, name_of(i, 1000), value_of(i), MatchType::NONE, 0);
+  }
+  for (int i = 4; i <= LIVE; ++i) {
+    CHECK(has_entry(table, i, 1000));
+    check_field(table, name_of(i, 1000), value_of(i), MatchType::EXACT, i);
+  }
+
+  // New entries are bound by the reduced size
+  REQUIRE(insert(table, LIVE + 1, 1000) == LIVE + 1);
+  CHECK(!has_entry(table, 4, 1000));
+  CHECK(has_entry(table, 5, 1000));
+  CHECK(has_entry(table, LIVE + 1, 1000));
+
+  // A referred entry stays until it is released
+  table.ref_entry(5);
+  table.update_size(40);
+  CHECK(has_entry(table, 5, 1000));
+  table.unref_entry(5);
+  table.update_size(40);
+  CHECK(!has_entry(table, 5, 1000));
+  CHECK(has_entry(table, LIVE + 1, 1000));
+
+  // The table can't grow past its allocation while it holds entries
+  table.update_size(2 * TABLE_SIZE);
+  for (int i = LIVE + 2; i <= 2 * LIVE + 1; ++i) {
+    REQUIRE(insert(table, i, 1000) == i);
+  }
+  CHECK(!has_entry(table, LIVE + 1, 1000));
+  for (int i = LIVE + 2; i <= 2 * LIVE + 1; ++i) {
+    CHECK(has_entry(table, i, 1000));
+  }
+
+  // Emptied, nothing fits, and indexes go on from where they were
+  table.update_size(0);
+  for (int i = LIVE + 2; i <= 2 * LIVE + 1; ++i) {
+    CHECK(!has_entry(table, i, 1000));
+    check_field(table, name_of(i, 1000), value_of(i), MatchType::NONE, 0);
+  }
+  std::string n = name_of(0, 1000), v = value_of(0);
+  CHECK(table.insert_entry(n.data(), n.size(), v.data(), v.size()).match_type == MatchType::NONE);
+
+  table.update_size(2 * TABLE_SIZE);
+  for (int i = 2 * LIVE + 2; i <= 4 * LIVE + 1; ++i) {
+    REQUIRE(insert(table, i, 1000) == i);
+  }
+  for (int i = 2 * LIVE + 2; i <= 4 * LIVE + 1; ++i) {
+    CHECK(has_entry(table, i, 1000));
+  }
+}
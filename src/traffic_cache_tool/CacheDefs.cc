@@ -632,6 +632,16 @@ Stripe::loadDir()
   }
   return zret;
 }
+
+void
+Stripe::unloadDir()
+{
+  if (dir) {
+    ats_memalign_free(reinterpret_cast<char *>(const_cast<CacheDirEntry *>(dir)) - this->vol_headerlen());
+    dir = nullptr;
+  }
+  _directory.clear();
+}
 //
 // Cache Directory
 //
@@ -162,6 +162,8 @@ public:
   uint16_t freelist[1];
 };
 
+constexpr uint32_t DOC_MAGIC = 0x5F129B13;
+
 struct Doc {
   uint32_t magic;     // DOC_MAGIC
   uint32_t len;       // length of this fragment (including hlen & sizeof(Doc), unrounded)
@@ -516,6 +518,8 @@ struct Stripe {
   /// Load metadata for this stripe.
   Errata loadMeta();
   Errata loadDir();
+  /// Release the directory and any buffered metadata search data.
+  void unloadDir();
   int check_loop(int s);
   void dir_check();
   bool walk_bucket_chain(int s); // returns true if there is a loop
@@ -27,9 +27,13 @@
 #include "../../proxy/hdrs/MIME.h"
 #include "../../proxy/hdrs/URL.h"
 
+#include <sstream>
+
 // using namespace ct;
 
 constexpr HdrHeapMarshalBlocks HTTP_ALT_MARSHAL_SIZE = ts::round_up(sizeof(HTTPCacheAlt));
+// Initial read size for first fragments, enough for the alternate headers of most objects.
+constexpr int64_t HEAD_READ_SIZE = 8192;
 
 namespace ct
 {
@@ -76,6 +80,223 @@ CacheScan::Scan(bool search)
   return zret;
 }
 
+int
+ScanStats::bucket(uint64_t value)
+{
+  return value ? 64 - __builtin_clzll(value) : 0;
+}
+
+void
+ScanStats::merge(ScanStats const &that)
+{
+  stripes += that.stripes;
+  dir_entries += that.dir_entries;
+  used_entries += that.used_entries;
+  head_entries += that.head_entries;
+  bytes_used += that.bytes_used;
+  read_errors += that.read_errors;
+  bad_docs += that.bad_docs;
+  objects += that.objects;
+  alternates += that.alternates;
+  for (int i = 0; i < N_BUCKETS; ++i) {
+    fragment_size[i] += that.fragment_size[i];
+    object_size[i] += that.object_size[i];
+    fragment_count[i] += that.fragment_count[i];
+    alternate_count[i] += that.alternate_count[i];
+    age[i] += that.age[i];
+  }
+}
+
+static void
+write_histogram(std::ostream &os, const char *name, ScanStats::Histogram const &h)
+{
+  bool first = true;
+  os << "\"" << name << "\":[";
+  for (int i = 0; i < ScanStats::N_BUCKETS; ++i) {
+    if (h[i]) {
+      uint64_t min = i ? uint64_t(1) << (i - 1) : 0;
+      uint64_t max = i ? min + (min - 1) : 0;
+      os << (first ? "" : ",") << "{\"min\":" << min << ",\"max\":" << max << ",\"count\":" << h[i] << "}";
+      first = false;
+    }
+  }
+  os << "]";
+}
+
+void
+ScanStats::write_json(std::ostream &os) const
+{
+  os << "{\"stripes\":" << stripes << ",\"dir_entries\":" << dir_entries << ",\"used_entries\":" << used_entries
+     << ",\"head_entries\":" << head_entries << ",\"bytes_used\":" << bytes_used << ",\"read_errors\":" << read_errors
+     << ",\"bad_docs\":" << bad_docs << ",\"objects\":" << objects << ",\"alternates\":" << alternates << ",";
+  write_histogram(os, "fragment_size", fragment_size);
+  os << ",";
+  write_histogram(os, "object_size", object_size);
+  os << ",";
+  write_histogram(os, "fragment_count", fragment_count);
+  os << ",";
+  write_histogram(os, "alternate_count", alternate_count);
+  os << ",";
+  write_histogram(os, "age", age);
+  os << "}" << std::endl;
+}
+
+Errata
+CacheScan::Stats(ScanStats &stats, time_t now)
+{
+  Errata zret;
+  std::bitset<65536> dir_bitset;
+  int64_t buf_size = HEAD_READ_SIZE;
+  char *buf        = static_cast<char *>(ats_memalign(ats_pagesize(), buf_size));
+  int fd           = this->stripe->_span->_fd;
+
+  ++stats.stripes;
+  stats.dir_entries += this->stripe->_segments * this->stripe->_buckets * DIR_DEPTH;
+  for (int s = 0; s < this->stripe->_segments; s++) {
+    dir_bitset.reset();
+    for (int b = 0; b < this->stripe->_buckets; b++) {
+      CacheDirEntry *seg = this->stripe->dir_segment(s);
+      CacheDirEntry *e   = dir_bucket(b, seg);
+      if (!dir_offset(e)) {
+        continue;
+      }
+      do {
+        // loop detected
+        if (dir_bitset[dir_to_offset(e, seg)]) {
+          break;
+        }
+        dir_bitset[dir_to_offset(e, seg)] = true;
+        if (this->stripe->dir_valid(e)) {
+          int64_t size = dir_approx_size(e);
+          ++stats.used_entries;
+          stats.bytes_used += size;
+          ++stats.fragment_size[ScanStats::bucket(size)];
+          if (dir_head(e)) {
+            ++stats.head_entries;
+            // Only the alternate headers are needed, so read a prefix of the first fragment and
+            // extend it only if the headers do not fit.
+            int64_t offset = this->stripe->stripe_offset(e);
+            ssize_t n      = pread(fd, buf, std::min(size, buf_size), offset);
+            Doc *doc       = reinterpret_cast<Doc *>(buf);
+            if (n >= static_cast<ssize_t>(sizeof(Doc)) && doc->magic == ts::DOC_MAGIC &&
+                static_cast<int64_t>(sizeof(Doc) + doc->hlen) > n && static_cast<int64_t>(sizeof(Doc) + doc->hlen) <= size) {
+              int64_t len = (sizeof(Doc) + doc->hlen + CACHE_BLOCK_SIZE - 1) / CACHE_BLOCK_SIZE * CACHE_BLOCK_SIZE;
+              len         = std::min(size, len);
+              if (len > buf_size) {
+                ats_memalign_free(buf);
+                buf_size = len;
+                buf      = static_cast<char *>(ats_memalign(ats_pagesize(), buf_size));
+              }
+              n   = pread(fd, buf, len, offset);
+              doc = reinterpret_cast<Doc *>(buf);
+            }
+            if (n < static_cast<ssize_t>(sizeof(Doc))) {
+              ++stats.read_errors;
+            } else if (doc->magic != ts::DOC_MAGIC || doc->hlen == 0 || static_cast<int64_t>(sizeof(Doc) + doc->hlen) > n) {
+              ++stats.bad_docs;
+            } else {
+              this->alternate_stats(doc->hdr(), doc->hlen, stats, now);
+            }
+          }
+        }
+        e = next_dir(e, seg);
+      } while (e);
+    }
+  }
+  ats_memalign_free(buf);
+
+  return zret;
+}
+
+void
+CacheScan::alternate_stats(char *buf, int length, ScanStats &stats, time_t now)
+{
+  char *start = buf;
+  int count   = 0;
+
+  while (length - (buf - start) > static_cast<int>(sizeof(HTTPCacheAlt))) {
+    HTTPCacheAlt *a = reinterpret_cast<HTTPCacheAlt *>(buf);
+    if (a->m_magic != CACHE_ALT_MAGIC_MARSHALED || this->unmarshal(buf, length - (buf - start), nullptr).size() ||
+        a->m_unmarshal_len <= 0) {
+      break;
+    }
+
+    int64_t object_size;
+    memcpy(&object_size, a->m_object_size, sizeof(object_size));
+    ++stats.object_size[ScanStats::bucket(std::max<int64_t>(object_size, 0))];
+    ++stats.fragment_count[ScanStats::bucket(a->m_frag_offset_count + 1)];
+    if (a->m_response_received_time > 0 && now > a->m_response_received_time) {
+      ++stats.age[ScanStats::bucket(now - a->m_response_received_time)];
+    } else {
+      ++stats.age[0];
+    }
+    if (a->m_frag_offset_count > HTTPCacheAlt::N_INTEGRAL_FRAG_OFFSETS) {
+      ats_free(a->m_frag_offsets);
+    }
+
+    ++count;
+    buf += a->m_unmarshal_len;
+  }
+
+  if (count) {
+    ++stats.objects;
+    stats.alternates += count;
+    ++stats.alternate_count[ScanStats::bucket(count)];
+  } else {
+    ++stats.bad_docs;
+  }
+}
+
+static void
+write_json_string(std::ostream &os, std::string_view str)
+{
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\';
+    }
+    os << c;
+  }
+  os << '"';
+}
+
+Errata
+CacheScan::DumpDir(std::function<void(std::string const &)> const &sink)
+{
+  Errata zret;
+  std::bitset<65536> dir_bitset;
+  std::ostringstream out;
+
+  for (int s = 0; s < this->stripe->_segments; s++) {
+    dir_bitset.reset();
+    out.str("");
+    for (int b = 0; b < this->stripe->_buckets; b++) {
+      CacheDirEntry *seg = this->stripe->dir_segment(s);
+      CacheDirEntry *e   = dir_bucket(b, seg);
+      if (!dir_offset(e)) {
+        continue;
+      }
+      do {
+        // loop detected
+        if (dir_bitset[dir_to_offset(e, seg)]) {
+          break;
+        }
+        dir_bitset[dir_to_offset(e, seg)] = true;
+        out << "{\"span\":";
+        write_json_string(out, this->stripe->_span->_path.view());
+        out << ",\"stripe\":" << this->stripe->_start.count() << ",\"segment\":" << s << ",\"bucket\":" << b
+            << ",\"offset\":" << static_cast<int64_t>(this->stripe->stripe_offset(e)) << ",\"size\":" << dir_approx_size(e)
+            << ",\"tag\":" << dir_tag(e) << ",\"phase\":" << dir_phase(e) << ",\"head\":" << dir_head(e)
+            << ",\"valid\":" << (this->stripe->dir_valid(e) ? "true" : "false") << "}\n";
+        e = next_dir(e, seg);
+      } while (e);
+    }
+    sink(out.str());
+  }
+
+  return zret;
+}
+
 Errata
 CacheScan::unmarshal(HTTPHdrImpl *obj, intptr_t offset)
 {
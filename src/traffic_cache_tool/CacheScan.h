@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <array>
+#include <functional>
+#include <ostream>
 #include <thread>
 #include <unordered_map>
 #include "CacheDefs.h"
@@ -37,6 +40,36 @@
 // using namespace ct;
 namespace ct
 {
+/// Offline statistics for one or more stripes. Each scanning thread fills its own instance, the
+/// results are combined with @c merge.
+struct ScanStats {
+  /// Histogram with power of two buckets. Bucket 0 counts zero values, bucket @a i counts values
+  /// in [2^(i-1), 2^i).
+  static constexpr int N_BUCKETS = 65;
+  using Histogram                = std::array<uint64_t, N_BUCKETS>;
+
+  uint64_t stripes      = 0; ///< Stripes scanned.
+  uint64_t dir_entries  = 0; ///< Directory slots.
+  uint64_t used_entries = 0; ///< Valid directory entries.
+  uint64_t head_entries = 0; ///< Valid directory entries for first fragments.
+  uint64_t bytes_used   = 0; ///< Approximate storage used by valid fragments.
+  uint64_t read_errors  = 0; ///< Failed reads of first fragments.
+  uint64_t bad_docs     = 0; ///< First fragments with an invalid header.
+  uint64_t objects      = 0; ///< First fragments with at least one HTTP alternate.
+  uint64_t alternates   = 0; ///< Alternates of all objects.
+
+  Histogram fragment_size{};   ///< Approximate size of each fragment, from the directory.
+  Histogram object_size{};     ///< Content length of each alternate.
+  Histogram fragment_count{};  ///< Fragments per alternate.
+  Histogram alternate_count{}; ///< Alternates per object.
+  Histogram age{};             ///< Seconds since the response of each alternate was received.
+
+  static int bucket(uint64_t value);
+  void merge(ScanStats const &that);
+  /// Write the statistics as a single JSON object.
+  void write_json(std::ostream &os) const;
+};
+
 class CacheScan
 {
   Stripe *stripe;
@@ -51,6 +84,11 @@ public:
   };
   CacheScan(Stripe *str) : stripe(str) {}
   Errata Scan(bool search = false);
+  /// Accumulate statistics for the stripe in @a stats, computing ages relative to @a now.
+  Errata Stats(ScanStats &stats, time_t now);
+  /// Pass every directory entry, with whether it is valid, as JSON lines to @a sink, one call per segment.
+  Errata DumpDir(std::function<void(std::string const &)> const &sink);
+  void alternate_stats(char *buf, int length, ScanStats &stats, time_t now);
   Errata get_alternates(const char *buf, int length, bool search);
   int unmarshal(HdrHeap *hh, int buf_length, int obj_type, HdrHeapObjImpl **found_obj, RefCountObj *block_ref);
   Errata unmarshal(char *buf, int len, RefCountObj *block_ref);
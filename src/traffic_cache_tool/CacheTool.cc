@@ -35,6 +35,9 @@
 #include <ctime>
 #include <bitset>
 #include <cinttypes>
+#include <atomic>
+#include <functional>
+#include <mutex>
 
 #include "tscore/ink_memory.h"
 #include "tscore/ink_file.h"
@@ -65,6 +68,7 @@ const Bytes ts::CacheSpan::OFFSET{CacheStoreBlocks{1}};
 ts::file::path SpanFile;
 ts::file::path VolumeFile;
 ts::ArgParser parser;
+unsigned Scan_Threads = 0; ///< Worker threads for offline analytics, 0 means one per CPU.
 
 Errata err;
 
@@ -1362,6 +1366,86 @@ Scan_Cache(ts::file::path const &regex_path)
   }
 }
 
+static unsigned
+scan_threads()
+{
+  return Scan_Threads ? Scan_Threads : std::max(1U, std::thread::hardware_concurrency());
+}
+
+/// Call @a fn with the directory of every allocated stripe of @a cache loaded.
+/// Stripes are handed out to a pool of @c Scan_Threads threads from a shared counter so a span
+/// with many stripes does not serialize the scan. @a fn is passed the index of the worker.
+static void
+for_each_stripe(Cache &cache, std::function<void(Stripe *, unsigned)> const &fn)
+{
+  std::vector<Stripe *> stripes;
+  for (auto sp : cache._spans) {
+    for (auto strp : sp->_stripes) {
+      if (!strp->isFree()) {
+        stripes.push_back(strp);
+      }
+    }
+  }
+
+  unsigned n_threads = std::max<size_t>(1, std::min<size_t>(scan_threads(), stripes.size()));
+  std::atomic<size_t> next{0};
+  std::vector<std::thread> threadPool;
+  for (unsigned i = 0; i < n_threads; ++i) {
+    threadPool.emplace_back([&, i]() {
+      for (size_t k = next++; k < stripes.size(); k = next++) {
+        Stripe *strp = stripes[k];
+        if (!strp->loadMeta()) {
+          std::cerr << "Failed to load stripe " << strp->hashText << std::endl;
+          continue;
+        }
+        strp->loadDir();
+        fn(strp, i);
+        strp->unloadDir();
+      }
+    });
+  }
+  for (auto &th : threadPool) {
+    th.join();
+  }
+}
+
+void
+Scan_Stats()
+{
+  Cache cache;
+  if ((err = cache.loadSpan(SpanFile))) {
+    if (err.size()) {
+      return;
+    }
+    std::vector<ScanStats> stats(scan_threads());
+    time_t now = time(nullptr);
+    for_each_stripe(cache, [&](Stripe *strp, unsigned i) { CacheScan(strp).Stats(stats[i], now); });
+    for (size_t i = 1; i < stats.size(); ++i) {
+      stats[0].merge(stats[i]);
+    }
+    stats[0].write_json(std::cout);
+  }
+}
+
+void
+Scan_Dir()
+{
+  Cache cache;
+  std::mutex out_lock;
+  if ((err = cache.loadSpan(SpanFile))) {
+    if (err.size()) {
+      return;
+    }
+    for_each_stripe(cache, [&](Stripe *strp, unsigned) {
+      CacheScan(strp).DumpDir([&](std::string const &text) {
+        std::lock_guard<std::mutex> lock(out_lock);
+        std::cout << text;
+      });
+    });
+    std::cout.flush();
+  }
+}
+
 int
 main(int argc, const char *argv[])
 {
@@ -1376,7 +1460,8 @@ main(int argc, const char *argv[])
     .add_option("--write", "-w", "")
     .add_option("--input", "-i", "", "", 1)
     .add_option("--device", "-d", "", "", 1)
-    .add_option("--aos", "-o", "", "", 1);
+    .add_option("--aos", "-o", "", "", 1)
+    .add_option("--threads", "-t", "", "", 1);
 
   parser.add_command("list", "List elements of the cache", []() { List_Stripes(Cache::SpanDumpDepth::SPAN); })
     .add_command("stripes", "List the stripes", []() { List_Stripes(Cache::SpanDumpDepth::STRIPE); });
@@ -1395,8 +1480,11 @@ main(int argc, const char *argv[])
   parser.add_command("clearspan", "clear specific span").add_command("span", "device path", [&]() { Clear_Span(inputFile); });
   parser.add_command("retrieve", " retrieve the response of the given list of URLs", [&]() { Get_Response(input_url_file); });
   parser.add_command("init", " Initializes uninitialized span", [&]() { Init_disk(input_url_file); });
-  parser.add_command("scan", " Scans the whole cache and lists the urls of the cached contents",
-                     [&]() { Scan_Cache(input_url_file); });
+  parser
+    .add_command("scan", " Scans the whole cache and lists the urls of the cached contents",
+                 [&]() { Scan_Cache(input_url_file); })
+    .add_command("stats", "Object size, age, alternate and fragment statistics as JSON", &Scan_Stats)
+    .add_command("dir", "Dump the directory entries as JSON lines", &Scan_Dir);
 
   // parse the arguments
   auto arguments = parser.parse(argv);
@@ -1412,6 +1500,9 @@ main(int argc, const char *argv[])
   if (auto data = arguments.get("aos")) {
     cache_config_min_average_object_size = std::stoi(data.value());
   }
+  if (auto data = arguments.get("threads")) {
+    Scan_Threads = std::stoi(data.value());
+  }
   if (auto data = arguments.get("device")) {
     inputFile = data.value();
   }
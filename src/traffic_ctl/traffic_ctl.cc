@@ -170,6 +170,7 @@ main(int argc, const char **argv)
   auto &storage_command = engine.parser.add_command("storage", "Manipulate cache storage").require_commands();
   auto &plugin_command  = engine.parser.add_command("plugin", "Interact with plugins").require_commands();
   auto &host_command    = engine.parser.add_command("host", "Interact with host status").require_commands();
+  auto &ssl_command     = engine.parser.add_command("ssl", "Manage TLS state of the server").require_commands();
 
   // alarm commands
   alarm_command.add_command("clear", "Clear all current alarms", [&]() { engine.alarm_clear(); })
@@ -253,6 +254,12 @@ main(int argc, const char **argv)
     .add_option("--no-new-connection", "-N", "Wait for new connections down to threshold before starting draining")
     .add_option("--undo", "-U", "Recover server from the drain mode");
 
+  // ssl commands
+  ssl_command
+    .add_command("rotate_ticket_keys", "Rotate the TLS session ticket keys without a reload",
+                 [&]() { engine.ssl_rotate_ticket_keys(); })
+    .add_example_usage("traffic_ctl ssl rotate_ticket_keys");
+
   // storage commands
   storage_command
     .add_command("offline", "Take one or more storage volumes offline", "", MORE_THAN_ONE_ARG_N,
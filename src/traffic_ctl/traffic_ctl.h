@@ -215,6 +215,9 @@ struct CtrlEngine {
   void server_start();
   void server_drain();
 
+  // ssl methods
+  void ssl_rotate_ticket_keys();
+
   // storage methods
   void storage_offline();
 };
@@ -131,6 +131,8 @@ event_int_to_string(int event, int blen, char *buffer)
     return "MGMT_EVENT_HOST_STATUS_UP";
   case MGMT_EVENT_HOST_STATUS_DOWN:
     return "MGMT_EVENT_HOST_STATUS_DOWN";
+  case MGMT_EVENT_SSL_TICKET_KEY_ROTATE:
+    return "MGMT_EVENT_SSL_TICKET_KEY_ROTATE";
 
   default:
     if (buffer != nullptr) {
@@ -128,6 +128,7 @@ static void mgmt_restart_shutdown_callback(ts::MemSpan<void>);
 static void mgmt_drain_callback(ts::MemSpan<void>);
 static void mgmt_storage_device_cmd_callback(int cmd, std::string_view const &arg);
 static void mgmt_lifecycle_msg_callback(ts::MemSpan<void>);
+static void mgmt_ssl_ticket_key_rotate_callback(ts::MemSpan<void>);
 static void init_ssl_ctx_callback(void *ctx, bool server);
 static void load_ssl_file_callback(const char *ssl_file);
 static void load_remap_file_callback(const char *remap_file);
@@ -1932,6 +1933,7 @@ main(int /* argc ATS_UNUSED */, const char **argv)
   }
 
   REC_ReadConfigInteger(thread_max_heartbeat_mseconds, "proxy.config.thread.max_heartbeat_mseconds");
+  REC_ReadConfigInteger(thread_timer_wheel, "proxy.config.thread.timer_wheel");
 
   ink_event_system_init(ts::ModuleVersion(1, 0, ts::ModuleVersion::PRIVATE));
   ink_net_init(ts::ModuleVersion(1, 0, ts::ModuleVersion::PRIVATE));
@@ -2122,6 +2124,7 @@ main(int /* argc ATS_UNUSED */, const char **argv)
       mgmt_storage_device_cmd_callback(MGMT_EVENT_STORAGE_DEVICE_CMD_OFFLINE, span.view());
     });
     pmgmt->registerMgmtCallback(MGMT_EVENT_LIFECYCLE_MESSAGE, &mgmt_lifecycle_msg_callback);
+    pmgmt->registerMgmtCallback(MGMT_EVENT_SSL_TICKET_KEY_ROTATE, &mgmt_ssl_ticket_key_rotate_callback);
 
     ink_set_thread_name("[TS_MAIN]");
 
@@ -2204,6 +2207,12 @@ mgmt_lifecycle_msg_callback(ts::MemSpan<void> span)
   }
 }
 
+static void
+mgmt_ssl_ticket_key_rotate_callback(ts::MemSpan<void>)
+{
+  SSLTicketKeyConfig::schedule_rotate();
+}
+
 static void
 init_ssl_ctx_callback(void *ctx, bool server)
 {
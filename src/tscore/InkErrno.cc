@@ -65,6 +65,8 @@ InkStrerror(int ink_errno)
     return "ECACHE_ALT_MISS";
   case ECACHE_BAD_READ_REQUEST:
     return "ECACHE_BAD_READ_REQUEST";
+  case ECACHE_NOT_ADMITTED:
+    return "ECACHE_NOT_ADMITTED";
   case EHTTP_ERROR:
     return "EHTTP_ERROR";
   }
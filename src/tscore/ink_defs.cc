@@ -67,6 +67,27 @@ ink_get_topology()
 
 #endif
 
+void
+ink_numa_interleave(void *addr, size_t len)
+{
+#if TS_USE_HWLOC
+  hwloc_topology_t topology = ink_get_topology();
+
+  if (hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE) > 1) {
+#if HWLOC_API_VERSION >= 0x20000
+    hwloc_set_area_membind(topology, addr, len, hwloc_topology_get_topology_nodeset(topology), HWLOC_MEMBIND_INTERLEAVE,
+                           HWLOC_MEMBIND_MIGRATE | HWLOC_MEMBIND_BYNODESET);
+#else
+    hwloc_set_area_membind_nodeset(topology, addr, len, hwloc_topology_get_topology_nodeset(topology), HWLOC_MEMBIND_INTERLEAVE,
+                                   HWLOC_MEMBIND_MIGRATE);
+#endif
+  }
+#else
+  (void)addr;
+  (void)len;
+#endif
+}
+
 int
 ink_sys_name_release(char *name, int namelen, char *release, int releaselen)
 {
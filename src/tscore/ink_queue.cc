@@ -37,7 +37,9 @@
   ****************************************************************************/
 
 #include "tscore/ink_config.h"
+#include <atomic>
 #include <cassert>
+#include <mutex>
 #include <memory.h>
 #include <cstdlib>
 #include <unistd.h>
@@ -49,6 +51,7 @@
 #include "tscore/ink_error.h"
 #include "tscore/ink_assert.h"
 #include "tscore/ink_align.h"
+#include "tscore/ink_thread.h"
 #include "tscore/hugepages.h"
 #include "tscore/Diags.h"
 #include "tscore/JeAllocator.h"
@@ -93,6 +96,44 @@ static const ink_freelist_ops *default_ops = &freelist_ops;
 
 static ink_freelist_list *freelists                = nullptr;
 static const ink_freelist_ops *freelist_global_ops = default_ops;
+static std::atomic<uint32_t> freelist_count{0}; // freelists may be created on any thread
+
+/*
+ * Per thread magazines
+ *
+ * With magazines enabled each thread keeps a short stack of free items
+ * for every freelist it uses. Allocation and free on the same thread
+ * touch only that stack; it is refilled from, or half of it returned
+ * to, the global list when it runs empty or full. Items held in a
+ * magazine count as used by the global list.
+ */
+
+// Cap on the memory one magazine may hold, so large buffer freelists get few or no items.
+#define FREELIST_MAGAZINE_MAX_BYTES (256 * 1024)
+
+struct ink_freelist_magazine {
+  void *head;
+  uint32_t count;
+  uint32_t capacity; // 0 until first use, UINT32_MAX if this freelist bypasses the magazine
+  uint64_t hits;     // allocations served from the magazine
+  uint64_t misses;   // allocations that refilled it from the global list
+};
+
+struct ink_freelist_thread_magazines {
+  ink_freelist_magazine *mags = nullptr;
+  uint32_t n_mags             = 0;
+  bool registered             = false;
+  bool destroyed              = false;
+  char thread_name[32]        = {0};
+  ink_freelist_thread_magazines *next = nullptr;
+
+  ~ink_freelist_thread_magazines();
+};
+
+static uint32_t freelist_magazine_size = 0;
+static std::mutex freelist_magazines_mutex;
+static ink_freelist_thread_magazines *freelist_magazines = nullptr;
+static thread_local ink_freelist_thread_magazines thread_magazines;
 
 const InkFreeListOps *
 ink_freelist_malloc_ops()
@@ -116,6 +157,12 @@ ink_freelist_init_ops(int nofl_class, int nofl_proxy)
   freelist_global_ops = (nofl_class || nofl_proxy) ? ink_freelist_malloc_ops() : ink_freelist_freelist_ops();
 }
 
+void
+ink_freelist_init_magazines(uint32_t magazine_size)
+{
+  freelist_magazine_size = magazine_size;
+}
+
 void
 ink_freelist_init(InkFreeList **fl, const char *name, uint32_t type_size, uint32_t chunk_size, uint32_t alignment)
 {
@@ -152,6 +199,7 @@ ink_freelist_init(InkFreeList **fl, const char *name, uint32_t type_size, uint32
   }
   Debug(DEBUG_TAG "_init", "<%s> Chunk Size request/actual (%" PRIu32 "/%" PRIu32 ")", name, chunk_size, f->chunk_size);
   SET_FREELIST_POINTER_VERSION(f->head, FROM_PTR(0), 0);
+  f->magazine_index = freelist_count.fetch_add(1);
 
   *fl = f;
 }
@@ -179,11 +227,108 @@ ink_freelist_create(const char *name, uint32_t type_size, uint32_t chunk_size, u
 int fake_global_for_ink_queue = 0;
 #endif
 
+static ink_freelist_magazine *
+freelist_magazine(InkFreeList *f)
+{
+  ink_freelist_thread_magazines &tm = thread_magazines;
+
+  if (unlikely(f->magazine_index >= tm.n_mags)) {
+    if (tm.destroyed) { // freed by a thread_local destructor running after ours
+      return nullptr;
+    }
+    uint32_t n = std::max(f->magazine_index + 1, freelist_count.load());
+    std::lock_guard<std::mutex> lock(freelist_magazines_mutex);
+
+    tm.mags = static_cast<ink_freelist_magazine *>(ats_realloc(tm.mags, n * sizeof(ink_freelist_magazine)));
+    memset(tm.mags + tm.n_mags, 0, (n - tm.n_mags) * sizeof(ink_freelist_magazine));
+    tm.n_mags = n;
+    if (!tm.registered) {
+      ink_get_thread_name(tm.thread_name, sizeof(tm.thread_name));
+      tm.next            = freelist_magazines;
+      freelist_magazines = &tm;
+      tm.registered      = true;
+    }
+  }
+
+  ink_freelist_magazine *m = tm.mags + f->magazine_index;
+  if (unlikely(m->capacity == 0)) {
+    m->capacity = std::min(freelist_magazine_size, FREELIST_MAGAZINE_MAX_BYTES / f->type_size);
+    if (m->capacity == 0) {
+      m->capacity = UINT32_MAX;
+    }
+  }
+  return m->capacity == UINT32_MAX ? nullptr : m;
+}
+
+// Return the first @a n items of @a m to the global list.
+static void
+freelist_magazine_flush(InkFreeList *f, ink_freelist_magazine *m, uint32_t n)
+{
+  void *head = m->head;
+  void *tail = head;
+
+  for (uint32_t i = 1; i < n; ++i) {
+    tail = *ADDRESS_OF_NEXT(tail, 0);
+  }
+  m->head = *ADDRESS_OF_NEXT(tail, 0);
+  m->count -= n;
+  freelist_bulkfree(f, head, tail, n);
+  ink_atomic_decrement(reinterpret_cast<int *>(&f->used), n);
+}
+
+ink_freelist_thread_magazines::~ink_freelist_thread_magazines()
+{
+  if (registered) {
+    std::lock_guard<std::mutex> lock(freelist_magazines_mutex);
+
+    for (ink_freelist_list *fll = freelists; fll; fll = fll->next) {
+      ink_freelist_magazine *m = mags + fll->fl->magazine_index;
+      if (fll->fl->magazine_index < n_mags && m->count > 0) {
+        freelist_magazine_flush(fll->fl, m, m->count);
+      }
+    }
+    for (ink_freelist_thread_magazines **p = &freelist_magazines; *p; p = &(*p)->next) {
+      if (*p == this) {
+        *p = next;
+        break;
+      }
+    }
+  }
+  ats_free(mags);
+  mags      = nullptr;
+  n_mags    = 0;
+  destroyed = true;
+}
+
 void *
 ink_freelist_new(InkFreeList *f)
 {
   void *ptr;
 
+  if (freelist_magazine_size && freelist_global_ops == &freelist_ops) {
+    ink_freelist_magazine *m = freelist_magazine(f);
+    if (m != nullptr) {
+      if (m->count > 0) {
+        ++m->hits;
+      } else {
+        // Refill half the magazine so the next frees have room.
+        uint32_t n = (m->capacity + 1) / 2;
+        for (uint32_t i = 0; i < n; ++i) {
+          ptr                       = freelist_new(f);
+          *ADDRESS_OF_NEXT(ptr, 0) = m->head;
+          m->head                   = ptr;
+        }
+        m->count = n;
+        ++m->misses;
+        ink_atomic_increment(reinterpret_cast<int *>(&f->used), n);
+      }
+      ptr     = m->head;
+      m->head = *ADDRESS_OF_NEXT(ptr, 0);
+      --m->count;
+      return ptr;
+    }
+  }
+
   if (likely(ptr = freelist_global_ops->fl_new(f))) {
     ink_atomic_increment(reinterpret_cast<int *>(&f->used), 1);
   }
@@ -274,6 +419,18 @@ ink_freelist_free(InkFreeList *f, void *item)
 {
   if (likely(item != nullptr)) {
     ink_assert(f->used != 0);
+    if (freelist_magazine_size && freelist_global_ops == &freelist_ops) {
+      ink_freelist_magazine *m = freelist_magazine(f);
+      if (m != nullptr) {
+        if (m->count == m->capacity) {
+          freelist_magazine_flush(f, m, m->capacity - m->capacity / 2);
+        }
+        *ADDRESS_OF_NEXT(item, 0) = m->head;
+        m->head                   = item;
+        ++m->count;
+        return;
+      }
+    }
     freelist_global_ops->fl_free(f, item);
     ink_atomic_decrement(reinterpret_cast<int *>(&f->used), 1);
   }
@@ -462,6 +619,29 @@ ink_freelists_dump(FILE *f)
   }
   fprintf(f, " %18" PRIu64 " | %18" PRIu64 " |            | TOTAL\n", total_allocated, total_used);
   fprintf(f, "-----------------------------------------------------------------------------------------\n");
+
+  if (freelist_magazine_size == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(freelist_magazines_mutex);
+
+  fprintf(f, "     Magazine Hits  |   Magazine Misses  | Hit Rate | Cached Bytes |   Thread\n");
+  fprintf(f, "--------------------|--------------------|----------|--------------|----------------------\n");
+  for (ink_freelist_thread_magazines *tm = freelist_magazines; tm; tm = tm->next) {
+    uint64_t hits = 0, misses = 0, cached = 0;
+    for (fll = freelists; fll; fll = fll->next) {
+      if (fll->fl->magazine_index < tm->n_mags) {
+        ink_freelist_magazine *m = tm->mags + fll->fl->magazine_index;
+        hits += m->hits;
+        misses += m->misses;
+        cached += static_cast<uint64_t>(m->count) * fll->fl->type_size;
+      }
+    }
+    fprintf(f, " %18" PRIu64 " | %18" PRIu64 " | %7.2f%% | %12" PRIu64 " | %s\n", hits, misses,
+            hits + misses ? 100.0 * hits / (hits + misses) : 0.0, cached, tm->thread_name);
+  }
+  fprintf(f, "-----------------------------------------------------------------------------------------\n");
 }
 
 void
@@ -27,6 +27,8 @@
 #include "tscore/ink_queue.h"
 
 #define NTHREADS 64
+#define RUN_SECONDS 30
+#define MAGAZINE_SIZE 32
 InkFreeList *flist = nullptr;
 
 void *
@@ -58,26 +60,41 @@ test(void *d)
     ink_freelist_free(flist, m2);
     ink_freelist_free(flist, m3);
 
-    // break out of the test if we have run more then 60 seconds
-    if (++count % 1000 == 0 && (start + 60) < time(nullptr)) {
+    // break out of the test if we have run more then RUN_SECONDS
+    if (++count % 1000 == 0 && (start + RUN_SECONDS) < time(nullptr)) {
       return nullptr;
     }
   }
 }
 
-int
-main(int /* argc ATS_UNUSED */, char * /*argv ATS_UNUSED */[])
+static void
+run(const char *name)
 {
-  int i;
+  ink_thread threads[NTHREADS];
 
-  flist = ink_freelist_create("woof", 64, 256, 8);
+  flist = ink_freelist_create(name, 64, 256, 8);
 
-  for (i = 0; i < NTHREADS; i++) {
-    fprintf(stderr, "Create thread %d\n", i);
-    ink_thread_create(nullptr, test, (void *)(static_cast<intptr_t>(i)), 0, 0, nullptr);
+  for (int i = 0; i < NTHREADS; i++) {
+    fprintf(stderr, "%s: create thread %d\n", name, i);
+    ink_thread_create(&threads[i], test, (void *)(static_cast<intptr_t>(i)), 0, 0, nullptr);
   }
 
   test((void *)NTHREADS);
 
+  for (auto t : threads) {
+    ink_thread_join(t);
+  }
+}
+
+int
+main(int argc, char *argv[])
+{
+  run("woof");
+
+  // The same workload through the per thread magazines. Their size is
+  // read when a list is first used by a thread, so use a new list.
+  ink_freelist_init_magazines(argc > 1 ? atoi(argv[1]) : MAGAZINE_SIZE);
+  run("woof-magazine");
+
   return 0;
 }